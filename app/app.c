@@ -33,6 +33,7 @@
 #include "board_indicator.h"
 #include "app_hw.h"
 #include "app_credentials.h"
+#include "app_schedules.h"
 #include "database_common.h"
 #include "ZAF_ApplicationEvents.h"
 #include "zaf_event_distributor_soc.h"
@@ -199,11 +200,56 @@ zaf_event_distributor_app_event_manager(const uint8_t event)
       request_credential_from_user();
       break;
     }
+    case EVENT_APP_DELETE_ALL_YD_SCHEDULES_START:
+    case EVENT_APP_DELETE_ALL_DR_SCHEDULES_START:
+    {
+      // Erase All has been accepted, clear the first users right away
+      app_sch_erase_all_process();
+      break;
+    }
+    case EVENT_APP_TIME_SYNC:
+    {
+      // Read the new time, so that the schedules are enforced from the correct time
+      app_sch_time_sync();
+      break;
+    }
     default:
       break;
   }
 }
 
+/**
+ * Door handle events are handled before reports and erase jobs. Repeated requests
+ * for a report, an erase job or a time sync are merged while the first one is still
+ * waiting.
+ */
+zaf_event_distributor_event_policy_t
+zaf_event_distributor_app_event_policy(const uint8_t event)
+{
+  zaf_event_distributor_event_policy_t policy = {
+    .lane = ZAF_EVENT_DISTRIBUTOR_LANE_BULK,
+    .coalesce = false
+  };
+
+  switch (event) {
+    case EVENT_APP_DOORHANDLE_ACTIVATED:
+    case EVENT_APP_DOORHANDLE_DEACTIVATED:
+      policy.lane = ZAF_EVENT_DISTRIBUTOR_LANE_URGENT;
+      break;
+    case EVENT_APP_BATTERY_REPORT:
+    case EVENT_APP_PERIODIC_BATTERY_CHECK_TRIGGER:
+    case EVENT_APP_DELETE_ALL_YD_SCHEDULES_START:
+    case EVENT_APP_DELETE_ALL_DR_SCHEDULES_START:
+    case EVENT_APP_TIME_SYNC:
+      policy.coalesce = true;
+      break;
+    default:
+      break;
+  }
+
+  return policy;
+}
+
 /**
  * @brief Timer function for periodic battery level checking
  * @param pTimer Timer object assigned to this function
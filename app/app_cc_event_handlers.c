@@ -20,6 +20,7 @@
 #include "CC_UserCode.h"
 #include "CC_UserCredential.h"
 #include "CC_Supervision.h"
+#include "CC_ActiveSchedule_types.h"
 #include "zaf_event_distributor_soc.h"
 #include "events.h"
 
@@ -47,3 +48,45 @@ door_lock_app_event_handler(const uint8_t event, const void *data)
 
 ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER(COMMAND_CLASS_USER_CODE, user_code_app_event_handler);
 ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER(COMMAND_CLASS_DOOR_LOCK, door_lock_app_event_handler);
+
+/**
+ * Lets the events on the way from entering a code to operating the lock overtake
+ * reports and schedule updates, which can pile up during bulk provisioning.
+ */
+zaf_event_distributor_event_policy_t
+zaf_event_distributor_cc_event_policy(const uint16_t command_class, const uint8_t event)
+{
+  zaf_event_distributor_event_policy_t policy = {
+    .lane = ZAF_EVENT_DISTRIBUTOR_LANE_BULK,
+    .coalesce = false
+  };
+
+  switch (command_class) {
+    case COMMAND_CLASS_USER_CODE:
+      if ((CC_USER_CODE_EVENT_VALIDATE == event)
+          || (CC_USER_CODE_EVENT_VALIDATE_VALID == event)
+          || (CC_USER_CODE_EVENT_VALIDATE_INVALID == event)) {
+        policy.lane = ZAF_EVENT_DISTRIBUTOR_LANE_URGENT;
+      }
+      break;
+    case COMMAND_CLASS_USER_CREDENTIAL:
+      if ((CC_USER_CREDENTIAL_EVENT_VALIDATE == event)
+          || (CC_USER_CREDENTIAL_EVENT_VALIDATE_VALID == event)
+          || (CC_USER_CREDENTIAL_EVENT_VALIDATE_INVALID == event)) {
+        policy.lane = ZAF_EVENT_DISTRIBUTOR_LANE_URGENT;
+      }
+      break;
+    case COMMAND_CLASS_DOOR_LOCK:
+      // Toggling twice is not the same as toggling once, so lock events are never coalesced
+      policy.lane = ZAF_EVENT_DISTRIBUTOR_LANE_URGENT;
+      break;
+    case COMMAND_CLASS_ACTIVE_SCHEDULE:
+      // The event data of a User always holds its latest schedule state
+      policy.coalesce = (ASCC_APP_EVENT_ON_SCHEDULE_STATE_CHANGE == event);
+      break;
+    default:
+      break;
+  }
+
+  return policy;
+}
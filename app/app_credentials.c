@@ -4,6 +4,7 @@
  * SPDX-FileCopyrightText: 2025 Card Access Engineering, LLC.
  */
 #include "app_credentials.h"
+#include "app_schedules_access.h"
 #include "CC_UserCredential.h"
 #include "cc_user_credential_io.h"
 #include "cc_user_credential_io_config.h"
@@ -49,6 +50,12 @@ void initialize_user_credential_database(void)
   }
 }
 
+bool CC_UserCredential_manufacturer_validate_user_schedule(const uint16_t uuid)
+{
+  // Kept up to date by the schedule tick service, so no date is converted here
+  return app_sch_is_user_in_schedule(uuid);
+}
+
 void request_credential_from_user(void)
 {
   zaf_event_distributor_enqueue_cc_event(
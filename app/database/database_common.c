@@ -36,6 +36,8 @@ extern "C" {
 /*                       PRIVATE FUNCTION DECLARATIONS                      */
 /****************************************************************************/
 
+static bool get_file_key(const app_nvm_area_t area, uint16_t offset, zpal_nvm_object_key_t* key);
+
 /****************************************************************************/
 /*                       EXPORTED FUNCTION DEFINITIONS                      */
 /****************************************************************************/
@@ -51,31 +53,13 @@ bool app_nvm(
   app_nvm_operation_t operation, app_nvm_area_t area, uint16_t offset, void* pData,
   uint16_t size)
 {
-  // Set parameters depending on the NVM area
-  zpal_nvm_object_key_t file_base;
-  switch (area) {
-  /**********************/ 
-  /* Known size objects */
-  /**********************/
-    case APP_NVM_AREA_MIGRATION_TABLE:
-      file_base = APP_NVM_FILE_MIGRATION_TABLE;
-      size = 0; // FIXME: Store migration mapping information in here.
-      offset = 0;
-      break;
-
-    /************************/
-    /* Dynamic size objects */
-    /************************/
-    case APP_NVM_AREA_SCHEDULE_DATA:
-      file_base = APP_NVM_FILE_SCHEDULE_DATA_BASE;
-      break;
-      
-    case APP_NVM_AREA_MIGRATION_DATA:
-      file_base = APP_NVM_FILE_MIGRATION_DATA_BASE;
-      break;
+  if (area == APP_NVM_AREA_MIGRATION_TABLE) {
+    size = 0; // FIXME: Store migration mapping information in here.
+  }
 
-    default:
-      return false;
+  zpal_nvm_object_key_t file_key;
+  if (!get_file_key(area, offset, &file_key)) {
+    return false;
   }
 
   if (size == 0) {
@@ -85,20 +69,99 @@ bool app_nvm(
   zpal_status_t nvm_result = ZPAL_STATUS_FAIL;
   switch (operation) {
     case U3C_READ:
-      nvm_result = ZAF_nvm_app_write(file_base + offset, pData, (size_t)size);
+      nvm_result = ZAF_nvm_app_read(file_key, pData, (size_t)size);
       break;
     case U3C_WRITE:
-      nvm_result = ZAF_nvm_app_write(file_base + offset, pData, (size_t)size);
+      nvm_result = ZAF_nvm_app_write(file_key, pData, (size_t)size);
       break;
     default:
       break;
   }
   return nvm_result == ZPAL_STATUS_OK;
 }
+
+bool app_nvm_read_part(
+  const app_nvm_area_t area, uint16_t offset, void* pData, uint16_t object_offset,
+  uint16_t size)
+{
+  zpal_nvm_object_key_t file_key;
+  if (!get_file_key(area, offset, &file_key)) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+  return ZAF_nvm_app_read_object_part(file_key, pData, (size_t)object_offset, (size_t)size)
+         == ZPAL_STATUS_OK;
+}
+
+bool app_nvm_get_size(const app_nvm_area_t area, uint16_t offset, uint16_t* size)
+{
+  zpal_nvm_object_key_t file_key;
+  size_t len = 0;
+  if (!size || !get_file_key(area, offset, &file_key)) {
+    return false;
+  }
+  if (ZAF_nvm_app_get_object_size(file_key, &len) != ZPAL_STATUS_OK) {
+    return false;
+  }
+  *size = (uint16_t)len;
+  return true;
+}
+
+bool app_nvm_erase(const app_nvm_area_t area, uint16_t offset)
+{
+  zpal_nvm_object_key_t file_key;
+  if (!get_file_key(area, offset, &file_key)) {
+    return false;
+  }
+  return ZAF_nvm_app_erase_object(file_key) == ZPAL_STATUS_OK;
+}
 /****************************************************************************/
 /*                       PRIVATE FUNCTION DEFINITIONS                       */
 /****************************************************************************/
 
+/**
+ * @brief Resolve the file key of an object in the application NVM.
+ *
+ * @param area   NVM area of the object
+ * @param offset Offset of the object within the area
+ * @param[out] key File key of the object
+ *
+ * @return true if the area is known
+ */
+static bool get_file_key(const app_nvm_area_t area, uint16_t offset, zpal_nvm_object_key_t* key)
+{
+  // Set parameters depending on the NVM area
+  switch (area) {
+  /**********************/
+  /* Known size objects */
+  /**********************/
+    case APP_NVM_AREA_MIGRATION_TABLE:
+      *key = APP_NVM_FILE_MIGRATION_TABLE;
+      break;
+
+    /************************/
+    /* Dynamic size objects */
+    /************************/
+    case APP_NVM_AREA_SCHEDULE_DATA:
+      *key = APP_NVM_FILE_SCHEDULE_DATA_BASE + offset;
+      break;
+
+    case APP_NVM_AREA_SCHEDULE_SLOT:
+      *key = APP_NVM_FILE_SCHEDULE_SLOT_BASE + offset;
+      break;
+
+    case APP_NVM_AREA_MIGRATION_DATA:
+      *key = APP_NVM_FILE_MIGRATION_DATA_BASE + offset;
+      break;
+
+    default:
+      return false;
+  }
+  return true;
+}
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -40,11 +40,19 @@ extern "C" {
 #define APP_NVM_FILE_SCHEDULE_DATA_END \
   (APP_NVM_FILE_SCHEDULE_DATA_BASE +   \
    CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS - 1) // One file for each user, base inclusive
+#define APP_NVM_SCHEDULE_SLOTS_PER_USER \
+  (CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER + \
+   CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER)
+#define APP_NVM_FILE_SCHEDULE_SLOT_BASE  (APP_NVM_FILE_SCHEDULE_DATA_END + 1)
+#define APP_NVM_FILE_SCHEDULE_SLOT_END \
+  (APP_NVM_FILE_SCHEDULE_SLOT_BASE +   \
+   (CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS * APP_NVM_SCHEDULE_SLOTS_PER_USER) - 1) // One file for each schedule slot
 
 typedef enum _app_nvm_area_ {
   APP_NVM_AREA_MIGRATION_TABLE, ///< Flash area for migration metadata
   APP_NVM_AREA_MIGRATION_DATA,  ///< Flash area for storing data for each migration operation
-  APP_NVM_AREA_SCHEDULE_DATA,   ///< Flash area to store schedule data
+  APP_NVM_AREA_SCHEDULE_DATA,   ///< Flash area to store the schedule state of each user
+  APP_NVM_AREA_SCHEDULE_SLOT,   ///< Flash area to store individual schedule slots
 } app_nvm_area_t;
 
 // Simple typedef for readability's sake, and ensuring all NVM operations share the same
@@ -72,6 +80,43 @@ bool app_nvm(
   const app_nvm_operation_t operation, const app_nvm_area_t area, uint16_t offset, void* pData,
   uint16_t size);
 
+/**
+ * @brief  Read part of an object from the application NVM, without transferring
+ *         the bytes before or after it.
+ *
+ * @param area          NVM area of the object
+ * @param offset        Offset of the object within the area
+ * @param pData         Buffer in which to return the data
+ * @param object_offset Offset within the object of the first byte to read
+ * @param size          Number of bytes to read
+ *
+ * @return true if the object exists and the part was read successfully
+ */
+bool app_nvm_read_part(
+  const app_nvm_area_t area, uint16_t offset, void* pData, uint16_t object_offset,
+  uint16_t size);
+
+/**
+ * @brief  Get the size of an object stored in the application NVM.
+ *
+ * @param area   NVM area of the object
+ * @param offset Offset of the object within the area
+ * @param[out] size Size of the stored object
+ *
+ * @return true if the object exists
+ */
+bool app_nvm_get_size(const app_nvm_area_t area, uint16_t offset, uint16_t* size);
+
+/**
+ * @brief  Remove an object from the application NVM.
+ *
+ * @param area   NVM area of the object
+ * @param offset Offset of the object within the area
+ *
+ * @return true if the object was removed
+ */
+bool app_nvm_erase(const app_nvm_area_t area, uint16_t offset);
+
 
 #ifdef __cplusplus
 }
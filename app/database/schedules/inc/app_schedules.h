@@ -40,10 +40,52 @@ extern "C" {
 void app_sch_initialize_handlers(void);
 
 /**
- * @brief Clear all stored schedule information
+ * @brief Clear all stored schedule information.
+ *
+ * The information is cleared in the background, a few users at a time.
  */
 void app_sch_reset_schedules(void);
 
+/**
+ * @brief Sets the current local wall clock time and evaluates the schedules again.
+ *
+ * Until the wall clock has been set, Users with active scheduling are denied access.
+ *
+ * @param now Current local time. Ignored if not a valid time stamp.
+ */
+void app_sch_set_time(const ascc_time_stamp_t * const now);
+
+/**
+ * @brief Time source hook, reads the current local wall clock time.
+ *
+ * The sample application has no time source of its own, so the default
+ * implementation returns false. Override it in the application with whatever
+ * provides time to the lock (e.g. an RTC, or time received from a controller).
+ * It is read by app_sch_time_sync().
+ *
+ * @param[out] now Pointer in which to return the current local time
+ * @return true if @p now holds the current time, false if the time is unknown.
+ */
+bool app_sch_time_source_get(ascc_time_stamp_t * now);
+
+/**
+ * @brief Sets the wall clock of the schedules from app_sch_time_source_get().
+ *
+ * Called once the schedules are initialized, and on EVENT_APP_TIME_SYNC, which the
+ * time source enqueues whenever it has been (re)synchronized.
+ */
+void app_sch_time_sync(void);
+
+/**
+ * @brief Runs one step of the pending erase all jobs, clearing a few users per job.
+ *
+ * Called when an erase all job is started and then automatically until all jobs
+ * are done, with a short pause between steps so incoming frames are processed in
+ * the meantime. When a job requested by a controller completes, the matching
+ * Active Schedule report is sent to it.
+ */
+void app_sch_erase_all_process(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file app_schedules_access.h
+ * @author bstewart-cae
+ * @brief This file contains the access window engine used to decide whether a
+ *        User is allowed in at a given moment, based on the Year Day and Daily
+ *        Repeating schedules attached to that User.
+ *
+ *        The schedule records stored in NVM are compiled into sorted, merged
+ *        time windows held in RAM, so that answering an access request never
+ *        needs to touch flash.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _APP_SCHEDULES_ACCESS_H_
+#define _APP_SCHEDULES_ACCESS_H_
+
+/* CPP type safety */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include "database_types_ascc.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/****************************************************************************/
+/*                      EXPORTED TYPES AND DEFINITIONS                      */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                      EXPORTED FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+/**
+ * @brief Clears every compiled access window for all users.
+ */
+void app_sch_access_reset(void);
+
+/**
+ * @brief Compiles the schedule record of a single user into its RAM resident
+ *        access windows, replacing any windows previously compiled for it.
+ *
+ * @param uuid          User Unique Identifier the record belongs to
+ * @param schedule_data Schedule record for the user, or NULL if the user has no
+ *                      record (which clears the user's windows).
+ */
+void app_sch_access_compile(const uint16_t uuid,
+                            const schedule_metadata_nvm_t * const schedule_data);
+
+/**
+ * @brief Checks whether a user may be granted access at a given moment.
+ *
+ * Users without active scheduling are always allowed. Users with active scheduling
+ * are allowed only if @p now falls within one of their Year Day or Daily Repeating
+ * windows. The check is a binary search over the user's compiled windows.
+ *
+ * @param uuid User Unique Identifier
+ * @param now  Local time to evaluate. Must be a valid time stamp.
+ * @return true if the user may be granted access at @p now.
+ */
+bool app_sch_is_access_allowed(const uint16_t uuid, const ascc_time_stamp_t * const now);
+
+/**
+ * @brief Active Schedule stub signalled by the schedule tick service whenever a User
+ *        enters or leaves its schedules. Updates the access state of the User.
+ *
+ * @param target      User Credential target whose schedule state changed
+ * @param in_schedule true if the User is now within one of its windows
+ */
+void app_sch_schedule_state_changed(const ascc_target_t * const target, const bool in_schedule);
+
+/**
+ * @brief Gets the access state of a User.
+ *
+ * The state is set from the windows of the User whenever its schedules or the wall
+ * clock change, and follows the window boundaries through
+ * app_sch_schedule_state_changed(). Until the wall clock has been set, Users with
+ * active scheduling are kept out and the other Users are allowed in.
+ *
+ * @param uuid User Unique Identifier
+ * @return true if the user may be granted access now.
+ */
+bool app_sch_is_user_in_schedule(const uint16_t uuid);
+
+/**
+ * @brief Sets the current local wall clock time used to evaluate schedules.
+ *
+ * Use app_sch_set_time(), which also reschedules the schedule tick service.
+ *
+ * @param now Current local time. Ignored if not a valid time stamp.
+ */
+void app_sch_set_current_time(const ascc_time_stamp_t * const now);
+
+/**
+ * @brief Gets the current local wall clock time.
+ *
+ * @param[out] now Pointer in which to return the current local time
+ * @return true if the wall clock has been set, false otherwise.
+ */
+bool app_sch_get_current_time(ascc_time_stamp_t * now);
+
+/**
+ * @brief Gets the time until the next moment at which any User with active
+ *        scheduling enters or leaves one of its windows.
+ *
+ * @param max_delay_ms   Longest delay to return, used when no window opens or
+ *                       closes sooner.
+ * @param[out] delay_ms  Pointer in which to return the delay, in milliseconds. May
+ *                       be 0 if a boundary is due now.
+ * @return true on success, false if the wall clock has not been set.
+ */
+bool app_sch_access_get_next_change(const uint32_t max_delay_ms, uint32_t * delay_ms);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* _APP_SCHEDULES_ACCESS_H_ */
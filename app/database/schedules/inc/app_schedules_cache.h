@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file app_schedules_cache.h
+ * @author bstewart-cae
+ * @brief This file contains the RAM write-back cache for the per-User schedule
+ *        records stored in NVM.
+ *
+ *        Records are read from NVM once and then served from RAM. Modified parts
+ *        of a record (the scheduling state or individual slots) are marked dirty
+ *        and written back together after a short quiet period, so a burst of
+ *        Active Schedule Set commands for the same slot results in a single
+ *        flash write, and changing one slot never rewrites the others.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _APP_SCHEDULES_CACHE_H_
+#define _APP_SCHEDULES_CACHE_H_
+
+/* CPP type safety */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include "database_types_ascc.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/****************************************************************************/
+/*                      EXPORTED TYPES AND DEFINITIONS                      */
+/****************************************************************************/
+
+/**
+ * Number of User schedule records held in RAM at once. The least recently used
+ * record is written back and evicted when a new one is needed.
+ */
+#if !defined(APP_SCHEDULE_CACHE_ENTRIES)
+#define APP_SCHEDULE_CACHE_ENTRIES  CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS
+#endif
+
+/**
+ * Quiet period, in milliseconds, after the last modification before dirty records
+ * are written back to NVM.
+ */
+#if !defined(APP_SCHEDULE_CACHE_FLUSH_DELAY_MS)
+#define APP_SCHEDULE_CACHE_FLUSH_DELAY_MS  2000
+#endif
+
+/****************************************************************************/
+/*                      EXPORTED FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+/**
+ * @brief Initializes the cache. Must be called before any other cache function.
+ */
+void app_sch_cache_init(void);
+
+/**
+ * @brief Gets the cached schedule record of a User, loading it from NVM if needed.
+ *
+ * A User without a record in NVM is given an empty record, which is only written
+ * to NVM once it is modified.
+ *
+ * @param uuid User Unique Identifier
+ * @return Pointer to the cached record, or NULL if @p uuid is out of range or no
+ *         cache entry could be freed. The pointer is only valid until the next
+ *         call to this function.
+ */
+schedule_metadata_nvm_t * app_sch_cache_get(const uint16_t uuid);
+
+/**
+ * @brief Marks the whole cached record of a User as modified and schedules a
+ *        write back.
+ *
+ * @param uuid User Unique Identifier
+ */
+void app_sch_cache_mark_dirty(const uint16_t uuid);
+
+/**
+ * @brief Marks the scheduling state of a User as modified and schedules a write back.
+ *
+ * @param uuid User Unique Identifier
+ */
+void app_sch_cache_mark_state_dirty(const uint16_t uuid);
+
+/**
+ * @brief Marks schedule slots of a User as modified and schedules a write back.
+ *        Only the marked slots are written to NVM.
+ *
+ * @param uuid User Unique Identifier
+ * @param type Schedule type of the slot
+ * @param slot Schedule slot (1-indexed), or 0 to mark every slot of @p type
+ */
+void app_sch_cache_mark_slot_dirty(const uint16_t uuid,
+                                   const ascc_type_t type,
+                                   const uint16_t slot);
+
+/**
+ * @brief Writes every modified record back to NVM immediately.
+ *
+ * @return true if all modified records were written successfully.
+ */
+bool app_sch_cache_flush(void);
+
+/**
+ * @brief Drops every cached record without writing it back.
+ */
+void app_sch_cache_reset(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* _APP_SCHEDULES_CACHE_H_ */
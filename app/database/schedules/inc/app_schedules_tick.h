@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file app_schedules_tick.h
+ * @author bstewart-cae
+ * @brief This file contains the schedule tick service, which tracks whether each
+ *        User is inside its schedules and signals the Active Schedule CC when
+ *        that changes.
+ *
+ *        Instead of polling the wall clock, a single timer is armed for the next
+ *        moment at which any window opens or closes, so the lock can stay asleep
+ *        between real transitions.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _APP_SCHEDULES_TICK_H_
+#define _APP_SCHEDULES_TICK_H_
+
+/* CPP type safety */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/****************************************************************************/
+/*                      EXPORTED TYPES AND DEFINITIONS                      */
+/****************************************************************************/
+
+/**
+ * Longest time, in milliseconds, the service waits before evaluating the schedules
+ * again. This also keeps the wall clock reference from falling behind the OS tick
+ * counter when no window opens or closes for a long time.
+ */
+#if !defined(APP_SCHEDULE_TICK_MAX_INTERVAL_MS)
+#define APP_SCHEDULE_TICK_MAX_INTERVAL_MS  (24UL * 60 * 60 * 1000)
+#endif
+
+/****************************************************************************/
+/*                      EXPORTED FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+/**
+ * @brief Initializes the tick service. Must be called after the access windows
+ *        have been compiled.
+ */
+void app_sch_tick_init(void);
+
+/**
+ * @brief Requests that the schedules are evaluated again shortly, e.g. because a
+ *        schedule or the wall clock has changed.
+ *
+ * Several requests in a row result in a single evaluation.
+ */
+void app_sch_tick_reschedule(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* _APP_SCHEDULES_TICK_H_ */
@@ -26,6 +26,22 @@ extern "C" {
 /****************************************************************************/
 /*                      EXPORTED TYPES AND DEFINITIONS                      */
 /****************************************************************************/
+/*
+ * This is packed to fill the same format as the YD schedules.
+ * The schedules are defined as loose values still because there's
+ * no standard way to represent time or time stamps, and we don't want
+ * to add unnecessary steps to any other application
+ */
+#pragma pack(push, 1)
+typedef struct ascc_time_stamp_ {
+    uint16_t year;   ///< Gregorian Year
+    uint8_t  month;  ///< January - 1, Feb. - 2, etc. 0 is unused and considered erroneous
+    uint8_t  day;    ///< Calendar day, 1-31
+    uint8_t  hour;   ///< Hour in 24h time (0-23)
+    uint8_t  minute; ///< Minute (0-59)
+} ascc_time_stamp_t;
+#pragma pack(pop)
+
 /**
  * @brief Packs relevant Year Day schedule information into single struct
  */
@@ -43,9 +59,23 @@ typedef struct daily_repeating_nvm_ {
 } daily_repeating_nvm_t;
 
 /**
- * Schedule metadata object for storage in NVM.
+ * Schedule state object for storage in NVM, one per User.
+ *
+ * @note The members MUST match the leading members of schedule_metadata_nvm_t,
+ * as the state is read straight out of records stored in the old single-object
+ * layout when migrating them.
+ */
+typedef struct schedule_header_nvm_t_ {
+  uint16_t uuid;
+  bool scheduling_active;
+} schedule_header_nvm_t;
+
+/**
+ * Schedule metadata object.
  *
- * This contains all of the schedule information for a given User.
+ * This contains all of the schedule information for a given User. In NVM, the
+ * state (see schedule_header_nvm_t) and each occupied schedule slot are stored as
+ * separate objects, so that changing one slot only rewrites that slot.
  *
  * @note The schedules are stored in zero-indexed arrays - a schedule
  * 'slot' will correspond to its array index + 1 as slots are 1-indexed.
@@ -22,6 +22,9 @@ extern "C" {
 /****************************************************************************/
 // Module includes should always go first and be listed alphabetically
 #include "app_schedules.h"
+#include "app_schedules_access.h"
+#include "app_schedules_cache.h"
+#include "app_schedules_tick.h"
 #include "database_common.h"
 #include "cc_user_credential_nvm.h"
 #include "CC_ActiveSchedule.h"
@@ -31,10 +34,15 @@ extern "C" {
 #include "cc_user_credential_io.h"
 #include "events.h"
 // Stack/SDK includes should always go second to last and be listed alphabetically
+#include "AppTimer.h"
 #include <Assert.h>
 //define DEBUGPRINT
 #include "DebugPrint.h"
+#include <FreeRTOS.h>
+#include "SwTimer.h"
+#include <task.h>
 #include "zaf_event_distributor_soc.h"
+#include "ZW_typedefs.h"
 // Language includes should always go last and be listed alphabetically
 #include <string.h>
 
@@ -50,21 +58,32 @@ extern "C" {
 #define LEAP_YEAR_CADENCE  (4)    ///< Number of days in February during leap years
 #define MAX_WEEKDAY_MASK   (0x7F) ///< Maximum value for weekday mask
 #define LAST_OCCUPIED_SLOT (0xFF) ///< Signifier that no more occupied slots exist
-/*
- * This is packed to fill the same format as the YD schedules.
- * The schedules are defined as loose values still because there's
- * no standard way to represent time or time stamps, and we don't want
- * to add unnecessary steps to any other application
+
+#define ERASE_ALL_USERS_PER_STEP   (4)   ///< Users cleared per step of an erase all job
+#define ERASE_ALL_STEP_INTERVAL_MS (10)  ///< Pause between steps, leaving room for radio traffic
+#define ERASE_ALL_DEFAULT_COST_MS  (25)  ///< Estimated time to clear one user until it has been measured
+#define MAX_WORKING_TIME_S         (255) ///< Largest duration that can be reported to the controller
+
+/**
+ * @brief Erase all jobs that can run in the background.
+ */
+typedef enum erase_job_id_ {
+    ERASE_JOB_YEAR_DAY,        ///< Erase the Year Day schedules of every user
+    ERASE_JOB_DAILY_REPEATING, ///< Erase the Daily Repeating schedules of every user
+    ERASE_JOB_ALL,             ///< Erase all schedule information of every user
+    ERASE_JOB_COUNT
+} erase_job_id_t;
+
+/**
+ * @brief State of an erase all job, which clears a few users on every step so
+ *        that the application keeps processing frames while it runs.
  */
-#pragma pack(push, 1)
-typedef struct ascc_time_stamp_ {
-    uint16_t year;   ///< Gregorian Year
-    uint8_t  month;  ///< January - 1, Feb. - 2, etc. 0 is unused and considered erroneous
-    uint8_t  day;    ///< Calendar day, 1-31
-    uint8_t  hour;   ///< Hour in 24h time (0-23)
-    uint8_t  minute; ///< Minute (0-59)
-} ascc_time_stamp_t;
-#pragma pack(pop)
+typedef struct erase_job_ {
+    bool active;                     ///< Job is in progress
+    bool report;                     ///< Report to the requesting node when done
+    uint16_t last_uuid;              ///< Last user cleared, 0 before the first one
+    RECEIVE_OPTIONS_TYPE_EX rx_opts; ///< Options of the frame that requested the job
+} erase_job_t;
 
 /****************************************************************************/
 /*                              PRIVATE DATA                                */
@@ -89,7 +108,9 @@ static const uint8_t m_day_count[] = {
     31 ///< December
 };
 
-static RECEIVE_OPTIONS_TYPE_EX m_rx_opts = { 0 };
+static erase_job_t m_erase_jobs[ERASE_JOB_COUNT] = { 0 };
+static uint32_t m_erase_cost_ms = ERASE_ALL_DEFAULT_COST_MS; ///< Measured time to clear one user
+static SSwTimer m_erase_timer;                                ///< Schedules the next erase all step
 
 /****************************************************************************/
 /*                       PRIVATE FUNCTION DECLARATIONS                      */
@@ -131,6 +152,11 @@ static void user_changed(
   const uint16_t uuid,
   const u3c_operation_type_t operation
 );
+static void erase_job_start(const erase_job_id_t id);
+static uint16_t erase_job_next_user(const uint16_t uuid);
+static uint8_t erase_job_working_time(void);
+static void erase_job_send_report(const erase_job_id_t id);
+static void erase_timer_callback(SSwTimer * timer);
 
 /****************************************************************************/
 /*                       EXPORTED FUNCTION DEFINITIONS                      */
@@ -148,22 +174,115 @@ void app_sch_initialize_handlers(void)
         .validate_schedule_data = app_sch_validate_schedule_data,
         .validate_schedule_slot = app_sch_validate_schedule_slot,
         .validate_target = app_sch_validate_target,
+        .schedule_state_changed = app_sch_schedule_state_changed,
     };
     u3c_nvm_cbs_t callbacks = {
         .user_changed = user_changed
     };
     u3c_nvm_register_cbs(&callbacks);
     CC_ActiveSchedule_RegisterCallbacks(COMMAND_CLASS_USER_CREDENTIAL_V2, &stubs);
+
+    app_sch_cache_init();
+    AppTimerRegister(&m_erase_timer, false, erase_timer_callback);
+
+    // Build the access windows once so that validating a credential never touches NVM
+    app_sch_access_reset();
+    uint16_t max = u3c_nvm_get_max_users();
+    for (uint16_t uuid = 1; uuid <= max; uuid++) {
+        if (u3c_nvm_get_user_offset_from_id(uuid, NULL)) {
+            app_sch_access_compile(uuid, app_sch_cache_get(uuid));
+        }
+    }
+    app_sch_tick_init();
+    app_sch_time_sync();
 }
 
 /**
  * @brief Clear all stored schedule information
  */
 void app_sch_reset_schedules(void) {
-    schedule_metadata_nvm_t data = { 0 };
-    uint16_t max = u3c_nvm_get_max_users();
-    for(uint16_t i = 0; i < max; i++) {
-        app_nvm(U3C_WRITE, APP_NVM_AREA_SCHEDULE_DATA, i ,&data, sizeof(schedule_metadata_nvm_t));
+    erase_job_start(ERASE_JOB_ALL);
+    TimerStart(&m_erase_timer, ERASE_ALL_STEP_INTERVAL_MS);
+}
+
+void app_sch_set_time(const ascc_time_stamp_t * const now)
+{
+    app_sch_set_current_time(now);
+    // Every window boundary moves relative to the new time
+    app_sch_tick_reschedule();
+}
+
+ZW_WEAK bool app_sch_time_source_get(__attribute__((unused)) ascc_time_stamp_t * now)
+{
+    return false;
+}
+
+void app_sch_time_sync(void)
+{
+    ascc_time_stamp_t now;
+    if (app_sch_time_source_get(&now)) {
+        app_sch_set_time(&now);
+    } else {
+        DPRINTF("%s: No time source, Users with schedules are denied access\n", __func__);
+    }
+}
+
+void app_sch_erase_all_process(void)
+{
+    const TickType_t start = xTaskGetTickCount();
+    uint16_t cleared = 0;
+    bool finished[ERASE_JOB_COUNT] = { false };
+    bool pending = false;
+
+    for (uint8_t id = 0; id < ERASE_JOB_COUNT; id++) {
+        erase_job_t * job = &m_erase_jobs[id];
+        for (uint16_t n = 0; job->active && n < ERASE_ALL_USERS_PER_STEP; n++) {
+            const uint16_t uuid = erase_job_next_user(job->last_uuid);
+            if (uuid == 0) {
+                break;
+            }
+            job->last_uuid = uuid;
+            schedule_metadata_nvm_t * schedule_data = app_sch_cache_get(uuid);
+            if (!schedule_data) {
+                continue;
+            }
+            if (id == ERASE_JOB_ALL) {
+                memset(schedule_data, 0x00, sizeof(schedule_metadata_nvm_t));
+                app_sch_cache_mark_dirty(uuid);
+            } else {
+                const ascc_type_t type = id == ERASE_JOB_YEAR_DAY ? ASCC_TYPE_YEAR_DAY :
+                                                                   ASCC_TYPE_DAILY_REPEATING;
+                clear_all_schedules_for_user_by_type(schedule_data, type);
+                app_sch_cache_mark_slot_dirty(uuid, type, 0);
+            }
+            app_sch_access_compile(uuid, schedule_data);
+            cleared++;
+        }
+        if (job->active && erase_job_next_user(job->last_uuid) == 0) {
+            job->active = false;
+            finished[id] = true;
+        }
+        pending |= job->active;
+    }
+
+    // Write the step out now instead of leaving the whole database to a single flush
+    app_sch_cache_flush();
+
+    if (cleared > 0) {
+        // The cleared Users may have entered or left their schedules
+        app_sch_tick_reschedule();
+
+        // Smooth the measured cost so a single slow step does not skew the estimate
+        const uint32_t cost_ms = ((xTaskGetTickCount() - start) * portTICK_PERIOD_MS) / cleared;
+        m_erase_cost_ms = (m_erase_cost_ms + cost_ms + 1) / 2;
+    }
+    for (uint8_t id = 0; id < ERASE_JOB_COUNT; id++) {
+        if (finished[id] && m_erase_jobs[id].report) {
+            erase_job_send_report((erase_job_id_t)id);
+        }
+    }
+    if (pending) {
+        TimerStart(&m_erase_timer, ERASE_ALL_STEP_INTERVAL_MS);
     }
 }
 
@@ -316,9 +435,9 @@ ascc_op_result_t app_sch_get_schedule_state(const ascc_target_t * const target,
     if (state &&
         target &&
         u3c_nvm_get_user_offset_from_id(target->target_id, NULL)) {
-        schedule_metadata_nvm_t schedule_data = { 0 };
-        if (app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_DATA, target->target_id-1, (void*)&schedule_data, sizeof(schedule_metadata_nvm_t))) {
-            *state = schedule_data.scheduling_active;
+        const schedule_metadata_nvm_t * schedule_data = app_sch_cache_get(target->target_id);
+        if (schedule_data) {
+            *state = schedule_data->scheduling_active;
             result.result = ASCC_OPERATION_SUCCESS;
         }
     }
@@ -348,14 +467,14 @@ ascc_op_result_t app_sch_set_schedule_state(const ascc_target_t * const target,
         .result = ASCC_OPERATION_FAIL
     };
     if (target && u3c_nvm_get_user_offset_from_id(target->target_id, NULL)) {
-        schedule_metadata_nvm_t schedule_data = { 0 };
-        if (app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_DATA, target->target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
+        schedule_metadata_nvm_t * schedule_data = app_sch_cache_get(target->target_id);
+        if (schedule_data) {
             // If 'enabled' value is not equal, then update and back up
-            if (schedule_data.scheduling_active != state) {
-                schedule_data.scheduling_active = state;
-                if(!app_nvm(U3C_WRITE, APP_NVM_AREA_SCHEDULE_DATA, target->target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
-                    return result;
-                }
+            if (schedule_data->scheduling_active != state) {
+                schedule_data->scheduling_active = state;
+                app_sch_cache_mark_state_dirty(target->target_id);
+                app_sch_access_compile(target->target_id, schedule_data);
+                app_sch_tick_reschedule();
             }
             result.result = ASCC_OPERATION_SUCCESS;
         }
@@ -398,21 +517,30 @@ ascc_op_result_t app_sch_get_schedule_data(const ascc_type_t schedule_type,
         && slot <= app_sch_get_schedule_count(schedule_type)
         && schedule
         && u3c_nvm_get_user_offset_from_id(target->target_id, NULL)) {
-        schedule_metadata_nvm_t schedule_data = { 0 };
-        if (app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_DATA, target->target_id-1, (void*)&schedule_data, sizeof(schedule_metadata_nvm_t))) {
-            uint16_t slot_tmp = slot == 0 ? get_first_schedule_slot(&schedule_data, schedule_type) :
+        const schedule_metadata_nvm_t * schedule_data = app_sch_cache_get(target->target_id);
+        if (schedule_data) {
+            uint16_t slot_tmp = slot == 0 ? get_first_schedule_slot(schedule_data, schedule_type) :
                                            slot;
+            if (slot_tmp == 0) {
+                // Asked for the first slot, but none are occupied
+                memset(&schedule->schedule, 0x00, sizeof(schedule->schedule));
+                if (next_slot) {
+                    *next_slot = 0;
+                }
+                result.result = ASCC_OPERATION_SUCCESS;
+                return result;
+            }
             if (schedule_type == ASCC_TYPE_DAILY_REPEATING) {
-                memcpy(&schedule->schedule.daily_repeating, (void*)&schedule_data.daily_repeating_schedules[slot_tmp-1].schedule, sizeof(ascc_daily_repeating_schedule_t));
+                memcpy(&schedule->schedule.daily_repeating, (void*)&schedule_data->daily_repeating_schedules[slot_tmp-1].schedule, sizeof(ascc_daily_repeating_schedule_t));
             } else if (schedule_type == ASCC_TYPE_YEAR_DAY) {
-                memcpy(&schedule->schedule.year_day, (void*)&schedule_data.year_day_schedules[slot_tmp-1].schedule, sizeof(ascc_year_day_schedule_t));
+                memcpy(&schedule->schedule.year_day, (void*)&schedule_data->year_day_schedules[slot_tmp-1].schedule, sizeof(ascc_year_day_schedule_t));
             } else {
                 result.result = ASCC_OPERATION_INVALID_GET;
                 return result;
             }
             // Populate next slot, if provided.
             if (next_slot) {
-                *next_slot = get_next_schedule_slot(&schedule_data, schedule_type, slot_tmp);
+                *next_slot = get_next_schedule_slot(schedule_data, schedule_type, slot_tmp);
             }
             result.result = ASCC_OPERATION_SUCCESS;
         }
@@ -456,75 +584,91 @@ ascc_op_result_t app_sch_set_schedule_data(const ascc_op_type_t operation,
         // Erase all schedules
         if (schedule->slot_id == 0) {
             if (schedule->target.target_id == 0) { // Erase all schedules for all targets
-                if (CC_ActiveSchedule_Get_Current_Frame_Options(&m_rx_opts)) {
+                const erase_job_id_t id = schedule->type == ASCC_TYPE_YEAR_DAY ? ERASE_JOB_YEAR_DAY :
+                                                                                 ERASE_JOB_DAILY_REPEATING;
+                // The job runs in the background and reports to the requesting node when done
+                if (CC_ActiveSchedule_Get_Current_Frame_Options(&m_erase_jobs[id].rx_opts)) {
+                    erase_job_start(id);
+                    m_erase_jobs[id].report = true;
                     result.result = ASCC_OPERATION_WORKING;
-                    result.working_time = 10; // 10 seconds as an example
+                    result.working_time = erase_job_working_time();
+                    zaf_event_distributor_enqueue_app_event(schedule->type == ASCC_TYPE_YEAR_DAY ? EVENT_APP_DELETE_ALL_YD_SCHEDULES_START :
+                                                                                                   EVENT_APP_DELETE_ALL_DR_SCHEDULES_START);
                 }
-                zaf_event_distributor_enqueue_app_event_from_isr(schedule->type == ASCC_TYPE_YEAR_DAY ? EVENT_APP_DELETE_ALL_YD_SCHEDULES_START :
-                                                                                                EVENT_APP_DELETE_ALL_DR_SCHEDULES_START);
             } else { // Erase all schedules for this target specifically
-                schedule_metadata_nvm_t schedule_data = { 0 };
-                if (u3c_nvm_get_user_offset_from_id(schedule->target.target_id, NULL) &&
-                      app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_DATA, schedule->target.target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
-                    clear_all_schedules_for_user_by_type(&schedule_data, schedule->type);
-                }
-                // Back up updated mirror to NVM
-                if (app_nvm(U3C_WRITE, APP_NVM_AREA_SCHEDULE_DATA, schedule->target.target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
+                schedule_metadata_nvm_t * schedule_data = app_sch_cache_get(schedule->target.target_id);
+                if (schedule_data) {
+                    // Back up updated mirror to NVM
+                    if (u3c_nvm_get_user_offset_from_id(schedule->target.target_id, NULL)) {
+                        clear_all_schedules_for_user_by_type(schedule_data, schedule->type);
+                        app_sch_cache_mark_slot_dirty(schedule->target.target_id, schedule->type, 0);
+                    } else {
+                        memset(schedule_data, 0x00, sizeof(schedule_metadata_nvm_t));
+                        app_sch_cache_mark_dirty(schedule->target.target_id);
+                    }
+                    app_sch_access_compile(schedule->target.target_id, schedule_data);
+                    app_sch_tick_reschedule();
                     result.result = ASCC_OPERATION_SUCCESS;
                     *next_slot = 0;
                 }
             }
         // Erase a specific schedule, 0 isn't allowed as a user
         } else if (schedule->slot_id != 0 && schedule->target.target_id != 0){
-            schedule_metadata_nvm_t schedule_data = { 0 };
-            if (u3c_nvm_get_user_offset_from_id(schedule->target.target_id, NULL) &&
-                  app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_DATA, schedule->target.target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
+            schedule_metadata_nvm_t * schedule_data = NULL;
+            if (u3c_nvm_get_user_offset_from_id(schedule->target.target_id, NULL)) {
+                schedule_data = app_sch_cache_get(schedule->target.target_id);
+            }
+            if (schedule_data) {
                 // Update information in local flash mirror
                 // By clearing out the entire struct, we also clear the available bit
                 void * ptr = NULL;
                 size_t len = 0;
                 if (schedule->type == ASCC_TYPE_DAILY_REPEATING) {
-                    ptr = (void*)&schedule_data.daily_repeating_schedules[schedule->slot_id-1];
+                    ptr = (void*)&schedule_data->daily_repeating_schedules[schedule->slot_id-1];
                     len = sizeof(daily_repeating_nvm_t);
                 } else if (schedule->type == ASCC_TYPE_YEAR_DAY) {
-                    ptr = (void*)&schedule_data.year_day_schedules[schedule->slot_id-1];
+                    ptr = (void*)&schedule_data->year_day_schedules[schedule->slot_id-1];
                     len = sizeof(year_day_nvm_t);
                 }
                 if (ptr) {
                     memset(ptr, 0x00, len);
                     // Back up updated mirror to NVM
-                    if (app_nvm(U3C_WRITE, APP_NVM_AREA_SCHEDULE_DATA, schedule->target.target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
-                        result.result = ASCC_OPERATION_SUCCESS;
-                        *next_slot = get_next_schedule_slot(&schedule_data, schedule->type, schedule->slot_id);
-                    }
+                    app_sch_cache_mark_slot_dirty(schedule->target.target_id, schedule->type, schedule->slot_id);
+                    app_sch_access_compile(schedule->target.target_id, schedule_data);
+                    app_sch_tick_reschedule();
+                    result.result = ASCC_OPERATION_SUCCESS;
+                    *next_slot = get_next_schedule_slot(schedule_data, schedule->type, schedule->slot_id);
                 }
             }
         }
     } else if (operation == ASCC_OP_TYPE_MODIFY &&
                schedule->slot_id != 0 && schedule->target.target_id != 0) {
-        schedule_metadata_nvm_t schedule_data = { 0 };
-        if (app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_DATA, schedule->target.target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
+        schedule_metadata_nvm_t * schedule_data = app_sch_cache_get(schedule->target.target_id);
+        if (schedule_data) {
             // Update information in local flash mirror
             if (schedule->type == ASCC_TYPE_DAILY_REPEATING) {
-                daily_repeating_nvm_t * tmp = &schedule_data.daily_repeating_schedules[schedule->slot_id-1];
+                daily_repeating_nvm_t * tmp = &schedule_data->daily_repeating_schedules[schedule->slot_id-1];
                 memcpy(&tmp->schedule,
                         &schedule->data.schedule.daily_repeating,
                         sizeof(ascc_daily_repeating_schedule_t));
                 tmp->occupied = true;
             } else if (schedule->type == ASCC_TYPE_YEAR_DAY) {
-                year_day_nvm_t * tmp = &schedule_data.year_day_schedules[schedule->slot_id-1];
+                year_day_nvm_t * tmp = &schedule_data->year_day_schedules[schedule->slot_id-1];
                 memcpy(&tmp->schedule,
                         &schedule->data.schedule.year_day,
                         sizeof(ascc_year_day_schedule_t));
                 tmp->occupied = true;
             }
+            schedule_data->uuid = schedule->target.target_id;
             // Enable scheduling for the target by default
-            schedule_data.scheduling_active = true;
+            schedule_data->scheduling_active = true;
             // Back up updated mirror to NVM
-            if (app_nvm(U3C_WRITE, APP_NVM_AREA_SCHEDULE_DATA, schedule->target.target_id-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
-                result.result = ASCC_OPERATION_SUCCESS;
-                *next_slot = get_next_schedule_slot(&schedule_data, schedule->type, schedule->slot_id);
-            }
+            app_sch_cache_mark_state_dirty(schedule->target.target_id);
+            app_sch_cache_mark_slot_dirty(schedule->target.target_id, schedule->type, schedule->slot_id);
+            app_sch_access_compile(schedule->target.target_id, schedule_data);
+            app_sch_tick_reschedule();
+            result.result = ASCC_OPERATION_SUCCESS;
+            *next_slot = get_next_schedule_slot(schedule_data, schedule->type, schedule->slot_id);
         }
     }
     return result;
@@ -682,16 +826,102 @@ static void user_changed(
 )
 {
     if (operation == U3C_OPERATION_TYPE_DELETE) {
-        schedule_metadata_nvm_t schedule_data = { 0 };
-        if(app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_DATA, uuid-1, &schedule_data, sizeof(schedule_metadata_nvm_t))) {
-            schedule_data.scheduling_active = false;
-            schedule_data.uuid = 0;
-            clear_all_schedules_for_user_by_type(&schedule_data, ASCC_TYPE_YEAR_DAY);
-            clear_all_schedules_for_user_by_type(&schedule_data, ASCC_TYPE_DAILY_REPEATING);
+        schedule_metadata_nvm_t * schedule_data = app_sch_cache_get(uuid);
+        if (schedule_data) {
+            schedule_data->scheduling_active = false;
+            schedule_data->uuid = 0;
+            clear_all_schedules_for_user_by_type(schedule_data, ASCC_TYPE_YEAR_DAY);
+            clear_all_schedules_for_user_by_type(schedule_data, ASCC_TYPE_DAILY_REPEATING);
             // Back up updated mirror to NVM
-            app_nvm(U3C_WRITE, APP_NVM_AREA_SCHEDULE_DATA, uuid-1, &schedule_data, sizeof(schedule_metadata_nvm_t));
+            app_sch_cache_mark_dirty(uuid);
         }
+        app_sch_access_compile(uuid, NULL);
+        app_sch_tick_reschedule();
+    }
+}
+
+/**
+ * @brief Starts, or restarts from the first user, an erase all job.
+ *
+ * @param id Job to start
+ */
+static void erase_job_start(const erase_job_id_t id)
+{
+    m_erase_jobs[id].active = true;
+    m_erase_jobs[id].report = false;
+    m_erase_jobs[id].last_uuid = 0;
+}
+
+/**
+ * @brief Finds the user that an erase all job clears after the given one.
+ *
+ * Only existing users are visited, as the schedules of a user are cleared when
+ * it is deleted.
+ *
+ * @param uuid Last user cleared, 0 for the first user
+ * @return Next user, or 0 if there is none
+ */
+static uint16_t erase_job_next_user(const uint16_t uuid)
+{
+    if (uuid == 0 || u3c_nvm_get_user_offset_from_id(uuid, NULL)) {
+        return CC_UserCredential_get_next_user(uuid);
+    }
+    // The last user cleared has been deleted since, so look up the first one after it
+    uint16_t next = CC_UserCredential_get_next_user(0);
+    while (next != 0 && next < uuid) {
+        next = CC_UserCredential_get_next_user(next);
+    }
+    return next;
+}
+
+/**
+ * @brief Estimates how long an erase all job will take, based on the measured
+ *        time needed to clear a single user.
+ *
+ * @return Estimated duration in seconds, rounded up.
+ */
+static uint8_t erase_job_working_time(void)
+{
+    const uint32_t users = u3c_nvm_get_num_users();
+    const uint32_t steps = (users + ERASE_ALL_USERS_PER_STEP - 1) / ERASE_ALL_USERS_PER_STEP;
+    const uint32_t duration_ms = users * m_erase_cost_ms + steps * ERASE_ALL_STEP_INTERVAL_MS;
+    const uint32_t duration_s = (duration_ms + 999) / 1000;
+    if (duration_s == 0) {
+        return 1;
     }
+    return duration_s > MAX_WORKING_TIME_S ? MAX_WORKING_TIME_S : (uint8_t)duration_s;
+}
+
+/**
+ * @brief Reports the completion of an erase all job to the node that requested it.
+ *
+ * @param id Job that completed
+ */
+static void erase_job_send_report(const erase_job_id_t id)
+{
+    const ascc_schedule_t schedule = {
+        .target = {
+            .target_cc = COMMAND_CLASS_USER_CREDENTIAL,
+            .target_id = 0,
+        },
+        .slot_id = 0,
+        .type = id == ERASE_JOB_YEAR_DAY ? ASCC_TYPE_YEAR_DAY : ASCC_TYPE_DAILY_REPEATING,
+    };
+    if (id == ERASE_JOB_YEAR_DAY) {
+        CC_ActiveSchedule_YearDay_Schedule_Report_tx(ASCC_REP_TYPE_MODIFY_ZWAVE,
+                                                     &schedule, 0, &m_erase_jobs[id].rx_opts);
+    } else if (id == ERASE_JOB_DAILY_REPEATING) {
+        CC_ActiveSchedule_DailyRepeating_Schedule_Report_tx(ASCC_REP_TYPE_MODIFY_ZWAVE,
+                                                            &schedule, 0, &m_erase_jobs[id].rx_opts);
+    }
+}
+
+/**
+ * @brief Runs the next step of the active erase all jobs.
+ */
+static void erase_timer_callback(__attribute__((unused)) SSwTimer * timer)
+{
+    app_sch_erase_all_process();
 }
 
 #ifdef __cplusplus
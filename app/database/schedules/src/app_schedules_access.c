@@ -0,0 +1,505 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file app_schedules_access.c
+ * @author bstewart-cae
+ * @brief This module compiles the Year Day and Daily Repeating schedules of each
+ *        User into sorted, merged time windows held in RAM and answers whether a
+ *        User may be granted access at a given moment.
+ *
+ *        Year Day windows are stored as absolute minutes since 2000-01-01 00:00.
+ *        Daily Repeating windows are stored as minutes since Sunday 00:00, so that
+ *        any moment can be checked against them regardless of the date.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+// Module includes should always go first and be listed alphabetically
+#include "app_schedules_access.h"
+// Stack/SDK includes should always go second to last and be listed alphabetically
+#include <FreeRTOS.h>
+//define DEBUGPRINT
+#include "DebugPrint.h"
+#include <task.h>
+// Language includes should always go last and be listed alphabetically
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define MINUTES_PER_HOUR   (60)                                ///< Minutes in an hour
+#define MINUTES_PER_DAY    (24 * MINUTES_PER_HOUR)             ///< Minutes in a day
+#define DAYS_PER_WEEK      (7)                                 ///< Days in a week
+#define MINUTES_PER_WEEK   ((uint32_t)DAYS_PER_WEEK * MINUTES_PER_DAY) ///< Minutes in a week
+#define EPOCH_YEAR         (2000)  ///< First year that can be represented, earlier years are clamped
+#define LAST_YEAR          (9999)  ///< Last year that can be represented, later years are clamped
+#define EPOCH_WEEKDAY      (6)     ///< 2000-01-01 was a Saturday (Sunday = 0)
+#define DAYS_PER_ERA       (146097) ///< Days in a 400 year Gregorian cycle
+#define DAYS_TO_EPOCH      (730425) ///< Days from 0000-03-01 to 2000-01-01
+#define MS_PER_MINUTE      (60 * 1000)                 ///< Milliseconds in a minute
+#define TICKS_PER_MINUTE   (pdMS_TO_TICKS(MS_PER_MINUTE)) ///< OS ticks in a minute
+#define NO_EDGE            (UINT32_MAX)                ///< No window opens or closes in the future
+
+#if (CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER > 0)
+#define YEAR_DAY_WINDOWS_MAX (CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER)
+#else
+#define YEAR_DAY_WINDOWS_MAX (1) ///< Keeps the array valid when Year Day schedules are unsupported
+#endif
+
+/*
+ * Every Daily Repeating schedule opens one window per selected weekday. A window that
+ * runs past Saturday midnight is split in two, so each schedule needs one extra entry.
+ */
+#if (CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER > 0)
+#define WEEK_WINDOWS_MAX (CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER * (DAYS_PER_WEEK + 1))
+#else
+#define WEEK_WINDOWS_MAX (1) ///< Keeps the array valid when Daily Repeating schedules are unsupported
+#endif
+
+/**
+ * @brief Half-open time window [start, stop), in minutes.
+ */
+typedef struct access_window_ {
+    uint32_t start; ///< First minute inside the window
+    uint32_t stop;  ///< First minute after the window
+} access_window_t;
+
+/**
+ * @brief Compiled access windows for a single User.
+ *
+ * Both window lists are kept sorted by start time and never overlap, so a lookup
+ * is a single binary search.
+ */
+typedef struct user_access_ {
+    bool scheduling_active;                            ///< Mirror of the NVM scheduling state
+    bool in_schedule;                                  ///< Access state, follows the window boundaries
+    uint8_t year_day_count;                            ///< Number of entries used in year_day
+    uint8_t week_count;                                ///< Number of entries used in week
+    access_window_t year_day[YEAR_DAY_WINDOWS_MAX];    ///< Minutes since 2000-01-01 00:00
+    access_window_t week[WEEK_WINDOWS_MAX];            ///< Minutes since Sunday 00:00
+} user_access_t;
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+/// Compiled windows, indexed by UUID - 1 as the schedule records are in NVM
+static user_access_t m_access[CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS];
+
+static bool m_clock_set = false;   ///< Whether the wall clock has been set
+static uint32_t m_clock_minutes;   ///< Minutes since 2000-01-01 00:00 at m_clock_ticks
+static TickType_t m_clock_ticks;   ///< OS tick count at which m_clock_minutes was valid
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+static void update_state(const uint16_t uuid);
+static uint32_t days_since_epoch(const ascc_time_stamp_t * const time);
+static uint32_t minutes_since_epoch(const ascc_time_stamp_t * const time);
+static uint32_t minutes_since_sunday(const ascc_time_stamp_t * const time);
+static uint8_t insert_window(access_window_t * windows,
+                             const uint8_t count,
+                             uint32_t start,
+                             uint32_t stop);
+static uint8_t find_first_window_after(const access_window_t * const windows,
+                                       const uint8_t count,
+                                       const uint32_t minute);
+static bool is_in_windows(const access_window_t * const windows,
+                          const uint8_t count,
+                          const uint32_t minute);
+static uint32_t minutes_to_next_edge(const access_window_t * const windows,
+                                     const uint8_t count,
+                                     const uint32_t minute,
+                                     const uint32_t period);
+
+/****************************************************************************/
+/*                       EXPORTED FUNCTION DEFINITIONS                      */
+/****************************************************************************/
+
+void app_sch_access_reset(void)
+{
+    memset(m_access, 0x00, sizeof(m_access));
+    for (uint16_t i = 0; i < CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS; i++) {
+        m_access[i].in_schedule = true;
+    }
+}
+
+void app_sch_access_compile(const uint16_t uuid,
+                            const schedule_metadata_nvm_t * const schedule_data)
+{
+    if (uuid == 0 || uuid > CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS) {
+        return;
+    }
+    user_access_t * access = &m_access[uuid - 1];
+    memset(access, 0x00, sizeof(user_access_t));
+    if (!schedule_data) {
+        access->in_schedule = true;
+        return;
+    }
+    access->scheduling_active = schedule_data->scheduling_active;
+
+#if (CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER > 0)
+    for (uint8_t i = 0; i < CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER; i++) {
+        const year_day_nvm_t * yd = &schedule_data->year_day_schedules[i];
+        if (!yd->occupied) {
+            continue;
+        }
+        const uint32_t start = minutes_since_epoch((const ascc_time_stamp_t *)&yd->schedule.start_year);
+        const uint32_t stop = minutes_since_epoch((const ascc_time_stamp_t *)&yd->schedule.stop_year);
+        if (start < stop) {
+            access->year_day_count = insert_window(access->year_day, access->year_day_count, start, stop);
+        }
+    }
+#endif
+
+#if (CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER > 0)
+    for (uint8_t i = 0; i < CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER; i++) {
+        const daily_repeating_nvm_t * dr = &schedule_data->daily_repeating_schedules[i];
+        const uint32_t duration = (uint32_t)dr->schedule.duration_hour * MINUTES_PER_HOUR
+                                  + dr->schedule.duration_minute;
+        if (!dr->occupied || duration == 0) {
+            continue;
+        }
+        const uint32_t time_of_day = (uint32_t)dr->schedule.start_hour * MINUTES_PER_HOUR
+                                     + dr->schedule.start_minute;
+        // Bit 0 of the weekday mask is Sunday
+        for (uint8_t day = 0; day < DAYS_PER_WEEK; day++) {
+            if (!(dr->schedule.weekday_mask & (1 << day))) {
+                continue;
+            }
+            const uint32_t start = (uint32_t)day * MINUTES_PER_DAY + time_of_day;
+            const uint32_t stop = start + duration;
+            if (stop > MINUTES_PER_WEEK) {
+                // Window runs past Saturday midnight, wrap the remainder to Sunday
+                access->week_count = insert_window(access->week, access->week_count, start, MINUTES_PER_WEEK);
+                access->week_count = insert_window(access->week, access->week_count, 0, stop - MINUTES_PER_WEEK);
+            } else {
+                access->week_count = insert_window(access->week, access->week_count, start, stop);
+            }
+        }
+    }
+#endif
+
+    // A change of the schedules takes effect at once, not at the next window boundary
+    update_state(uuid);
+
+    DPRINTF("%s: UUID %d compiled to %d Year Day and %d weekly windows\n",
+            __func__, uuid, access->year_day_count, access->week_count);
+}
+
+bool app_sch_is_access_allowed(const uint16_t uuid, const ascc_time_stamp_t * const now)
+{
+    if (!now || uuid == 0 || uuid > CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS) {
+        return false;
+    }
+    const user_access_t * access = &m_access[uuid - 1];
+    if (!access->scheduling_active) {
+        return true;
+    }
+    // With scheduling active, access is only granted within one of the windows
+    return is_in_windows(access->year_day, access->year_day_count, minutes_since_epoch(now))
+           || is_in_windows(access->week, access->week_count, minutes_since_sunday(now));
+}
+
+void app_sch_schedule_state_changed(const ascc_target_t * const target, const bool in_schedule)
+{
+    if (!target || target->target_cc != COMMAND_CLASS_USER_CREDENTIAL
+        || target->target_id == 0 || target->target_id > CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS) {
+        return;
+    }
+    m_access[target->target_id - 1].in_schedule = in_schedule;
+    DPRINTF("%s: UUID %d is %s its schedules\n",
+            __func__, target->target_id, in_schedule ? "within" : "outside");
+}
+
+bool app_sch_is_user_in_schedule(const uint16_t uuid)
+{
+    if (uuid == 0 || uuid > CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS) {
+        return false;
+    }
+    return m_access[uuid - 1].in_schedule;
+}
+
+void app_sch_set_current_time(const ascc_time_stamp_t * const now)
+{
+    if (!now || now->month == 0 || now->month > 12 || now->day == 0 || now->day > 31
+        || now->hour >= 24 || now->minute >= MINUTES_PER_HOUR) {
+        return;
+    }
+    m_clock_minutes = minutes_since_epoch(now);
+    m_clock_ticks = xTaskGetTickCount();
+    m_clock_set = true;
+    for (uint16_t uuid = 1; uuid <= CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS; uuid++) {
+        update_state(uuid);
+    }
+}
+
+bool app_sch_get_current_time(ascc_time_stamp_t * now)
+{
+    if (!m_clock_set || !now) {
+        return false;
+    }
+    /*
+     * Move the reference point forward by whole minutes only, so the remainder is
+     * carried over and the clock survives tick counter wrap-around as long as this
+     * is called at least once per wrap period.
+     */
+    const TickType_t elapsed = xTaskGetTickCount() - m_clock_ticks;
+    const uint32_t minutes = elapsed / TICKS_PER_MINUTE;
+    m_clock_minutes += minutes;
+    m_clock_ticks += (TickType_t)(minutes * TICKS_PER_MINUTE);
+
+    // Convert days back to a civil date, counting years from March
+    const uint32_t days = m_clock_minutes / MINUTES_PER_DAY + DAYS_TO_EPOCH;
+    const uint32_t era = days / DAYS_PER_ERA;
+    const uint32_t day_of_era = days - era * DAYS_PER_ERA;
+    const uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524
+                                  - day_of_era / (DAYS_PER_ERA - 1)) / 365;
+    const uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const uint32_t month_index = (5 * day_of_year + 2) / 153; // March = 0
+    const uint32_t minute_of_day = m_clock_minutes % MINUTES_PER_DAY;
+
+    now->day = (uint8_t)(day_of_year - (153 * month_index + 2) / 5 + 1);
+    now->month = (uint8_t)(month_index < 10 ? month_index + 3 : month_index - 9);
+    now->year = (uint16_t)(year_of_era + era * 400 + (now->month <= 2 ? 1 : 0));
+    now->hour = (uint8_t)(minute_of_day / MINUTES_PER_HOUR);
+    now->minute = (uint8_t)(minute_of_day % MINUTES_PER_HOUR);
+    return true;
+}
+
+bool app_sch_access_get_next_change(const uint32_t max_delay_ms, uint32_t * delay_ms)
+{
+    ascc_time_stamp_t now;
+    if (!delay_ms || !app_sch_get_current_time(&now)) {
+        return false;
+    }
+    // Getting the time moved the clock reference to the start of the current minute
+    const uint32_t epoch_minute = m_clock_minutes;
+    const uint32_t week_minute = minutes_since_sunday(&now);
+    uint32_t minutes = NO_EDGE;
+    for (uint16_t i = 0; i < CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS; i++) {
+        const user_access_t * access = &m_access[i];
+        if (!access->scheduling_active) {
+            continue;
+        }
+        uint32_t edge = minutes_to_next_edge(access->year_day, access->year_day_count, epoch_minute, 0);
+        if (edge < minutes) {
+            minutes = edge;
+        }
+        edge = minutes_to_next_edge(access->week, access->week_count, week_minute, MINUTES_PER_WEEK);
+        if (edge < minutes) {
+            minutes = edge;
+        }
+    }
+
+    *delay_ms = max_delay_ms;
+    if (minutes <= max_delay_ms / MS_PER_MINUTE) {
+        // Windows open and close on whole minutes, so subtract the part of this one that has passed
+        const uint32_t elapsed_ms = (xTaskGetTickCount() - m_clock_ticks) * portTICK_PERIOD_MS;
+        const uint32_t remaining_ms = minutes * MS_PER_MINUTE;
+        *delay_ms = remaining_ms > elapsed_ms ? remaining_ms - elapsed_ms : 0;
+    }
+    return true;
+}
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+/**
+ * @brief Sets the access state of a User from its windows at the current time.
+ *
+ * Until the wall clock has been set, the windows cannot be evaluated, so Users with
+ * active scheduling are kept out and the other Users are allowed in.
+ *
+ * @param uuid User Unique Identifier
+ */
+static void update_state(const uint16_t uuid)
+{
+    ascc_time_stamp_t now;
+    user_access_t * access = &m_access[uuid - 1];
+    if (app_sch_get_current_time(&now)) {
+        access->in_schedule = app_sch_is_access_allowed(uuid, &now);
+    } else {
+        access->in_schedule = !access->scheduling_active;
+    }
+}
+
+/**
+ * @brief Computes the number of days between 2000-01-01 and a given date.
+ *
+ * Years are counted from March so that the leap day falls at the end of the year.
+ * Years outside of 2000-9999 are clamped to that range.
+ *
+ * @param time Time stamp to convert
+ * @return Number of whole days since 2000-01-01.
+ */
+static uint32_t days_since_epoch(const ascc_time_stamp_t * const time)
+{
+    if (time->year < EPOCH_YEAR) {
+        return 0;
+    }
+    const uint32_t year = (time->year > LAST_YEAR ? LAST_YEAR : time->year)
+                          - (time->month <= 2 ? 1 : 0);
+    const uint32_t era = year / 400;
+    const uint32_t year_of_era = year - era * 400;
+    const uint32_t month_index = (time->month + 9) % 12; // March = 0
+    const uint32_t day_of_year = (153 * month_index + 2) / 5 + time->day - 1;
+    const uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * DAYS_PER_ERA + day_of_era - DAYS_TO_EPOCH;
+}
+
+/**
+ * @brief Converts a time stamp to minutes since 2000-01-01 00:00.
+ */
+static uint32_t minutes_since_epoch(const ascc_time_stamp_t * const time)
+{
+    return days_since_epoch(time) * MINUTES_PER_DAY
+           + (uint32_t)time->hour * MINUTES_PER_HOUR
+           + time->minute;
+}
+
+/**
+ * @brief Converts a time stamp to minutes since the preceding Sunday 00:00.
+ */
+static uint32_t minutes_since_sunday(const ascc_time_stamp_t * const time)
+{
+    const uint32_t weekday = (days_since_epoch(time) + EPOCH_WEEKDAY) % DAYS_PER_WEEK;
+    return weekday * MINUTES_PER_DAY
+           + (uint32_t)time->hour * MINUTES_PER_HOUR
+           + time->minute;
+}
+
+/**
+ * @brief Inserts a window into a sorted window list, merging it with any windows
+ *        it overlaps or touches.
+ *
+ * @note The caller must guarantee room for one more entry.
+ *
+ * @param windows Sorted, non-overlapping window list
+ * @param count   Number of windows currently in the list
+ * @param start   Start of the new window
+ * @param stop    Stop of the new window
+ * @return New number of windows in the list.
+ */
+static uint8_t insert_window(access_window_t * windows,
+                             const uint8_t count,
+                             uint32_t start,
+                             uint32_t stop)
+{
+    // Skip past every window that ends before the new one begins
+    uint8_t first = 0;
+    while (first < count && windows[first].stop < start) {
+        first++;
+    }
+    // Absorb every window that begins before the new one ends
+    uint8_t last = first;
+    while (last < count && windows[last].start <= stop) {
+        if (windows[last].start < start) {
+            start = windows[last].start;
+        }
+        if (windows[last].stop > stop) {
+            stop = windows[last].stop;
+        }
+        last++;
+    }
+    // Windows [first, last) are replaced with the merged window
+    memmove(&windows[first + 1], &windows[last], (count - last) * sizeof(access_window_t));
+    windows[first].start = start;
+    windows[first].stop = stop;
+    return (uint8_t)(count - (last - first) + 1);
+}
+
+/**
+ * @brief Finds the first window of a sorted window list that starts after a minute.
+ *
+ * @param windows Sorted, non-overlapping window list
+ * @param count   Number of windows in the list
+ * @param minute  Minute to look up
+ * @return Index of the first window starting after @p minute, or @p count if none does.
+ */
+static uint8_t find_first_window_after(const access_window_t * const windows,
+                                       const uint8_t count,
+                                       const uint32_t minute)
+{
+    uint8_t low = 0;
+    uint8_t high = count;
+    while (low < high) {
+        const uint8_t mid = (uint8_t)((low + high) / 2);
+        if (windows[mid].start <= minute) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Checks whether a minute falls within any window of a sorted window list.
+ *
+ * @param windows Sorted, non-overlapping window list
+ * @param count   Number of windows in the list
+ * @param minute  Minute to look up
+ * @return true if a window contains @p minute.
+ */
+static bool is_in_windows(const access_window_t * const windows,
+                          const uint8_t count,
+                          const uint32_t minute)
+{
+    const uint8_t next = find_first_window_after(windows, count, minute);
+    // The window before it is the only one that can contain the minute
+    return next > 0 && minute < windows[next - 1].stop;
+}
+
+/**
+ * @brief Computes how long it is until a sorted window list next opens or closes.
+ *
+ * @param windows Sorted, non-overlapping window list
+ * @param count   Number of windows in the list
+ * @param minute  Current minute
+ * @param period  Length of the cycle the windows repeat over, or 0 if they do not repeat
+ * @return Minutes until the next window boundary, or NO_EDGE if there is none.
+ */
+static uint32_t minutes_to_next_edge(const access_window_t * const windows,
+                                     const uint8_t count,
+                                     const uint32_t minute,
+                                     const uint32_t period)
+{
+    if (count == 0) {
+        return NO_EDGE;
+    }
+    const uint8_t next = find_first_window_after(windows, count, minute);
+    uint32_t edge;
+    if (next > 0 && minute < windows[next - 1].stop) {
+        edge = windows[next - 1].stop;
+        if (period != 0 && edge == period && windows[0].start == 0) {
+            // Window was split at the end of the cycle, it really closes in the next one
+            edge = period + windows[0].stop;
+        }
+    } else if (next < count) {
+        edge = windows[next].start;
+    } else if (period != 0) {
+        edge = period + windows[0].start;
+    } else {
+        return NO_EDGE;
+    }
+    return edge - minute;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,416 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file app_schedules_cache.c
+ * @author bstewart-cae
+ * @brief This module holds the per-User schedule records in RAM and writes
+ *        modified parts of them back to NVM after a short quiet period.
+ *
+ *        Each record is split into parts in NVM: the scheduling state, stored in
+ *        the schedule data area, and one object per occupied schedule slot, stored
+ *        in the schedule slot area. Free slots have no object at all, and neither
+ *        has any part of the record of a User that does not exist.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+// Module includes should always go first and be listed alphabetically
+#include "app_schedules_cache.h"
+#include "database_common.h"
+// Stack/SDK includes should always go second to last and be listed alphabetically
+#include "AppTimer.h"
+#include "cc_user_credential_nvm.h"
+//define DEBUGPRINT
+#include "DebugPrint.h"
+#include "SwTimer.h"
+// Language includes should always go last and be listed alphabetically
+#include <stddef.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define CACHE_ENTRY_FREE  (0) ///< UUID value marking an unused cache entry
+#define PART_STATE        (0) ///< Part index of the scheduling state
+#define PART_FIRST_SLOT   (1) ///< Part index of the first Year Day slot, Daily Repeating slots follow
+#define PART_COUNT        (PART_FIRST_SLOT + APP_NVM_SCHEDULE_SLOTS_PER_USER) ///< Parts per record
+#define PART_BITMAP_SIZE  ((PART_COUNT + 7) / 8) ///< Bytes needed for one bit per part
+
+/**
+ * @brief A single cached schedule record.
+ */
+typedef struct cache_entry_ {
+    uint16_t uuid;                       ///< Owner of the record, or CACHE_ENTRY_FREE
+    uint32_t last_used;                  ///< Value of m_use_counter at the last access
+    uint8_t dirty[PART_BITMAP_SIZE];     ///< Parts that differ from their copy in NVM
+    uint8_t stored[PART_BITMAP_SIZE];    ///< Parts that have an object in NVM
+    schedule_metadata_nvm_t record;      ///< Schedule record of the User
+} cache_entry_t;
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static cache_entry_t m_cache[APP_SCHEDULE_CACHE_ENTRIES];
+static uint32_t m_use_counter = 0;  ///< Incremented on every access, used for LRU eviction
+static SSwTimer m_flush_timer;      ///< Delays write backs until modifications settle
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+static cache_entry_t * find_entry(const uint16_t uuid);
+static void load(cache_entry_t * entry, const uint16_t uuid);
+static bool write_back(cache_entry_t * entry);
+static bool store_part(cache_entry_t * entry,
+                       const uint16_t part,
+                       const bool keep,
+                       const app_nvm_area_t area,
+                       const uint16_t offset,
+                       void * data,
+                       const uint16_t size);
+static void * get_slot(schedule_metadata_nvm_t * record,
+                       const uint16_t part,
+                       uint16_t * size,
+                       uint16_t * record_offset);
+static void mark_part_dirty(cache_entry_t * entry, const uint16_t part);
+static bool is_dirty(const cache_entry_t * entry);
+static void flush_timer_callback(SSwTimer * timer);
+
+/****************************************************************************/
+/*                       EXPORTED FUNCTION DEFINITIONS                      */
+/****************************************************************************/
+
+void app_sch_cache_init(void)
+{
+    memset(m_cache, 0x00, sizeof(m_cache));
+    AppTimerRegister(&m_flush_timer, false, flush_timer_callback);
+}
+
+schedule_metadata_nvm_t * app_sch_cache_get(const uint16_t uuid)
+{
+    if (uuid == 0 || uuid > CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS) {
+        return NULL;
+    }
+    cache_entry_t * victim = &m_cache[0];
+    for (uint16_t i = 0; i < APP_SCHEDULE_CACHE_ENTRIES; i++) {
+        cache_entry_t * entry = &m_cache[i];
+        if (entry->uuid == uuid) {
+            entry->last_used = ++m_use_counter;
+            return &entry->record;
+        }
+        // Prefer a free entry, otherwise the least recently used one
+        if (victim->uuid != CACHE_ENTRY_FREE &&
+              (entry->uuid == CACHE_ENTRY_FREE || entry->last_used < victim->last_used)) {
+            victim = entry;
+        }
+    }
+
+    // Miss - the evicted record must reach NVM before its entry is reused
+    if (is_dirty(victim) && !write_back(victim)) {
+        return NULL;
+    }
+    load(victim, uuid);
+    victim->last_used = ++m_use_counter;
+    return &victim->record;
+}
+
+void app_sch_cache_mark_dirty(const uint16_t uuid)
+{
+    cache_entry_t * entry = find_entry(uuid);
+    if (entry) {
+        for (uint16_t part = 0; part < PART_COUNT; part++) {
+            mark_part_dirty(entry, part);
+        }
+    }
+}
+
+void app_sch_cache_mark_state_dirty(const uint16_t uuid)
+{
+    cache_entry_t * entry = find_entry(uuid);
+    if (entry) {
+        mark_part_dirty(entry, PART_STATE);
+    }
+}
+
+void app_sch_cache_mark_slot_dirty(const uint16_t uuid,
+                                   const ascc_type_t type,
+                                   const uint16_t slot)
+{
+    cache_entry_t * entry = find_entry(uuid);
+    uint16_t first = PART_FIRST_SLOT;
+    uint16_t count = 0;
+    if (type == ASCC_TYPE_YEAR_DAY) {
+        count = CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER;
+    } else if (type == ASCC_TYPE_DAILY_REPEATING) {
+        first += CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER;
+        count = CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER;
+    }
+    if (!entry || slot > count) {
+        return;
+    }
+    if (slot != 0) {
+        mark_part_dirty(entry, first + slot - 1);
+    } else {
+        for (uint16_t i = 0; i < count; i++) {
+            mark_part_dirty(entry, first + i);
+        }
+    }
+}
+
+bool app_sch_cache_flush(void)
+{
+    bool result = true;
+    TimerStop(&m_flush_timer);
+    for (uint16_t i = 0; i < APP_SCHEDULE_CACHE_ENTRIES; i++) {
+        if (is_dirty(&m_cache[i]) && !write_back(&m_cache[i])) {
+            result = false;
+        }
+    }
+    if (!result) {
+        // Try again later rather than losing the changes
+        TimerStart(&m_flush_timer, APP_SCHEDULE_CACHE_FLUSH_DELAY_MS);
+    }
+    return result;
+}
+
+void app_sch_cache_reset(void)
+{
+    TimerStop(&m_flush_timer);
+    memset(m_cache, 0x00, sizeof(m_cache));
+}
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+/**
+ * @brief Finds the cache entry holding the record of a User.
+ *
+ * @return Pointer to the cache entry, or NULL if the record is not cached.
+ */
+static cache_entry_t * find_entry(const uint16_t uuid)
+{
+    if (uuid == CACHE_ENTRY_FREE) {
+        return NULL;
+    }
+    for (uint16_t i = 0; i < APP_SCHEDULE_CACHE_ENTRIES; i++) {
+        if (m_cache[i].uuid == uuid) {
+            return &m_cache[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Loads the record of a User from NVM into a cache entry.
+ *
+ * Records still stored in the old layout, with all slots in a single object, are
+ * read slot by slot and marked dirty so that they are rewritten in the current
+ * layout on the next write back.
+ *
+ * @param entry Cache entry to fill
+ * @param uuid  User Unique Identifier
+ */
+static void load(cache_entry_t * entry, const uint16_t uuid)
+{
+    memset(entry, 0x00, sizeof(cache_entry_t));
+    entry->uuid = uuid;
+
+    uint16_t stored_size = 0;
+    if (!app_nvm_get_size(APP_NVM_AREA_SCHEDULE_DATA, uuid-1, &stored_size)) {
+        // Nothing stored for this User yet, start from an empty record
+        return;
+    }
+    entry->stored[PART_STATE / 8] |= (uint8_t)(1 << (PART_STATE % 8));
+    const bool legacy = stored_size == sizeof(schedule_metadata_nvm_t);
+    // The state is at the start of both layouts
+    app_nvm_read_part(APP_NVM_AREA_SCHEDULE_DATA, uuid-1, &entry->record,
+                      0, sizeof(schedule_header_nvm_t));
+
+    for (uint16_t part = PART_FIRST_SLOT; part < PART_COUNT; part++) {
+        uint16_t size = 0;
+        uint16_t record_offset = 0;
+        void * slot = get_slot(&entry->record, part, &size, &record_offset);
+        if (legacy) {
+            app_nvm_read_part(APP_NVM_AREA_SCHEDULE_DATA, uuid-1, slot, record_offset, size);
+        } else if (app_nvm(U3C_READ, APP_NVM_AREA_SCHEDULE_SLOT,
+                           (uuid-1) * APP_NVM_SCHEDULE_SLOTS_PER_USER + part - PART_FIRST_SLOT,
+                           slot, size)) {
+            entry->stored[part / 8] |= (uint8_t)(1 << (part % 8));
+        }
+    }
+    if (legacy) {
+        DPRINTF("%s: Migrating schedules of UUID %d\n", __func__, uuid);
+        for (uint16_t part = 0; part < PART_COUNT; part++) {
+            mark_part_dirty(entry, part);
+        }
+    }
+}
+
+/**
+ * @brief Writes the dirty parts of a cached record to NVM and clears their dirty
+ *        flags on success. Occupied slots are written, free slots are erased.
+ *        If the User does not exist, every part is erased instead.
+ *
+ * The state is written last, and only once every slot has been written, as it
+ * replaces a record still stored in the old layout.
+ *
+ * @param entry Cache entry to write
+ * @return true if every dirty part was written.
+ */
+static bool write_back(cache_entry_t * entry)
+{
+    bool result = true;
+    const bool present = u3c_nvm_get_user_offset_from_id(entry->uuid, NULL);
+    for (uint16_t i = PART_FIRST_SLOT; i <= PART_COUNT; i++) {
+        const uint16_t part = i % PART_COUNT;
+        const uint8_t mask = (uint8_t)(1 << (part % 8));
+        if (!(entry->dirty[part / 8] & mask)) {
+            continue;
+        }
+        bool written = false;
+        if (part == PART_STATE) {
+            written = result && store_part(entry, part, present, APP_NVM_AREA_SCHEDULE_DATA,
+                                           entry->uuid-1, &entry->record,
+                                           sizeof(schedule_header_nvm_t));
+        } else {
+            const uint16_t offset = (entry->uuid-1) * APP_NVM_SCHEDULE_SLOTS_PER_USER
+                                    + part - PART_FIRST_SLOT;
+            uint16_t size = 0;
+            uint16_t record_offset = 0;
+            void * slot = get_slot(&entry->record, part, &size, &record_offset);
+            // The occupied flag is the first member of both slot types
+            written = store_part(entry, part, present && *(bool *)slot,
+                                 APP_NVM_AREA_SCHEDULE_SLOT, offset, slot, size);
+        }
+        if (written) {
+            entry->dirty[part / 8] &= (uint8_t)~mask;
+        } else {
+            DPRINTF("%s: Failed to write part %d of UUID %d\n", __func__, part, entry->uuid);
+            result = false;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Writes a part of a record to its NVM object, or erases the object if
+ *        the part is not to be kept.
+ *
+ * @param entry  Cache entry holding the record
+ * @param part   Part index
+ * @param keep   true to write the part, false to remove it from NVM
+ * @param area   NVM area of the part
+ * @param offset Offset of the part's object within the area
+ * @param data   Data of the part
+ * @param size   Size of the part
+ * @return true if NVM holds the part as requested.
+ */
+static bool store_part(cache_entry_t * entry,
+                       const uint16_t part,
+                       const bool keep,
+                       const app_nvm_area_t area,
+                       const uint16_t offset,
+                       void * data,
+                       const uint16_t size)
+{
+    const uint8_t mask = (uint8_t)(1 << (part % 8));
+    if (keep) {
+        if (!app_nvm(U3C_WRITE, area, offset, data, size)) {
+            return false;
+        }
+        entry->stored[part / 8] |= mask;
+    } else if (entry->stored[part / 8] & mask) {
+        if (!app_nvm_erase(area, offset)) {
+            return false;
+        }
+        entry->stored[part / 8] &= (uint8_t)~mask;
+    }
+    // A part that is neither kept nor stored needs nothing
+    return true;
+}
+
+/**
+ * @brief Locates the schedule slot backing a part of a record.
+ *
+ * @param record             Record containing the slot
+ * @param part               Slot part index
+ * @param[out] size          Size of the slot
+ * @param[out] record_offset Offset of the slot within the record
+ * @return Pointer to the slot within @p record.
+ */
+static void * get_slot(schedule_metadata_nvm_t * record,
+                       const uint16_t part,
+                       uint16_t * size,
+                       uint16_t * record_offset)
+{
+    uint16_t index = part - PART_FIRST_SLOT;
+#if (CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER > 0)
+    if (index < CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER) {
+        *size = sizeof(year_day_nvm_t);
+        *record_offset = (uint16_t)(offsetof(schedule_metadata_nvm_t, year_day_schedules)
+                                    + index * sizeof(year_day_nvm_t));
+        return &record->year_day_schedules[index];
+    }
+#endif
+    index -= CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER;
+#if (CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER > 0)
+    *size = sizeof(daily_repeating_nvm_t);
+    *record_offset = (uint16_t)(offsetof(schedule_metadata_nvm_t, daily_repeating_schedules)
+                                + index * sizeof(daily_repeating_nvm_t));
+    return &record->daily_repeating_schedules[index];
+#else
+    (void)record;
+    (void)size;
+    (void)record_offset;
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Marks a part of a cached record as dirty and (re)starts the write back
+ *        timer, which coalesces a burst of changes into one write per part.
+ */
+static void mark_part_dirty(cache_entry_t * entry, const uint16_t part)
+{
+    entry->dirty[part / 8] |= (uint8_t)(1 << (part % 8));
+    TimerStart(&m_flush_timer, APP_SCHEDULE_CACHE_FLUSH_DELAY_MS);
+}
+
+/**
+ * @brief Checks whether any part of a cached record is dirty.
+ */
+static bool is_dirty(const cache_entry_t * entry)
+{
+    for (uint16_t i = 0; i < PART_BITMAP_SIZE; i++) {
+        if (entry->dirty[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Writes back all dirty records once modifications have settled.
+ */
+static void flush_timer_callback(__attribute__((unused)) SSwTimer * timer)
+{
+    app_sch_cache_flush();
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file app_schedules_tick.c
+ * @author bstewart-cae
+ * @brief This module arms a single timer for the next moment at which any User
+ *        enters or leaves its schedules. When it fires, every User whose state
+ *        has changed is reported to the Active Schedule CC through an
+ *        ASCC_APP_EVENT_ON_SCHEDULE_STATE_CHANGE event.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+// Module includes should always go first and be listed alphabetically
+#include "app_schedules_tick.h"
+#include "app_schedules_access.h"
+#include "CC_ActiveSchedule_types.h"
+// Stack/SDK includes should always go second to last and be listed alphabetically
+#include "AppTimer.h"
+//define DEBUGPRINT
+#include "DebugPrint.h"
+#include "SwTimer.h"
+#include "zaf_event_distributor_soc.h"
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define TICK_UPDATE_DELAY_MS (10)  ///< Delay collecting several schedule changes into one evaluation
+#define TICK_RETRY_DELAY_MS  (100) ///< Delay before retrying changes the event queue had no room for
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static SSwTimer m_tick_timer; ///< Fires at the next window boundary
+
+/// Schedule state last signalled for each User, indexed by UUID - 1
+static bool m_in_schedule[CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS];
+
+/*
+ * Queued events only carry a pointer to their data, so each User has its own entry
+ * which stays untouched until the state of that User changes again.
+ */
+static ascc_sched_state_change_event_data_t m_events[CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS];
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+static void tick_timer_callback(SSwTimer * timer);
+
+/****************************************************************************/
+/*                       EXPORTED FUNCTION DEFINITIONS                      */
+/****************************************************************************/
+
+void app_sch_tick_init(void)
+{
+    // Only changes from the state the Users start out with are signalled
+    for (uint16_t uuid = 1; uuid <= CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS; uuid++) {
+        m_in_schedule[uuid - 1] = app_sch_is_user_in_schedule(uuid);
+    }
+    AppTimerRegister(&m_tick_timer, false, tick_timer_callback);
+    app_sch_tick_reschedule();
+}
+
+void app_sch_tick_reschedule(void)
+{
+    TimerStart(&m_tick_timer, TICK_UPDATE_DELAY_MS);
+}
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+/**
+ * @brief Signals every User whose schedule state has changed and arms the timer for
+ *        the next window boundary.
+ */
+static void tick_timer_callback(__attribute__((unused)) SSwTimer * timer)
+{
+    ascc_time_stamp_t now;
+    if (!app_sch_get_current_time(&now)) {
+        // Nothing can change until the clock is set, which reschedules the service
+        return;
+    }
+
+    bool retry = false;
+    for (uint16_t uuid = 1; uuid <= CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS; uuid++) {
+        const bool in_schedule = app_sch_is_access_allowed(uuid, &now);
+        if (in_schedule == m_in_schedule[uuid - 1]) {
+            continue;
+        }
+        ascc_sched_state_change_event_data_t * event = &m_events[uuid - 1];
+        event->target.target_cc = COMMAND_CLASS_USER_CREDENTIAL;
+        event->target.target_id = uuid;
+        event->in_schedule = in_schedule;
+        if (zaf_event_distributor_enqueue_cc_event(COMMAND_CLASS_ACTIVE_SCHEDULE,
+                                                   ASCC_APP_EVENT_ON_SCHEDULE_STATE_CHANGE,
+                                                   event)) {
+            m_in_schedule[uuid - 1] = in_schedule;
+            DPRINTF("%s: UUID %d is %s its schedules\n",
+                    __func__, uuid, in_schedule ? "within" : "outside");
+        } else {
+            retry = true;
+        }
+    }
+
+    uint32_t delay_ms = APP_SCHEDULE_TICK_MAX_INTERVAL_MS;
+    app_sch_access_get_next_change(APP_SCHEDULE_TICK_MAX_INTERVAL_MS, &delay_ms);
+    if (retry && delay_ms > TICK_RETRY_DELAY_MS) {
+        delay_ms = TICK_RETRY_DELAY_MS;
+    }
+    // Zero is not a valid timeout
+    TimerStart(&m_tick_timer, delay_ms > 0 ? delay_ms : 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
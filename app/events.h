@@ -35,7 +35,8 @@ typedef enum EVENT_APP_DOOR_LOCK{
   EVENT_APP_DOORHANDLE_DEACTIVATED, //!< EVENT_APP_DOORHANDLE_DEACTIVATED
   EVENT_APP_CREDENTIAL_LEARN_START, //!< EVENT_APP_CREDENTIAL_LEARN_START
   EVENT_APP_DELETE_ALL_YD_SCHEDULES_START, ///! EVENT_APP_DELETE_ALL_YD_SCHEDULES_START
-  EVENT_APP_DELETE_ALL_DR_SCHEDULES_START  ///! EVENT_APP_DELETE_ALL_DR_SCHEDULES_START
+  EVENT_APP_DELETE_ALL_DR_SCHEDULES_START, ///! EVENT_APP_DELETE_ALL_DR_SCHEDULES_START
+  EVENT_APP_TIME_SYNC                      //!< EVENT_APP_TIME_SYNC, the time source has been (re)synchronized
 }
 EVENT_APP;
 
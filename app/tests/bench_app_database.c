@@ -0,0 +1,594 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file bench_app_database.c
+ * @author bstewart-cae
+ * @brief Host benchmark of the User Credential and Active Schedule database.
+ *
+ *        The SoC NVM driver of the User Credential CC and the application
+ *        schedule database run on top of a RAM backed zpal_nvm, and realistic
+ *        workloads are timed against them. Every workload prints one line per
+ *        operation with its latency and the flash accesses it caused, so that
+ *        regressions in these paths show up before firmware ships.
+ *
+ *        The number of Users is set at build time with BENCH_USERS.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <unity.h>
+#include "bench_op.h"
+#include "zpal_nvm_ram.h"
+#include "database_common.h"
+#include "app_schedules.h"
+#include "app_schedules_access.h"
+#include "app_schedules_cache.h"
+#include "CC_ActiveSchedule.h"
+#include "cc_user_credential_io.h"
+#include "cc_user_credential_nvm.h"
+#include "cc_user_credential_validation.h"
+#include "cc_user_credential_handlers_checksum.h"
+#include "cc_user_credential_tx.h"
+#include "ZAF_nvm.h"
+#include "zpal_entropy.h"
+#include "AppTimer_mock.h"
+#include "SwTimer_mock.h"
+#include "task_mock.h"
+#include "zaf_event_distributor_soc_mock.h"
+#include "cc_active_schedule_io_mock.h"
+#include "cc_user_credential_config_api_mock.h"
+#include <stdio.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#if !defined(BENCH_USERS)
+#define BENCH_USERS  CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS
+#endif
+
+#define BENCH_PIN_LENGTH          6
+#define BENCH_VALIDATION_ATTEMPTS 2000 ///< PIN entries in a validation storm
+#define BENCH_INVALID_PIN_RATIO   4    ///< One in this many PIN entries is unknown
+#define BENCH_CHECKSUM_POLLS      50   ///< All Users Checksum Get frames per poll round
+#define BENCH_MAX_TIMERS          8
+
+/**
+ * @brief Timer registered by the code under test, run by run_timers().
+ */
+typedef struct bench_timer_ {
+  SSwTimer * timer;
+  void (*callback)(SSwTimer * timer);
+  uint32_t timeout;
+  bool pending;
+} bench_timer_t;
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static ascc_target_stubs_t m_ascc;
+static bench_timer_t m_timers[BENCH_MAX_TIMERS];
+static uint8_t m_timer_count;
+static uint32_t m_rng = 0x2545F491;
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static uint32_t bench_random(void)
+{
+  // xorshift32, so every run drives the same workload
+  m_rng ^= m_rng << 13;
+  m_rng ^= m_rng >> 17;
+  m_rng ^= m_rng << 5;
+  return m_rng;
+}
+
+static void op_begin(bench_op_t * op, const char * name)
+{
+  bench_op_begin(op, name);
+  zpal_nvm_ram_clear_stats();
+}
+
+static void op_report(const bench_op_t * op)
+{
+  zpal_nvm_ram_stats_t nvm;
+  zpal_nvm_ram_get_stats(&nvm);
+  const double n = bench_op_runs(op);
+  printf("[bench] users=%-5u %-32s n=%-6u mean=%10.2f us  max=%10.2f us  "
+         "reads/op=%7.2f  writes/op=%6.2f  bytes written=%-8u sector erases=%u\n",
+         BENCH_USERS, op->name, op->count,
+         bench_op_mean_us(op), bench_op_max_us(op),
+         nvm.reads / n, nvm.writes / n, nvm.write_bytes, nvm.sector_erases);
+}
+
+static void pin_for_user(const uint16_t uuid, uint8_t * pin)
+{
+  uint32_t value = 100000u + (uint32_t)uuid * 7919u % 900000u;
+  for (int8_t i = BENCH_PIN_LENGTH - 1; i >= 0; i--) {
+    pin[i] = (uint8_t)('0' + value % 10);
+    value /= 10;
+  }
+}
+
+static u3c_db_operation_result add_user(const uint16_t uuid)
+{
+  char name[U3C_BUFFER_SIZE_USER_NAME];
+  const int name_length = snprintf(name, sizeof(name), "User %u", uuid);
+  u3c_user_t user = {
+    .unique_identifier = uuid,
+    .type = USER_TYPE_GENERAL,
+    .active = true,
+    .credential_rule = CREDENTIAL_RULE_SINGLE,
+    .modifier_type = MODIFIER_TYPE_Z_WAVE,
+    .modifier_node_id = 1,
+    .name_encoding = USER_NAME_ENCODING_STANDARD_ASCII,
+    .name_length = (uint8_t)(name_length < CC_USER_CREDENTIAL_MAX_LENGTH_USER_NAME ?
+                             name_length : CC_USER_CREDENTIAL_MAX_LENGTH_USER_NAME),
+  };
+  return CC_UserCredential_add_user(&user, (uint8_t *)name);
+}
+
+static u3c_db_operation_result add_pin(const uint16_t uuid)
+{
+  uint8_t pin[BENCH_PIN_LENGTH];
+  pin_for_user(uuid, pin);
+  u3c_credential_t credential = {
+    .metadata = {
+      .uuid = uuid,
+      .type = CREDENTIAL_TYPE_PIN_CODE,
+      .slot = uuid,
+      .length = BENCH_PIN_LENGTH,
+      .modifier_type = MODIFIER_TYPE_Z_WAVE,
+      .modifier_node_id = 1,
+    },
+    .data = pin,
+  };
+  return CC_UserCredential_add_credential(&credential);
+}
+
+static bool set_schedules(const uint16_t uuid)
+{
+  uint16_t next_slot;
+  ascc_schedule_t year_day = {
+    .target = { .target_cc = COMMAND_CLASS_USER_CREDENTIAL, .target_id = uuid },
+    .slot_id = 1,
+    .type = ASCC_TYPE_YEAR_DAY,
+    .data.schedule.year_day = {
+      .start_year = 2026, .start_month = 1, .start_day = 1, .start_hour = 0, .start_minute = 0,
+      .stop_year = 2026, .stop_month = 12, .stop_day = 31, .stop_hour = 23, .stop_minute = 59,
+    },
+  };
+  ascc_schedule_t daily_repeating = {
+    .target = { .target_cc = COMMAND_CLASS_USER_CREDENTIAL, .target_id = uuid },
+    .slot_id = 1,
+    .type = ASCC_TYPE_DAILY_REPEATING,
+    .data.schedule.daily_repeating = {
+      .weekday_mask = 0x3E, .start_hour = 8, .start_minute = 0,
+      .duration_hour = 9, .duration_minute = 30,
+    },
+  };
+  bool success = true;
+  success &= m_ascc.set_schedule_data(ASCC_OP_TYPE_MODIFY, &year_day, &next_slot).result
+             == ASCC_OPERATION_SUCCESS;
+  success &= m_ascc.set_schedule_data(ASCC_OP_TYPE_MODIFY, &daily_repeating, &next_slot).result
+             == ASCC_OPERATION_SUCCESS;
+  return success;
+}
+
+/**
+ * @brief Runs every started timer, including those started by the callbacks,
+ *        as if their timeouts had elapsed.
+ *
+ * The OS tick count never moves in the benchmark, so timers waiting for the next
+ * schedule boundary would keep getting restarted. Only the short timers used for
+ * deferred database work are run.
+ */
+static void run_timers(void)
+{
+  bool ran = true;
+  while (ran) {
+    ran = false;
+    for (uint8_t i = 0; i < m_timer_count; i++) {
+      if (m_timers[i].pending && m_timers[i].timeout <= APP_SCHEDULE_CACHE_FLUSH_DELAY_MS) {
+        m_timers[i].pending = false;
+        m_timers[i].callback(m_timers[i].timer);
+        ran = true;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Adds BENCH_USERS Users, each with a PIN Code and schedules, and
+ *        optionally reports how long each step took.
+ *
+ * @return Number of Users that were stored
+ */
+static uint16_t provision(const bool report)
+{
+  bench_op_t op;
+  uint16_t stored = 0;
+
+  op_begin(&op, "add user");
+  for (uint16_t uuid = 1; uuid <= BENCH_USERS; uuid++) {
+    const uint64_t start = bench_now_ns();
+    if (add_user(uuid) == U3C_DB_OPERATION_RESULT_SUCCESS) {
+      stored++;
+    }
+    bench_op_sample(&op, start);
+  }
+  if (report) {
+    op_report(&op);
+  }
+
+  op_begin(&op, "add PIN code");
+  for (uint16_t uuid = 1; uuid <= stored; uuid++) {
+    const uint64_t start = bench_now_ns();
+    add_pin(uuid);
+    bench_op_sample(&op, start);
+  }
+  if (report) {
+    op_report(&op);
+  }
+
+  op_begin(&op, "set schedules (YD + DR)");
+  for (uint16_t uuid = 1; uuid <= stored; uuid++) {
+    const uint64_t start = bench_now_ns();
+    set_schedules(uuid);
+    bench_op_sample(&op, start);
+  }
+  if (report) {
+    op_report(&op);
+  }
+
+  op_begin(&op, "schedule cache flush");
+  const uint64_t start = bench_now_ns();
+  app_sch_cache_flush();
+  bench_op_sample(&op, start);
+  if (report) {
+    op_report(&op);
+  }
+  return stored;
+}
+
+/****************************************************************************/
+/*                         STAND-INS FOR THE TARGET                         */
+/****************************************************************************/
+
+uint8_t zpal_get_pseudo_random(void)
+{
+  return (uint8_t)bench_random();
+}
+
+bool CC_ActiveSchedule_Get_Current_Frame_Options(RECEIVE_OPTIONS_TYPE_EX * rx_opts)
+{
+  memset(rx_opts, 0, sizeof(RECEIVE_OPTIONS_TYPE_EX));
+  return true;
+}
+
+void CC_ActiveSchedule_YearDay_Schedule_Report_tx(
+  __attribute__((unused)) const ascc_report_type_t report_type,
+  __attribute__((unused)) const ascc_schedule_t * schedule,
+  __attribute__((unused)) const uint16_t next_schedule_slot,
+  __attribute__((unused)) RECEIVE_OPTIONS_TYPE_EX * rx_opts)
+{
+}
+
+void CC_ActiveSchedule_DailyRepeating_Schedule_Report_tx(
+  __attribute__((unused)) const ascc_report_type_t report_type,
+  __attribute__((unused)) const ascc_schedule_t * schedule,
+  __attribute__((unused)) const uint16_t next_schedule_slot,
+  __attribute__((unused)) RECEIVE_OPTIONS_TYPE_EX * rx_opts)
+{
+}
+
+void CC_UserCredential_AllUsersChecksumReport_tx(
+  __attribute__((unused)) uint16_t checksum,
+  __attribute__((unused)) RECEIVE_OPTIONS_TYPE_EX * p_rx_options)
+{
+}
+
+void CC_UserCredential_UserChecksumReport_tx(
+  __attribute__((unused)) uint16_t uuid,
+  __attribute__((unused)) uint16_t checksum,
+  __attribute__((unused)) RECEIVE_OPTIONS_TYPE_EX * p_rx_options)
+{
+}
+
+void CC_UserCredential_CredentialChecksumReport_tx(
+  __attribute__((unused)) u3c_credential_type credential_type,
+  __attribute__((unused)) uint16_t checksum,
+  __attribute__((unused)) RECEIVE_OPTIONS_TYPE_EX * p_rx_options)
+{
+}
+
+static void register_callbacks_stub(uint8_t command_class_id,
+                                    const ascc_target_stubs_t * stubs,
+                                    __attribute__((unused)) int cmock_num_calls)
+{
+  TEST_ASSERT_EQUAL(COMMAND_CLASS_USER_CREDENTIAL_V2, command_class_id);
+  m_ascc = *stubs;
+}
+
+static bool app_timer_register_stub(SSwTimer * pTimer,
+                                    __attribute__((unused)) bool bAutoReload,
+                                    void (*pCallback)(SSwTimer * pTimer),
+                                    __attribute__((unused)) int cmock_num_calls)
+{
+  for (uint8_t i = 0; i < m_timer_count; i++) {
+    if (m_timers[i].timer == pTimer) {
+      return true;
+    }
+  }
+  TEST_ASSERT_LESS_THAN(BENCH_MAX_TIMERS, m_timer_count);
+  m_timers[m_timer_count++] = (bench_timer_t) { .timer = pTimer, .callback = pCallback };
+  return true;
+}
+
+static bench_timer_t * find_timer(const SSwTimer * pTimer)
+{
+  for (uint8_t i = 0; i < m_timer_count; i++) {
+    if (m_timers[i].timer == pTimer) {
+      return &m_timers[i];
+    }
+  }
+  return NULL;
+}
+
+static ESwTimerStatus timer_start_stub(SSwTimer * pTimer,
+                                       uint32_t iTimeout,
+                                       __attribute__((unused)) int cmock_num_calls)
+{
+  bench_timer_t * timer = find_timer(pTimer);
+  if (timer) {
+    timer->timeout = iTimeout;
+    timer->pending = true;
+  }
+  return ESWTIMER_STATUS_SUCCESS;
+}
+
+static ESwTimerStatus timer_stop_stub(SSwTimer * pTimer,
+                                      __attribute__((unused)) int cmock_num_calls)
+{
+  bench_timer_t * timer = find_timer(pTimer);
+  if (timer) {
+    timer->pending = false;
+  }
+  return ESWTIMER_STATUS_SUCCESS;
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(m_timers, 0, sizeof(m_timers));
+  m_timer_count = 0;
+
+  AppTimerRegister_Stub(app_timer_register_stub);
+  TimerStart_Stub(timer_start_stub);
+  TimerStop_Stub(timer_stop_stub);
+  xTaskGetTickCount_IgnoreAndReturn(0);
+  zaf_event_distributor_enqueue_app_event_IgnoreAndReturn(true);
+  CC_ActiveSchedule_RegisterCallbacks_Stub(register_callbacks_stub);
+  cc_user_credential_get_max_user_unique_identifiers_IgnoreAndReturn(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS);
+  cc_user_credential_get_num_year_day_per_user_IgnoreAndReturn(CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER);
+  cc_user_credential_get_num_daily_repeating_per_user_IgnoreAndReturn(CC_USER_CREDENTIAL_DAILY_REPEATING_SCHEDULES_PER_USER);
+  cc_user_credential_is_all_users_checksum_supported_IgnoreAndReturn(true);
+  cc_user_credential_is_user_checksum_supported_IgnoreAndReturn(true);
+
+  // Start every workload from an empty flash
+  zpal_nvm_ram_reset();
+  ZAF_nvm_init();
+  CC_UserCredential_factory_reset();
+  app_nvm_init();
+  app_sch_cache_reset();
+}
+
+void tearDown(void)
+{
+}
+
+/****************************************************************************/
+/*                                WORKLOADS                                 */
+/****************************************************************************/
+
+/**
+ * Provisions the database from empty, as a controller would when setting up
+ * a lock, and then restarts the node.
+ */
+void test_bench_bulk_provisioning(void)
+{
+  bench_op_t op;
+  const uint16_t stored = provision(true);
+  TEST_ASSERT_EQUAL_UINT16(BENCH_USERS, stored);
+
+  op_begin(&op, "restart (init database)");
+  const uint64_t start = bench_now_ns();
+  CC_UserCredential_init_database();
+  app_nvm_init();
+  bench_op_sample(&op, start);
+  op_report(&op);
+}
+
+/**
+ * Enters PIN Codes at the keypad in quick succession. Every entry is looked
+ * up among the stored Credentials and, when found, checked against the
+ * schedules of its User.
+ */
+void test_bench_pin_validation_storm(void)
+{
+  bench_op_t op;
+  const uint16_t stored = provision(false);
+  const ascc_time_stamp_t now = {
+    .year = 2026, .month = 3, .day = 10, .hour = 12, .minute = 0
+  };
+  app_sch_set_time(&now);
+
+  // Restart so that the storm starts from the state after a power cycle
+  CC_UserCredential_init_database();
+  app_nvm_init();
+
+  uint32_t granted = 0;
+  op_begin(&op, "PIN validation");
+  for (uint32_t i = 0; i < BENCH_VALIDATION_ATTEMPTS; i++) {
+    uint8_t pin[BENCH_PIN_LENGTH];
+    const uint16_t uuid = (uint16_t)(1 + bench_random() % stored);
+    pin_for_user(uuid, pin);
+    if (i % BENCH_INVALID_PIN_RATIO == 0) {
+      pin[0] = 'X'; // Unknown PIN Code
+    }
+    u3c_credential_t credential = {
+      .metadata = {
+        .type = CREDENTIAL_TYPE_PIN_CODE,
+        .length = BENCH_PIN_LENGTH,
+      },
+      .data = pin,
+    };
+    uint16_t owner;
+    uint16_t slot;
+
+    const uint64_t start = bench_now_ns();
+    if (find_credential_owner(&credential, &owner, &slot)
+        && app_sch_is_access_allowed(owner, &now)) {
+      granted++;
+    }
+    bench_op_sample(&op, start);
+  }
+  op_report(&op);
+  TEST_ASSERT_EQUAL_UINT32(BENCH_VALIDATION_ATTEMPTS - (BENCH_VALIDATION_ATTEMPTS + BENCH_INVALID_PIN_RATIO - 1) / BENCH_INVALID_PIN_RATIO,
+                           granted);
+}
+
+/**
+ * Polls the checksums as a controller does to find out whether its copy of
+ * the database is still up to date.
+ */
+void test_bench_checksum_polls(void)
+{
+  bench_op_t op;
+  const uint16_t stored = provision(false);
+  RECEIVE_OPTIONS_TYPE_EX rx_options = { 0 };
+  ZW_APPLICATION_TX_BUFFER frame = { 0 };
+  cc_handler_input_t input = {
+    .rx_options = &rx_options,
+    .frame = &frame,
+    .length = sizeof(ZW_USER_CHECKSUM_GET_FRAME),
+  };
+
+  op_begin(&op, "All Users Checksum Get (first)");
+  uint64_t start = bench_now_ns();
+  CC_UserCredential_AllUsersChecksumGet_handler(&input);
+  bench_op_sample(&op, start);
+  op_report(&op);
+
+  op_begin(&op, "All Users Checksum Get (repeat)");
+  for (uint32_t i = 0; i < BENCH_CHECKSUM_POLLS; i++) {
+    start = bench_now_ns();
+    CC_UserCredential_AllUsersChecksumGet_handler(&input);
+    bench_op_sample(&op, start);
+  }
+  op_report(&op);
+
+  op_begin(&op, "User Checksum Get (every user)");
+  for (uint16_t uuid = 1; uuid <= stored; uuid++) {
+    frame.ZW_UserChecksumGetFrame.userUniqueIdentifier1 = (uint8_t)(uuid >> 8);
+    frame.ZW_UserChecksumGetFrame.userUniqueIdentifier2 = (uint8_t)uuid;
+    start = bench_now_ns();
+    CC_UserCredential_UserChecksumGet_handler(&input);
+    bench_op_sample(&op, start);
+  }
+  op_report(&op);
+
+  // A single change between polls, as when a User changes their PIN Code
+  op_begin(&op, "All Users Checksum Get (changed)");
+  u3c_credential_metadata_t metadata = { 0 };
+  uint8_t pin[BENCH_PIN_LENGTH];
+  CC_UserCredential_get_credential(stored, CREDENTIAL_TYPE_PIN_CODE, stored, &metadata, pin);
+  pin[0] = 'Y';
+  u3c_credential_t credential = { .metadata = metadata, .data = pin };
+  CC_UserCredential_modify_credential(&credential);
+  start = bench_now_ns();
+  CC_UserCredential_AllUsersChecksumGet_handler(&input);
+  bench_op_sample(&op, start);
+  op_report(&op);
+}
+
+/**
+ * Erases every schedule of every User, running the background job to
+ * completion.
+ */
+void test_bench_erase_all(void)
+{
+  bench_op_t op;
+  provision(false);
+
+  op_begin(&op, "Erase All schedules (job)");
+  const uint64_t start = bench_now_ns();
+  app_sch_reset_schedules();
+  run_timers();
+  bench_op_sample(&op, start);
+  op_report(&op);
+
+  bool state = true;
+  const ascc_target_t target = { .target_cc = COMMAND_CLASS_USER_CREDENTIAL, .target_id = 1 };
+  m_ascc.get_schedule_state(&target, &state);
+  TEST_ASSERT_FALSE(state);
+}
+
+/**
+ * Reads back every occupied schedule slot of every User, following the next
+ * slot returned with each Report.
+ */
+void test_bench_schedule_get_iteration(void)
+{
+  bench_op_t op;
+  const uint16_t stored = provision(false);
+
+  // Restart so that the records are read back from flash
+  app_sch_cache_reset();
+  app_nvm_init();
+
+  uint32_t slots = 0;
+  op_begin(&op, "Schedule Get (iterate slots)");
+  for (uint16_t uuid = 1; uuid <= stored; uuid++) {
+    const ascc_target_t target = { .target_cc = COMMAND_CLASS_USER_CREDENTIAL, .target_id = uuid };
+    for (uint8_t type = ASCC_TYPE_YEAR_DAY; type <= ASCC_TYPE_DAILY_REPEATING; type++) {
+      uint16_t slot = 0;
+      do {
+        ascc_schedule_data_t data;
+        uint16_t next_slot = 0;
+        const uint64_t start = bench_now_ns();
+        ascc_op_result_t result = m_ascc.get_schedule_data((ascc_type_t)type, slot, &target,
+                                                           &data, &next_slot);
+        bench_op_sample(&op, start);
+        if (result.result != ASCC_OPERATION_SUCCESS) {
+          break;
+        }
+        slots++;
+        slot = next_slot;
+      } while (slot != 0);
+    }
+  }
+  op_report(&op);
+  TEST_ASSERT_EQUAL_UINT32(2u * stored, slots);
+}
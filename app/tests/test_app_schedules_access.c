@@ -0,0 +1,450 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_app_schedules_access.c
+ * @brief Host tests of the access window engine: whether a User may be granted
+ *        access at a given moment, and the time until the next schedule window
+ *        boundary, which drives the schedule tick service.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <unity.h>
+#include "app_schedules_access.h"
+#include "task_mock.h"
+#include <FreeRTOS.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define MS_PER_MINUTE     (60UL * 1000)
+#define MAX_DELAY_MS      (7UL * 24 * 60 * MS_PER_MINUTE)
+
+#define SUNDAY            (1 << 0)
+#define MONDAY            (1 << 1)
+#define WEDNESDAY         (1 << 3)
+#define SATURDAY          (1 << 6)
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static TickType_t m_ticks;
+static schedule_metadata_nvm_t m_schedule;
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static TickType_t tick_count_stub(__attribute__((unused)) int cmock_num_calls)
+{
+  return m_ticks;
+}
+
+static void set_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute)
+{
+  const ascc_time_stamp_t now = {
+    .year = year, .month = month, .day = day, .hour = hour, .minute = minute
+  };
+  app_sch_set_current_time(&now);
+}
+
+static void add_year_day(uint8_t slot,
+                         const ascc_time_stamp_t * const start,
+                         const ascc_time_stamp_t * const stop)
+{
+  year_day_nvm_t * yd = &m_schedule.year_day_schedules[slot];
+  yd->occupied = true;
+  yd->schedule.start_year = start->year;
+  yd->schedule.start_month = start->month;
+  yd->schedule.start_day = start->day;
+  yd->schedule.start_hour = start->hour;
+  yd->schedule.start_minute = start->minute;
+  yd->schedule.stop_year = stop->year;
+  yd->schedule.stop_month = stop->month;
+  yd->schedule.stop_day = stop->day;
+  yd->schedule.stop_hour = stop->hour;
+  yd->schedule.stop_minute = stop->minute;
+}
+
+static void add_daily_repeating(uint8_t slot,
+                                uint8_t weekday_mask,
+                                uint8_t start_hour,
+                                uint8_t start_minute,
+                                uint8_t duration_hour,
+                                uint8_t duration_minute)
+{
+  daily_repeating_nvm_t * dr = &m_schedule.daily_repeating_schedules[slot];
+  dr->occupied = true;
+  dr->schedule.weekday_mask = weekday_mask;
+  dr->schedule.start_hour = start_hour;
+  dr->schedule.start_minute = start_minute;
+  dr->schedule.duration_hour = duration_hour;
+  dr->schedule.duration_minute = duration_minute;
+}
+
+/// Compiles the schedules built up with add_year_day() and add_daily_repeating()
+static void compile(uint16_t uuid)
+{
+  m_schedule.uuid = uuid;
+  m_schedule.scheduling_active = true;
+  app_sch_access_compile(uuid, &m_schedule);
+  memset(&m_schedule, 0, sizeof(m_schedule));
+}
+
+static bool is_allowed(uint16_t uuid, uint16_t year, uint8_t month, uint8_t day,
+                       uint8_t hour, uint8_t minute)
+{
+  const ascc_time_stamp_t now = {
+    .year = year, .month = month, .day = day, .hour = hour, .minute = minute
+  };
+  return app_sch_is_access_allowed(uuid, &now);
+}
+
+static uint32_t next_change_ms(void)
+{
+  uint32_t delay_ms = 0;
+  TEST_ASSERT_TRUE(app_sch_access_get_next_change(MAX_DELAY_MS, &delay_ms));
+  return delay_ms;
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  m_ticks = 0;
+  memset(&m_schedule, 0, sizeof(m_schedule));
+  xTaskGetTickCount_Stub(tick_count_stub);
+  app_sch_access_reset();
+}
+
+void tearDown(void)
+{
+}
+
+/****************************************************************************/
+/*                                  TESTS                                   */
+/****************************************************************************/
+
+/**
+ * Before the wall clock has been set, nothing is due and Users with active scheduling
+ * are kept out until the clock is set.
+ *
+ * The clock cannot be unset again, so this test must run first.
+ */
+void test_clock_not_set(void)
+{
+  uint32_t delay_ms = 0;
+  TEST_ASSERT_FALSE(app_sch_access_get_next_change(MAX_DELAY_MS, &delay_ms));
+  TEST_ASSERT_FALSE(app_sch_access_get_next_change(MAX_DELAY_MS, NULL));
+
+  add_daily_repeating(0, WEDNESDAY, 10, 0, 1, 0);
+  compile(1);
+  m_schedule.uuid = 2;
+  app_sch_access_compile(2, &m_schedule);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(1));
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(2));
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(3));
+
+  // Invalid times do not set the clock
+  set_time(2026, 13, 21, 10, 30);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(1));
+
+  // 2026-10-21 is a Wednesday
+  set_time(2026, 10, 21, 10, 30);
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(1));
+}
+
+/**
+ * Without any schedule, or without active scheduling, the longest delay is used.
+ */
+void test_next_change_no_schedule(void)
+{
+  set_time(2026, 3, 10, 12, 0);
+  TEST_ASSERT_EQUAL_UINT32(MAX_DELAY_MS, next_change_ms());
+
+  // Scheduling active, but no window
+  compile(1);
+  TEST_ASSERT_EQUAL_UINT32(MAX_DELAY_MS, next_change_ms());
+
+  // A window of a User without active scheduling is never signalled
+  add_daily_repeating(0, 0x7F, 12, 30, 1, 0);
+  m_schedule.scheduling_active = false;
+  m_schedule.uuid = 2;
+  app_sch_access_compile(2, &m_schedule);
+  TEST_ASSERT_EQUAL_UINT32(MAX_DELAY_MS, next_change_ms());
+}
+
+/**
+ * A Year Day window is due when it opens and when it closes, and never again
+ * after that.
+ */
+void test_next_change_year_day(void)
+{
+  const ascc_time_stamp_t start = { .year = 2026, .month = 3, .day = 10, .hour = 12, .minute = 30 };
+  const ascc_time_stamp_t stop = { .year = 2026, .month = 3, .day = 11, .hour = 8, .minute = 0 };
+  add_year_day(0, &start, &stop);
+  compile(1);
+
+  set_time(2026, 3, 10, 10, 0);
+  TEST_ASSERT_EQUAL_UINT32(150 * MS_PER_MINUTE, next_change_ms());
+
+  set_time(2026, 3, 10, 12, 30);
+  TEST_ASSERT_EQUAL_UINT32(1170 * MS_PER_MINUTE, next_change_ms());
+
+  set_time(2026, 3, 11, 8, 0);
+  TEST_ASSERT_EQUAL_UINT32(MAX_DELAY_MS, next_change_ms());
+}
+
+/**
+ * Year Day windows are counted across the end of a month, a year and a leap day.
+ */
+void test_next_change_year_day_date_edges(void)
+{
+  const ascc_time_stamp_t new_year = { .year = 2027, .month = 1, .day = 1, .hour = 0, .minute = 10 };
+  const ascc_time_stamp_t new_year_stop = { .year = 2027, .month = 1, .day = 2, .hour = 0, .minute = 0 };
+  add_year_day(0, &new_year, &new_year_stop);
+  compile(1);
+
+  set_time(2026, 12, 31, 23, 50);
+  TEST_ASSERT_EQUAL_UINT32(20 * MS_PER_MINUTE, next_change_ms());
+
+  // 2028 is a leap year, so the 29th of February lies in between
+  const ascc_time_stamp_t march = { .year = 2028, .month = 3, .day = 1, .hour = 0, .minute = 0 };
+  const ascc_time_stamp_t march_stop = { .year = 2028, .month = 3, .day = 2, .hour = 0, .minute = 0 };
+  add_year_day(0, &march, &march_stop);
+  compile(1);
+
+  set_time(2028, 2, 28, 23, 0);
+  TEST_ASSERT_EQUAL_UINT32((24 + 1) * 60 * MS_PER_MINUTE, next_change_ms());
+
+  set_time(2027, 2, 28, 23, 0);
+  TEST_ASSERT_EQUAL_UINT32(MAX_DELAY_MS, next_change_ms());
+}
+
+/**
+ * A Daily Repeating window past the last window of the week is found in the
+ * next week.
+ */
+void test_next_change_week_wrap(void)
+{
+  add_daily_repeating(0, MONDAY, 8, 0, 1, 0);
+  compile(1);
+
+  // 2026-10-17 is a Saturday, the window opens on Monday 08:00
+  set_time(2026, 10, 17, 22, 0);
+  TEST_ASSERT_EQUAL_UINT32((2 + 24 + 8) * 60 * MS_PER_MINUTE, next_change_ms());
+
+  set_time(2026, 10, 19, 8, 15);
+  TEST_ASSERT_EQUAL_UINT32(45 * MS_PER_MINUTE, next_change_ms());
+
+  // After it closes, the window of the following Monday is next
+  set_time(2026, 10, 19, 9, 0);
+  TEST_ASSERT_EQUAL_UINT32((7 * 24 - 1) * 60 * MS_PER_MINUTE, next_change_ms());
+}
+
+/**
+ * A Daily Repeating window running past Saturday midnight is split in two, but
+ * only closes on Sunday.
+ */
+void test_next_change_window_across_week_end(void)
+{
+  add_daily_repeating(0, SATURDAY, 23, 0, 2, 0);
+  compile(1);
+
+  set_time(2026, 10, 17, 23, 30);
+  TEST_ASSERT_EQUAL_UINT32(90 * MS_PER_MINUTE, next_change_ms());
+
+  set_time(2026, 10, 18, 0, 30);
+  TEST_ASSERT_EQUAL_UINT32(30 * MS_PER_MINUTE, next_change_ms());
+
+  // A window starting at Sunday midnight is a window of its own
+  add_daily_repeating(0, SUNDAY, 0, 0, 1, 0);
+  compile(2);
+  set_time(2026, 10, 17, 23, 30);
+  TEST_ASSERT_EQUAL_UINT32(30 * MS_PER_MINUTE, next_change_ms());
+}
+
+/**
+ * The earliest boundary of all Users is used, less the part of the current
+ * minute that has passed. Boundaries beyond the longest delay are not used.
+ */
+void test_next_change_earliest_user(void)
+{
+  add_daily_repeating(0, 0x7F, 14, 0, 1, 0);
+  compile(1);
+  add_daily_repeating(0, 0x7F, 13, 0, 1, 0);
+  compile(2);
+
+  set_time(2026, 10, 14, 12, 0);
+  TEST_ASSERT_EQUAL_UINT32(60 * MS_PER_MINUTE, next_change_ms());
+
+  m_ticks = pdMS_TO_TICKS(20 * 1000);
+  TEST_ASSERT_EQUAL_UINT32(60 * MS_PER_MINUTE - 20 * 1000, next_change_ms());
+
+  // The clock has moved on to 12:59
+  m_ticks = pdMS_TO_TICKS(59 * MS_PER_MINUTE + 30 * 1000);
+  TEST_ASSERT_EQUAL_UINT32(30 * 1000, next_change_ms());
+
+  uint32_t delay_ms = 0;
+  TEST_ASSERT_TRUE(app_sch_access_get_next_change(10 * 1000, &delay_ms));
+  TEST_ASSERT_EQUAL_UINT32(10 * 1000, delay_ms);
+}
+
+/**
+ * Users without active scheduling are always allowed, Users with active
+ * scheduling but no window never are. Invalid User IDs are refused.
+ */
+void test_access_scheduling_state(void)
+{
+  // No record compiled at all
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 19, 8, 0));
+
+  // A window of a User without active scheduling does not restrict it
+  add_daily_repeating(0, MONDAY, 8, 0, 1, 0);
+  m_schedule.uuid = 1;
+  app_sch_access_compile(1, &m_schedule);
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 20, 12, 0));
+
+  memset(&m_schedule, 0, sizeof(m_schedule));
+  compile(2);
+  TEST_ASSERT_FALSE(is_allowed(2, 2026, 10, 19, 8, 0));
+
+  // Compiling without a record, as done when a User is deleted, lifts the restriction
+  app_sch_access_compile(2, NULL);
+  TEST_ASSERT_TRUE(is_allowed(2, 2026, 10, 19, 8, 0));
+
+  TEST_ASSERT_FALSE(is_allowed(0, 2026, 10, 19, 8, 0));
+  TEST_ASSERT_FALSE(is_allowed(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS + 1, 2026, 10, 19, 8, 0));
+  TEST_ASSERT_FALSE(app_sch_is_access_allowed(1, NULL));
+}
+
+/**
+ * A Year Day window includes its start minute and excludes its stop minute.
+ */
+void test_access_year_day(void)
+{
+  const ascc_time_stamp_t start = { .year = 2026, .month = 2, .day = 28, .hour = 12, .minute = 30 };
+  const ascc_time_stamp_t stop = { .year = 2026, .month = 3, .day = 1, .hour = 8, .minute = 0 };
+  add_year_day(0, &start, &stop);
+  // A window that stops before it starts is ignored
+  add_year_day(1, &stop, &start);
+  compile(1);
+
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 2, 28, 12, 29));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 2, 28, 12, 30));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 3, 1, 7, 59));
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 3, 1, 8, 0));
+  // Same time of day, other year
+  TEST_ASSERT_FALSE(is_allowed(1, 2027, 2, 28, 18, 0));
+}
+
+/**
+ * A Daily Repeating window is open on each selected weekday, including the part
+ * of a window running past Saturday midnight.
+ */
+void test_access_daily_repeating(void)
+{
+  add_daily_repeating(0, MONDAY | WEDNESDAY, 8, 0, 1, 0);
+  add_daily_repeating(1, SATURDAY, 23, 0, 2, 0);
+  compile(1);
+
+  // 2026-10-19 is a Monday
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 10, 19, 7, 59));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 19, 8, 0));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 19, 8, 59));
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 10, 19, 9, 0));
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 10, 20, 8, 30));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 21, 8, 30));
+  // Any week
+  TEST_ASSERT_TRUE(is_allowed(1, 2027, 1, 4, 8, 30));
+
+  // Saturday 23:00 to Sunday 01:00
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 17, 23, 30));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 18, 0, 59));
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 10, 18, 1, 0));
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 10, 17, 0, 30));
+}
+
+/**
+ * Overlapping windows are merged, and a User is allowed within either a Year Day
+ * or a Daily Repeating window.
+ */
+void test_access_merged_windows(void)
+{
+  add_daily_repeating(0, MONDAY, 8, 0, 2, 0);
+  add_daily_repeating(1, MONDAY, 9, 0, 2, 0);
+  const ascc_time_stamp_t start = { .year = 2026, .month = 10, .day = 19, .hour = 11, .minute = 30 };
+  const ascc_time_stamp_t stop = { .year = 2026, .month = 10, .day = 19, .hour = 12, .minute = 0 };
+  add_year_day(0, &start, &stop);
+  compile(1);
+
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 19, 9, 30));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 19, 10, 30));
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 10, 19, 11, 0));
+  TEST_ASSERT_TRUE(is_allowed(1, 2026, 10, 19, 11, 45));
+  TEST_ASSERT_FALSE(is_allowed(1, 2026, 10, 26, 11, 45));
+}
+
+/**
+ * The access state of a User is set from its windows as soon as its schedules or
+ * the wall clock change, and then follows the boundaries signalled by the tick
+ * service.
+ */
+void test_access_state(void)
+{
+  // 2026-10-21 is a Wednesday
+  set_time(2026, 10, 21, 9, 59);
+  add_daily_repeating(0, WEDNESDAY, 10, 0, 1, 0);
+  compile(1);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(1));
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(2));
+
+  // The window opens
+  ascc_target_t target = { .target_cc = COMMAND_CLASS_USER_CREDENTIAL, .target_id = 1 };
+  app_sch_schedule_state_changed(&target, true);
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(1));
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(2));
+
+  // Targets of other command classes and unknown Users are ignored
+  target.target_cc = COMMAND_CLASS_USER_CODE;
+  app_sch_schedule_state_changed(&target, false);
+  target.target_cc = COMMAND_CLASS_USER_CREDENTIAL;
+  target.target_id = CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS + 1;
+  app_sch_schedule_state_changed(&target, false);
+  app_sch_schedule_state_changed(NULL, false);
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(1));
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(0));
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS + 1));
+
+  // Setting the clock outside of the window denies access at once
+  set_time(2026, 10, 21, 11, 0);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(1));
+
+  // So does removing the last window, and removing the record allows access
+  set_time(2026, 10, 21, 10, 30);
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(1));
+  compile(1);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(1));
+  app_sch_access_compile(1, NULL);
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(1));
+}
@@ -0,0 +1,327 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_app_schedules_cache.c
+ * @brief Host tests of the write-back cache of the schedule records, run on top
+ *        of a RAM backed zpal_nvm so that the flash accesses can be counted.
+ *
+ *        The test is built with two cache entries for three Users, so that the
+ *        third User evicts one of the others.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <unity.h>
+#include "zpal_nvm_ram.h"
+#include "app_schedules_cache.h"
+#include "cc_user_credential_nvm.h"
+#include "database_common.h"
+#include "ZAF_nvm.h"
+#include "AppTimer_mock.h"
+#include "SwTimer_mock.h"
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define USER_A  1
+#define USER_B  2
+#define USER_C  3
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static void (*m_flush_callback)(SSwTimer * timer);
+static SSwTimer * m_flush_timer;
+static bool m_flush_pending;
+/// Users that exist in the User Credential database, indexed by UUID
+static bool m_user_exists[CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS + 1];
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static bool app_timer_register_stub(SSwTimer * pTimer,
+                                    __attribute__((unused)) bool bAutoReload,
+                                    void (*pCallback)(SSwTimer * pTimer),
+                                    __attribute__((unused)) int cmock_num_calls)
+{
+  m_flush_timer = pTimer;
+  m_flush_callback = pCallback;
+  return true;
+}
+
+static ESwTimerStatus timer_start_stub(SSwTimer * pTimer,
+                                       uint32_t iTimeout,
+                                       __attribute__((unused)) int cmock_num_calls)
+{
+  TEST_ASSERT_EQUAL_PTR(m_flush_timer, pTimer);
+  TEST_ASSERT_EQUAL_UINT32(APP_SCHEDULE_CACHE_FLUSH_DELAY_MS, iTimeout);
+  m_flush_pending = true;
+  return ESWTIMER_STATUS_SUCCESS;
+}
+
+static ESwTimerStatus timer_stop_stub(__attribute__((unused)) SSwTimer * pTimer,
+                                      __attribute__((unused)) int cmock_num_calls)
+{
+  m_flush_pending = false;
+  return ESWTIMER_STATUS_SUCCESS;
+}
+
+/// Runs the flush timer callback if the timer is running
+static void run_flush_timer(void)
+{
+  if (m_flush_pending) {
+    m_flush_pending = false;
+    m_flush_callback(m_flush_timer);
+  }
+}
+
+static zpal_nvm_ram_stats_t get_stats(void)
+{
+  zpal_nvm_ram_stats_t stats;
+  zpal_nvm_ram_get_stats(&stats);
+  return stats;
+}
+
+/// Occupies a Daily Repeating slot (1-indexed) of a cached record
+static void set_daily_repeating(schedule_metadata_nvm_t * record,
+                                const uint16_t slot,
+                                const uint8_t start_hour)
+{
+  daily_repeating_nvm_t * dr = &record->daily_repeating_schedules[slot - 1];
+  dr->occupied = true;
+  dr->schedule.weekday_mask = 0x7F;
+  dr->schedule.start_hour = start_hour;
+  dr->schedule.duration_hour = 1;
+}
+
+/// Modifies a Daily Repeating slot as the Active Schedule Set handler does
+static void modify_daily_repeating(const uint16_t uuid,
+                                   const uint16_t slot,
+                                   const uint8_t start_hour)
+{
+  schedule_metadata_nvm_t * record = app_sch_cache_get(uuid);
+  TEST_ASSERT_NOT_NULL(record);
+  set_daily_repeating(record, slot, start_hour);
+  record->uuid = uuid;
+  record->scheduling_active = true;
+  app_sch_cache_mark_state_dirty(uuid);
+  app_sch_cache_mark_slot_dirty(uuid, ASCC_TYPE_DAILY_REPEATING, slot);
+}
+
+static bool is_slot_stored(const uint16_t uuid, const uint16_t slot)
+{
+  uint16_t size = 0;
+  const uint16_t offset = (uuid - 1) * APP_NVM_SCHEDULE_SLOTS_PER_USER
+                          + CC_USER_CREDENTIAL_YEAR_DAY_SCHEDULES_PER_USER + slot - 1;
+  return app_nvm_get_size(APP_NVM_AREA_SCHEDULE_SLOT, offset, &size);
+}
+
+static bool is_state_stored(const uint16_t uuid)
+{
+  uint16_t size = 0;
+  return app_nvm_get_size(APP_NVM_AREA_SCHEDULE_DATA, uuid - 1, &size);
+}
+
+/****************************************************************************/
+/*                          STUBBED DEPENDENCIES                            */
+/****************************************************************************/
+
+bool u3c_nvm_get_user_offset_from_id(const uint16_t uuid, uint16_t * offset)
+{
+  if (uuid > CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS || !m_user_exists[uuid]) {
+    return false;
+  }
+  if (offset) {
+    *offset = uuid - 1;
+  }
+  return true;
+}
+
+/// Called by app_nvm_init(), the Active Schedule handlers are not under test
+void app_sch_initialize_handlers(void)
+{
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  m_flush_pending = false;
+  memset(m_user_exists, true, sizeof(m_user_exists));
+
+  AppTimerRegister_Stub(app_timer_register_stub);
+  TimerStart_Stub(timer_start_stub);
+  TimerStop_Stub(timer_stop_stub);
+
+  zpal_nvm_ram_reset();
+  ZAF_nvm_init();
+  app_nvm_init();
+  app_sch_cache_init();
+  zpal_nvm_ram_clear_stats();
+}
+
+void tearDown(void)
+{
+}
+
+/****************************************************************************/
+/*                                  TESTS                                   */
+/****************************************************************************/
+
+/**
+ * A User without a stored record is given an empty record, which is not written
+ * until it is modified. Invalid User IDs have no record.
+ */
+void test_cache_empty_record(void)
+{
+  schedule_metadata_nvm_t * record = app_sch_cache_get(USER_A);
+  TEST_ASSERT_NOT_NULL(record);
+  TEST_ASSERT_FALSE(record->scheduling_active);
+  TEST_ASSERT_FALSE(record->daily_repeating_schedules[0].occupied);
+
+  TEST_ASSERT_NULL(app_sch_cache_get(0));
+  TEST_ASSERT_NULL(app_sch_cache_get(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS + 1));
+
+  TEST_ASSERT_TRUE(app_sch_cache_flush());
+  TEST_ASSERT_EQUAL_UINT32(0, get_stats().writes);
+  TEST_ASSERT_FALSE(is_state_stored(USER_A));
+}
+
+/**
+ * Modifications are written back once the flush timer expires, and a burst of
+ * modifications of the same slot costs a single write of the slot and the state.
+ */
+void test_cache_burst_costs_one_write(void)
+{
+  for (uint8_t hour = 8; hour < 15; hour++) {
+    modify_daily_repeating(USER_A, 1, hour);
+  }
+  TEST_ASSERT_TRUE(m_flush_pending);
+  TEST_ASSERT_EQUAL_UINT32(0, get_stats().writes);
+
+  run_flush_timer();
+
+  TEST_ASSERT_EQUAL_UINT32(2, get_stats().writes);
+  TEST_ASSERT_TRUE(is_state_stored(USER_A));
+  TEST_ASSERT_TRUE(is_slot_stored(USER_A, 1));
+  // Slots that were not marked are not written
+  TEST_ASSERT_FALSE(is_slot_stored(USER_A, 2));
+
+  // Only the marked slot is written again
+  zpal_nvm_ram_clear_stats();
+  set_daily_repeating(app_sch_cache_get(USER_A), 2, 16);
+  app_sch_cache_mark_slot_dirty(USER_A, ASCC_TYPE_DAILY_REPEATING, 2);
+  run_flush_timer();
+  TEST_ASSERT_EQUAL_UINT32(1, get_stats().writes);
+  TEST_ASSERT_TRUE(is_slot_stored(USER_A, 2));
+}
+
+/**
+ * Gets are served from RAM, and a record written back reads the same from NVM.
+ */
+void test_cache_write_back_and_reload(void)
+{
+  modify_daily_repeating(USER_A, 2, 9);
+  schedule_metadata_nvm_t * record = app_sch_cache_get(USER_A);
+  TEST_ASSERT_TRUE(app_sch_cache_flush());
+  TEST_ASSERT_FALSE(m_flush_pending);
+  TEST_ASSERT_EQUAL_UINT32(2, get_stats().writes);
+
+  zpal_nvm_ram_clear_stats();
+  TEST_ASSERT_EQUAL_PTR(record, app_sch_cache_get(USER_A));
+  TEST_ASSERT_EQUAL_UINT32(0, get_stats().reads);
+
+  schedule_metadata_nvm_t expected = *record;
+  app_sch_cache_reset();
+  record = app_sch_cache_get(USER_A);
+  TEST_ASSERT_NOT_NULL(record);
+  TEST_ASSERT_EQUAL_MEMORY(&expected, record, sizeof(expected));
+}
+
+/**
+ * A slot that is freed has its object erased.
+ */
+void test_cache_freed_slot_erased(void)
+{
+  modify_daily_repeating(USER_A, 1, 8);
+  schedule_metadata_nvm_t * record = app_sch_cache_get(USER_A);
+  TEST_ASSERT_TRUE(app_sch_cache_flush());
+  TEST_ASSERT_TRUE(is_slot_stored(USER_A, 1));
+
+  memset(&record->daily_repeating_schedules[0], 0, sizeof(daily_repeating_nvm_t));
+  app_sch_cache_mark_slot_dirty(USER_A, ASCC_TYPE_DAILY_REPEATING, 0);
+  zpal_nvm_ram_clear_stats();
+  TEST_ASSERT_TRUE(app_sch_cache_flush());
+
+  TEST_ASSERT_FALSE(is_slot_stored(USER_A, 1));
+  TEST_ASSERT_EQUAL_UINT32(0, get_stats().writes);
+  TEST_ASSERT_EQUAL_UINT32(1, get_stats().erases);
+}
+
+/**
+ * When the cache is full, the least recently used record is written back before
+ * its entry is reused.
+ */
+void test_cache_eviction_writes_back(void)
+{
+  modify_daily_repeating(USER_A, 1, 8);
+  modify_daily_repeating(USER_B, 1, 9);
+  // User A is now the most recently used
+  TEST_ASSERT_NOT_NULL(app_sch_cache_get(USER_A));
+
+  TEST_ASSERT_NOT_NULL(app_sch_cache_get(USER_C));
+
+  TEST_ASSERT_TRUE(is_slot_stored(USER_B, 1));
+  TEST_ASSERT_FALSE(is_slot_stored(USER_A, 1));
+  TEST_ASSERT_EQUAL_UINT8(9, app_sch_cache_get(USER_B)->daily_repeating_schedules[0].schedule.start_hour);
+}
+
+/**
+ * Nothing is kept in NVM for a User that does not exist, such as a User that has
+ * just been deleted.
+ */
+void test_cache_missing_user_not_stored(void)
+{
+  modify_daily_repeating(USER_A, 1, 8);
+  schedule_metadata_nvm_t * record = app_sch_cache_get(USER_A);
+  TEST_ASSERT_TRUE(app_sch_cache_flush());
+  TEST_ASSERT_TRUE(is_state_stored(USER_A));
+  TEST_ASSERT_TRUE(is_slot_stored(USER_A, 1));
+
+  m_user_exists[USER_A] = false;
+  memset(record, 0, sizeof(schedule_metadata_nvm_t));
+  app_sch_cache_mark_dirty(USER_A);
+  TEST_ASSERT_TRUE(app_sch_cache_flush());
+  TEST_ASSERT_FALSE(is_state_stored(USER_A));
+  TEST_ASSERT_FALSE(is_slot_stored(USER_A, 1));
+
+  // Modifying the record of a missing User writes nothing
+  m_user_exists[USER_B] = false;
+  app_sch_cache_get(USER_B)->scheduling_active = true;
+  app_sch_cache_mark_state_dirty(USER_B);
+  zpal_nvm_ram_clear_stats();
+  TEST_ASSERT_TRUE(app_sch_cache_flush());
+  TEST_ASSERT_EQUAL_UINT32(0, get_stats().writes);
+  TEST_ASSERT_FALSE(is_state_stored(USER_B));
+}
@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_app_schedules_tick.c
+ * @brief Host tests of the schedule tick service: a window boundary is signalled
+ *        through the Active Schedule CC and reaches the access state of the User.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <unity.h>
+#include "app_schedules_access.h"
+#include "app_schedules_tick.h"
+#include "AppTimer_mock.h"
+#include "SwTimer_mock.h"
+#include "task_mock.h"
+#include "zaf_event_distributor_soc_mock.h"
+#include <FreeRTOS.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define MS_PER_MINUTE     (60UL * 1000)
+#define WEDNESDAY         (1 << 3)
+#define USER_A            1
+#define USER_B            2
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static TickType_t m_ticks;
+static void (*m_tick_callback)(SSwTimer * timer);
+static SSwTimer * m_tick_timer;
+static uint32_t m_timeout_ms;
+static uint32_t m_elapsed_ms;   ///< Time passed since 09:59
+static bool m_queue_full;
+
+/// State change events enqueued for the Active Schedule CC
+static const ascc_sched_state_change_event_data_t * m_events[CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS];
+static uint8_t m_event_count;
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static TickType_t tick_count_stub(__attribute__((unused)) int cmock_num_calls)
+{
+  return m_ticks;
+}
+
+static bool app_timer_register_stub(SSwTimer * timer,
+                                    __attribute__((unused)) bool auto_reload,
+                                    void (*callback)(SSwTimer * timer),
+                                    __attribute__((unused)) int cmock_num_calls)
+{
+  m_tick_timer = timer;
+  m_tick_callback = callback;
+  return true;
+}
+
+static ESwTimerStatus timer_start_stub(__attribute__((unused)) SSwTimer * timer,
+                                       uint32_t timeout,
+                                       __attribute__((unused)) int cmock_num_calls)
+{
+  m_timeout_ms = timeout;
+  return ESWTIMER_STATUS_SUCCESS;
+}
+
+static bool enqueue_cc_event_stub(const uint16_t command_class,
+                                  const uint8_t event,
+                                  const void * data,
+                                  __attribute__((unused)) int cmock_num_calls)
+{
+  TEST_ASSERT_EQUAL_UINT16(COMMAND_CLASS_ACTIVE_SCHEDULE, command_class);
+  TEST_ASSERT_EQUAL_UINT8(ASCC_APP_EVENT_ON_SCHEDULE_STATE_CHANGE, event);
+  if (m_queue_full) {
+    return false;
+  }
+  TEST_ASSERT_LESS_THAN(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS, m_event_count);
+  m_events[m_event_count++] = data;
+  return true;
+}
+
+/// Lets the armed timeout elapse and fires the tick timer
+static void fire_tick(void)
+{
+  m_ticks += pdMS_TO_TICKS(m_timeout_ms);
+  m_elapsed_ms += m_timeout_ms;
+  m_event_count = 0;
+  m_tick_callback(m_tick_timer);
+}
+
+/// Hands the enqueued events to the stub, as the Active Schedule CC does
+static void dispatch_events(void)
+{
+  for (uint8_t i = 0; i < m_event_count; i++) {
+    app_sch_schedule_state_changed(&m_events[i]->target, m_events[i]->in_schedule);
+  }
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  m_ticks = 0;
+  m_elapsed_ms = 0;
+  m_event_count = 0;
+  m_queue_full = false;
+  xTaskGetTickCount_Stub(tick_count_stub);
+  AppTimerRegister_Stub(app_timer_register_stub);
+  TimerStart_Stub(timer_start_stub);
+  zaf_event_distributor_enqueue_cc_event_Stub(enqueue_cc_event_stub);
+
+  // 2026-10-21 is a Wednesday, User A may come in from 10:00 to 11:00
+  const ascc_time_stamp_t now = { .year = 2026, .month = 10, .day = 21, .hour = 9, .minute = 59 };
+  app_sch_set_current_time(&now);
+  app_sch_access_reset();
+  schedule_metadata_nvm_t schedule;
+  memset(&schedule, 0, sizeof(schedule));
+  schedule.uuid = USER_A;
+  schedule.scheduling_active = true;
+  schedule.daily_repeating_schedules[0].occupied = true;
+  schedule.daily_repeating_schedules[0].schedule.weekday_mask = WEDNESDAY;
+  schedule.daily_repeating_schedules[0].schedule.start_hour = 10;
+  schedule.daily_repeating_schedules[0].schedule.duration_hour = 1;
+  app_sch_access_compile(USER_A, &schedule);
+}
+
+void tearDown(void)
+{
+}
+
+/****************************************************************************/
+/*                                  TESTS                                   */
+/****************************************************************************/
+
+/**
+ * Each window boundary of User A reaches its access state through a state change
+ * event, while User B without schedules is never signalled.
+ */
+void test_tick_boundary_reaches_access_state(void)
+{
+  app_sch_tick_init();
+  TEST_ASSERT_NOT_NULL(m_tick_callback);
+
+  // User A starts out outside its window, so the first evaluation signals nothing
+  fire_tick();
+  TEST_ASSERT_EQUAL_UINT8(0, m_event_count);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(USER_A));
+  // The timer is armed for 10:00 sharp
+  TEST_ASSERT_EQUAL_UINT32(MS_PER_MINUTE, m_elapsed_ms + m_timeout_ms);
+
+  // 10:00, the window opens
+  fire_tick();
+  TEST_ASSERT_EQUAL_UINT8(1, m_event_count);
+  TEST_ASSERT_EQUAL_UINT8(COMMAND_CLASS_USER_CREDENTIAL, m_events[0]->target.target_cc);
+  TEST_ASSERT_EQUAL_UINT16(USER_A, m_events[0]->target.target_id);
+  TEST_ASSERT_TRUE(m_events[0]->in_schedule);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(USER_A));
+  dispatch_events();
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(USER_A));
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(USER_B));
+  TEST_ASSERT_EQUAL_UINT32(61 * MS_PER_MINUTE, m_elapsed_ms + m_timeout_ms);
+
+  // 11:00, the window closes
+  fire_tick();
+  TEST_ASSERT_EQUAL_UINT8(1, m_event_count);
+  TEST_ASSERT_FALSE(m_events[0]->in_schedule);
+  dispatch_events();
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(USER_A));
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(USER_B));
+}
+
+/**
+ * A boundary the event queue has no room for is signalled again shortly after.
+ */
+void test_tick_boundary_retried_when_queue_full(void)
+{
+  app_sch_tick_init();
+  fire_tick();
+  dispatch_events();
+
+  m_queue_full = true;
+  fire_tick();
+  TEST_ASSERT_EQUAL_UINT8(0, m_event_count);
+  TEST_ASSERT_FALSE(app_sch_is_user_in_schedule(USER_A));
+  TEST_ASSERT_EQUAL_UINT32(100, m_timeout_ms);
+
+  m_queue_full = false;
+  fire_tick();
+  TEST_ASSERT_EQUAL_UINT8(1, m_event_count);
+  TEST_ASSERT_TRUE(m_events[0]->in_schedule);
+  dispatch_events();
+  TEST_ASSERT_TRUE(app_sch_is_user_in_schedule(USER_A));
+}
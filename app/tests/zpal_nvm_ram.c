@@ -0,0 +1,263 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file zpal_nvm_ram.c
+ * @author bstewart-cae
+ * @brief RAM backed stand-in for the zpal_nvm API. See zpal_nvm_ram.h.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include "zpal_nvm_ram.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+/// Objects that can be stored per area. Must be a power of two.
+#define RAM_NVM_OBJECTS_PER_AREA  8192
+#define RAM_NVM_MASK              (RAM_NVM_OBJECTS_PER_AREA - 1)
+#define RAM_NVM_AREA_COUNT        (ZPAL_NVM_AREA_MANUFACTURER_TOKENS + 1)
+
+typedef struct ram_nvm_object_ {
+  bool used;
+  zpal_nvm_object_key_t key;
+  size_t size;
+  uint8_t * data;
+} ram_nvm_object_t;
+
+typedef struct ram_nvm_area_ {
+  ram_nvm_object_t objects[RAM_NVM_OBJECTS_PER_AREA];
+} ram_nvm_area_t;
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static ram_nvm_area_t m_areas[RAM_NVM_AREA_COUNT];
+static zpal_nvm_ram_stats_t m_stats;
+static uint32_t m_log_offset; ///< Write position in the simulated flash log
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static uint32_t key_slot(zpal_nvm_object_key_t key)
+{
+  return (key * 2654435761u) & RAM_NVM_MASK;
+}
+
+/**
+ * @brief Finds the slot of an object, or the free slot where it would go.
+ */
+static ram_nvm_object_t * find_object(ram_nvm_area_t * area, zpal_nvm_object_key_t key)
+{
+  uint32_t i = key_slot(key);
+  while (area->objects[i].used && area->objects[i].key != key) {
+    i = (i + 1) & RAM_NVM_MASK;
+  }
+  return &area->objects[i];
+}
+
+/**
+ * @brief Accounts for the flash used by writing a record of @p size bytes.
+ */
+static void append_to_log(size_t size)
+{
+  const uint32_t length = (uint32_t)size + ZPAL_NVM_RAM_OBJECT_OVERHEAD;
+  const uint32_t sector_before = m_log_offset / ZPAL_NVM_RAM_SECTOR_SIZE;
+  m_log_offset += length;
+  m_stats.write_bytes += length;
+  m_stats.sector_erases += (m_log_offset / ZPAL_NVM_RAM_SECTOR_SIZE) - sector_before;
+}
+
+/**
+ * @brief Removes an object, shifting back the objects probed past it so that
+ *        lookups never need tombstones.
+ */
+static void remove_object(ram_nvm_area_t * area, ram_nvm_object_t * object)
+{
+  uint32_t hole = (uint32_t)(object - area->objects);
+  free(object->data);
+  memset(object, 0, sizeof(ram_nvm_object_t));
+
+  uint32_t i = (hole + 1) & RAM_NVM_MASK;
+  while (area->objects[i].used) {
+    const uint32_t home = key_slot(area->objects[i].key);
+    if (((i - home) & RAM_NVM_MASK) >= ((i - hole) & RAM_NVM_MASK)) {
+      area->objects[hole] = area->objects[i];
+      memset(&area->objects[i], 0, sizeof(ram_nvm_object_t));
+      hole = i;
+    }
+    i = (i + 1) & RAM_NVM_MASK;
+  }
+}
+
+/****************************************************************************/
+/*                       EXPORTED FUNCTION DEFINITIONS                      */
+/****************************************************************************/
+
+void zpal_nvm_ram_reset(void)
+{
+  for (uint32_t a = 0; a < RAM_NVM_AREA_COUNT; a++) {
+    for (uint32_t i = 0; i < RAM_NVM_OBJECTS_PER_AREA; i++) {
+      free(m_areas[a].objects[i].data);
+    }
+  }
+  memset(m_areas, 0, sizeof(m_areas));
+  m_log_offset = 0;
+  zpal_nvm_ram_clear_stats();
+}
+
+void zpal_nvm_ram_get_stats(zpal_nvm_ram_stats_t * stats)
+{
+  *stats = m_stats;
+}
+
+void zpal_nvm_ram_clear_stats(void)
+{
+  memset(&m_stats, 0, sizeof(m_stats));
+}
+
+zpal_nvm_handle_t zpal_nvm_init(zpal_nvm_area_t area)
+{
+  if ((uint32_t)area >= RAM_NVM_AREA_COUNT) {
+    return NULL;
+  }
+  return &m_areas[area];
+}
+
+zpal_status_t zpal_nvm_close(__attribute__((unused)) zpal_nvm_handle_t handle)
+{
+  return ZPAL_STATUS_OK;
+}
+
+zpal_status_t zpal_nvm_read(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, void *object, size_t object_size)
+{
+  return zpal_nvm_read_object_part(handle, key, object, 0, object_size);
+}
+
+zpal_status_t zpal_nvm_read_object_part(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, void *object, size_t offset, size_t object_size)
+{
+  m_stats.reads++;
+  if (!handle) {
+    return ZPAL_STATUS_FAIL;
+  }
+  const ram_nvm_object_t * p_object = find_object((ram_nvm_area_t *)handle, key);
+  // Like the key-value store on the target, reading past the end of the object fails
+  if (!p_object->used || offset + object_size > p_object->size) {
+    return ZPAL_STATUS_FAIL;
+  }
+  memcpy(object, p_object->data + offset, object_size);
+  m_stats.read_bytes += (uint32_t)object_size;
+  return ZPAL_STATUS_OK;
+}
+
+zpal_status_t zpal_nvm_write(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, const void *object, size_t object_size)
+{
+  m_stats.writes++;
+  if (!handle) {
+    return ZPAL_STATUS_FAIL;
+  }
+  ram_nvm_object_t * p_object = find_object((ram_nvm_area_t *)handle, key);
+  uint8_t * data = malloc(object_size ? object_size : 1);
+  if (!data) {
+    return ZPAL_STATUS_FAIL;
+  }
+  memcpy(data, object, object_size);
+  free(p_object->data);
+  p_object->used = true;
+  p_object->key = key;
+  p_object->size = object_size;
+  p_object->data = data;
+  append_to_log(object_size);
+  return ZPAL_STATUS_OK;
+}
+
+zpal_status_t zpal_nvm_write_object_part(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, const void *object, size_t offset, size_t object_size)
+{
+  m_stats.writes++;
+  if (!handle) {
+    return ZPAL_STATUS_FAIL;
+  }
+  ram_nvm_object_t * p_object = find_object((ram_nvm_area_t *)handle, key);
+  if (!p_object->used || offset + object_size > p_object->size) {
+    return ZPAL_STATUS_FAIL;
+  }
+  memcpy(p_object->data + offset, object, object_size);
+  // The key-value store on the target rewrites the whole object
+  append_to_log(p_object->size);
+  return ZPAL_STATUS_OK;
+}
+
+zpal_status_t zpal_nvm_erase_all(zpal_nvm_handle_t handle)
+{
+  if (!handle) {
+    return ZPAL_STATUS_FAIL;
+  }
+  ram_nvm_area_t * area = (ram_nvm_area_t *)handle;
+  for (uint32_t i = 0; i < RAM_NVM_OBJECTS_PER_AREA; i++) {
+    free(area->objects[i].data);
+  }
+  memset(area, 0, sizeof(ram_nvm_area_t));
+  return ZPAL_STATUS_OK;
+}
+
+zpal_status_t zpal_nvm_erase_object(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key)
+{
+  m_stats.erases++;
+  if (!handle) {
+    return ZPAL_STATUS_FAIL;
+  }
+  ram_nvm_object_t * p_object = find_object((ram_nvm_area_t *)handle, key);
+  if (p_object->used) {
+    remove_object((ram_nvm_area_t *)handle, p_object);
+    // Deleting an object writes a deletion marker
+    append_to_log(0);
+  }
+  return ZPAL_STATUS_OK;
+}
+
+zpal_status_t zpal_nvm_get_object_size(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, size_t *len)
+{
+  m_stats.size_queries++;
+  if (!handle) {
+    return ZPAL_STATUS_FAIL;
+  }
+  const ram_nvm_object_t * p_object = find_object((ram_nvm_area_t *)handle, key);
+  if (!p_object->used) {
+    return ZPAL_STATUS_FAIL;
+  }
+  *len = p_object->size;
+  return ZPAL_STATUS_OK;
+}
+
+size_t zpal_nvm_enum_objects(zpal_nvm_handle_t handle,
+                             zpal_nvm_object_key_t *key_list,
+                             size_t key_list_size,
+                             zpal_nvm_object_key_t key_min,
+                             zpal_nvm_object_key_t key_max)
+{
+  size_t count = 0;
+  if (!handle) {
+    return 0;
+  }
+  const ram_nvm_area_t * area = (const ram_nvm_area_t *)handle;
+  for (uint32_t i = 0; i < RAM_NVM_OBJECTS_PER_AREA && count < key_list_size; i++) {
+    const ram_nvm_object_t * p_object = &area->objects[i];
+    if (p_object->used && p_object->key >= key_min && p_object->key <= key_max) {
+      key_list[count++] = p_object->key;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file zpal_nvm_ram.h
+ * @author bstewart-cae
+ * @brief This file contains a RAM backed stand-in for the zpal_nvm API, used to
+ *        run the application database on a host.
+ *
+ *        Every access is counted, and the flash wear that the accesses would
+ *        cause is estimated by appending each written object to a simulated
+ *        log-structured flash, as done by the key-value store on the target.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _ZPAL_NVM_RAM_H_
+#define _ZPAL_NVM_RAM_H_
+
+/* CPP type safety */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include "zpal_nvm.h"
+#include <stdint.h>
+
+/****************************************************************************/
+/*                      EXPORTED TYPES AND DEFINITIONS                      */
+/****************************************************************************/
+
+/// Size of a simulated flash sector, in bytes
+#if !defined(ZPAL_NVM_RAM_SECTOR_SIZE)
+#define ZPAL_NVM_RAM_SECTOR_SIZE  4096
+#endif
+
+/// Bytes of flash used by the header of every object written
+#if !defined(ZPAL_NVM_RAM_OBJECT_OVERHEAD)
+#define ZPAL_NVM_RAM_OBJECT_OVERHEAD  24
+#endif
+
+/**
+ * @brief Counters of the NVM accesses made since the last reset.
+ */
+typedef struct zpal_nvm_ram_stats_ {
+  uint32_t reads;          ///< Successful and failed reads, including partial reads
+  uint32_t read_bytes;     ///< Bytes transferred by successful reads
+  uint32_t writes;         ///< Object writes
+  uint32_t write_bytes;    ///< Bytes of flash used by the writes, headers included
+  uint32_t erases;         ///< Object erases
+  uint32_t sector_erases;  ///< Simulated flash sectors filled, each costing one erase
+  uint32_t size_queries;   ///< Object size queries
+} zpal_nvm_ram_stats_t;
+
+/****************************************************************************/
+/*                      EXPORTED FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+/**
+ * @brief Removes every stored object from every area and clears the counters.
+ */
+void zpal_nvm_ram_reset(void);
+
+/**
+ * @brief Gets the counters of the NVM accesses made since the last call to
+ *        zpal_nvm_ram_clear_stats() or zpal_nvm_ram_reset().
+ *
+ * @param[out] stats Pointer in which to return the counters
+ */
+void zpal_nvm_ram_get_stats(zpal_nvm_ram_stats_t * stats);
+
+/**
+ * @brief Clears the access counters, keeping the stored objects.
+ */
+void zpal_nvm_ram_clear_stats(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* _ZPAL_NVM_RAM_H_ */
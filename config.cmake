@@ -13,6 +13,15 @@ if (NOT ZWSDK_CONFIG_USE_SOURCES)
   # set(ZWSDK_CONFIG_USE_SOURCES "ON")
 endif()
 
+if (NOT DEFINED ZWSDK_CONFIG_OTA_DELTA)
+  # Build ZPAL without support for delta firmware update images.
+  set(ZWSDK_CONFIG_OTA_DELTA "OFF")
+  # Build ZPAL with support for delta firmware update images. The decoder uses about 10 kB of RAM.
+  # Requires ZWSDK_CONFIG_USE_SOURCES. Set ZW_OTA_DELTA_BASE to the <name>_signed.bin of the
+  # application running on the nodes to generate <name>_delta.ota.
+  # set(ZWSDK_CONFIG_OTA_DELTA "ON")
+endif()
+
 if (NOT DEFINED ZWSDK_CONFIG_REGION)
   # Set the region to build the application for.
   set(ZWSDK_CONFIG_REGION REGION_US_LR)
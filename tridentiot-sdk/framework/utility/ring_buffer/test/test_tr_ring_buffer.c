@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_tr_ring_buffer.c
+ * @brief Host tests of the block read of the ring buffer used for UART
+ *        reception.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+
+#include <unity.h>
+#include <tr_ring_buffer.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define TEST_BUFFER_SIZE  8
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static uint8_t m_buffer[TEST_BUFFER_SIZE];
+static tr_ring_buffer_t m_ring_buffer;
+static uint8_t m_next_written;
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+/// Writes a counting sequence, so every byte read can be checked.
+static void write_bytes(size_t length)
+{
+  for (size_t i = 0; i < length; i++) {
+    TEST_ASSERT_TRUE(tr_ring_buffer_write(&m_ring_buffer, m_next_written++));
+  }
+}
+
+static void assert_sequence(uint8_t first, const uint8_t * data, size_t length)
+{
+  for (size_t i = 0; i < length; i++) {
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)(first + i), data[i]);
+  }
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(m_buffer, 0, sizeof(m_buffer));
+  m_ring_buffer.p_buffer = m_buffer;
+  m_ring_buffer.buffer_size = sizeof(m_buffer);
+  TEST_ASSERT_TRUE(tr_ring_buffer_init(&m_ring_buffer));
+  m_next_written = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/****************************************************************************/
+/*                                  TESTS                                   */
+/****************************************************************************/
+
+/**
+ * A read across the end of the buffer returns the bytes in the order they
+ * were written.
+ */
+void test_tr_ring_buffer_read_wraps_around(void)
+{
+  uint8_t data[TEST_BUFFER_SIZE];
+
+  write_bytes(6);
+  TEST_ASSERT_EQUAL_size_t(5, tr_ring_buffer_read(&m_ring_buffer, data, 5));
+  assert_sequence(0, data, 5);
+
+  // The head wraps, leaving 3 bytes before and 4 bytes after the end of the buffer
+  write_bytes(6);
+  TEST_ASSERT_EQUAL_size_t(7, tr_ring_buffer_get_available(&m_ring_buffer));
+
+  memset(data, 0, sizeof(data));
+  TEST_ASSERT_EQUAL_size_t(7, tr_ring_buffer_read(&m_ring_buffer, data, 7));
+  assert_sequence(5, data, 7);
+  TEST_ASSERT_EQUAL_size_t(0, tr_ring_buffer_get_available(&m_ring_buffer));
+
+  // The tail continues after the wrap-around
+  write_bytes(2);
+  TEST_ASSERT_EQUAL_size_t(2, tr_ring_buffer_read(&m_ring_buffer, data, sizeof(data)));
+  assert_sequence(12, data, 2);
+}
+
+/**
+ * A read that ends exactly at the end of the buffer moves the tail to the
+ * start of the buffer.
+ */
+void test_tr_ring_buffer_read_to_end_of_buffer(void)
+{
+  uint8_t data[TEST_BUFFER_SIZE];
+
+  write_bytes(TEST_BUFFER_SIZE);
+  TEST_ASSERT_FALSE(tr_ring_buffer_write(&m_ring_buffer, 0xFF));
+  TEST_ASSERT_EQUAL_size_t(TEST_BUFFER_SIZE, tr_ring_buffer_read(&m_ring_buffer, data, sizeof(data)));
+  assert_sequence(0, data, TEST_BUFFER_SIZE);
+  TEST_ASSERT_EQUAL_size_t(0, m_ring_buffer.tail);
+
+  write_bytes(3);
+  TEST_ASSERT_EQUAL_size_t(3, tr_ring_buffer_read(&m_ring_buffer, data, 3));
+  assert_sequence(TEST_BUFFER_SIZE, data, 3);
+}
+
+/**
+ * A read of more bytes than are available returns only the available bytes
+ * and leaves the rest of the destination untouched.
+ */
+void test_tr_ring_buffer_read_more_than_available(void)
+{
+  uint8_t data[TEST_BUFFER_SIZE];
+
+  write_bytes(7);
+  TEST_ASSERT_EQUAL_size_t(4, tr_ring_buffer_read(&m_ring_buffer, data, 4));
+  write_bytes(2);
+
+  memset(data, 0xAA, sizeof(data));
+  TEST_ASSERT_EQUAL_size_t(5, tr_ring_buffer_read(&m_ring_buffer, data, sizeof(data)));
+  assert_sequence(4, data, 5);
+  TEST_ASSERT_EQUAL_UINT8(0xAA, data[5]);
+
+  TEST_ASSERT_EQUAL_size_t(0, tr_ring_buffer_read(&m_ring_buffer, data, sizeof(data)));
+}
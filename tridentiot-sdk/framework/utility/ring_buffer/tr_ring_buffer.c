@@ -3,17 +3,13 @@
  * SPDX-FileCopyrightText: 2024 Trident IoT, LLC <https://www.tridentiot.com>
  */
 #include "tr_ring_buffer.h"
+#include <string.h>
 
 static bool ring_buffer_is_full(tr_ring_buffer_t *p_rb) 
 {
   return (p_rb->count == p_rb->buffer_size);
 }
 
-static bool ring_buffer_is_empty(tr_ring_buffer_t *p_rb) 
-{
-  return (0 == p_rb->count);
-}
-
 bool tr_ring_buffer_init(tr_ring_buffer_t *p_rb) 
 {
   if (NULL == p_rb)
@@ -47,17 +43,19 @@ bool tr_ring_buffer_write(tr_ring_buffer_t *p_rb, uint8_t data)
 
 size_t tr_ring_buffer_read(tr_ring_buffer_t *p_rb, uint8_t *p_data, size_t length) 
 {
-  size_t count = 0;
-  for (; count < length; count++)
+  size_t count = (length < p_rb->count) ? length : p_rb->count;
+
+  // The data is copied in at most two blocks, before and after the wrap-around.
+  size_t first = p_rb->buffer_size - p_rb->tail;
+  if (first > count)
   {
-    if (ring_buffer_is_empty(p_rb)) {
-     // Handle underflow here.
-     break;
-    }    
-    p_data[count] = p_rb->p_buffer[p_rb->tail];
-    p_rb->tail = (p_rb->tail + 1) % p_rb->buffer_size;
-    p_rb->count--;
+    first = count;
   }
+  memcpy(p_data, &p_rb->p_buffer[p_rb->tail], first);
+  memcpy(&p_data[first], p_rb->p_buffer, count - first);
+
+  p_rb->tail = (p_rb->tail + count) % p_rb->buffer_size;
+  p_rb->count -= count;
   return count;
 }
 
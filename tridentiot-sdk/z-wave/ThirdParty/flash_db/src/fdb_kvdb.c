@@ -46,6 +46,11 @@
 #define FDB_GC_EMPTY_SEC_THRESHOLD                1
 #endif
 
+/* the total remain empty sector number at or below which the GC step collects the dirty sectors */
+#ifndef FDB_GC_STEP_EMPTY_SEC_WATERMARK
+#define FDB_GC_STEP_EMPTY_SEC_WATERMARK           (FDB_GC_EMPTY_SEC_THRESHOLD + 1)
+#endif
+
 /* the string KV value buffer size for legacy fdb_get_kv(db, ) function */
 #ifndef FDB_STR_KV_VALUE_MAX_SIZE
 #define FDB_STR_KV_VALUE_MAX_SIZE                128
@@ -78,6 +83,7 @@
 #define KV_MAGIC_OFFSET                          ((unsigned long)(&((struct kv_hdr_data *)0)->magic))
 #define KV_LEN_OFFSET                            ((unsigned long)(&((struct kv_hdr_data *)0)->len))
 #define KV_NAME_LEN_OFFSET                       ((unsigned long)(&((struct kv_hdr_data *)0)->name_len))
+#define KV_CRC32_OFFSET                          ((unsigned long)(&((struct kv_hdr_data *)0)->crc32))
 
 #define db_name(db)                              (((fdb_db_t)db)->name)
 #define db_init_ok(db)                           (((fdb_db_t)db)->init_ok)
@@ -140,6 +146,14 @@ struct gc_cb_args {
     uint32_t traversed_len;
 };
 
+/* the value of a new KV which is copied from a saved KV with a part of it replaced */
+struct kv_patch {
+    uint32_t saved_addr;                         /**< value address of the saved KV */
+    size_t offset;                               /**< offset of the replaced part in the value */
+    const uint8_t *buf;                          /**< new data of the replaced part */
+    size_t len;                                  /**< length of the replaced part */
+};
+
 static void gc_collect(fdb_kvdb_t db);
 static void gc_collect_by_free_size(fdb_kvdb_t db, size_t free_size);
 
@@ -200,44 +214,81 @@ static void update_sector_status_store_cache(fdb_kvdb_t db, uint32_t sec_addr, f
     }
 }
 
-static void update_kv_cache(fdb_kvdb_t db, const char *name, size_t name_len, uint32_t addr)
+/*
+ * The KV cache is an open addressing hash table. A KV is cached in one of the
+ * FDB_KV_CACHE_PROBE_MAX nodes starting at the node selected by its name CRC.
+ * When all of them are used, the least recently used one is replaced.
+ */
+static size_t kv_cache_probe_num(fdb_kvdb_t db)
 {
-    size_t i, empty_index = FDB_KV_CACHE_TABLE_SIZE, min_activity_index = FDB_KV_CACHE_TABLE_SIZE;
-    uint16_t name_crc = (uint16_t) (fdb_calc_crc32(0, name, name_len) >> 16), min_activity = 0xFFFF;
+    return db->kv_cache.num < FDB_KV_CACHE_PROBE_MAX ? db->kv_cache.num : FDB_KV_CACHE_PROBE_MAX;
+}
 
-    for (i = 0; i < FDB_KV_CACHE_TABLE_SIZE; i++) {
-        if (addr != FDB_DATA_UNUSED) {
-            /* update the KV address in cache */
-            if (db->kv_cache_table[i].name_crc == name_crc) {
-                db->kv_cache_table[i].addr = addr;
-                return;
-            } else if ((db->kv_cache_table[i].addr == FDB_DATA_UNUSED) && (empty_index == FDB_KV_CACHE_TABLE_SIZE)) {
-                empty_index = i;
-            } else if (db->kv_cache_table[i].addr != FDB_DATA_UNUSED) {
-                if (db->kv_cache_table[i].active > 0) {
-                    db->kv_cache_table[i].active--;
-                }
-                if (db->kv_cache_table[i].active < min_activity) {
-                    min_activity_index = i;
-                    min_activity = db->kv_cache_table[i].active;
-                }
+/*
+ * Advance the KV cache access time. The node access times never pass the current
+ * time, so before it overflows all of them are halved, which keeps their order.
+ */
+static uint16_t kv_cache_next_time(fdb_kvdb_t db)
+{
+    size_t i;
+
+    if (db->kv_cache_time == UINT16_MAX) {
+        for (i = 0; i < db->kv_cache.num; i++) {
+            db->kv_cache.nodes[i].active >>= 1;
+        }
+        db->kv_cache_time >>= 1;
+    }
+
+    return ++db->kv_cache_time;
+}
+
+static void clear_kv_cache(fdb_kvdb_t db)
+{
+    size_t i;
+
+    for (i = 0; i < db->kv_cache.num; i++) {
+        db->kv_cache.nodes[i].addr = FDB_DATA_UNUSED;
+    }
+}
+
+static void update_kv_cache(fdb_kvdb_t db, const char *name, size_t name_len, uint32_t addr)
+{
+    size_t i, index, probe_num = kv_cache_probe_num(db);
+    size_t empty_index = db->kv_cache.num, lru_index = db->kv_cache.num;
+    uint16_t name_crc = (uint16_t) (fdb_calc_crc32(0, name, name_len) >> 16), age, lru_age = 0;
+    kv_cache_node_t node;
+
+    for (i = 0; i < probe_num; i++) {
+        index = (name_crc + i) % db->kv_cache.num;
+        node = &db->kv_cache.nodes[index];
+        if (node->addr == FDB_DATA_UNUSED) {
+            if (empty_index == db->kv_cache.num) {
+                empty_index = index;
             }
-        } else if (db->kv_cache_table[i].name_crc == name_crc) {
-            /* delete the KV */
-            db->kv_cache_table[i].addr = FDB_DATA_UNUSED;
-            db->kv_cache_table[i].active = 0;
+        } else if (node->name_crc == name_crc) {
+            /* update the KV address in cache, or delete the KV */
+            node->addr = addr;
             return;
+        } else {
+            age = (uint16_t) (db->kv_cache_time - node->active);
+            if (lru_index == db->kv_cache.num || age > lru_age) {
+                lru_index = index;
+                lru_age = age;
+            }
         }
     }
-    /* add the KV to cache, using LRU (Least Recently Used) like algorithm */
-    if (empty_index < FDB_KV_CACHE_TABLE_SIZE) {
-        db->kv_cache_table[empty_index].addr = addr;
-        db->kv_cache_table[empty_index].name_crc = name_crc;
-        db->kv_cache_table[empty_index].active = FDB_KV_CACHE_TABLE_SIZE;
-    } else if (min_activity_index < FDB_KV_CACHE_TABLE_SIZE) {
-        db->kv_cache_table[min_activity_index].addr = addr;
-        db->kv_cache_table[min_activity_index].name_crc = name_crc;
-        db->kv_cache_table[min_activity_index].active = FDB_KV_CACHE_TABLE_SIZE;
+    if (addr == FDB_DATA_UNUSED) {
+        return;
+    }
+    /* add the KV to cache, using LRU (Least Recently Used) algorithm */
+    if (empty_index == db->kv_cache.num && lru_index < db->kv_cache.num) {
+        empty_index = lru_index;
+        db->kv_cache_stats.evictions++;
+    }
+    if (empty_index < db->kv_cache.num) {
+        db->kv_cache.nodes[empty_index].addr = addr;
+        db->kv_cache.nodes[empty_index].name_crc = name_crc;
+        db->kv_cache.nodes[empty_index].active = kv_cache_next_time(db);
     }
 }
 
@@ -246,25 +297,25 @@ static void update_kv_cache(fdb_kvdb_t db, const char *name, size_t name_len, ui
  */
 static bool get_kv_from_cache(fdb_kvdb_t db, const char *name, size_t name_len, uint32_t *addr)
 {
-    size_t i;
+    size_t i, probe_num = kv_cache_probe_num(db);
     uint16_t name_crc = (uint16_t) (fdb_calc_crc32(0, name, name_len) >> 16);
+    kv_cache_node_t node;
 
-    for (i = 0; i < FDB_KV_CACHE_TABLE_SIZE; i++) {
-        if ((db->kv_cache_table[i].addr != FDB_DATA_UNUSED) && (db->kv_cache_table[i].name_crc == name_crc)) {
+    for (i = 0; i < probe_num; i++) {
+        node = &db->kv_cache.nodes[(name_crc + i) % db->kv_cache.num];
+        if ((node->addr != FDB_DATA_UNUSED) && (node->name_crc == name_crc)) {
             char saved_name[FDB_KV_NAME_MAX] = { 0 };
             /* read the KV name in flash */
-            _fdb_flash_read((fdb_db_t)db, db->kv_cache_table[i].addr + KV_HDR_DATA_SIZE, (uint32_t *) saved_name, FDB_KV_NAME_MAX);
+            _fdb_flash_read((fdb_db_t)db, node->addr + KV_HDR_DATA_SIZE, (uint32_t *) saved_name, FDB_KV_NAME_MAX);
             if (!strncmp(name, saved_name, name_len)) {
-                *addr = db->kv_cache_table[i].addr;
-                if (db->kv_cache_table[i].active >= 0xFFFF - FDB_KV_CACHE_TABLE_SIZE) {
-                    db->kv_cache_table[i].active = 0xFFFF;
-                } else {
-                    db->kv_cache_table[i].active += FDB_KV_CACHE_TABLE_SIZE;
-                }
+                *addr = node->addr;
+                node->active = kv_cache_next_time(db);
+                db->kv_cache_stats.hits++;
                 return true;
             }
         }
     }
+    db->kv_cache_stats.misses++;
 
     return false;
 }
@@ -1164,6 +1215,129 @@ static void gc_collect(fdb_kvdb_t db)
     gc_collect_by_free_size(db, db_max_size(db));
 }
 
+static bool gc_step_find_cb(kv_sec_info_t sector, void *arg1, void *arg2)
+{
+    uint32_t *gc_sec = arg1, *dirty_sec = arg2;
+
+    if (!sector->check_ok) {
+        return false;
+    }
+    /* continue the sector which is already in GC first */
+    if (sector->status.dirty == FDB_SECTOR_DIRTY_GC) {
+        *gc_sec = sector->addr;
+        return true;
+    }
+    /* otherwise the oldest dirty sector, as the GC on write does */
+    if (*dirty_sec == FAILED_ADDR && sector->status.dirty == FDB_SECTOR_DIRTY_TRUE) {
+        *dirty_sec = sector->addr;
+    }
+
+    return false;
+}
+
+/**
+ * Run one step of the incremental GC.
+ *
+ * The GC normally runs when a KV is written and there is no space for it, so the
+ * writer waits until all KVs of the collected sectors are moved. This function does
+ * the same work in small steps, e.g. when the system is idle. Each call moves at most
+ * max_moves KVs out of the sector which is being collected, and formats the sector once
+ * all of them are moved. A new sector is only collected when the number of empty sectors
+ * is at or below FDB_GC_STEP_EMPTY_SEC_WATERMARK, which is before a write has to GC.
+ *
+ * The sector status is saved in flash, so the GC is resumed after a power loss.
+ *
+ * @param db database object
+ * @param max_moves the maximum number of KVs moved by this step
+ *
+ * @return true when garbage was collected and the function should be called again,
+ *         false when there is nothing to collect
+ */
+bool fdb_kv_gc_step(fdb_kvdb_t db, size_t max_moves)
+{
+    struct kvdb_sec_info sector, alloc_sec;
+    struct fdb_kv kv;
+    size_t empty_sec = 0, moves = 0;
+    uint32_t gc_sec = FAILED_ADDR, dirty_sec = FAILED_ADDR;
+    bool collected = false, moved_all = true, gc_request, no_space = false;
+
+    if (!db_init_ok(db)) {
+        FDB_INFO("Error: KV (%s) isn't initialize OK.\n", db_name(db));
+        return false;
+    }
+
+    /* lock the KV cache */
+    db_lock(db);
+
+    sector_iterator(db, &sector, FDB_SECTOR_STORE_EMPTY, &empty_sec, NULL, gc_check_cb, false);
+    sector_iterator(db, &sector, FDB_SECTOR_STORE_UNUSED, &gc_sec, &dirty_sec, gc_step_find_cb, false);
+    if (gc_sec == FAILED_ADDR && empty_sec <= FDB_GC_STEP_EMPTY_SEC_WATERMARK) {
+        gc_sec = dirty_sec;
+    }
+
+    if (gc_sec != FAILED_ADDR && read_sector_info(db, gc_sec, &sector, false) == FDB_NO_ERR) {
+        /* same as a GC on write: the moved KVs go to the empty sectors, but not to the dirty ones */
+        gc_request = db->gc_request;
+        db->gc_request = true;
+        kv.addr.start = sector.addr + SECTOR_HDR_DATA_SIZE;
+        do {
+            read_kv(db, &kv);
+            if (kv.crc_is_ok && (kv.status == FDB_KV_WRITE || kv.status == FDB_KV_PRE_DELETE)) {
+                if (moves == max_moves) {
+                    moved_all = false;
+                    break;
+                }
+                /* the move must not take the last empty sectors, which are kept for the GC on write */
+                if (alloc_kv(db, &alloc_sec, kv.len) == FAILED_ADDR || (alloc_sec.status.store == FDB_SECTOR_STORE_EMPTY
+                        && empty_sec <= FDB_GC_EMPTY_SEC_THRESHOLD)) {
+                    moved_all = false;
+                    no_space = true;
+                    break;
+                }
+                if (alloc_sec.status.store == FDB_SECTOR_STORE_EMPTY) {
+                    empty_sec--;
+                }
+                if (sector.status.dirty == FDB_SECTOR_DIRTY_TRUE) {
+                    uint8_t status_table[FDB_DIRTY_STATUS_TABLE_SIZE];
+                    /* change the sector status to GC */
+                    _fdb_write_status((fdb_db_t)db, sector.addr + SECTOR_DIRTY_OFFSET, status_table, FDB_SECTOR_DIRTY_STATUS_NUM, FDB_SECTOR_DIRTY_GC, true);
+                    sector.status.dirty = FDB_SECTOR_DIRTY_GC;
+#ifdef FDB_KV_USING_CACHE
+                    {
+                        /* the next step must find the sector in GC, which is read from the cache */
+                        kv_sec_info_t sector_cache = get_sector_from_cache(db, sector.addr);
+                        if (sector_cache) {
+                            sector_cache->status.dirty = FDB_SECTOR_DIRTY_GC;
+                        }
+                    }
+#endif /* FDB_KV_USING_CACHE */
+                }
+                if (move_kv(db, &kv) != FDB_NO_ERR) {
+                    FDB_INFO("Error: Moved the KV (%.*s) for GC step failed.\n", kv.name_len, kv.name);
+                    moved_all = false;
+                    break;
+                }
+                moves++;
+            }
+        } while ((kv.addr.start = get_next_kv_addr(db, &sector, &kv)) != FAILED_ADDR);
+        /* keep a request made before the step, and request a GC as alloc_kv does when there was no space */
+        db->gc_request = gc_request || no_space;
+
+        if (moved_all) {
+            format_sector(db, sector.addr, SECTOR_NOT_COMBINED);
+            FDB_DEBUG("Collect a sector @0x%08" PRIX32 " by GC step\n", sector.addr);
+            /* update oldest_addr for next GC sector format */
+            db_oldest_addr(db) = get_next_sector_addr(db, &sector, 0);
+        }
+        collected = moved_all || moves > 0;
+    }
+
+    /* unlock the KV cache */
+    db_unlock(db);
+
+    return collected;
+}
+
 static fdb_err_t align_write(fdb_kvdb_t db, uint32_t addr, const uint32_t *buf, size_t size)
 {
     fdb_err_t result = FDB_NO_ERR;
@@ -1191,7 +1365,76 @@ static fdb_err_t align_write(fdb_kvdb_t db, uint32_t addr, const uint32_t *buf,
     return result;
 }
 
-static fdb_err_t create_kv_blob(fdb_kvdb_t db, kv_sec_info_t sector, const char *key, const void *value, size_t len)
+/*
+ * Read a part of a patched value: the saved value with the replaced part on top of it.
+ * The size must not exceed 32 bytes.
+ */
+static void read_kv_patch(fdb_kvdb_t db, const struct kv_patch *patch, size_t offset, uint8_t *buf, size_t size)
+{
+    size_t start = offset > patch->offset ? offset : patch->offset;
+    size_t end = offset + size < patch->offset + patch->len ? offset + size : patch->offset + patch->len;
+
+    _fdb_flash_read((fdb_db_t)db, patch->saved_addr + offset, (uint32_t *) buf, FDB_WG_ALIGN(size));
+    if (start < end) {
+        memcpy(buf + (start - offset), patch->buf + (start - patch->offset), end - start);
+    }
+}
+
+/*
+ * CRC32(header.name_len + header.value_len + name + value) as stored in the KV header,
+ * using sizeof(uint32_t) for compatible V1.x. The value is taken from the patch if it is not NULL.
+ */
+static uint32_t calc_kv_crc32(fdb_kvdb_t db, const struct kv_hdr_data *kv_hdr, const char *key, const void *value,
+        const struct kv_patch *patch)
+{
+    uint8_t ff = FDB_BYTE_ERASED, buf[32];
+    uint32_t crc32 = 0;
+    size_t align_remain, len, size;
+
+    crc32 = fdb_calc_crc32(crc32, &kv_hdr->name_len, sizeof(uint32_t));
+    crc32 = fdb_calc_crc32(crc32, &kv_hdr->value_len, sizeof(uint32_t));
+    crc32 = fdb_calc_crc32(crc32, key, kv_hdr->name_len);
+    align_remain = FDB_WG_ALIGN(kv_hdr->name_len) - kv_hdr->name_len;
+    while (align_remain--) {
+        crc32 = fdb_calc_crc32(crc32, &ff, 1);
+    }
+    if (patch) {
+        for (len = 0; len < kv_hdr->value_len; len += size) {
+            size = kv_hdr->value_len - len < sizeof(buf) ? kv_hdr->value_len - len : sizeof(buf);
+            read_kv_patch(db, patch, len, buf, size);
+            crc32 = fdb_calc_crc32(crc32, buf, size);
+        }
+    } else {
+        crc32 = fdb_calc_crc32(crc32, value, kv_hdr->value_len);
+    }
+    align_remain = FDB_WG_ALIGN(kv_hdr->value_len) - kv_hdr->value_len;
+    while (align_remain--) {
+        crc32 = fdb_calc_crc32(crc32, &ff, 1);
+    }
+
+    return crc32;
+}
+
+static fdb_err_t write_kv_patch(fdb_kvdb_t db, uint32_t addr, const struct kv_patch *patch, size_t value_len)
+{
+    fdb_err_t result = FDB_NO_ERR;
+    uint8_t buf[32];
+    size_t len, size;
+
+    for (len = 0; len < value_len && result == FDB_NO_ERR; len += size) {
+        size = value_len - len < sizeof(buf) ? value_len - len : sizeof(buf);
+        read_kv_patch(db, patch, len, buf, size);
+        result = align_write(db, addr + len, (uint32_t *) buf, size);
+    }
+
+    return result;
+}
+
+/*
+ * Create a KV. Its value is taken from the patch if it is not NULL.
+ */
+static fdb_err_t create_kv(fdb_kvdb_t db, kv_sec_info_t sector, const char *key, const void *value, size_t len,
+        const struct kv_patch *patch)
 {
     fdb_err_t result = FDB_NO_ERR;
     struct kv_hdr_data kv_hdr;
@@ -1215,28 +1458,12 @@ static fdb_err_t create_kv_blob(fdb_kvdb_t db, kv_sec_info_t sector, const char
     }
 
     if (kv_addr != FAILED_ADDR || (kv_addr = new_kv(db, sector, kv_hdr.len)) != FAILED_ADDR) {
-        size_t align_remain;
         /* update the sector status */
         if (result == FDB_NO_ERR) {
             result = update_sec_status(db, sector, kv_hdr.len, &is_full);
         }
         if (result == FDB_NO_ERR) {
-            uint8_t ff = FDB_BYTE_ERASED;
-            /* start calculate CRC32 */
-            kv_hdr.crc32 = 0;
-            /* CRC32(header.name_len + header.value_len + name + value), using sizeof(uint32_t) for compatible V1.x */
-            kv_hdr.crc32 = fdb_calc_crc32(kv_hdr.crc32, &kv_hdr.name_len, sizeof(uint32_t));
-            kv_hdr.crc32 = fdb_calc_crc32(kv_hdr.crc32, &kv_hdr.value_len, sizeof(uint32_t));
-            kv_hdr.crc32 = fdb_calc_crc32(kv_hdr.crc32, key, kv_hdr.name_len);
-            align_remain = FDB_WG_ALIGN(kv_hdr.name_len) - kv_hdr.name_len;
-            while (align_remain--) {
-                kv_hdr.crc32 = fdb_calc_crc32(kv_hdr.crc32, &ff, 1);
-            }
-            kv_hdr.crc32 = fdb_calc_crc32(kv_hdr.crc32, value, kv_hdr.value_len);
-            align_remain = FDB_WG_ALIGN(kv_hdr.value_len) - kv_hdr.value_len;
-            while (align_remain--) {
-                kv_hdr.crc32 = fdb_calc_crc32(kv_hdr.crc32, &ff, 1);
-            }
+            kv_hdr.crc32 = calc_kv_crc32(db, &kv_hdr, key, value, patch);
             /* write KV header data */
             result = write_kv_hdr(db, kv_addr, &kv_hdr);
         }
@@ -1253,7 +1480,10 @@ static fdb_err_t create_kv_blob(fdb_kvdb_t db, kv_sec_info_t sector, const char
 #endif /* FDB_KV_USING_CACHE */
         }
         /* write value */
-        if (result == FDB_NO_ERR) {
+        if (result == FDB_NO_ERR && patch) {
+            result = write_kv_patch(db, kv_addr + KV_HDR_DATA_SIZE + FDB_WG_ALIGN(kv_hdr.name_len), patch,
+                    kv_hdr.value_len);
+        } else if (result == FDB_NO_ERR) {
             result = align_write(db, kv_addr + KV_HDR_DATA_SIZE + FDB_WG_ALIGN(kv_hdr.name_len), value,
                     kv_hdr.value_len);
         }
@@ -1274,6 +1504,11 @@ static fdb_err_t create_kv_blob(fdb_kvdb_t db, kv_sec_info_t sector, const char
     return result;
 }
 
+static fdb_err_t create_kv_blob(fdb_kvdb_t db, kv_sec_info_t sector, const char *key, const void *value, size_t len)
+{
+    return create_kv(db, sector, key, value, len, NULL);
+}
+
 /**
  * Delete an KV.
  *
@@ -1366,6 +1601,232 @@ fdb_err_t fdb_kv_set_blob(fdb_kvdb_t db, const char *key, fdb_blob_t blob)
     return result;
 }
 
+/*
+ * Compare data in flash with data in RAM.
+ */
+static bool kv_data_is_equal(fdb_kvdb_t db, uint32_t addr, const void *buf, size_t len)
+{
+    uint8_t saved[32];
+    size_t cmp_len, size;
+
+    for (cmp_len = 0; cmp_len < len; cmp_len += size) {
+        size = len - cmp_len < sizeof(saved) ? len - cmp_len : sizeof(saved);
+        _fdb_flash_read((fdb_db_t)db, addr + cmp_len, (uint32_t *) saved, FDB_WG_ALIGN(size));
+        if (memcmp(saved, (const uint8_t *) buf + cmp_len, size) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Check whether a found KV already holds the value. The CRC32 stored in the KV header
+ * serves as content hash, so a changed value is normally detected without reading it.
+ * Only on a matching CRC32 the stored value is compared to rule out a collision.
+ */
+static bool kv_value_is_equal(fdb_kvdb_t db, fdb_kv_t kv, const char *key, const void *value_buf, size_t buf_len)
+{
+    struct kv_hdr_data kv_hdr;
+    uint32_t saved_crc32;
+
+    if (!kv->crc_is_ok || kv->value_len != buf_len) {
+        return false;
+    }
+
+    memset(&kv_hdr, FDB_BYTE_ERASED, sizeof(struct kv_hdr_data));
+    kv_hdr.name_len = kv->name_len;
+    kv_hdr.value_len = kv->value_len;
+    _fdb_flash_read((fdb_db_t)db, kv->addr.start + KV_CRC32_OFFSET, &saved_crc32, sizeof(saved_crc32));
+    if (saved_crc32 != calc_kv_crc32(db, &kv_hdr, key, value_buf, NULL)) {
+        return false;
+    }
+
+    return kv_data_is_equal(db, kv->addr.value, value_buf, buf_len);
+}
+
+/*
+ * Check whether a found KV is no longer stored at its address, e.g. because a GC moved it.
+ */
+static bool kv_is_moved(fdb_kvdb_t db, fdb_kv_t kv)
+{
+    struct kv_hdr_data kv_hdr;
+    char name[FDB_WG_ALIGN(FDB_KV_NAME_MAX)];
+
+    _fdb_flash_read((fdb_db_t)db, kv->addr.start, (uint32_t *)&kv_hdr, sizeof(struct kv_hdr_data));
+    if (_fdb_get_status(kv_hdr.status_table, FDB_KV_STATUS_NUM) != FDB_KV_WRITE || kv_hdr.name_len != kv->name_len) {
+        return true;
+    }
+    _fdb_flash_read((fdb_db_t)db, kv->addr.start + KV_HDR_DATA_SIZE, (uint32_t *) name, FDB_WG_ALIGN(kv->name_len));
+
+    return memcmp(name, kv->name, kv->name_len) != 0;
+}
+
+/*
+ * Same as set_kv(), but the KV is looked up only once. The found KV
+ * is used both for the comparison and as the old KV to delete.
+ */
+static fdb_err_t set_kv_if_changed(fdb_kvdb_t db, const char *key, const void *value_buf, size_t buf_len,
+        bool *changed)
+{
+    fdb_err_t result = FDB_NO_ERR;
+    bool kv_is_found;
+
+    *changed = false;
+    if (value_buf == NULL) {
+        result = del_kv(db, key, NULL, true);
+        *changed = (result == FDB_NO_ERR);
+        return result;
+    }
+
+    kv_is_found = find_kv(db, key, &db->cur_kv);
+    if (kv_is_found && kv_value_is_equal(db, &db->cur_kv, key, value_buf, buf_len)) {
+        return FDB_NO_ERR;
+    }
+
+    /* make sure the flash has enough space */
+    if (new_kv_ex(db, &db->cur_sector, strlen(key), buf_len) == FAILED_ADDR) {
+        return FDB_SAVED_FULL;
+    }
+    /* a GC on the way has moved the found KV */
+    if (kv_is_found && kv_is_moved(db, &db->cur_kv)) {
+        kv_is_found = find_kv(db, key, &db->cur_kv);
+    }
+    /* prepare to delete the old KV */
+    if (kv_is_found) {
+        result = del_kv(db, key, &db->cur_kv, false);
+    }
+    /* create the new KV */
+    if (result == FDB_NO_ERR) {
+        result = create_kv_blob(db, &db->cur_sector, key, value_buf, buf_len);
+    }
+    /* delete the old KV */
+    if (kv_is_found && result == FDB_NO_ERR) {
+        result = del_kv(db, key, &db->cur_kv, true);
+    }
+    *changed = (result == FDB_NO_ERR);
+    /* process the GC after set KV */
+    if (db->gc_request) {
+        gc_collect_by_free_size(db, KV_HDR_DATA_SIZE + FDB_WG_ALIGN(strlen(key)) + FDB_WG_ALIGN(buf_len));
+    }
+
+    return result;
+}
+
+/**
+ * Set a blob KV only when it differs from the saved value. If it blob value is NULL, delete it.
+ * If not find it in flash, then create it.
+ *
+ * @param db database object
+ * @param key KV name
+ * @param blob blob object
+ * @param changed true when the KV has been written, can be NULL
+ *
+ * @return result
+ */
+fdb_err_t fdb_kv_set_blob_if_changed(fdb_kvdb_t db, const char *key, fdb_blob_t blob, bool *changed)
+{
+    fdb_err_t result = FDB_NO_ERR;
+    bool written = false;
+
+    if (!db_init_ok(db)) {
+        FDB_INFO("Error: KV (%s) isn't initialize OK.\n", db_name(db));
+        return FDB_INIT_FAILED;
+    }
+
+    /* lock the KV cache */
+    db_lock(db);
+
+    result = set_kv_if_changed(db, key, blob->buf, blob->size, &written);
+
+    /* unlock the KV cache */
+    db_unlock(db);
+
+    if (changed) {
+        *changed = written;
+    }
+
+    return result;
+}
+
+/*
+ * Replace a part of the value of a saved KV. The new KV is written from the saved KV with the
+ * part on top of it, so the whole value is never held in RAM.
+ */
+static fdb_err_t set_kv_part(fdb_kvdb_t db, const char *key, size_t offset, const void *part_buf, size_t part_len)
+{
+    fdb_err_t result = FDB_NO_ERR;
+    struct kv_patch patch = { 0, offset, part_buf, part_len };
+    size_t value_len;
+
+    if (!find_kv(db, key, &db->cur_kv)) {
+        return FDB_KV_NAME_ERR;
+    }
+    value_len = db->cur_kv.value_len;
+    if (offset > value_len || part_len > value_len - offset) {
+        FDB_INFO("Error: The part exceeds the KV (%s) value.\n", key);
+        return FDB_WRITE_ERR;
+    }
+    /* the part is already saved */
+    if (kv_data_is_equal(db, db->cur_kv.addr.value + offset, part_buf, part_len)) {
+        return FDB_NO_ERR;
+    }
+
+    /* make sure the flash has enough space */
+    if (new_kv_ex(db, &db->cur_sector, strlen(key), value_len) == FAILED_ADDR) {
+        return FDB_SAVED_FULL;
+    }
+    /* a GC on the way has moved the saved KV */
+    if (kv_is_moved(db, &db->cur_kv) && !find_kv(db, key, &db->cur_kv)) {
+        return FDB_KV_NAME_ERR;
+    }
+    patch.saved_addr = db->cur_kv.addr.value;
+    /* the saved KV stays readable until the new KV is complete */
+    result = del_kv(db, key, &db->cur_kv, false);
+    if (result == FDB_NO_ERR) {
+        result = create_kv(db, &db->cur_sector, key, NULL, value_len, &patch);
+    }
+    if (result == FDB_NO_ERR) {
+        result = del_kv(db, key, &db->cur_kv, true);
+    }
+    /* process the GC after set KV */
+    if (db->gc_request) {
+        gc_collect_by_free_size(db, KV_HDR_DATA_SIZE + FDB_WG_ALIGN(strlen(key)) + FDB_WG_ALIGN(value_len));
+    }
+
+    return result;
+}
+
+/**
+ * Replace a part of the value of a saved blob KV. The size of the value does not change.
+ *
+ * @param db database object
+ * @param key KV name
+ * @param offset offset of the part in the value
+ * @param blob blob object with the new data of the part
+ *
+ * @return result, FDB_KV_NAME_ERR if the KV is not found, FDB_WRITE_ERR if the part exceeds the value
+ */
+fdb_err_t fdb_kv_set_blob_part(fdb_kvdb_t db, const char *key, size_t offset, fdb_blob_t blob)
+{
+    fdb_err_t result = FDB_NO_ERR;
+
+    if (!db_init_ok(db)) {
+        FDB_INFO("Error: KV (%s) isn't initialize OK.\n", db_name(db));
+        return FDB_INIT_FAILED;
+    }
+
+    /* lock the KV cache */
+    db_lock(db);
+
+    result = set_kv_part(db, key, offset, blob->buf, blob->size);
+
+    /* unlock the KV cache */
+    db_unlock(db);
+
+    return result;
+}
+
 /**
  * Set a string KV. If it value is NULL, delete it.
  * If not find it in flash, then create it.
@@ -1399,9 +1860,7 @@ fdb_err_t fdb_kv_set_default(fdb_kvdb_t db)
     db_lock(db);
 
 #ifdef FDB_KV_USING_CACHE
-    for (i = 0; i < FDB_KV_CACHE_TABLE_SIZE; i++) {
-        db->kv_cache_table[i].addr = FDB_DATA_UNUSED;
-    }
+    clear_kv_cache(db);
 #endif /* FDB_KV_USING_CACHE */
 
     /* format all sectors */
@@ -1729,6 +2188,21 @@ void fdb_kvdb_control(fdb_kvdb_t db, int cmd, void *arg)
         FDB_ASSERT(db->parent.init_ok == false);
         db->parent.not_formatable = *(bool *)arg;
         break;
+    case FDB_KVDB_CTRL_SET_KV_CACHE:
+#ifdef FDB_KV_USING_CACHE
+        /* this change MUST before database initialization */
+        FDB_ASSERT(db->parent.init_ok == false);
+        FDB_ASSERT(((struct fdb_kv_cache_table *)arg)->num <= 0xFFFF);
+        db->kv_cache = *(struct fdb_kv_cache_table *)arg;
+#endif
+        break;
+    case FDB_KVDB_CTRL_GET_KV_CACHE_STATS:
+#ifdef FDB_KV_USING_CACHE
+        *(struct fdb_kv_cache_stats *)arg = db->kv_cache_stats;
+#else
+        memset(arg, 0, sizeof(struct fdb_kv_cache_stats));
+#endif
+        break;
     }
 }
 
@@ -1792,9 +2266,15 @@ fdb_err_t fdb_kvdb_init(fdb_kvdb_t db, const char *name, const char *path, struc
         db->sector_cache_table[i].empty_kv = FAILED_ADDR;
         db->sector_cache_table[i].addr = FDB_DATA_UNUSED;
     }
-    for (i = 0; i < FDB_KV_CACHE_TABLE_SIZE; i++) {
-        db->kv_cache_table[i].addr = FDB_DATA_UNUSED;
+#ifndef FDB_KV_CACHE_USER_TABLE
+    if (db->kv_cache.nodes == NULL) {
+        db->kv_cache.nodes = db->kv_cache_default_table;
+        db->kv_cache.num = FDB_KV_CACHE_TABLE_SIZE;
     }
+#endif
+    clear_kv_cache(db);
+    db->kv_cache_time = 0;
+    memset(&db->kv_cache_stats, 0, sizeof(db->kv_cache_stats));
 #endif /* FDB_KV_USING_CACHE */
 
     FDB_DEBUG("KVDB size is %" PRIu32 " bytes.\n", db_max_size(db));
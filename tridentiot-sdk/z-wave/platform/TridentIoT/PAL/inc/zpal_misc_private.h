@@ -22,7 +22,9 @@
  */
 
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <zpal_nvm.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -59,6 +61,27 @@ void zpal_increase_restarts(void);
  */
 void zpal_block_flash_erase(uint32_t flash_addr, uint32_t image_size);
 
+/**
+ * @brief Run one step of the NVM garbage collection
+ * Moves a few objects out of a dirty NVM sector, and erases the sector once it
+ * holds no valid objects, so that writes rarely have to collect garbage themselves.
+ * Called from the idle task. It returns at once if the NVM is in use.
+ *
+ * @return True if there is more garbage to collect
+ */
+bool zpal_nvm_gc_step(void);
+
+/**
+ * @brief Get the NVM object cache statistics of an area
+ * The counters are cleared when the area is initialized.
+ *
+ * @param[in]  area      NVM area.
+ * @param[out] hits      Number of objects found in the cache.
+ * @param[out] misses    Number of objects searched in flash.
+ * @param[out] evictions Number of cached objects replaced by another object.
+ */
+void zpal_nvm_get_cache_stats(zpal_nvm_area_t area, uint32_t *hits, uint32_t *misses, uint32_t *evictions);
+
 
 /**
  * @brief Perform a soft reset
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file aes_engine_rt584.c
+ * @brief Takes the AES engine of the RT584 for the PAL modules using it, see aes_engine_rt584.h.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/**************************************************************************************************
+ *    INCLUDES
+ *************************************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "aes_engine_rt584.h"
+#include "crypto.h"
+
+/**************************************************************************************************
+ *    LOCAL VARIABLES
+ *************************************************************************************************/
+extern uint32_t crypto_firmware;
+
+static struct aes_ctx m_aes_ctx;
+
+// Key whose round keys are currently loaded into the engine
+static uint8_t m_loaded_key[AES_ENGINE_RT584_KEY_LENGTH];
+static bool m_key_loaded = false;
+
+/**************************************************************************************************
+ *    GLOBAL FUNCTIONS
+ *************************************************************************************************/
+void aes_engine_rt584_init(void)
+{
+  crypto_lib_init();
+  m_key_loaded = false;
+}
+
+struct aes_ctx *aes_engine_rt584_acquire(const uint8_t *key)
+{
+  /*
+   * The engine is used by the S2 encryption of the protocol task and by the decryption of
+   * delta images of the application task. The engine driver does not lock it, so other
+   * tasks are kept out while the engine holds the round keys of one of them.
+   */
+  vTaskSuspendAll();
+
+  /*
+   * Loading other firmware, e.g. for ECC, overwrites the round keys. Otherwise the round keys
+   * only have to be reloaded when the key changes, which saves the key expansion for every
+   * frame of an S2 session.
+   */
+  const bool round_keys_valid = (AES_FIRMWARE == crypto_firmware)
+                                && m_key_loaded
+                                && (0 == memcmp(m_loaded_key, key, AES_ENGINE_RT584_KEY_LENGTH));
+
+  aes_acquire(&m_aes_ctx);
+  if (!round_keys_valid)
+  {
+    aes_key_init(&m_aes_ctx, key, AES_KEY128);
+    aes_load_round_key(&m_aes_ctx);
+    memcpy(m_loaded_key, key, AES_ENGINE_RT584_KEY_LENGTH);
+    m_key_loaded = true;
+  }
+  return &m_aes_ctx;
+}
+
+void aes_engine_rt584_release(void)
+{
+  aes_release(&m_aes_ctx);
+  (void)xTaskResumeAll();
+}
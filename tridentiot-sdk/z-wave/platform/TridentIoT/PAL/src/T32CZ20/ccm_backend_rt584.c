@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file ccm_backend_rt584.c
+ * @brief Runs the S2 CCM encryption on the AES engine of the RT584, see ccm_backend_rt584.h.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/**************************************************************************************************
+ *    INCLUDES
+ *************************************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "ccm_backend.h"
+#include "ccm_backend_rt584.h"
+#include "aes_engine_rt584.h"
+#include "crypto.h"
+
+/**************************************************************************************************
+ *    CONSTANTS AND DEFINES
+ *************************************************************************************************/
+#define CCM_NONCE_LENGTH      (NONCE_LEN) // The engine uses a fixed two byte length field
+#define CCM_MAX_AAD_AND_TEXT  (479)       // The engine requires hdr_len + data_len < 480
+#define CCM_MIN_MAC_LENGTH    (4)
+#define CCM_MAX_MAC_LENGTH    (16)
+
+/**************************************************************************************************
+ *    LOCAL VARIABLES
+ *************************************************************************************************/
+/*
+ * Only end device libraries include the CCM implementation of libs2, so the backend is
+ * registered only when it is linked in.
+ */
+extern void CCM_set_backend(const ccm_backend_t *backend) __attribute__((weak));
+
+// The engine takes and returns the AAD, the text and the MAC as one contiguous buffer
+static uint8_t m_ccm_buffer[CCM_MAX_AAD_AND_TEXT + CCM_MAX_MAC_LENGTH];
+
+/**************************************************************************************************
+ *    LOCAL FUNCTIONS
+ *************************************************************************************************/
+static bool is_supported(const ccm_backend_msg_t *msg)
+{
+  /*
+   * libs2 always sets the Adata flag of B0, while the engine only sets it when there is
+   * AAD. Messages without AAD are left to the software implementation to stay compatible.
+   */
+  return (CCM_NONCE_LENGTH == msg->nonce_len)
+         && (0 < msg->aad_len)
+         && ((msg->aad_len + msg->text_len) <= CCM_MAX_AAD_AND_TEXT)
+         && (CCM_MIN_MAC_LENGTH <= msg->mac_len)
+         && (CCM_MAX_MAC_LENGTH >= msg->mac_len)
+         && (0 == (msg->mac_len & 1));
+}
+
+static ccm_backend_status_t rt584_ccm_encrypt(const ccm_backend_msg_t *msg)
+{
+  if (!is_supported(msg))
+  {
+    return CCM_BACKEND_UNSUPPORTED;
+  }
+
+  uint32_t output_length = sizeof(m_ccm_buffer);
+  struct aes_ccm_encryption_packet packet = {
+    .nonce       = (uint8_t *)msg->nonce,
+    .hdr         = (uint8_t *)msg->aad,
+    .hdr_len     = msg->aad_len,
+    .data        = msg->text,
+    .data_len    = msg->text_len,
+    .mlen        = msg->mac_len,
+    .out_buf     = m_ccm_buffer,
+    .out_buf_len = &output_length
+  };
+
+  (void)aes_engine_rt584_acquire(msg->key);
+  uint32_t status = aes_ccm_encryption(&packet);
+  aes_engine_rt584_release();
+
+  if (STATUS_SUCCESS != status)
+  {
+    return CCM_BACKEND_UNSUPPORTED;
+  }
+
+  // The output starts with a copy of the AAD
+  memcpy(msg->text, &m_ccm_buffer[msg->aad_len], msg->text_len);
+  memcpy(msg->mac, &m_ccm_buffer[msg->aad_len + msg->text_len], msg->mac_len);
+  return CCM_BACKEND_SUCCESS;
+}
+
+static ccm_backend_status_t rt584_ccm_decrypt(const ccm_backend_msg_t *msg)
+{
+  if (!is_supported(msg))
+  {
+    return CCM_BACKEND_UNSUPPORTED;
+  }
+
+  memcpy(m_ccm_buffer, msg->aad, msg->aad_len);
+  memcpy(&m_ccm_buffer[msg->aad_len], msg->text, msg->text_len);
+  memcpy(&m_ccm_buffer[msg->aad_len + msg->text_len], msg->mac, msg->mac_len);
+
+  uint32_t output_length = msg->text_len;
+  struct aes_ccm_decryption_packet packet = {
+    .payload_buf    = m_ccm_buffer,
+    .payload_length = msg->aad_len + msg->text_len + msg->mac_len,
+    .nonce          = (uint8_t *)msg->nonce,
+    .hdr_len        = msg->aad_len,
+    .data_len       = msg->text_len,
+    .mlen           = msg->mac_len,
+    .out_buf        = msg->text,
+    .out_buf_len    = &output_length
+  };
+
+  (void)aes_engine_rt584_acquire(msg->key);
+  uint32_t status = aes_ccm_decryption_verification(&packet);
+  aes_engine_rt584_release();
+
+  switch (status)
+  {
+    case STATUS_SUCCESS:
+      return CCM_BACKEND_SUCCESS;
+    case STATUS_ERROR:
+      return CCM_BACKEND_AUTH_FAILED;
+    default:
+      return CCM_BACKEND_UNSUPPORTED;
+  }
+}
+
+static const ccm_backend_t m_rt584_ccm_backend = {
+  .encrypt = rt584_ccm_encrypt,
+  .decrypt = rt584_ccm_decrypt
+};
+
+/**************************************************************************************************
+ *    GLOBAL FUNCTIONS
+ *************************************************************************************************/
+void ccm_backend_rt584_init(void)
+{
+  if (NULL == CCM_set_backend)
+  {
+    return;
+  }
+  aes_engine_rt584_init();
+  CCM_set_backend(&m_rt584_ccm_backend);
+}
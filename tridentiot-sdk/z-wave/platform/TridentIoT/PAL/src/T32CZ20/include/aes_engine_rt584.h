@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file aes_engine_rt584.h
+ * @brief Shares the AES engine of the RT584 between the PAL modules using it.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _AES_ENGINE_RT584_H_
+#define _AES_ENGINE_RT584_H_
+
+#include <stdint.h>
+
+#define AES_ENGINE_RT584_KEY_LENGTH  (16)
+
+struct aes_ctx;
+
+/**
+ * Forgets the round keys loaded into the engine.
+ */
+void aes_engine_rt584_init(void);
+
+/**
+ * Takes the AES engine and loads the round keys of an AES-128 key into it.
+ *
+ * The round keys are only reloaded when the key changed or another firmware was
+ * loaded into the engine since the last use. The scheduler is suspended until
+ * @ref aes_engine_rt584_release, so the engine must only be held for short operations.
+ *
+ * @param[in] key AES-128 key.
+ * @return Context to pass to the AES functions of the engine.
+ */
+struct aes_ctx *aes_engine_rt584_acquire(const uint8_t *key);
+
+/**
+ * Gives back the AES engine taken by @ref aes_engine_rt584_acquire.
+ */
+void aes_engine_rt584_release(void);
+
+#endif /* _AES_ENGINE_RT584_H_ */
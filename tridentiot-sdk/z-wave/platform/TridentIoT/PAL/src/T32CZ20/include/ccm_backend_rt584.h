@@ -0,0 +1,24 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file ccm_backend_rt584.h
+ * @brief Runs the S2 CCM encryption on the AES engine of the RT584.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _CCM_BACKEND_RT584_H_
+#define _CCM_BACKEND_RT584_H_
+
+/**
+ * Registers the RT584 AES engine as CCM backend of libs2.
+ *
+ * Messages the engine cannot handle are still processed by the software AES of libs2.
+ */
+void ccm_backend_rt584_init(void);
+
+#endif /* _CCM_BACKEND_RT584_H_ */
@@ -15,7 +15,12 @@
 #define NOR_FLASH_DEV_NAME             "t32cz20_flash"
 
 #define FDB_KV_NAME_MAX               6
+// Enables the KV cache. With FDB_KV_CACHE_USER_TABLE the databases have no
+// built-in table: zpal_nvm_init() installs a table sized per area through
+// FDB_KVDB_CTRL_SET_KV_CACHE. FDB_KV_CACHE_TABLE_SIZE only sizes the tables
+// that the host tests set up themselves.
 #define FDB_KV_CACHE_TABLE_SIZE       64
+#define FDB_KV_CACHE_USER_TABLE
 #define FDB_SECTOR_CACHE_TABLE_SIZE   8
 extern uint32_t __nvm_storage_start__;
 /* ===================== Flash device Configuration ========================= */
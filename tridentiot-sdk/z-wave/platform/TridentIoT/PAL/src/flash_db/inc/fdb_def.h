@@ -33,6 +33,11 @@ extern "C" {
 #define FDB_KV_CACHE_TABLE_SIZE        64
 #endif
 
+/* the KV cache nodes searched for a KV, starting at the node selected by the KV name CRC */
+#ifndef FDB_KV_CACHE_PROBE_MAX
+#define FDB_KV_CACHE_PROBE_MAX         8
+#endif
+
 /* the sector cache table size, it will improve KV save speed when using cache */
 #ifndef FDB_SECTOR_CACHE_TABLE_SIZE
 #define FDB_SECTOR_CACHE_TABLE_SIZE    8
@@ -95,6 +100,8 @@ if (!(EXPR))                                                                  \
 #define FDB_KVDB_CTRL_SET_FILE_MODE    0x09             /**< set file mode control command, this change MUST before database initialization */
 #define FDB_KVDB_CTRL_SET_MAX_SIZE     0x0A             /**< set database max size in file mode control command, this change MUST before database initialization */
 #define FDB_KVDB_CTRL_SET_NOT_FORMAT   0x0B             /**< set database NOT format mode control command, this change MUST before database initialization */
+#define FDB_KVDB_CTRL_SET_KV_CACHE     0x0C             /**< set KV cache table control command, this change MUST before database initialization */
+#define FDB_KVDB_CTRL_GET_KV_CACHE_STATS 0x0D           /**< get KV cache statistics control command */
 
 #define FDB_TSDB_CTRL_SET_SEC_SIZE     0x00             /**< set sector size control command, this change MUST before database initialization */
 #define FDB_TSDB_CTRL_GET_SEC_SIZE     0x01             /**< get sector size control command */
@@ -258,11 +265,24 @@ typedef struct tsdb_sec_info *tsdb_sec_info_t;
 
 struct kv_cache_node {
     uint16_t name_crc;                           /**< KV name's CRC32 low 16bit value */
-    uint16_t active;                             /**< KV node access active degree */
+    uint16_t active;                             /**< KV node last access time */
     uint32_t addr;                               /**< KV node address */
 };
 typedef struct kv_cache_node *kv_cache_node_t;
 
+/* KV cache table, @see FDB_KVDB_CTRL_SET_KV_CACHE */
+struct fdb_kv_cache_table {
+    struct kv_cache_node *nodes;                 /**< KV cache nodes */
+    size_t num;                                  /**< KV cache node number */
+};
+
+/* KV cache statistics, @see FDB_KVDB_CTRL_GET_KV_CACHE_STATS */
+struct fdb_kv_cache_stats {
+    uint32_t hits;                               /**< KV found in cache */
+    uint32_t misses;                             /**< KV searched in flash */
+    uint32_t evictions;                          /**< cached KV replaced by another KV */
+};
+
 /* database structure */
 typedef struct fdb_db *fdb_db_t;
 struct fdb_db {
@@ -308,8 +328,14 @@ struct fdb_kvdb {
     bool last_is_complete_del;
 
 #ifdef FDB_KV_USING_CACHE
-    /* KV cache table */
-    struct kv_cache_node kv_cache_table[FDB_KV_CACHE_TABLE_SIZE];
+#ifndef FDB_KV_CACHE_USER_TABLE
+    /* default KV cache table, it's used when no table is set by FDB_KVDB_CTRL_SET_KV_CACHE */
+    struct kv_cache_node kv_cache_default_table[FDB_KV_CACHE_TABLE_SIZE];
+#endif
+    /* KV cache table, it's a hash table which is indexed by the KV name CRC */
+    struct fdb_kv_cache_table kv_cache;
+    uint16_t kv_cache_time;                      /**< KV cache access time, increased on every access */
+    struct fdb_kv_cache_stats kv_cache_stats;
     /* sector cache table, it caching the sector info which status is current using */
     struct kvdb_sec_info sector_cache_table[FDB_SECTOR_CACHE_TABLE_SIZE];
 #endif /* FDB_KV_USING_CACHE */
@@ -49,6 +49,8 @@ size_t     fdb_blob_read     (fdb_db_t db, fdb_blob_t blob);
 fdb_err_t         fdb_kv_set          (fdb_kvdb_t db, const char *key, const char *value);
 char             *fdb_kv_get          (fdb_kvdb_t db, const char *key);
 fdb_err_t         fdb_kv_set_blob     (fdb_kvdb_t db, const char *key, fdb_blob_t blob);
+fdb_err_t         fdb_kv_set_blob_if_changed(fdb_kvdb_t db, const char *key, fdb_blob_t blob, bool *changed);
+fdb_err_t         fdb_kv_set_blob_part(fdb_kvdb_t db, const char *key, size_t offset, fdb_blob_t blob);
 size_t            fdb_kv_get_blob     (fdb_kvdb_t db, const char *key, fdb_blob_t blob);
 fdb_err_t         fdb_kv_del          (fdb_kvdb_t db, const char *key);
 fdb_kv_t          fdb_kv_get_obj      (fdb_kvdb_t db, const char *key, fdb_kv_t kv);
@@ -57,6 +59,7 @@ fdb_err_t         fdb_kv_set_default  (fdb_kvdb_t db);
 void              fdb_kv_print        (fdb_kvdb_t db);
 fdb_kv_iterator_t fdb_kv_iterator_init(fdb_kvdb_t db, fdb_kv_iterator_t itr);
 bool              fdb_kv_iterate      (fdb_kvdb_t db, fdb_kv_iterator_t itr);
+bool              fdb_kv_gc_step      (fdb_kvdb_t db, size_t max_moves);
 
 /* Time series log API like a TSDB */
 fdb_err_t  fdb_tsl_append      (fdb_tsdb_t db, fdb_blob_t blob);
@@ -37,6 +37,9 @@
 #include <rtc_util.h>
 #endif
 #include "zpal_radio_private.h"
+#if (CHIP_MODEL == CHIP_ID(RT584, RT58X_MPB)) || (CHIP_MODEL == CHIP_ID(RT584, RT58X_MPA))
+#include "ccm_backend_rt584.h"
+#endif
 extern uint8_t __ret_sram_start__;
 extern uint8_t __ret_sram_end__;
 
@@ -209,6 +212,11 @@ zpal_increase_restarts();
   // Initialize MP sector values
   MpSectorInit();
 
+#if (CHIP_MODEL == CHIP_ID(RT584, RT58X_MPB)) || (CHIP_MODEL == CHIP_ID(RT584, RT58X_MPA))
+  // Run the S2 encryption on the AES engine
+  ccm_backend_rt584_init();
+#endif
+
   // Load (common) calibration values from tokens to registers
   tr_mfg_tokens_process();
 
@@ -220,6 +228,8 @@ zpal_increase_restarts();
 void vApplicationIdleHook(void)
 {
   zpal_feed_watchdog();
+  // Collect NVM garbage while idle, so writes rarely wait for it
+  (void)zpal_nvm_gc_step();
 }
 
 #if 0
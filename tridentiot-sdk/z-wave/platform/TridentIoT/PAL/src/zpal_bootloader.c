@@ -16,6 +16,12 @@
 #include <flashctl.h>
 #include "flashdb_low_lvl.h"
 #include "cz20_fota_define.h"
+#include "zpal_bootloader_delta.h"
+#ifdef ZPAL_BOOTLOADER_DELTA
+#include "tr_mfg_tokens.h"
+#include "crypto.h"
+#include "aes_engine_rt584.h"
+#endif
 //#define DEBUGPRINT // NOSONAR
 #include <DebugPrint.h>
 
@@ -46,19 +52,60 @@ static fota_information_t m_ota_info __attribute__((__used__, section(".btl_mail
 
 STATIC_ASSERT(sizeof(app_version_info_t) == 16, STATIC_ASSERT_FAILED_zpal_bootloader_app_version_info_t_wrong_size);
 
+STATIC_ASSERT(ZPAL_BOOTLOADER_DELTA_PAGE_SIZE == FLASH_PROGRAM_SIZE_PAGE, STATIC_ASSERT_FAILED_zpal_bootloader_delta_page_size);
+
+extern uint32_t __flash_max_size__;
+
+#ifdef ZPAL_BOOTLOADER_DELTA
+static void delta_image_write(uint32_t offset, const uint8_t *data, uint16_t length)
+{
+  nvm_write(OTA_IMAGE_FILE_START_ADDR + offset, length, (uint8_t *)data);
+}
+
+// AES-128-CTR state of an encrypted delta image
+static uint8_t m_delta_counter[ZPAL_BOOTLOADER_DELTA_IV_SIZE];
+static uint8_t m_delta_stream_block[ZPAL_BOOTLOADER_DELTA_IV_SIZE];
+static uint32_t m_delta_stream_offset;
+
+static bool delta_image_decrypt_start(const uint8_t *iv)
+{
+  memcpy(m_delta_counter, iv, sizeof(m_delta_counter));
+  m_delta_stream_offset = 0;
+  return true;
+}
+
+static void delta_image_decrypt(const uint8_t *in, uint8_t *out, uint16_t length)
+{
+  // Delta images are encrypted with the key the bootloader decrypts full images with
+  uint8_t key[AES_ENGINE_RT584_KEY_LENGTH];
+  tr_get_mfg_token(key, TR_MFG_TOKEN_BOOTLOAD_AES_KEY);
+
+  struct aes_ctx *ctx = aes_engine_rt584_acquire(key);
+  aes_iv_set(ctx, m_delta_counter);
+  aes_ctr_buffer_crypt(ctx, (uint8_t *)in, out, m_delta_stream_block, &m_delta_stream_offset, length);
+  aes_iv_get(ctx, m_delta_counter);
+  aes_engine_rt584_release();
+  memset(key, 0, sizeof(key));
+}
+
+/*
+ * A delta image is reconstructed into a regular OTA image file in the bank, so the
+ * rest of the update is the same as for a full image.
+ */
+static zpal_bootloader_delta_image_t m_delta_image = {
+  .source = (const uint8_t *)APP_START_ADDR,
+  .target = (const uint8_t *)OTA_IMAGE_FILE_START_ADDR,
+  .target_min_length = sizeof(ota_header_t),
+  .target_max_length = OTA_IMAGE_BANK_LENGTH - 1,
+  .write = delta_image_write,
+  .decrypt_start = delta_image_decrypt_start,
+  .decrypt = delta_image_decrypt
+};
+#endif
+
 static uint32_t ota_crc32checksum(uint32_t flash_addr, uint32_t data_len)
 {
-    const uint8_t *p_buf = ((uint8_t *)flash_addr);
-    uint32_t chk_sum = ~0;
-    for (uint32_t i = 0; i < data_len; i ++ )
-    {
-        chk_sum ^= *p_buf++;
-        for (uint16_t k = 0; k < 8; k ++)
-        {
-            chk_sum = chk_sum & 1 ? (chk_sum >> 1) ^ 0xedb88320 : chk_sum >> 1;
-        }
-    }
-    return ~chk_sum;
+  return zpal_bootloader_crc32((const uint8_t *)flash_addr, data_len);
 }
 
 static void ota_info_read(const uint8_t *flash_addr, uint8_t *pdata, uint32_t data_len)
@@ -80,8 +127,6 @@ zpal_status_t zpal_bootloader_init(void)
   flash_set_read_pagesize();
   return ZPAL_STATUS_OK;
 }
-extern uint32_t __flash_max_size__;
-
 extern bool xmodem_receive(void);
 void zpal_bootloader_reboot_and_install(void)
 {
@@ -150,6 +195,15 @@ zpal_status_t zpal_bootloader_verify_image(void)
 {
   ota_header_t  ota_header;
 
+#ifdef ZPAL_BOOTLOADER_DELTA
+  zpal_bootloader_delta_status_t delta_status = zpal_bootloader_delta_verify();
+  if ((ZPAL_BOOTLOADER_DELTA_NONE != delta_status) && (ZPAL_BOOTLOADER_DELTA_DONE != delta_status))
+  {
+    // The delta image could not be applied, or was incomplete
+    return ZPAL_STATUS_BOOTLOADER_INVALID_CHECKSUM;
+  }
+#endif
+
   ota_info_read((uint8_t*)(OTA_IMAGE_FILE_START_ADDR), (uint8_t*)&ota_header, sizeof(ota_header_t));
   if (false == ota_version_check(&ota_header.app_version_info.app_version))
   {
@@ -169,6 +223,24 @@ zpal_status_t zpal_bootloader_write_data(uint32_t offset, uint8_t *data, uint16_
   {
     return ZPAL_STATUS_FAIL;
   }
+#ifdef ZPAL_BOOTLOADER_DELTA
+  if (0 == offset)
+  {
+    zpal_bootloader_delta_stop();
+    if (zpal_bootloader_delta_detect(data, length))
+    {
+      // The maximum length of the app image is only known at link time
+      m_delta_image.source_max_length = (uint32_t)&__flash_max_size__;
+      zpal_bootloader_delta_start(&m_delta_image);
+    }
+  }
+  if (ZPAL_BOOTLOADER_DELTA_NONE != zpal_bootloader_delta_get_status())
+  {
+    // The OTA image file is reconstructed from the delta image and written to the bank instead
+    zpal_bootloader_delta_write(offset, data, length);
+    return ZPAL_STATUS_OK;
+  }
+#endif
   nvm_write(OTA_IMAGE_FILE_START_ADDR + offset, length, data);
   return ZPAL_STATUS_OK;
 }
@@ -192,6 +264,9 @@ bool zpal_bootloader_is_first_boot(bool *updated_successfully)
 void zpal_bootloader_reset_page_counters(void)
 {
   ota_header_t ota_header;
+#ifdef ZPAL_BOOTLOADER_DELTA
+  zpal_bootloader_delta_stop();
+#endif
   ota_info_read((uint8_t*)(OTA_IMAGE_FILE_START_ADDR), (uint8_t*)&ota_header, sizeof(ota_header_t));
   uint8_t *ptr = (uint8_t*)&ota_header;
   if (ptr[0] != 0xFF && ptr[1] != 0xFF &&
@@ -0,0 +1,473 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file zpal_bootloader_delta.c
+ * @brief Reconstructs an OTA image file from a delta image while it is received.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#include "zpal_bootloader_delta.h"
+#include <string.h>
+#include "Assert.h"
+#include <zpal_watchdog.h>
+#include <flashdb.h>
+#include "LzmaDec.h"
+//#define DEBUGPRINT // NOSONAR
+#include <DebugPrint.h>
+
+/*
+ * Delta images
+ *
+ * A delta image is an LZMA compressed patch against the running application. It is
+ * reconstructed into a regular OTA image file while it is received, so the rest of the
+ * update (verification, signature check and installation by the bootloader) is unchanged.
+ *
+ * Format (little endian):
+ *   delta_header_t
+ *   Raw LZMA stream (with end marker) of patch records:
+ *     DELTA_OP_ADD:    opcode, 4 byte length, 4 byte source offset, <length> bytes added
+ *                      to the running application starting at the source offset.
+ *     DELTA_OP_INSERT: opcode, 4 byte length, <length> bytes copied as is.
+ *
+ * With DELTA_FLAG_ENCRYPTED, the LZMA stream is encrypted with AES-128-CTR, starting
+ * with the initial vector of the header.
+ */
+#define DELTA_MAGIC                 0x544C445A  // "ZDLT"
+#define DELTA_VERSION               1
+#define DELTA_FLAG_ENCRYPTED        0x01
+#define DELTA_OP_ADD                0x01
+#define DELTA_OP_INSERT             0x02
+#define DELTA_RECORD_MAX_LENGTH     9
+#define DELTA_MAX_DICTIONARY_SIZE   4096        // Multiple of 4 kB, the granularity of LzmaDec
+#define DELTA_MAX_LITERAL_BITS      0           // Maximum of lc + lp
+#define DELTA_NUM_PROBS             (1984 + (0x300 << DELTA_MAX_LITERAL_BITS))
+#define DELTA_LZMA_HEAP_SIZE        ((DELTA_NUM_PROBS * sizeof(CLzmaProb)) + DELTA_MAX_DICTIONARY_SIZE)
+#define DELTA_DECODE_CHUNK_SIZE     64
+#define DELTA_DECRYPT_CHUNK_SIZE    64
+
+// Number of bytes of an image checked between two watchdog feeds
+#define CRC32_BLOCK_SIZE            4096
+
+// Number of bytes of the running application checked per received fragment
+#ifndef DELTA_SOURCE_CHECK_BLOCK_SIZE
+#define DELTA_SOURCE_CHECK_BLOCK_SIZE   CRC32_BLOCK_SIZE
+#endif
+
+typedef struct __attribute__((packed))
+{
+  uint32_t magic;
+  uint8_t  version;
+  uint8_t  lzma_props[LZMA_PROPS_SIZE];
+  uint8_t  flags;
+  uint8_t  reserved;
+  uint32_t source_length;    // Length of the running application the patch applies to
+  uint32_t source_crc32;
+  uint32_t target_length;    // Length of the reconstructed OTA image file
+  uint32_t target_crc32;
+  uint32_t reserved2;
+  uint8_t  iv[ZPAL_BOOTLOADER_DELTA_IV_SIZE];  // Initial vector of an encrypted LZMA stream
+} delta_header_t;
+
+STATIC_ASSERT(sizeof(delta_header_t) == 48, STATIC_ASSERT_FAILED_zpal_bootloader_delta_header_t_wrong_size);
+
+typedef enum
+{
+  DELTA_STATE_IDLE,          // The image being received is not a delta image
+  DELTA_STATE_HEADER,
+  DELTA_STATE_RECORD,
+  DELTA_STATE_DATA,
+  DELTA_STATE_DECODED,       // The OTA image file is complete, but its CRC is not checked yet
+  DELTA_STATE_DONE,
+  DELTA_STATE_ERROR
+} delta_state_t;
+
+typedef struct
+{
+  delta_state_t state;
+  const zpal_bootloader_delta_image_t *image;
+  uint32_t next_offset;      // Offset of the next byte expected from the delta image
+  delta_header_t header;
+  uint8_t header_length;
+  uint8_t record[DELTA_RECORD_MAX_LENGTH];
+  uint8_t record_length;
+  bool encrypted;
+  uint8_t opcode;
+  uint32_t data_remaining;
+  uint32_t source_offset;
+  uint32_t target_offset;    // Number of bytes of the OTA image file reconstructed so far
+  uint32_t source_checked;   // Number of bytes of the running application in source_crc32
+  uint32_t source_crc32;
+  uint8_t page[ZPAL_BOOTLOADER_DELTA_PAGE_SIZE];
+  uint16_t page_length;
+  CLzmaDec lzma;
+  size_t heap_used;
+} delta_session_t;
+
+static delta_session_t m_delta;
+static uint8_t m_delta_lzma_heap[DELTA_LZMA_HEAP_SIZE] __attribute__((aligned(4)));
+
+/*
+ * The decoder state of a session is placed in a static heap, which keeps the RAM
+ * needed for a delta update bounded and independent of the FreeRTOS heap.
+ */
+static void *delta_lzma_alloc(ISzAllocPtr p, size_t size)
+{
+  (void)p;
+  size = (size + 3) & ~(size_t)3;
+  if ((sizeof(m_delta_lzma_heap) - m_delta.heap_used) < size)
+  {
+    return NULL;
+  }
+  void *address = &m_delta_lzma_heap[m_delta.heap_used];
+  m_delta.heap_used += size;
+  return address;
+}
+
+static void delta_lzma_free(ISzAllocPtr p, void *address)
+{
+  // The heap is released as a whole when a new session starts
+  (void)p;
+  (void)address;
+}
+
+static const ISzAlloc m_delta_lzma_allocator = { delta_lzma_alloc, delta_lzma_free };
+
+static uint32_t delta_read_u32(const uint8_t *p)
+{
+  return ((uint32_t)p[0]) | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool delta_start(void)
+{
+  const delta_header_t *header = &m_delta.header;
+  const zpal_bootloader_delta_image_t *image = m_delta.image;
+  CLzmaProps props;
+
+  if ((DELTA_VERSION != header->version)
+      || (0 != (header->flags & ~DELTA_FLAG_ENCRYPTED))
+      || (SZ_OK != LzmaProps_Decode(&props, header->lzma_props, LZMA_PROPS_SIZE))
+      || (DELTA_MAX_DICTIONARY_SIZE < props.dicSize)
+      || (DELTA_MAX_LITERAL_BITS < (props.lc + props.lp))
+      || (image->target_min_length > header->target_length)
+      || (image->target_max_length < header->target_length)
+      || (0 == header->source_length)
+      || (image->source_max_length < header->source_length))
+  {
+    DPRINT("Unsupported delta image\n");
+    return false;
+  }
+
+  m_delta.encrypted = (0 != (header->flags & DELTA_FLAG_ENCRYPTED));
+  if (m_delta.encrypted && ((NULL == image->decrypt_start) || !image->decrypt_start(header->iv)))
+  {
+    DPRINT("Encrypted delta image not supported\n");
+    return false;
+  }
+
+  LzmaDec_Construct(&m_delta.lzma);
+  m_delta.heap_used = 0;
+  if (SZ_OK != LzmaDec_Allocate(&m_delta.lzma, header->lzma_props, LZMA_PROPS_SIZE, &m_delta_lzma_allocator))
+  {
+    return false;
+  }
+  LzmaDec_Init(&m_delta.lzma);
+  m_delta.record_length = 0;
+  m_delta.target_offset = 0;
+  m_delta.page_length = 0;
+  m_delta.source_checked = 0;
+  m_delta.source_crc32 = 0;
+  return true;
+}
+
+/*
+ * The patch must be applied to exactly the image it was generated against. The CRC of
+ * the running application is calculated a block at a time, so checking it does not stall
+ * the reception of a fragment.
+ */
+static delta_state_t delta_check_source(delta_state_t state, uint32_t max_length)
+{
+  uint32_t length = m_delta.header.source_length - m_delta.source_checked;
+  if (0 == length)
+  {
+    return state;
+  }
+  if (max_length < length)
+  {
+    length = max_length;
+  }
+  m_delta.source_crc32 = fdb_calc_crc32(m_delta.source_crc32, &m_delta.image->source[m_delta.source_checked], length);
+  m_delta.source_checked += length;
+  if ((m_delta.header.source_length == m_delta.source_checked)
+      && (m_delta.header.source_crc32 != m_delta.source_crc32))
+  {
+    DPRINT("Delta image does not match the running application\n");
+    return DELTA_STATE_ERROR;
+  }
+  return state;
+}
+
+static void delta_flush_page(void)
+{
+  if (0 != m_delta.page_length)
+  {
+    m_delta.image->write(m_delta.target_offset - m_delta.page_length, m_delta.page, m_delta.page_length);
+    m_delta.page_length = 0;
+  }
+}
+
+static void delta_output(uint8_t value)
+{
+  m_delta.page[m_delta.page_length++] = value;
+  m_delta.target_offset++;
+  if (sizeof(m_delta.page) == m_delta.page_length)
+  {
+    delta_flush_page();
+  }
+}
+
+static delta_state_t delta_finish(void)
+{
+  // The CRC of the reconstructed image is checked by zpal_bootloader_delta_verify()
+  delta_flush_page();
+  return DELTA_STATE_DECODED;
+}
+
+static delta_state_t delta_parse_record(void)
+{
+  const uint8_t *record = m_delta.record;
+  uint8_t record_length = (DELTA_OP_ADD == record[0]) ? 9 : 5;
+
+  if ((DELTA_OP_ADD != record[0]) && (DELTA_OP_INSERT != record[0]))
+  {
+    return DELTA_STATE_ERROR;
+  }
+  if (m_delta.record_length < record_length)
+  {
+    return DELTA_STATE_RECORD;
+  }
+
+  m_delta.opcode = record[0];
+  m_delta.data_remaining = delta_read_u32(&record[1]);
+  m_delta.record_length = 0;
+
+  if ((m_delta.header.target_length - m_delta.target_offset) < m_delta.data_remaining)
+  {
+    return DELTA_STATE_ERROR;
+  }
+  if (DELTA_OP_ADD == m_delta.opcode)
+  {
+    m_delta.source_offset = delta_read_u32(&record[5]);
+    if ((m_delta.source_offset > m_delta.header.source_length)
+        || ((m_delta.header.source_length - m_delta.source_offset) < m_delta.data_remaining))
+    {
+      return DELTA_STATE_ERROR;
+    }
+  }
+  return (0 == m_delta.data_remaining) ? DELTA_STATE_RECORD : DELTA_STATE_DATA;
+}
+
+/*
+ * Applies decompressed patch bytes and writes the result to the OTA image bank.
+ */
+static delta_state_t delta_apply(delta_state_t state, const uint8_t *data, size_t length)
+{
+  const uint8_t *source = m_delta.image->source;
+
+  for (size_t i = 0; (i < length) && ((DELTA_STATE_RECORD == state) || (DELTA_STATE_DATA == state)); i++)
+  {
+    if (DELTA_STATE_RECORD == state)
+    {
+      m_delta.record[m_delta.record_length++] = data[i];
+      state = delta_parse_record();
+    }
+    else
+    {
+      uint8_t value = data[i];
+      if (DELTA_OP_ADD == m_delta.opcode)
+      {
+        value = (uint8_t)(value + source[m_delta.source_offset++]);
+      }
+      delta_output(value);
+      if (0 == --m_delta.data_remaining)
+      {
+        state = DELTA_STATE_RECORD;
+      }
+    }
+
+    if ((DELTA_STATE_RECORD == state) && (m_delta.header.target_length == m_delta.target_offset))
+    {
+      state = delta_finish();
+    }
+  }
+  return state;
+}
+
+static delta_state_t delta_decode(delta_state_t state, const uint8_t *data, uint16_t length)
+{
+  uint8_t chunk[DELTA_DECODE_CHUNK_SIZE];
+
+  while ((DELTA_STATE_RECORD == state) || (DELTA_STATE_DATA == state))
+  {
+    SizeT in_length = length;
+    SizeT out_length = sizeof(chunk);
+    ELzmaStatus status;
+    SRes res = LzmaDec_DecodeToBuf(&m_delta.lzma, chunk, &out_length, data, &in_length, LZMA_FINISH_ANY, &status);
+    data += in_length;
+    length = (uint16_t)(length - in_length);
+    if (SZ_OK != res)
+    {
+      return DELTA_STATE_ERROR;
+    }
+
+    state = delta_apply(state, chunk, out_length);
+
+    if ((0 == out_length) && ((0 == length) || (0 == in_length)))
+    {
+      // All input is consumed, or the stream ended before the image was complete
+      if ((0 != length) && (DELTA_STATE_DECODED != state))
+      {
+        state = DELTA_STATE_ERROR;
+      }
+      break;
+    }
+  }
+  return state;
+}
+
+bool zpal_bootloader_delta_detect(const uint8_t *data, uint16_t length)
+{
+  return (sizeof(uint32_t) <= length) && (DELTA_MAGIC == delta_read_u32(data));
+}
+
+void zpal_bootloader_delta_start(const zpal_bootloader_delta_image_t *image)
+{
+  memset(&m_delta, 0, sizeof(m_delta));
+  m_delta.image = image;
+  m_delta.state = DELTA_STATE_HEADER;
+}
+
+void zpal_bootloader_delta_stop(void)
+{
+  m_delta.state = DELTA_STATE_IDLE;
+}
+
+static delta_state_t delta_decrypt_and_decode(delta_state_t state, const uint8_t *data, uint16_t length)
+{
+  uint8_t chunk[DELTA_DECRYPT_CHUNK_SIZE];
+
+  while ((0 != length) && ((DELTA_STATE_RECORD == state) || (DELTA_STATE_DATA == state)))
+  {
+    uint16_t chunk_length = (sizeof(chunk) < length) ? sizeof(chunk) : length;
+    m_delta.image->decrypt(data, chunk, chunk_length);
+    state = delta_decode(state, chunk, chunk_length);
+    data += chunk_length;
+    length = (uint16_t)(length - chunk_length);
+  }
+  return state;
+}
+
+void zpal_bootloader_delta_write(uint32_t offset, const uint8_t *data, uint16_t length)
+{
+  if ((DELTA_STATE_HEADER != m_delta.state) && (DELTA_STATE_RECORD != m_delta.state) && (DELTA_STATE_DATA != m_delta.state))
+  {
+    return;
+  }
+  if (offset != m_delta.next_offset)
+  {
+    m_delta.state = DELTA_STATE_ERROR;
+    return;
+  }
+  m_delta.next_offset += length;
+
+  if (DELTA_STATE_HEADER == m_delta.state)
+  {
+    uint16_t header_bytes = sizeof(delta_header_t) - m_delta.header_length;
+    if (header_bytes > length)
+    {
+      header_bytes = length;
+    }
+    memcpy((uint8_t *)&m_delta.header + m_delta.header_length, data, header_bytes);
+    m_delta.header_length = (uint8_t)(m_delta.header_length + header_bytes);
+    data += header_bytes;
+    length = (uint16_t)(length - header_bytes);
+    if (sizeof(delta_header_t) > m_delta.header_length)
+    {
+      return;
+    }
+    m_delta.state = delta_start() ? DELTA_STATE_RECORD : DELTA_STATE_ERROR;
+  }
+
+  m_delta.state = delta_check_source(m_delta.state, DELTA_SOURCE_CHECK_BLOCK_SIZE);
+  if (DELTA_STATE_ERROR != m_delta.state)
+  {
+    if (m_delta.encrypted)
+    {
+      m_delta.state = delta_decrypt_and_decode(m_delta.state, data, length);
+    }
+    else
+    {
+      m_delta.state = delta_decode(m_delta.state, data, length);
+    }
+  }
+}
+
+zpal_bootloader_delta_status_t zpal_bootloader_delta_verify(void)
+{
+  delta_state_t state = m_delta.state;
+  if (DELTA_STATE_DECODED != state)
+  {
+    return zpal_bootloader_delta_get_status();
+  }
+
+  // The part of the running application not checked while the fragments were received
+  while ((DELTA_STATE_DECODED == state) && (m_delta.header.source_length != m_delta.source_checked))
+  {
+    state = delta_check_source(state, CRC32_BLOCK_SIZE);
+    zpal_feed_watchdog();
+  }
+  if (DELTA_STATE_DECODED == state)
+  {
+    state = DELTA_STATE_DONE;
+    if (m_delta.header.target_crc32 != zpal_bootloader_crc32(m_delta.image->target, m_delta.header.target_length))
+    {
+      DPRINT("Reconstructed image CRC mismatch\n");
+      state = DELTA_STATE_ERROR;
+    }
+  }
+  m_delta.state = state;
+  return zpal_bootloader_delta_get_status();
+}
+
+zpal_bootloader_delta_status_t zpal_bootloader_delta_get_status(void)
+{
+  switch (m_delta.state)
+  {
+    case DELTA_STATE_IDLE:
+      return ZPAL_BOOTLOADER_DELTA_NONE;
+    case DELTA_STATE_DONE:
+      return ZPAL_BOOTLOADER_DELTA_DONE;
+    case DELTA_STATE_ERROR:
+      return ZPAL_BOOTLOADER_DELTA_ERROR;
+    default:
+      return ZPAL_BOOTLOADER_DELTA_RECEIVING;
+  }
+}
+
+uint32_t zpal_bootloader_crc32(const uint8_t *data, uint32_t length)
+{
+  uint32_t crc = 0;
+  while (0 != length)
+  {
+    uint32_t block = (CRC32_BLOCK_SIZE < length) ? CRC32_BLOCK_SIZE : length;
+    crc = fdb_calc_crc32(crc, data, block);
+    data += block;
+    length -= block;
+    zpal_feed_watchdog();
+  }
+  return crc;
+}
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file zpal_bootloader_delta.h
+ * @brief Reconstructs an OTA image file from a delta image while it is received.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef ZPAL_BOOTLOADER_DELTA_H
+#define ZPAL_BOOTLOADER_DELTA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Number of reconstructed bytes written to the OTA image file at once
+#define ZPAL_BOOTLOADER_DELTA_PAGE_SIZE  256
+
+/// Length of the AES-128-CTR initial vector of an encrypted delta image
+#define ZPAL_BOOTLOADER_DELTA_IV_SIZE    16
+
+/**
+ * Where a delta image is applied.
+ */
+typedef struct
+{
+  const uint8_t *source;          ///< Running application the patch applies to
+  uint32_t source_max_length;     ///< Largest accepted length of the running application
+  const uint8_t *target;          ///< OTA image file, read back to check the reconstructed image
+  uint32_t target_min_length;     ///< Smallest accepted length of the OTA image file
+  uint32_t target_max_length;     ///< Largest accepted length of the OTA image file
+  /// Writes reconstructed bytes at an offset of the OTA image file
+  void (*write)(uint32_t offset, const uint8_t *data, uint16_t length);
+  /**
+   * Starts the AES-128-CTR decryption of an encrypted delta image with the key of the
+   * bootloader. NULL, or returning false, rejects encrypted delta images.
+   */
+  bool (*decrypt_start)(const uint8_t *iv);
+  /// Decrypts the next bytes of an encrypted delta image
+  void (*decrypt)(const uint8_t *in, uint8_t *out, uint16_t length);
+} zpal_bootloader_delta_image_t;
+
+typedef enum
+{
+  ZPAL_BOOTLOADER_DELTA_NONE,       ///< The image being received is not a delta image
+  ZPAL_BOOTLOADER_DELTA_RECEIVING,  ///< The OTA image file is not complete or not verified yet
+  ZPAL_BOOTLOADER_DELTA_DONE,       ///< The OTA image file is complete and its CRC matches
+  ZPAL_BOOTLOADER_DELTA_ERROR       ///< The delta image could not be applied
+} zpal_bootloader_delta_status_t;
+
+/**
+ * Checks whether the first fragment of an image starts a delta image.
+ */
+bool zpal_bootloader_delta_detect(const uint8_t *data, uint16_t length);
+
+/**
+ * Starts a new delta session. Any previous session is dropped.
+ *
+ * @param[in] image Where the delta image is applied. Must stay valid during the session.
+ */
+void zpal_bootloader_delta_start(const zpal_bootloader_delta_image_t *image);
+
+/**
+ * Ends the delta session, so the next image is not handled as a delta image.
+ */
+void zpal_bootloader_delta_stop(void);
+
+/**
+ * Processes a fragment of a delta image. Fragments must arrive in order.
+ *
+ * Each fragment also checks a block of the running application against the delta
+ * header, so the time spent per fragment stays bounded.
+ *
+ * Errors are latched and reported by @ref zpal_bootloader_delta_get_status.
+ */
+void zpal_bootloader_delta_write(uint32_t offset, const uint8_t *data, uint16_t length);
+
+/**
+ * Completes the checks of a received delta image: the rest of the running application
+ * and the CRC of the reconstructed OTA image file.
+ *
+ * Called once all fragments are received, as it reads whole images.
+ */
+zpal_bootloader_delta_status_t zpal_bootloader_delta_verify(void);
+
+zpal_bootloader_delta_status_t zpal_bootloader_delta_get_status(void);
+
+/**
+ * Calculates the CRC32 of an image in flash.
+ *
+ * The CRC is calculated in blocks and the watchdog is fed after each of them, as
+ * an image of several hundred kB takes longer than the watchdog timeout.
+ */
+uint32_t zpal_bootloader_crc32(const uint8_t *data, uint32_t length);
+
+#endif /* ZPAL_BOOTLOADER_DELTA_H */
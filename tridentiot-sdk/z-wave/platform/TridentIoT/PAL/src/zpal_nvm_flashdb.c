@@ -8,6 +8,7 @@
 #include <zpal_watchdog.h>
 #include <FreeRTOS.h>
 #include <semphr.h>
+#include <task.h>
 #include <MfgTokens.h>
 #include <flashctl.h>
 #include "string.h"
@@ -16,6 +17,8 @@
 #include "tr_mfg_tokens.h"
 
 #include <flashdb_low_lvl.h>
+#include "zpal_nvm_flashdb_keys.h"
+#include <zpal_misc_private.h>
 
 extern bool zpal_get_lib_type(void);
 
@@ -69,11 +72,17 @@ static StaticSemaphore_t fdbMutexBuffer;
 // lfs has been mounted
 static bool fdb_mounted = false;
 
+// Maximum number of objects moved by one garbage collection step
+#define ZPAL_NVM_GC_STEP_MAX_MOVES    4
+
+// The idle task holds the file system mutex while it runs a garbage collection step
+static bool m_gc_step_holds_lock = false;
+// An object was written or erased since the garbage collection had nothing to collect
+static bool m_gc_step_pending = false;
+
 // variables used by the filesystem
 //static struct fdb_kvdb kvdb = { 0 };
-static uint8_t fdb_read_buffer[256];
 
-#define flash_write_buffer fdb_read_buffer
 #define FILE_SYSTEM_NAME    "ZWAVE_FS"
 // Array of directory names
 #define     HANDLE_NAME_MAX   5
@@ -94,6 +103,17 @@ static fdb_info_t m_fdb_info[3] = {{"APP"  , APP_PART_NAME  , {{0}}},
                                    {"STACK", STACK_PART_NAME, {{0}}}};
 #pragma GCC diagnostic pop
 
+/*
+ * KV cache nodes of each area, in the order of zpal_nvm_area_t. The ZAF area of an end
+ * device holds the User Credential objects, and the stack area of a controller holds
+ * the node information, so these get most of the nodes.
+ */
+static const uint16_t slave_kv_cache_size[] = {64, 256, 64};
+static const uint16_t ctrl_kv_cache_size[]  = {64, 32, 288};
+#define KV_CACHE_NODES    384
+
+static struct kv_cache_node m_kv_cache_nodes[KV_CACHE_NODES];
+
 static bool backup_first_write = true;
 void zpal_block_flash_erase(uint32_t flash_addr, uint32_t image_size)
 {
@@ -121,9 +141,14 @@ void zpal_block_flash_erase(uint32_t flash_addr, uint32_t image_size)
   }
 }
 
+static bool gc_step_holds_lock(void)
+{
+  return m_gc_step_holds_lock && (xSemaphoreGetMutexHolder(fdbMutex) == xTaskGetCurrentTaskHandle());
+}
+
 static void LockFs(__attribute__((unused)) fdb_db_t db)
 {
-  if (NULL == fdbMutex)
+  if ((NULL == fdbMutex) || gc_step_holds_lock())
   {
     return;
   }
@@ -133,30 +158,13 @@ static void LockFs(__attribute__((unused)) fdb_db_t db)
 
 static void UnlockFs(__attribute__((unused)) fdb_db_t db)
 {
-  if (NULL == fdbMutex)
+  if ((NULL == fdbMutex) || gc_step_holds_lock())
   {
     return;
   }
   xSemaphoreGive( fdbMutex );
 }
 
-void key_2_filename(const char *dirname, zpal_nvm_object_key_t key, char *filename)
-{
-  uint8_t cnt = 0;
-  // Copy area name from handle
-  filename[cnt++] = *dirname;
-  for (uint8_t i = 0; i < sizeof(uint32_t); i++)
-  {
-    uint8_t digit = ((uint8_t*)&key)[i];
-    if (!digit)
-    {
-      digit = 0x30;
-    }
-    filename[cnt++] = digit;
-  }
-  filename[cnt] = 0;
-}
-
 extern int fal_partition_init(void);
 
 zpal_nvm_handle_t zpal_nvm_init(zpal_nvm_area_t area)
@@ -183,18 +191,28 @@ zpal_nvm_handle_t zpal_nvm_init(zpal_nvm_area_t area)
     fdb_mounted = true;
     fal_partition_init();
   }
+  const uint16_t *kv_cache_size;
   if (ZPAL_LIBRARY_TYPE_CONTROLLER == zpal_get_library_type())
   {
     // controller libary
     fal_set_partition_table_temp((fal_partition_t)&ctrl_part_tbl_def[0], PART_TABLE_LEN);
+    kv_cache_size = ctrl_kv_cache_size;
   }
   else
   {
     fal_set_partition_table_temp((fal_partition_t)&slave_part_tbl_def[0], PART_TABLE_LEN);
+    kv_cache_size = slave_kv_cache_size;
+  }
+  // The areas share the cache nodes
+  struct fdb_kv_cache_table kv_cache = { .nodes = m_kv_cache_nodes, .num = kv_cache_size[area] };
+  for (uint32_t i = 0; i < area; i++)
+  {
+    kv_cache.nodes += kv_cache_size[i];
   }
   fdb_kvdb_deinit(&m_fdb_info[area].kvdb);
   fdb_kvdb_control(&m_fdb_info[area].kvdb, FDB_KVDB_CTRL_SET_LOCK, (void *)LockFs);
   fdb_kvdb_control(&m_fdb_info[area].kvdb, FDB_KVDB_CTRL_SET_UNLOCK, (void *)UnlockFs);
+  fdb_kvdb_control(&m_fdb_info[area].kvdb, FDB_KVDB_CTRL_SET_KV_CACHE, &kv_cache);
   fdb_kvdb_init(&m_fdb_info[area].kvdb, m_fdb_info[area].db_name, m_fdb_info[area].part_name, NULL, NULL);
   return (zpal_nvm_handle_t)&m_fdb_info[area];
 }
@@ -231,18 +249,24 @@ zpal_status_t zpal_nvm_read_object_part(zpal_nvm_handle_t handle, zpal_nvm_objec
   fdb_info_t * p_fdb_info = (fdb_info_t *)handle;
   // Add database name to file_name
   key_2_filename(p_fdb_info->db_name, key, file_name);
-  // read data
-  fdb_blob_make(&blob, fdb_read_buffer, sizeof(fdb_read_buffer));
-  fdb_kv_get_obj(&p_fdb_info->kvdb, file_name, &kv_obj);
-  uint32_t read_len = fdb_blob_read((fdb_db_t)&p_fdb_info->kvdb, fdb_kv_to_blob(&kv_obj, &blob));
-
-  /* the blob.saved.len is more than 0 when get the value successful */
-  if (read_len)
+  if (NULL == fdb_kv_get_obj(&p_fdb_info->kvdb, file_name, &kv_obj))
   {
-     memcpy((uint8_t*)object, &fdb_read_buffer[offset], object_size);
-     return ZPAL_STATUS_OK;
+    return ZPAL_STATUS_FAIL;
   }
-  return ZPAL_STATUS_FAIL;
+  fdb_kv_to_blob(&kv_obj, fdb_blob_make(&blob, object, object_size));
+  // Reading past the end of the object fails
+  if ((offset > blob.saved.len) || (object_size > (blob.saved.len - offset)))
+  {
+    return ZPAL_STATUS_FAIL;
+  }
+  // Read only the requested part, directly from its location in flash
+  blob.saved.addr += offset;
+  blob.saved.len -= offset;
+  if (fdb_blob_read((fdb_db_t)&p_fdb_info->kvdb, &blob) != object_size)
+  {
+    return ZPAL_STATUS_FAIL;
+  }
+  return ZPAL_STATUS_OK;
 }
 
 zpal_status_t zpal_nvm_write(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, const void *object, size_t object_size)
@@ -260,75 +284,33 @@ zpal_status_t zpal_nvm_write(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key
   key_2_filename(p_fdb_info->db_name, key, file_name);
 
   struct fdb_blob blob;
-  uint8_t temp_buf[64];
   /*
-   * We need to read and compare the new data with the stored data.
-   * We should only write the new data if it is different from what is already stored.
-   * If the new data exceeds the size of the local buffer, we will read the stored data in chunks and compare it with the new data.
-   * This approach helps reduce FLASH writes and prolong the lifespan of the FLASH memory.
-  */
-  if (object_size > sizeof(temp_buf))
-  {
-    uint32_t idx = 0;
-    struct fdb_kv kv_obj;
-    bool new_data = false;
-    // Retrieve the address of the stored data using its name.
-    fdb_kv_get_obj(&p_fdb_info->kvdb, file_name, &kv_obj);
-    fdb_blob_make(&blob, temp_buf, sizeof(temp_buf));
-    fdb_kv_to_blob(&kv_obj, &blob);
-    const uint8_t *obj_ptr = (const uint8_t *)object;
-    uint8_t read_size = sizeof(temp_buf);
-    uint8_t count = object_size / sizeof(temp_buf);
-    do
-    {
-      /*
-       * Read the stored data chunks and compare them with the new data.
-       * If the data is different, flag it as new and stop reading the chunks.
-       * If the data is the same, increment the stored data pointer's offset by the size of the local buffer.
-       */
-
-      fdb_blob_read((fdb_db_t)&p_fdb_info->kvdb, &blob);
-      if (memcmp(temp_buf, &obj_ptr[idx], read_size))
-      {
-        new_data = true;
-        break;
-      }
-      idx += sizeof(temp_buf);
-      blob.saved.addr += sizeof(temp_buf);
-    } while (--count);
-    /*
-     * If the length of the new data is not a multiple of the local buffer length,
-     * and all the read data matches the new data chunks,
-     * then read the remaining stored data and compare it with the new data.
-    */
-    read_size = object_size % sizeof(temp_buf);
-    if (read_size && !new_data)
-    {
-      blob.size = read_size;
-      fdb_blob_read((fdb_db_t)&p_fdb_info->kvdb, &blob);
-      if (memcmp(temp_buf, &obj_ptr[idx], read_size))
-      {
-        new_data = true;
-      }
-    }
-    // If the new data matches the stored data, then skip the write operation.
-    if (!new_data)
-    {
-      return ZPAL_STATUS_OK;
-    }
-  }
-  else
+   * The data is only written if it differs from what is already stored.
+   * This reduces FLASH writes and prolongs the lifespan of the FLASH memory.
+   * The key is looked up once for both the comparison and the write.
+   */
+  fdb_err_t res = fdb_kv_set_blob_if_changed(&p_fdb_info->kvdb, file_name, fdb_blob_make(&blob, object, object_size), NULL);
+  m_gc_step_pending = true;
+  if (FDB_NO_ERR == res)
   {
-    // Open file and read the data
-    memset(temp_buf, 0xFF, sizeof(temp_buf));
-    fdb_kv_get_blob(&p_fdb_info->kvdb, file_name, fdb_blob_make(&blob, temp_buf, object_size));
-    // If the new data matches the stored data, then skip the write operation.
-    if ((blob.saved.len == object_size) && !memcmp(temp_buf, object, object_size))
-    {
-      return ZPAL_STATUS_OK;
-    }
+    return ZPAL_STATUS_OK;
   }
-  fdb_err_t res = fdb_kv_set_blob(&p_fdb_info->kvdb, file_name, fdb_blob_make(&blob, object, object_size));
+  return ZPAL_STATUS_FAIL;
+}
+
+zpal_status_t zpal_nvm_write_object_part(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, const void *object, size_t offset, size_t object_size)
+{
+  struct fdb_blob blob;
+  char file_name[6];
+  fdb_info_t * p_fdb_info = (fdb_info_t *)handle;
+  // Add database name to file_name
+  key_2_filename(p_fdb_info->db_name, key, file_name);
+  /*
+   * The rest of the object is copied from flash while the new object is written,
+   * so the caller only needs to hold the part. An unchanged part is not written.
+   */
+  fdb_err_t res = fdb_kv_set_blob_part(&p_fdb_info->kvdb, file_name, offset, fdb_blob_make(&blob, object, object_size));
+  m_gc_step_pending = true;
   if (FDB_NO_ERR == res)
   {
     return ZPAL_STATUS_OK;
@@ -361,6 +343,7 @@ zpal_status_t zpal_nvm_erase_object(zpal_nvm_handle_t handle, zpal_nvm_object_ke
   char file_name[6];
   key_2_filename(p_fdb_info->db_name, key, file_name);
   fdb_err_t res = fdb_kv_del(&p_fdb_info->kvdb, file_name);
+  m_gc_step_pending = true;
   if (FDB_NO_ERR == res)
   {
     return ZPAL_STATUS_OK;
@@ -373,14 +356,11 @@ zpal_status_t zpal_nvm_get_object_size(zpal_nvm_handle_t handle, zpal_nvm_object
   char file_name[6];
   // Add database name to file_name
   struct fdb_kv kv_obj;
-  struct fdb_blob blob;
   fdb_info_t * p_fdb_info = (fdb_info_t *)handle;
   key_2_filename(p_fdb_info->db_name, key, file_name);
-  fdb_blob_make(&blob, fdb_read_buffer, sizeof(fdb_read_buffer));
   if (NULL != fdb_kv_get_obj(&p_fdb_info->kvdb, file_name, &kv_obj))
   {
-    uint32_t read_len = fdb_blob_read((fdb_db_t)&p_fdb_info->kvdb, fdb_kv_to_blob(&kv_obj, &blob));
-    *len = read_len;
+    *len = kv_obj.value_len;
     return ZPAL_STATUS_OK;
   }
   return ZPAL_STATUS_FAIL;
@@ -392,23 +372,56 @@ size_t zpal_nvm_enum_objects(zpal_nvm_handle_t handle,
                              zpal_nvm_object_key_t key_min,
                              zpal_nvm_object_key_t key_max)
 {
-  (void)key_max;
-
-  char file_name[6];
   fdb_info_t * p_fdb_info = (fdb_info_t *)handle;
 
-  size_t keys_count = 0;
-  struct fdb_kv kv_obj;
-  for (zpal_nvm_object_key_t obj_key = key_min; obj_key < (key_min + key_list_size) ; obj_key++ )
+  // One walk through the database instead of a lookup of every key in the range
+  LockFs(NULL);
+  size_t keys_count = flashdb_enum_keys(&p_fdb_info->kvdb, p_fdb_info->db_name,
+                                        key_list, key_list_size, key_min, key_max);
+  UnlockFs(NULL);
+  return keys_count;
+}
+
+void zpal_nvm_get_cache_stats(zpal_nvm_area_t area, uint32_t *hits, uint32_t *misses, uint32_t *evictions)
+{
+  struct fdb_kv_cache_stats stats = { 0 };
+  if (area < sizeof(m_fdb_info) / sizeof(m_fdb_info[0]))
   {
-    key_2_filename(p_fdb_info->db_name, obj_key, file_name);
-    if (NULL != fdb_kv_get_obj(&p_fdb_info->kvdb, file_name, &kv_obj))
+    LockFs(NULL);
+    fdb_kvdb_control(&m_fdb_info[area].kvdb, FDB_KVDB_CTRL_GET_KV_CACHE_STATS, &stats);
+    UnlockFs(NULL);
+  }
+  *hits = stats.hits;
+  *misses = stats.misses;
+  *evictions = stats.evictions;
+}
+
+bool zpal_nvm_gc_step(void)
+{
+  if (!fdb_mounted || !m_gc_step_pending)
+  {
+    return false;
+  }
+  // Never wait for the file system, a task using it has higher priority than the caller
+  if (pdTRUE != xSemaphoreTake(fdbMutex, 0))
+  {
+    return true;
+  }
+  m_gc_step_holds_lock = true;
+
+  bool collected = false;
+  for (size_t i = 0; (i < sizeof(m_fdb_info) / sizeof(m_fdb_info[0])) && !collected; i++)
+  {
+    if (m_fdb_info[i].kvdb.parent.init_ok)
     {
-       keys_count++;
-       key_list[obj_key - key_min] = obj_key;
+      collected = fdb_kv_gc_step(&m_fdb_info[i].kvdb, ZPAL_NVM_GC_STEP_MAX_MOVES);
     }
   }
-  return keys_count;
+  m_gc_step_pending = collected;
+
+  m_gc_step_holds_lock = false;
+  xSemaphoreGive(fdbMutex);
+  return collected;
 }
 
 zpal_status_t zpal_nvm_backup_open(void)
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file zpal_nvm_flashdb_keys.c
+ * @brief Maps zpal NVM object keys to FlashDB KV names and back, see zpal_nvm_flashdb_keys.h.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#include <string.h>
+#include "zpal_nvm_flashdb_keys.h"
+
+#define KEY_ZERO_BYTE   0x30
+
+// Moved from zpal_nvm_flashdb.c
+// SPDX-SnippetBegin
+// SPDX-SnippetCopyrightText: 2023 Trident IoT, LLC <https://www.tridentiot.com>
+// SPDX-License-Identifier: LicenseRef-TridentMSLA
+void key_2_filename(const char *dirname, zpal_nvm_object_key_t key, char *filename)
+{
+  uint8_t cnt = 0;
+  // Copy area name from handle
+  filename[cnt++] = *dirname;
+  for (uint8_t i = 0; i < sizeof(uint32_t); i++)
+  {
+    uint8_t digit = ((uint8_t*)&key)[i];
+    if (!digit)
+    {
+      digit = KEY_ZERO_BYTE;
+    }
+    filename[cnt++] = digit;
+  }
+  filename[cnt] = 0;
+}
+// SPDX-SnippetEnd
+
+/*
+ * Decodes a KV name into the keys in range that map to it. Returns the number of keys
+ * written to key_list.
+ */
+static size_t filename_2_keys(const char *dirname,
+                              const struct fdb_kv *kv,
+                              zpal_nvm_object_key_t *key_list,
+                              size_t key_list_size,
+                              zpal_nvm_object_key_t key_min,
+                              zpal_nvm_object_key_t key_max)
+{
+  if ((ZPAL_NVM_FILENAME_SIZE - 1 != kv->name_len) || (*dirname != kv->name[0]))
+  {
+    return 0;
+  }
+
+  // Each '0' byte of the name is a zero byte or a '0' byte of the key
+  uint8_t key_bytes[sizeof(zpal_nvm_object_key_t)];
+  uint8_t ambiguous = 0;
+  memcpy(key_bytes, &kv->name[1], sizeof(key_bytes));
+  for (uint8_t i = 0; i < sizeof(key_bytes); i++)
+  {
+    if (KEY_ZERO_BYTE == key_bytes[i])
+    {
+      ambiguous |= (uint8_t)(1 << i);
+    }
+  }
+
+  // Walk all subsets of the ambiguous bytes, where the bytes in the subset are '0' bytes
+  size_t keys_count = 0;
+  uint8_t subset = 0;
+  do
+  {
+    for (uint8_t i = 0; i < sizeof(key_bytes); i++)
+    {
+      if (ambiguous & (1 << i))
+      {
+        key_bytes[i] = (subset & (1 << i)) ? KEY_ZERO_BYTE : 0;
+      }
+    }
+    zpal_nvm_object_key_t key;
+    memcpy(&key, key_bytes, sizeof(key));
+    if ((key >= key_min) && (key <= key_max) && (keys_count < key_list_size))
+    {
+      key_list[keys_count++] = key;
+    }
+    subset = (uint8_t)(subset - ambiguous) & ambiguous;
+  } while (0 != subset);
+
+  return keys_count;
+}
+
+size_t flashdb_enum_keys(fdb_kvdb_t db,
+                         const char *dirname,
+                         zpal_nvm_object_key_t *key_list,
+                         size_t key_list_size,
+                         zpal_nvm_object_key_t key_min,
+                         zpal_nvm_object_key_t key_max)
+{
+  struct fdb_kv_iterator iterator;
+  size_t keys_count = 0;
+
+  fdb_kv_iterator_init(db, &iterator);
+  while ((keys_count < key_list_size) && fdb_kv_iterate(db, &iterator))
+  {
+    keys_count += filename_2_keys(dirname,
+                                  &iterator.curr_kv,
+                                  &key_list[keys_count],
+                                  key_list_size - keys_count,
+                                  key_min,
+                                  key_max);
+  }
+  return keys_count;
+}
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file zpal_nvm_flashdb_keys.h
+ * @brief Maps zpal NVM object keys to FlashDB KV names and back.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef ZPAL_NVM_FLASHDB_KEYS_H
+#define ZPAL_NVM_FLASHDB_KEYS_H
+
+#include <stddef.h>
+#include <zpal_nvm.h>
+#include <flashdb.h>
+
+/// Length of a KV name including the terminating zero
+#define ZPAL_NVM_FILENAME_SIZE  (1 + sizeof(zpal_nvm_object_key_t) + 1)
+
+/**
+ * Creates the KV name of an object.
+ *
+ * The name is the first character of @p dirname followed by the bytes of the key, where
+ * zero bytes are replaced by '0' to keep the name a string.
+ *
+ * @param[in]  dirname  Name of the database holding the object.
+ * @param[in]  key      Object key.
+ * @param[out] filename Buffer of at least @ref ZPAL_NVM_FILENAME_SIZE bytes.
+ */
+void key_2_filename(const char *dirname, zpal_nvm_object_key_t key, char *filename);
+
+/**
+ * Lists the keys of the objects stored in a database within a key range.
+ *
+ * The database is walked once and the KV names are decoded back into keys. As the names
+ * do not distinguish a zero byte from a '0' byte, every key in range that maps to a stored
+ * name is listed, as if each key in the range had been looked up. The keys are listed in
+ * storage order.
+ *
+ * The caller must hold the database lock.
+ *
+ * @param[in]  db            Database to walk.
+ * @param[in]  dirname       Name of the database, as passed to @ref key_2_filename.
+ * @param[out] key_list      Buffer for the found keys.
+ * @param[in]  key_list_size Number of keys that fit in @p key_list.
+ * @param[in]  key_min       Lowest key to list.
+ * @param[in]  key_max       Highest key to list.
+ * @return The number of keys written to @p key_list.
+ */
+size_t flashdb_enum_keys(fdb_kvdb_t db,
+                         const char *dirname,
+                         zpal_nvm_object_key_t *key_list,
+                         size_t key_list_size,
+                         zpal_nvm_object_key_t key_min,
+                         zpal_nvm_object_key_t key_max);
+
+#endif /* ZPAL_NVM_FLASHDB_KEYS_H */
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file bench_op.c
+ * @brief Latency statistics shared by the host benchmarks, see bench_op.h.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include "bench_op.h"
+#include <string.h>
+#include <time.h>
+
+/****************************************************************************/
+/*                       EXPORTED FUNCTION DEFINITIONS                      */
+/****************************************************************************/
+
+uint64_t bench_now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void bench_op_begin(bench_op_t * op, const char * name)
+{
+  memset(op, 0, sizeof(bench_op_t));
+  op->name = name;
+}
+
+void bench_op_sample(bench_op_t * op, const uint64_t start_ns)
+{
+  const uint64_t elapsed = bench_now_ns() - start_ns;
+  op->count++;
+  op->total_ns += elapsed;
+  if (elapsed > op->max_ns) {
+    op->max_ns = elapsed;
+  }
+}
+
+double bench_op_runs(const bench_op_t * op)
+{
+  return op->count ? (double)op->count : 1.0;
+}
+
+double bench_op_mean_us(const bench_op_t * op)
+{
+  return (double)op->total_ns / bench_op_runs(op) / 1000.0;
+}
+
+double bench_op_max_us(const bench_op_t * op)
+{
+  return (double)op->max_ns / 1000.0;
+}
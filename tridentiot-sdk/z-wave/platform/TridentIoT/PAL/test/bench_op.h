@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file bench_op.h
+ * @brief This file contains the latency statistics shared by the host benchmarks.
+ *
+ *        Each benchmark reports its own access counters next to the latency of
+ *        an operation, so the report itself is left to the benchmark.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _BENCH_OP_H_
+#define _BENCH_OP_H_
+
+/* CPP type safety */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <stdint.h>
+
+/****************************************************************************/
+/*                      EXPORTED TYPES AND DEFINITIONS                      */
+/****************************************************************************/
+
+/**
+ * @brief Latency statistics of one benchmarked operation.
+ */
+typedef struct bench_op_ {
+  const char * name;
+  uint32_t count;
+  uint64_t total_ns;
+  uint64_t max_ns;
+} bench_op_t;
+
+/****************************************************************************/
+/*                      EXPORTED FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+/**
+ * @brief Gets the time of a monotonic clock.
+ *
+ * @return Time in nanoseconds, to pass to bench_op_sample().
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief Clears the statistics of an operation.
+ *
+ * @param[out] op   Operation to clear
+ * @param      name Name of the operation in the report
+ */
+void bench_op_begin(bench_op_t * op, const char * name);
+
+/**
+ * @brief Adds one run of an operation to its statistics.
+ *
+ * @param op       Operation
+ * @param start_ns Time returned by bench_now_ns() when the run started
+ */
+void bench_op_sample(bench_op_t * op, const uint64_t start_ns);
+
+/**
+ * @brief Gets the number of runs to divide the counters of an operation by, at
+ *        least 1.
+ */
+double bench_op_runs(const bench_op_t * op);
+
+/**
+ * @brief Gets the mean latency of an operation, in microseconds.
+ */
+double bench_op_mean_us(const bench_op_t * op);
+
+/**
+ * @brief Gets the largest latency of an operation, in microseconds.
+ */
+double bench_op_max_us(const bench_op_t * op);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* _BENCH_OP_H_ */
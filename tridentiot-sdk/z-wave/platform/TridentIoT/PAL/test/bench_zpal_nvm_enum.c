@@ -0,0 +1,277 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file bench_zpal_nvm_enum.c
+ * @brief Host benchmark of the object enumeration of the FlashDB NVM driver.
+ *
+ *        zpal_nvm_enum_objects() runs at boot when the stack validates and
+ *        migrates its files. It used to look up every key of the requested
+ *        range, where each missing key costs a walk through all sectors. It
+ *        now walks the database once and decodes the KV names back into keys.
+ *        Both approaches are timed here on a RAM backed FlashDB partition, their
+ *        results are compared, and the flash reads of the scan are checked
+ *        against a bound per stored object.
+ *
+ *        The number of stored objects is set at build time with BENCH_OBJECTS.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <unity.h>
+#include <flashdb.h>
+#include "bench_op.h"
+#include "fal_ram.h"
+#include "zpal_nvm_flashdb_keys.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#if !defined(BENCH_OBJECTS)
+#define BENCH_OBJECTS  100
+#endif
+
+#define BENCH_DB_NAME        "STACK"
+#define BENCH_PART_NAME      "bench_db"
+// Room for the objects, the sector GC keeps free and some spare
+#define BENCH_FLASH_SIZE     (((BENCH_OBJECTS * 64) / FAL_RAM_SECTOR_SIZE + 3) * FAL_RAM_SECTOR_SIZE)
+#define BENCH_KEY_BASE       0x00050100 ///< Stored keys are BENCH_KEY_BASE + 2 * n
+#define BENCH_ROUNDS         5
+#define BENCH_SMALL_RANGE    8          ///< Size of the MPAN/SPAN table ranges
+#define SCAN_READS_PER_OBJECT 5         ///< Flash reads a scan may spend per stored object
+
+typedef size_t (*enum_fn_t)(zpal_nvm_object_key_t * key_list, size_t key_list_size,
+                            zpal_nvm_object_key_t key_min, zpal_nvm_object_key_t key_max);
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static struct fdb_kvdb m_kvdb;
+static struct kv_cache_node m_kv_cache_nodes[FDB_KV_CACHE_TABLE_SIZE];
+
+static zpal_nvm_object_key_t m_keys[2 * BENCH_OBJECTS];
+static zpal_nvm_object_key_t m_reference_keys[2 * BENCH_OBJECTS];
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static void op_begin(bench_op_t * op, const char * name)
+{
+  bench_op_begin(op, name);
+  fal_ram_clear_stats();
+}
+
+static uint32_t flash_reads(void)
+{
+  fal_ram_stats_t stats;
+  fal_ram_get_stats(&stats);
+  return stats.reads;
+}
+
+static void op_report(const bench_op_t * op)
+{
+  printf("[bench] objects=%-5u %-36s n=%-4u mean=%10.2f us  max=%10.2f us  flash reads/op=%9.1f\n",
+         BENCH_OBJECTS, op->name, op->count,
+         bench_op_mean_us(op), bench_op_max_us(op), flash_reads() / bench_op_runs(op));
+}
+
+/*
+ * The enumeration used before: one lookup for every key in the range.
+ */
+static size_t enum_by_lookup(zpal_nvm_object_key_t * key_list, size_t key_list_size,
+                             zpal_nvm_object_key_t key_min, zpal_nvm_object_key_t key_max)
+{
+  char file_name[ZPAL_NVM_FILENAME_SIZE];
+  struct fdb_kv kv_obj;
+  size_t keys_count = 0;
+  for (zpal_nvm_object_key_t key = key_min; (key <= key_max) && (keys_count < key_list_size); key++) {
+    key_2_filename(BENCH_DB_NAME, key, file_name);
+    if (NULL != fdb_kv_get_obj(&m_kvdb, file_name, &kv_obj)) {
+      key_list[keys_count++] = key;
+    }
+    if (key == UINT32_MAX) {
+      break;
+    }
+  }
+  return keys_count;
+}
+
+static size_t enum_by_scan(zpal_nvm_object_key_t * key_list, size_t key_list_size,
+                           zpal_nvm_object_key_t key_min, zpal_nvm_object_key_t key_max)
+{
+  return flashdb_enum_keys(&m_kvdb, BENCH_DB_NAME, key_list, key_list_size, key_min, key_max);
+}
+
+static void store_object(const zpal_nvm_object_key_t key)
+{
+  char file_name[ZPAL_NVM_FILENAME_SIZE];
+  struct fdb_blob blob;
+  key_2_filename(BENCH_DB_NAME, key, file_name);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob(&m_kvdb, file_name, fdb_blob_make(&blob, &key, sizeof(key))));
+}
+
+static int compare_keys(const void * a, const void * b)
+{
+  const zpal_nvm_object_key_t key_a = *(const zpal_nvm_object_key_t *)a;
+  const zpal_nvm_object_key_t key_b = *(const zpal_nvm_object_key_t *)b;
+  return (key_a > key_b) - (key_a < key_b);
+}
+
+/*
+ * Both approaches must list the same keys, although not in the same order.
+ */
+static void assert_same_keys(zpal_nvm_object_key_t key_min, zpal_nvm_object_key_t key_max, size_t key_list_size)
+{
+  const size_t expected = enum_by_lookup(m_reference_keys, key_list_size, key_min, key_max);
+  const size_t count = enum_by_scan(m_keys, key_list_size, key_min, key_max);
+  TEST_ASSERT_EQUAL_size_t(expected, count);
+  qsort(m_keys, count, sizeof(zpal_nvm_object_key_t), compare_keys);
+  TEST_ASSERT_EQUAL_UINT32_ARRAY(m_reference_keys, m_keys, count);
+}
+
+/*
+ * Returns the mean number of flash reads per enumeration.
+ */
+static uint32_t bench_range(const char * name, enum_fn_t enum_fn, size_t expected_count,
+                            zpal_nvm_object_key_t key_min, zpal_nvm_object_key_t key_max)
+{
+  bench_op_t op;
+  const size_t key_list_size = key_max - key_min + 1;
+  op_begin(&op, name);
+  for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+    const uint64_t start = bench_now_ns();
+    const size_t count = enum_fn(m_keys, key_list_size, key_min, key_max);
+    bench_op_sample(&op, start);
+    TEST_ASSERT_EQUAL_size_t(expected_count, count);
+  }
+  op_report(&op);
+  return flash_reads() / op.count;
+}
+
+/*
+ * A scan reads every stored object a bounded number of times whatever the range,
+ * and must read less than a lookup of every key of the range.
+ */
+static void assert_scan_reads(const uint32_t scan_reads, const uint32_t lookup_reads)
+{
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(SCAN_READS_PER_OBJECT * BENCH_OBJECTS, scan_reads);
+  TEST_ASSERT_LESS_THAN_UINT32(lookup_reads, scan_reads);
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  // Start every workload from an empty flash
+  memset(&m_kvdb, 0, sizeof(m_kvdb));
+  fal_ram_init(BENCH_PART_NAME, BENCH_FLASH_SIZE);
+  // The target sets the KV cache of each area
+  struct fdb_kv_cache_table kv_cache = { m_kv_cache_nodes, FDB_KV_CACHE_TABLE_SIZE };
+  fdb_kvdb_control(&m_kvdb, FDB_KVDB_CTRL_SET_KV_CACHE, &kv_cache);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kvdb_init(&m_kvdb, BENCH_DB_NAME, BENCH_PART_NAME, NULL, NULL));
+
+  // Every other key of the range is stored, so half of the lookups miss
+  for (uint32_t i = 0; i < BENCH_OBJECTS; i++) {
+    store_object(BENCH_KEY_BASE + 2 * i);
+  }
+}
+
+void tearDown(void)
+{
+  fdb_kvdb_deinit(&m_kvdb);
+}
+
+/****************************************************************************/
+/*                                WORKLOADS                                 */
+/****************************************************************************/
+
+/**
+ * Lists every stored object, as the file system validation at boot does.
+ */
+void test_bench_enum_all_objects(void)
+{
+  const zpal_nvm_object_key_t key_max = BENCH_KEY_BASE + 2 * BENCH_OBJECTS - 1;
+  assert_same_keys(BENCH_KEY_BASE, key_max, 2 * BENCH_OBJECTS);
+
+  const uint32_t lookup_reads =
+    bench_range("enum all (lookup per key)", enum_by_lookup, BENCH_OBJECTS, BENCH_KEY_BASE, key_max);
+  const uint32_t scan_reads =
+    bench_range("enum all (single scan)", enum_by_scan, BENCH_OBJECTS, BENCH_KEY_BASE, key_max);
+  assert_scan_reads(scan_reads, lookup_reads);
+}
+
+/**
+ * Lists the objects of a small table, like the SPAN and MPAN tables, among
+ * all other stored objects.
+ */
+void test_bench_enum_small_range(void)
+{
+  const zpal_nvm_object_key_t key_min = BENCH_KEY_BASE + BENCH_OBJECTS;
+  const zpal_nvm_object_key_t key_max = key_min + BENCH_SMALL_RANGE - 1;
+  assert_same_keys(key_min, key_max, BENCH_SMALL_RANGE);
+
+  const uint32_t lookup_reads =
+    bench_range("enum small range (lookup per key)", enum_by_lookup, BENCH_SMALL_RANGE / 2, key_min, key_max);
+  const uint32_t scan_reads =
+    bench_range("enum small range (single scan)", enum_by_scan, BENCH_SMALL_RANGE / 2, key_min, key_max);
+  assert_scan_reads(scan_reads, lookup_reads);
+}
+
+/**
+ * Lists the objects of a table that does not exist yet, as happens on the
+ * first boot after an update that adds a file.
+ */
+void test_bench_enum_empty_range(void)
+{
+  const zpal_nvm_object_key_t key_min = BENCH_KEY_BASE + 2 * BENCH_OBJECTS;
+  const zpal_nvm_object_key_t key_max = key_min + BENCH_SMALL_RANGE - 1;
+  assert_same_keys(key_min, key_max, BENCH_SMALL_RANGE);
+
+  const uint32_t lookup_reads =
+    bench_range("enum empty range (lookup per key)", enum_by_lookup, 0, key_min, key_max);
+  const uint32_t scan_reads =
+    bench_range("enum empty range (single scan)", enum_by_scan, 0, key_min, key_max);
+  assert_scan_reads(scan_reads, lookup_reads);
+}
+
+/**
+ * A '0' byte of a KV name stands for both a zero byte and a '0' byte of the
+ * key, so a lookup finds both keys. The scan must list both as well.
+ */
+void test_enum_ambiguous_key_bytes(void)
+{
+  const zpal_nvm_object_key_t expected[] = { 0x00000000, 0x00000030, 0x00003000, 0x00003030,
+                                             0x00003100, 0x00003130 };
+  store_object(0x00000000);
+  store_object(0x00003100);
+
+  const size_t count = enum_by_scan(m_keys, 2 * BENCH_OBJECTS, 0x00000000, 0x00003131);
+  TEST_ASSERT_EQUAL_size_t(sizeof(expected) / sizeof(expected[0]), count);
+  qsort(m_keys, count, sizeof(zpal_nvm_object_key_t), compare_keys);
+  TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, m_keys, count);
+
+  // The list is cut at its size
+  TEST_ASSERT_EQUAL_size_t(1, enum_by_scan(m_keys, 1, 0x00000000, 0x00003131));
+}
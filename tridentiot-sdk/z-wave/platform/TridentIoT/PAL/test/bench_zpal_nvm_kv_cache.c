@@ -0,0 +1,278 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file bench_zpal_nvm_kv_cache.c
+ * @brief Host benchmark of the KV cache of the FlashDB NVM driver.
+ *
+ *        A KV found in the cache is read with a single flash access, while a
+ *        cache miss walks through all sectors. The User Credential objects of
+ *        a populated lock are read from a RAM backed FlashDB partition, and the
+ *        latency, the flash accesses and the cache statistics are reported and
+ *        checked against what each cache size must achieve.
+ *
+ *        The number of stored objects and of cache nodes are set at build time
+ *        with BENCH_OBJECTS and BENCH_CACHE_NODES.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+
+#include <unity.h>
+#include <flashdb.h>
+#include "bench_op.h"
+#include "fal_ram.h"
+#include "zpal_nvm_flashdb_keys.h"
+#include <stdio.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#if !defined(BENCH_OBJECTS)
+#define BENCH_OBJECTS      200
+#endif
+
+#if !defined(BENCH_CACHE_NODES)
+#define BENCH_CACHE_NODES  256
+#endif
+
+#define BENCH_DB_NAME        "ZAF"
+#define BENCH_PART_NAME      "bench_db"
+// Room for the objects, the sector GC keeps free and some spare
+#define BENCH_FLASH_SIZE     (((BENCH_OBJECTS * 64) / FAL_RAM_SECTOR_SIZE + 3) * FAL_RAM_SECTOR_SIZE)
+#define BENCH_KEY_BASE       0x00050101 ///< Stored keys are BENCH_KEY_BASE + n, n < 255
+#define BENCH_ROUNDS         5
+#define HIT_FLASH_READS_MAX  6                        ///< Flash reads of a KV found in the cache
+#define MISS_FLASH_READS_MAX (3 * BENCH_OBJECTS)      ///< Flash reads of a walk through all KVs
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static struct fdb_kvdb m_kvdb;
+static struct kv_cache_node m_kv_cache_nodes[BENCH_CACHE_NODES];
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static void op_begin(bench_op_t * op, const char * name)
+{
+  bench_op_begin(op, name);
+  fal_ram_clear_stats();
+}
+
+static uint32_t flash_reads(void)
+{
+  fal_ram_stats_t stats;
+  fal_ram_get_stats(&stats);
+  return stats.reads;
+}
+
+static void op_report(const bench_op_t * op)
+{
+  printf("[bench] objects=%-5u cache=%-4u %-24s n=%-5u mean=%10.2f us  max=%10.2f us  flash reads/op=%9.1f\n",
+         BENCH_OBJECTS, BENCH_CACHE_NODES, op->name, op->count,
+         bench_op_mean_us(op), bench_op_max_us(op), flash_reads() / bench_op_runs(op));
+}
+
+static struct fdb_kv_cache_stats get_cache_stats(void)
+{
+  struct fdb_kv_cache_stats stats;
+  fdb_kvdb_control(&m_kvdb, FDB_KVDB_CTRL_GET_KV_CACHE_STATS, &stats);
+  return stats;
+}
+
+static void init_kvdb(struct kv_cache_node * nodes, size_t num)
+{
+  struct fdb_kv_cache_table kv_cache = { nodes, num };
+  memset(&m_kvdb, 0, sizeof(m_kvdb));
+  fdb_kvdb_control(&m_kvdb, FDB_KVDB_CTRL_SET_KV_CACHE, &kv_cache);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kvdb_init(&m_kvdb, BENCH_DB_NAME, BENCH_PART_NAME, NULL, NULL));
+}
+
+static void store_object(const zpal_nvm_object_key_t key)
+{
+  char file_name[ZPAL_NVM_FILENAME_SIZE];
+  struct fdb_blob blob;
+  key_2_filename(BENCH_DB_NAME, key, file_name);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob(&m_kvdb, file_name, fdb_blob_make(&blob, &key, sizeof(key))));
+}
+
+static size_t read_object(const zpal_nvm_object_key_t key, zpal_nvm_object_key_t * value)
+{
+  char file_name[ZPAL_NVM_FILENAME_SIZE];
+  struct fdb_blob blob;
+  key_2_filename(BENCH_DB_NAME, key, file_name);
+  return fdb_kv_get_blob(&m_kvdb, file_name, fdb_blob_make(&blob, value, sizeof(*value)));
+}
+
+static void assert_object(const zpal_nvm_object_key_t key)
+{
+  zpal_nvm_object_key_t value = 0;
+  TEST_ASSERT_EQUAL_size_t(sizeof(value), read_object(key, &value));
+  TEST_ASSERT_EQUAL_UINT32(key, value);
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  // Start every workload from an empty flash
+  fal_ram_init(BENCH_PART_NAME, BENCH_FLASH_SIZE);
+  init_kvdb(m_kv_cache_nodes, BENCH_CACHE_NODES);
+}
+
+void tearDown(void)
+{
+  fdb_kvdb_deinit(&m_kvdb);
+}
+
+/****************************************************************************/
+/*                                WORKLOADS                                 */
+/****************************************************************************/
+
+/**
+ * Reads every stored object, as the User Credential CC does when it reports
+ * all Users and Credentials after a reboot.
+ */
+void test_bench_read_all_objects(void)
+{
+  bench_op_t op;
+
+  for (uint32_t i = 0; i < BENCH_OBJECTS; i++) {
+    store_object(BENCH_KEY_BASE + i);
+  }
+  // The cache is filled with the stored KVs when the database is loaded
+  fdb_kvdb_deinit(&m_kvdb);
+  init_kvdb(m_kv_cache_nodes, BENCH_CACHE_NODES);
+  const struct fdb_kv_cache_stats loaded = get_cache_stats();
+
+  op_begin(&op, "read all objects");
+  for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+    for (uint32_t i = 0; i < BENCH_OBJECTS; i++) {
+      const uint64_t start = bench_now_ns();
+      zpal_nvm_object_key_t value = 0;
+      const size_t read = read_object(BENCH_KEY_BASE + i, &value);
+      bench_op_sample(&op, start);
+      TEST_ASSERT_EQUAL_size_t(sizeof(value), read);
+      TEST_ASSERT_EQUAL_UINT32(BENCH_KEY_BASE + i, value);
+    }
+  }
+  op_report(&op);
+
+  const struct fdb_kv_cache_stats stats = get_cache_stats();
+  const uint32_t hits = stats.hits - loaded.hits;
+  const uint32_t misses = stats.misses - loaded.misses;
+  printf("[bench] objects=%-5u cache=%-4u hits=%u misses=%u evictions=%u\n",
+         BENCH_OBJECTS, BENCH_CACHE_NODES, hits, misses, stats.evictions - loaded.evictions);
+  TEST_ASSERT_EQUAL_UINT32(BENCH_ROUNDS * BENCH_OBJECTS, hits + misses);
+  // A hit costs a few flash reads, a miss at most one walk through the KVs
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(hits * HIT_FLASH_READS_MAX + misses * MISS_FLASH_READS_MAX,
+                                   flash_reads());
+#if BENCH_CACHE_NODES > BENCH_OBJECTS
+  // Only the objects whose probe sequence is full are missed
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(BENCH_ROUNDS * BENCH_OBJECTS * 9 / 10, hits);
+  // Which keeps the flash reads close to those of hitting on every read
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(BENCH_ROUNDS * BENCH_OBJECTS * HIT_FLASH_READS_MAX + MISS_FLASH_READS_MAX,
+                                   flash_reads());
+#else
+  // Reading the objects in turn evicts each of them before it is read again
+  TEST_ASSERT_EQUAL_UINT32(0, hits);
+#endif
+}
+
+/**
+ * The cache must follow the objects when they are overwritten and erased.
+ */
+void test_kv_cache_follows_writes(void)
+{
+  zpal_nvm_object_key_t value;
+
+  for (uint32_t i = 0; i < 8; i++) {
+    store_object(BENCH_KEY_BASE + i);
+  }
+  for (uint32_t i = 0; i < 8; i++) {
+    assert_object(BENCH_KEY_BASE + i);
+  }
+
+  // Overwritten with another value
+  char file_name[ZPAL_NVM_FILENAME_SIZE];
+  struct fdb_blob blob;
+  const zpal_nvm_object_key_t new_value = 0xCAFE;
+  key_2_filename(BENCH_DB_NAME, BENCH_KEY_BASE, file_name);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob(&m_kvdb, file_name, fdb_blob_make(&blob, &new_value, sizeof(new_value))));
+  TEST_ASSERT_EQUAL_size_t(sizeof(value), read_object(BENCH_KEY_BASE, &value));
+  TEST_ASSERT_EQUAL_UINT32(new_value, value);
+
+  // Erased
+  key_2_filename(BENCH_DB_NAME, BENCH_KEY_BASE + 1, file_name);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_del(&m_kvdb, file_name));
+  const struct fdb_kv_cache_stats before = get_cache_stats();
+  TEST_ASSERT_EQUAL_size_t(0, read_object(BENCH_KEY_BASE + 1, &value));
+  TEST_ASSERT_EQUAL_UINT32(before.misses + 1, get_cache_stats().misses);
+
+  for (uint32_t i = 2; i < 8; i++) {
+    assert_object(BENCH_KEY_BASE + i);
+  }
+}
+
+/**
+ * With a table of FDB_KV_CACHE_PROBE_MAX nodes all KVs share the same nodes,
+ * so the least recently used KV is replaced.
+ */
+void test_kv_cache_replaces_least_recently_used(void)
+{
+  struct kv_cache_node nodes[FDB_KV_CACHE_PROBE_MAX];
+  const uint32_t objects = FDB_KV_CACHE_PROBE_MAX + 1;
+
+  for (uint32_t i = 0; i < objects; i++) {
+    store_object(BENCH_KEY_BASE + i);
+  }
+  fdb_kvdb_deinit(&m_kvdb);
+  init_kvdb(nodes, FDB_KV_CACHE_PROBE_MAX);
+
+  // Fill the cache with all but the last object, the first one is the least recently used
+  for (uint32_t i = 0; i < objects - 1; i++) {
+    assert_object(BENCH_KEY_BASE + i);
+  }
+  struct fdb_kv_cache_stats before = get_cache_stats();
+  assert_object(BENCH_KEY_BASE + objects - 1);
+  struct fdb_kv_cache_stats after = get_cache_stats();
+  TEST_ASSERT_EQUAL_UINT32(before.misses + 1, after.misses);
+  TEST_ASSERT_EQUAL_UINT32(before.evictions + 1, after.evictions);
+
+  // All others are still cached
+  before = after;
+  for (uint32_t i = 1; i < objects; i++) {
+    assert_object(BENCH_KEY_BASE + i);
+  }
+  after = get_cache_stats();
+  TEST_ASSERT_EQUAL_UINT32(before.hits + objects - 1, after.hits);
+  TEST_ASSERT_EQUAL_UINT32(before.misses, after.misses);
+
+  // The first one was replaced
+  assert_object(BENCH_KEY_BASE);
+  TEST_ASSERT_EQUAL_UINT32(after.misses + 1, get_cache_stats().misses);
+
+  fdb_kvdb_deinit(&m_kvdb);
+  init_kvdb(m_kv_cache_nodes, BENCH_CACHE_NODES);
+}
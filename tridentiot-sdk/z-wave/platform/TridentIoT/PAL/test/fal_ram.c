@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file fal_ram.c
+ * @brief RAM backed NOR flash device for FAL, see fal_ram.h.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include "fal_ram.h"
+#include <fal.h>
+#include <assert.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define FAL_PART_MAGIC_WORD  0x45503130 ///< Partition magic word of fal_partition.c
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static uint8_t m_flash[FAL_RAM_FLASH_SIZE];
+static fal_ram_stats_t m_stats;
+static struct fal_partition m_partition;
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static int ram_flash_init(void)
+{
+  return 0;
+}
+
+static int ram_flash_read(long offset, uint8_t * buf, size_t size)
+{
+  m_stats.reads++;
+  memcpy(buf, &m_flash[offset], size);
+  return (int)size;
+}
+
+static int ram_flash_write(long offset, const uint8_t * buf, size_t size)
+{
+  m_stats.writes++;
+  // NOR flash can only clear bits
+  for (size_t i = 0; i < size; i++) {
+    m_flash[offset + i] &= buf[i];
+  }
+  return (int)size;
+}
+
+static int ram_flash_erase(long offset, size_t size)
+{
+  m_stats.erases++;
+  memset(&m_flash[offset], 0xFF, size);
+  return (int)size;
+}
+
+/****************************************************************************/
+/*                              STUBBED FUNCTIONS                           */
+/****************************************************************************/
+
+// Name of the flash device in fal_cfg.h of the target
+const struct fal_flash_dev t32cz20_onchip_flash = {
+  .name = NOR_FLASH_DEV_NAME,
+  .addr = 0,
+  .len = FAL_RAM_FLASH_SIZE,
+  .blk_size = FAL_RAM_SECTOR_SIZE,
+  .ops = { ram_flash_init, ram_flash_read, ram_flash_write, ram_flash_erase },
+  .write_gran = 1
+};
+
+/****************************************************************************/
+/*                       EXPORTED FUNCTION DEFINITIONS                      */
+/****************************************************************************/
+
+void fal_ram_init(const char * part_name, const size_t size)
+{
+  assert((size <= FAL_RAM_FLASH_SIZE) && (0 == (size % FAL_RAM_SECTOR_SIZE)));
+
+  memset(&m_partition, 0, sizeof(m_partition));
+  m_partition.magic_word = FAL_PART_MAGIC_WORD;
+  strncpy(m_partition.name, part_name, sizeof(m_partition.name) - 1);
+  strncpy(m_partition.flash_name, NOR_FLASH_DEV_NAME, sizeof(m_partition.flash_name) - 1);
+  m_partition.len = size;
+
+  fal_ram_erase();
+  fal_ram_clear_stats();
+  fal_init();
+  fal_set_partition_table_temp(&m_partition, 1);
+}
+
+void fal_ram_erase(void)
+{
+  memset(m_flash, 0xFF, sizeof(m_flash));
+}
+
+const uint8_t * fal_ram_get_flash(void)
+{
+  return m_flash;
+}
+
+void fal_ram_get_stats(fal_ram_stats_t * stats)
+{
+  *stats = m_stats;
+}
+
+void fal_ram_clear_stats(void)
+{
+  memset(&m_stats, 0, sizeof(m_stats));
+}
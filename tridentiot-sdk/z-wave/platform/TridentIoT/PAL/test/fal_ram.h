@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file fal_ram.h
+ * @brief This file contains a RAM backed NOR flash device for FAL, used to run
+ *        FlashDB and the NVM driver on a host.
+ *
+ *        The device replaces t32cz20_onchip_flash of fal_cfg.h and holds a
+ *        single partition. Flash accesses are counted.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#ifndef _FAL_RAM_H_
+#define _FAL_RAM_H_
+
+/* CPP type safety */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/****************************************************************************/
+/*                      EXPORTED TYPES AND DEFINITIONS                      */
+/****************************************************************************/
+
+/// Size of a flash sector, in bytes
+#define FAL_RAM_SECTOR_SIZE  4096
+
+/// Size of the flash device, the largest partition that can be set up
+#if !defined(FAL_RAM_FLASH_SIZE)
+#define FAL_RAM_FLASH_SIZE  (32 * FAL_RAM_SECTOR_SIZE)
+#endif
+
+/**
+ * @brief Counters of the flash accesses made since the last reset.
+ */
+typedef struct fal_ram_stats_ {
+  uint32_t reads;   ///< Read operations
+  uint32_t writes;  ///< Write operations
+  uint32_t erases;  ///< Erase operations
+} fal_ram_stats_t;
+
+/****************************************************************************/
+/*                      EXPORTED FUNCTION DECLARATIONS                      */
+/****************************************************************************/
+
+/**
+ * @brief Erases the flash, clears the counters and initializes FAL with a single
+ *        partition at the start of the flash.
+ *
+ * @param part_name Name of the partition, as passed to fdb_kvdb_init()
+ * @param size      Size of the partition, a multiple of FAL_RAM_SECTOR_SIZE of
+ *                  at most FAL_RAM_FLASH_SIZE
+ */
+void fal_ram_init(const char * part_name, const size_t size);
+
+/**
+ * @brief Erases the whole flash, keeping the partition and the counters.
+ */
+void fal_ram_erase(void);
+
+/**
+ * @brief Gets the content of the flash, e.g. to check sector headers.
+ *
+ * @return Pointer to the first byte of the flash.
+ */
+const uint8_t * fal_ram_get_flash(void);
+
+/**
+ * @brief Gets the counters of the flash accesses made since the last call to
+ *        fal_ram_clear_stats() or fal_ram_init().
+ *
+ * @param[out] stats Pointer in which to return the counters
+ */
+void fal_ram_get_stats(fal_ram_stats_t * stats);
+
+/**
+ * @brief Clears the access counters, keeping the content of the flash.
+ */
+void fal_ram_clear_stats(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* _FAL_RAM_H_ */
@@ -0,0 +1,531 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_fdb_kvdb.c
+ * @brief Host tests of the KV database extensions of FlashDB used by the NVM
+ *        driver, run against a RAM backed FlashDB partition.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+
+#include <unity.h>
+#include <flashdb.h>
+#include <fdb_low_lvl.h>
+#include "fal_ram.h"
+#include <stdio.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define TEST_DB_NAME       "ZAF"
+#define TEST_PART_NAME     "test_db"
+#define TEST_SECTOR_SIZE   FAL_RAM_SECTOR_SIZE
+#define TEST_SECTORS       6
+#define TEST_FLASH_SIZE    (TEST_SECTORS * TEST_SECTOR_SIZE)
+// Number of empty sectors kept for the GC on write, FDB_GC_EMPTY_SEC_THRESHOLD of fdb_kvdb.c
+#define TEST_GC_RESERVED_SECTORS  1
+// Number of empty sectors at which the GC step starts, FDB_GC_STEP_EMPTY_SEC_WATERMARK of fdb_kvdb.c
+#define TEST_GC_STEP_WATERMARK    2
+#define TEST_GC_KEYS              60
+#define TEST_GC_VALUE_SIZE_MAX    40
+// Nodes of the KV cache table, few enough for every KV to compete for all of them
+#define TEST_CACHE_NODES          3
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static struct fdb_kvdb m_kvdb;
+static uint32_t m_random;
+static uint8_t m_gc_values[TEST_GC_KEYS][TEST_GC_VALUE_SIZE_MAX];
+static size_t m_gc_value_sizes[TEST_GC_KEYS];
+static struct kv_cache_node m_cache_nodes[TEST_CACHE_NODES];
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static uint32_t flash_writes(void)
+{
+  fal_ram_stats_t stats;
+  fal_ram_get_stats(&stats);
+  return stats.writes;
+}
+
+static void init_kvdb(void)
+{
+  memset(&m_kvdb, 0, sizeof(m_kvdb));
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kvdb_init(&m_kvdb, TEST_DB_NAME, TEST_PART_NAME, NULL, NULL));
+}
+
+static void init_kvdb_with_cache(void)
+{
+  struct fdb_kv_cache_table kv_cache = { m_cache_nodes, TEST_CACHE_NODES };
+  fdb_kvdb_deinit(&m_kvdb);
+  memset(&m_kvdb, 0, sizeof(m_kvdb));
+  fdb_kvdb_control(&m_kvdb, FDB_KVDB_CTRL_SET_KV_CACHE, &kv_cache);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kvdb_init(&m_kvdb, TEST_DB_NAME, TEST_PART_NAME, NULL, NULL));
+}
+
+static struct fdb_kv_cache_stats get_cache_stats(void)
+{
+  struct fdb_kv_cache_stats stats;
+  fdb_kvdb_control(&m_kvdb, FDB_KVDB_CTRL_GET_KV_CACHE_STATS, &stats);
+  return stats;
+}
+
+static void get_kv(const char * key)
+{
+  struct fdb_kv kv;
+  TEST_ASSERT_TRUE(fdb_kv_get_obj(&m_kvdb, key, &kv));
+}
+
+static void set_kv(const char * key, const void * value, size_t size)
+{
+  struct fdb_blob blob;
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob(&m_kvdb, key, fdb_blob_make(&blob, value, size)));
+}
+
+static void assert_kv(const char * key, const void * expected, size_t size)
+{
+  uint8_t value[64];
+  struct fdb_blob blob;
+  TEST_ASSERT_EQUAL_size_t(size, fdb_kv_get_blob(&m_kvdb, key, fdb_blob_make(&blob, value, sizeof(value))));
+  TEST_ASSERT_EQUAL_size_t(size, blob.saved.len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, value, size);
+}
+
+static uint32_t next_random(void)
+{
+  m_random = m_random * 1103515245u + 12345u;
+  return m_random >> 16;
+}
+
+static void gc_key(uint32_t index, char * key)
+{
+  snprintf(key, FDB_KV_NAME_MAX + 1, "G%04u", (unsigned)index);
+}
+
+static fdb_sector_store_status_t sector_store_status(uint32_t sector)
+{
+  uint8_t status_table[FDB_STORE_STATUS_TABLE_SIZE];
+  memcpy(status_table, &fal_ram_get_flash()[sector * TEST_SECTOR_SIZE], sizeof(status_table));
+  return (fdb_sector_store_status_t)_fdb_get_status(status_table, FDB_SECTOR_STORE_STATUS_NUM);
+}
+
+static fdb_sector_dirty_status_t sector_dirty_status(uint32_t sector)
+{
+  // The dirty status table follows the store status table in the sector header
+  uint8_t status_table[FDB_DIRTY_STATUS_TABLE_SIZE];
+  memcpy(status_table, &fal_ram_get_flash()[sector * TEST_SECTOR_SIZE + FDB_STORE_STATUS_TABLE_SIZE], sizeof(status_table));
+  return (fdb_sector_dirty_status_t)_fdb_get_status(status_table, FDB_SECTOR_DIRTY_STATUS_NUM);
+}
+
+static uint32_t count_empty_sectors(void)
+{
+  uint32_t empty = 0;
+  for (uint32_t sector = 0; sector < TEST_SECTORS; sector++) {
+    if (FDB_SECTOR_STORE_EMPTY == sector_store_status(sector)) {
+      empty++;
+    }
+  }
+  return empty;
+}
+
+/**
+ * Returns the sector which is being collected, or TEST_SECTORS if there is none.
+ */
+static uint32_t find_gc_sector(void)
+{
+  uint32_t gc_sector = TEST_SECTORS;
+  for (uint32_t sector = 0; sector < TEST_SECTORS; sector++) {
+    if (FDB_SECTOR_DIRTY_GC == sector_dirty_status(sector)) {
+      // Only one sector is collected at a time
+      TEST_ASSERT_EQUAL_UINT32(TEST_SECTORS, gc_sector);
+      gc_sector = sector;
+    }
+  }
+  return gc_sector;
+}
+
+static uint32_t count_sector_kvs(uint32_t sector)
+{
+  struct fdb_kv kv;
+  char key[FDB_KV_NAME_MAX + 1];
+  uint32_t kvs = 0;
+  for (uint32_t i = 0; i < TEST_GC_KEYS; i++) {
+    gc_key(i, key);
+    if (fdb_kv_get_obj(&m_kvdb, key, &kv) && (kv.addr.start / TEST_SECTOR_SIZE == sector)) {
+      kvs++;
+    }
+  }
+  return kvs;
+}
+
+static void set_gc_kv(uint32_t index, size_t size)
+{
+  char key[FDB_KV_NAME_MAX + 1];
+  for (size_t i = 0; i < size; i++) {
+    m_gc_values[index][i] = (uint8_t)next_random();
+  }
+  m_gc_value_sizes[index] = size;
+  gc_key(index, key);
+  set_kv(key, m_gc_values[index], size);
+}
+
+/**
+ * Same as set_gc_kv(), but written with fdb_kv_set_blob_if_changed().
+ */
+static bool set_gc_kv_if_changed(uint32_t index, size_t size)
+{
+  char key[FDB_KV_NAME_MAX + 1];
+  struct fdb_blob blob;
+  bool changed = false;
+  for (size_t i = 0; i < size; i++) {
+    m_gc_values[index][i] = (uint8_t)next_random();
+  }
+  m_gc_value_sizes[index] = size;
+  gc_key(index, key);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob_if_changed(&m_kvdb, key, fdb_blob_make(&blob, m_gc_values[index], size), &changed));
+  return changed;
+}
+
+/**
+ * Every KV holds its last value, and is stored exactly once.
+ */
+static void assert_gc_kvs(void)
+{
+  char key[FDB_KV_NAME_MAX + 1];
+  uint32_t stored = 0;
+  for (uint32_t i = 0; i < TEST_GC_KEYS; i++) {
+    if (m_gc_value_sizes[i] > 0) {
+      gc_key(i, key);
+      assert_kv(key, m_gc_values[i], m_gc_value_sizes[i]);
+      stored++;
+    }
+  }
+
+  struct fdb_kv_iterator iterator;
+  uint32_t iterated = 0;
+  fdb_kv_iterator_init(&m_kvdb, &iterator);
+  while (fdb_kv_iterate(&m_kvdb, &iterator)) {
+    iterated++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(stored, iterated);
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  m_random = 1;
+  memset(m_gc_value_sizes, 0, sizeof(m_gc_value_sizes));
+  fal_ram_init(TEST_PART_NAME, TEST_FLASH_SIZE);
+  init_kvdb();
+}
+
+void tearDown(void)
+{
+  fdb_kvdb_deinit(&m_kvdb);
+}
+
+/****************************************************************************/
+/*                                  TESTS                                   */
+/****************************************************************************/
+
+/**
+ * A part written inside a KV only changes the bytes it covers.
+ */
+void test_fdb_kv_set_blob_part_inside(void)
+{
+  uint8_t value[16];
+  const uint8_t patch[4] = { 0xA1, 0xA2, 0xA3, 0xA4 };
+  struct fdb_blob blob;
+
+  for (uint8_t i = 0; i < sizeof(value); i++) {
+    value[i] = i;
+  }
+  set_kv("K0001", value, sizeof(value));
+
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob_part(&m_kvdb, "K0001", 5, fdb_blob_make(&blob, patch, sizeof(patch))));
+  memcpy(&value[5], patch, sizeof(patch));
+  assert_kv("K0001", value, sizeof(value));
+
+  // The part is also found after the database is loaded again
+  fdb_kvdb_deinit(&m_kvdb);
+  init_kvdb();
+  assert_kv("K0001", value, sizeof(value));
+}
+
+/**
+ * A part may end at the end of the KV, but must not go beyond it.
+ */
+void test_fdb_kv_set_blob_part_at_end(void)
+{
+  uint8_t value[16];
+  const uint8_t patch[3] = { 0xB1, 0xB2, 0xB3 };
+  struct fdb_blob blob;
+
+  memset(value, 0x11, sizeof(value));
+  set_kv("K0002", value, sizeof(value));
+
+  const size_t offset = sizeof(value) - sizeof(patch);
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob_part(&m_kvdb, "K0002", offset, fdb_blob_make(&blob, patch, sizeof(patch))));
+  memcpy(&value[offset], patch, sizeof(patch));
+  assert_kv("K0002", value, sizeof(value));
+
+  // One byte beyond the end is rejected and the KV is left as it was
+  TEST_ASSERT_EQUAL(FDB_WRITE_ERR, fdb_kv_set_blob_part(&m_kvdb, "K0002", offset + 1, fdb_blob_make(&blob, patch, sizeof(patch))));
+  assert_kv("K0002", value, sizeof(value));
+
+  // A part of a KV that does not exist is rejected
+  TEST_ASSERT_EQUAL(FDB_KV_NAME_ERR, fdb_kv_set_blob_part(&m_kvdb, "K0003", 0, fdb_blob_make(&blob, patch, 1)));
+}
+
+/**
+ * A sector which is partly collected is continued by the next GC step, until all
+ * of its KVs are moved and it is formatted.
+ */
+void test_fdb_kv_gc_step_resumes_sector(void)
+{
+  // Two sectors of KVs, then every other KV is rewritten until the GC step starts
+  for (uint32_t i = 0; i < TEST_GC_KEYS; i++) {
+    set_gc_kv(i, TEST_GC_VALUE_SIZE_MAX);
+  }
+  for (uint32_t i = 0; count_empty_sectors() > TEST_GC_STEP_WATERMARK; i = (i + 2) % TEST_GC_KEYS) {
+    set_gc_kv(i, TEST_GC_VALUE_SIZE_MAX);
+  }
+  TEST_ASSERT_EQUAL_UINT32(TEST_SECTORS, find_gc_sector());
+
+  TEST_ASSERT_TRUE(fdb_kv_gc_step(&m_kvdb, 1));
+  const uint32_t gc_sector = find_gc_sector();
+  TEST_ASSERT_TRUE(gc_sector < TEST_SECTORS);
+  uint32_t kvs = count_sector_kvs(gc_sector);
+  TEST_ASSERT_TRUE(kvs > 1);
+
+  // Each step moves one more KV out of the same sector
+  while (kvs > 0) {
+    TEST_ASSERT_TRUE(fdb_kv_gc_step(&m_kvdb, 1));
+    TEST_ASSERT_EQUAL_UINT32(kvs - 1, count_sector_kvs(gc_sector));
+    kvs--;
+    if (kvs > 0) {
+      TEST_ASSERT_EQUAL_UINT32(gc_sector, find_gc_sector());
+    }
+  }
+  // Formatted by the step which moved the last KV
+  TEST_ASSERT_EQUAL_UINT32(TEST_SECTORS, find_gc_sector());
+  TEST_ASSERT_EQUAL(FDB_SECTOR_STORE_EMPTY, sector_store_status(gc_sector));
+  assert_gc_kvs();
+}
+
+/**
+ * Random writes mixed with GC steps, with the database loaded again from time to
+ * time. No KV may be lost or stored twice, and the GC steps must never take the
+ * empty sectors kept for the GC on write.
+ */
+void test_fdb_kv_gc_step_random_writes(void)
+{
+  uint32_t resumed = 0;
+
+  for (uint32_t n = 0; n < 40000; n++) {
+    set_gc_kv(next_random() % TEST_GC_KEYS, 1 + next_random() % TEST_GC_VALUE_SIZE_MAX);
+
+    if (0 == next_random() % 4) {
+      for (uint8_t step = 0; step < 3; step++) {
+        const uint32_t empty = count_empty_sectors();
+        if (find_gc_sector() < TEST_SECTORS) {
+          resumed++;
+        }
+        if (!fdb_kv_gc_step(&m_kvdb, 4)) {
+          break;
+        }
+        const uint32_t reserved = (empty < TEST_GC_RESERVED_SECTORS) ? empty : TEST_GC_RESERVED_SECTORS;
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(reserved, count_empty_sectors());
+      }
+    }
+    if (0 == n % 997) {
+      assert_gc_kvs();
+    }
+    if (0 == n % 4001) {
+      fdb_kvdb_deinit(&m_kvdb);
+      init_kvdb();
+      assert_gc_kvs();
+    }
+  }
+  assert_gc_kvs();
+  TEST_ASSERT_TRUE(resumed > 0);
+}
+
+/**
+ * Writing the value a KV already holds does not write to the flash.
+ */
+void test_fdb_kv_set_blob_if_changed_unchanged(void)
+{
+  uint8_t value[16];
+  struct fdb_blob blob;
+  bool changed = true;
+
+  memset(value, 0x33, sizeof(value));
+  set_kv("K0004", value, sizeof(value));
+
+  fal_ram_clear_stats();
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob_if_changed(&m_kvdb, "K0004", fdb_blob_make(&blob, value, sizeof(value)), &changed));
+  TEST_ASSERT_FALSE(changed);
+  TEST_ASSERT_EQUAL_UINT32(0, flash_writes());
+  assert_kv("K0004", value, sizeof(value));
+}
+
+/**
+ * A new content, a new length or a new key is written, and replaces the
+ * saved KV.
+ */
+void test_fdb_kv_set_blob_if_changed_changed(void)
+{
+  uint8_t value[16];
+  struct fdb_blob blob;
+  bool changed = false;
+
+  memset(value, 0x44, sizeof(value));
+  set_kv("K0005", value, sizeof(value));
+
+  // Same length, one byte differs
+  value[sizeof(value) - 1] = 0x45;
+  fal_ram_clear_stats();
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob_if_changed(&m_kvdb, "K0005", fdb_blob_make(&blob, value, sizeof(value)), &changed));
+  TEST_ASSERT_TRUE(changed);
+  TEST_ASSERT_TRUE(flash_writes() > 0);
+  assert_kv("K0005", value, sizeof(value));
+
+  // Same content, shorter
+  changed = false;
+  fal_ram_clear_stats();
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob_if_changed(&m_kvdb, "K0005", fdb_blob_make(&blob, value, sizeof(value) - 1), &changed));
+  TEST_ASSERT_TRUE(changed);
+  TEST_ASSERT_TRUE(flash_writes() > 0);
+  assert_kv("K0005", value, sizeof(value) - 1);
+
+  // A key which is not saved yet
+  changed = false;
+  TEST_ASSERT_EQUAL(FDB_NO_ERR, fdb_kv_set_blob_if_changed(&m_kvdb, "K0006", fdb_blob_make(&blob, value, sizeof(value)), &changed));
+  TEST_ASSERT_TRUE(changed);
+  assert_kv("K0006", value, sizeof(value));
+
+  // The old KV is deleted, also after the database is loaded again
+  fdb_kvdb_deinit(&m_kvdb);
+  init_kvdb();
+  assert_kv("K0005", value, sizeof(value) - 1);
+  struct fdb_kv_iterator iterator;
+  uint32_t iterated = 0;
+  fdb_kv_iterator_init(&m_kvdb, &iterator);
+  while (fdb_kv_iterate(&m_kvdb, &iterator)) {
+    iterated++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(2, iterated);
+}
+
+/**
+ * The KV found before the write may be moved by the GC which makes room for
+ * the new KV. The moved KV must be the one deleted, so the key is stored once.
+ *
+ * The database is filled up to a number of writes more for each attempt,
+ * until the write of the KV is the one which starts the GC of its sector.
+ */
+void test_fdb_kv_set_blob_if_changed_moved_by_gc(void)
+{
+  const uint32_t moved_index = TEST_GC_KEYS - 1;
+  const uint32_t rewritten_keys = 10;
+  bool moved = false;
+
+  for (uint32_t extra_writes = 0; !moved && extra_writes < 100; extra_writes++) {
+    fdb_kvdb_deinit(&m_kvdb);
+    fal_ram_erase();
+    memset(m_gc_value_sizes, 0, sizeof(m_gc_value_sizes));
+    init_kvdb();
+
+    // The KV goes first into the oldest sector, which the other KVs make dirty
+    set_gc_kv(moved_index, TEST_GC_VALUE_SIZE_MAX);
+    uint32_t i = 0;
+    while (count_empty_sectors() > TEST_GC_RESERVED_SECTORS) {
+      set_gc_kv(i++ % rewritten_keys, TEST_GC_VALUE_SIZE_MAX);
+    }
+    for (uint32_t n = 0; n < extra_writes; n++) {
+      set_gc_kv(i++ % rewritten_keys, TEST_GC_VALUE_SIZE_MAX);
+    }
+
+    char key[FDB_KV_NAME_MAX + 1];
+    struct fdb_kv kv;
+    gc_key(moved_index, key);
+    TEST_ASSERT_TRUE(fdb_kv_get_obj(&m_kvdb, key, &kv));
+    const uint32_t sector = kv.addr.start / TEST_SECTOR_SIZE;
+
+    TEST_ASSERT_TRUE(set_gc_kv_if_changed(moved_index, TEST_GC_VALUE_SIZE_MAX));
+    moved = (FDB_SECTOR_STORE_EMPTY == sector_store_status(sector));
+    assert_gc_kvs();
+  }
+  TEST_ASSERT_TRUE(moved);
+
+  fdb_kvdb_deinit(&m_kvdb);
+  init_kvdb();
+  assert_gc_kvs();
+}
+
+/**
+ * The least recently used KV is replaced in the cache, also once the cache access
+ * time has gone past its 16 bit range. The stale KV was last used exactly 65536
+ * accesses before the newest one, which a wrapping time would make look as new.
+ */
+void test_fdb_kv_cache_lru_after_time_overflow(void)
+{
+  const uint8_t value = 0x5A;
+  // The gets of B and C make two of the accesses since A was used
+  const uint32_t accesses = 0x10000 - 2;
+  init_kvdb_with_cache();
+  set_kv("A", &value, sizeof(value));
+  set_kv("B", &value, sizeof(value));
+  set_kv("C", &value, sizeof(value));
+  set_kv("D", &value, sizeof(value));
+
+  get_kv("A");
+  get_kv("B");
+  get_kv("C");
+  struct fdb_kv_cache_stats stats = get_cache_stats();
+  for (uint32_t i = 1; i <= accesses; i++) {
+    get_kv((i % 2) ? "B" : "C");
+  }
+  TEST_ASSERT_EQUAL_UINT32(stats.hits + accesses, get_cache_stats().hits);
+
+  // D replaces A, the only KV not used since
+  stats = get_cache_stats();
+  get_kv("D");
+  TEST_ASSERT_EQUAL_UINT32(stats.evictions + 1, get_cache_stats().evictions);
+  stats = get_cache_stats();
+  get_kv("B");
+  get_kv("C");
+  get_kv("D");
+  TEST_ASSERT_EQUAL_UINT32(stats.hits + 3, get_cache_stats().hits);
+  TEST_ASSERT_EQUAL_UINT32(stats.misses, get_cache_stats().misses);
+
+  // A itself is read from flash again
+  get_kv("A");
+  TEST_ASSERT_EQUAL_UINT32(stats.misses + 1, get_cache_stats().misses);
+}
@@ -0,0 +1,406 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_zpal_bootloader_delta.c
+ * @brief Host tests of the reconstruction of an OTA image file from a delta
+ *        image, run against images in RAM.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+/****************************************************************************/
+/*                              INCLUDE FILES                               */
+/****************************************************************************/
+
+#include <unity.h>
+#include <zpal_bootloader_delta.h>
+#include <zpal_watchdog.h>
+#include <fal.h>
+#include <string.h>
+
+/****************************************************************************/
+/*                      PRIVATE TYPES and DEFINITIONS                       */
+/****************************************************************************/
+
+#define TEST_SOURCE_LENGTH   2048
+#define TEST_TARGET_LENGTH   2016
+// Smallest accepted OTA image file, sizeof(ota_header_t) of zpal_bootloader.c
+#define TEST_TARGET_MIN_LENGTH  48
+#define TEST_TARGET_MAX_LENGTH  4096
+// zlib.crc32() of the target image, as stored in the delta header by ota_image_generate.py
+#define TEST_TARGET_CRC32    0xF8FEBE19
+#define TEST_FRAGMENT_SIZE   24
+// Layout of the delta header
+#define TEST_HEADER_LENGTH   48
+#define TEST_FLAGS_OFFSET    10
+#define TEST_IV_OFFSET       32
+#define TEST_IV_SIZE         16
+// Number of fragments of TEST_FRAGMENT_SIZE carrying the header
+#define TEST_HEADER_FRAGMENTS  (TEST_HEADER_LENGTH / TEST_FRAGMENT_SIZE)
+// Number of fragments that check the whole source, with the DELTA_SOURCE_CHECK_BLOCK_SIZE
+// of 512 bytes set by CMakeLists.txt
+#define TEST_SOURCE_CHECK_FRAGMENTS  (TEST_SOURCE_LENGTH / 512)
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+/*
+ * Delta image generated by generate_delta() of tools/ota_image_generate.py, without an
+ * encryption key.
+ *
+ * The source is the image built by build_source_image(). The target is the source with
+ * bytes 100 to 115 incremented by one, the bytes 0xA0 to 0xBF inserted at offset 1000
+ * and the last 64 bytes removed.
+ */
+static const uint8_t m_delta[] = {
+  0x5A, 0x44, 0x4C, 0x54, 0x01, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x08, 0x00, 0x00, 0x28, 0x56, 0x4B, 0xCB, 0xE0, 0x07, 0x00, 0x00,
+  0x19, 0xBE, 0xFE, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x9A, 0xCF, 0x82, 0x85, 0x33, 0x15, 0x96, 0x74, 0xD8, 0xCA,
+  0x13, 0x17, 0xFB, 0xA1, 0x0D, 0x21, 0x0B, 0xC4, 0xF7, 0x86, 0x5D, 0xF6,
+  0xF1, 0x15, 0xC4, 0x02, 0x10, 0x79, 0x34, 0x3F, 0xE8, 0x33, 0xD4, 0x55,
+  0x43, 0x2D, 0x7C, 0x36, 0xD8, 0x57, 0x23, 0x8E, 0x84, 0x56, 0x00, 0x05,
+  0x3E, 0x7E, 0xDB, 0x55, 0x8B, 0x21, 0xD9, 0x62, 0xB5, 0x40, 0x47, 0x70,
+  0xFB, 0xA9, 0x47, 0x39, 0x01, 0x68, 0x5C, 0x6C, 0xB4, 0x3C, 0x3F, 0x23,
+  0x68, 0x68, 0x02, 0x75, 0xA5, 0x5F, 0x7B, 0x87, 0xC0, 0xAE, 0x4C, 0xB3,
+  0x21, 0x71, 0x4F, 0xB5, 0x1A, 0xF8, 0x00, 0xE0, 0xFF, 0x6F, 0xCB, 0x40,
+  0x00
+};
+
+// m_delta with the LZMA stream encrypted by test_key_stream()
+static uint8_t m_encrypted_delta[sizeof(m_delta)];
+
+static uint8_t m_source[TEST_SOURCE_LENGTH];
+static uint8_t m_target[TEST_TARGET_MAX_LENGTH];
+static uint32_t m_target_writes;
+static uint32_t m_watchdog_feeds;
+static uint8_t m_decrypt_iv[TEST_IV_SIZE];
+static uint32_t m_decrypt_offset;
+static uint32_t m_decrypt_starts;
+
+static void target_write(uint32_t offset, const uint8_t * data, uint16_t length)
+{
+  TEST_ASSERT_TRUE(ZPAL_BOOTLOADER_DELTA_PAGE_SIZE >= length);
+  TEST_ASSERT_TRUE(sizeof(m_target) >= (offset + length));
+  memcpy(&m_target[offset], data, length);
+  m_target_writes++;
+}
+
+/*
+ * Stands in for AES-128-CTR, which is provided by the platform. It checks that the
+ * stream after the header is decrypted in order, starting with the IV of the header.
+ */
+static uint8_t test_key_stream(const uint8_t * iv, uint32_t offset)
+{
+  return (uint8_t)(iv[offset % TEST_IV_SIZE] + (offset / TEST_IV_SIZE));
+}
+
+static bool test_decrypt_start(const uint8_t * iv)
+{
+  memcpy(m_decrypt_iv, iv, TEST_IV_SIZE);
+  m_decrypt_offset = 0;
+  m_decrypt_starts++;
+  return true;
+}
+
+static void test_decrypt(const uint8_t * in, uint8_t * out, uint16_t length)
+{
+  for (uint16_t i = 0; i < length; i++) {
+    out[i] = in[i] ^ test_key_stream(m_decrypt_iv, m_decrypt_offset++);
+  }
+}
+
+static const zpal_bootloader_delta_image_t m_image = {
+  .source = m_source,
+  .source_max_length = TEST_SOURCE_LENGTH,
+  .target = m_target,
+  .target_min_length = TEST_TARGET_MIN_LENGTH,
+  .target_max_length = TEST_TARGET_MAX_LENGTH,
+  .write = target_write,
+  .decrypt_start = test_decrypt_start,
+  .decrypt = test_decrypt
+};
+
+static const zpal_bootloader_delta_image_t m_image_without_decryption = {
+  .source = m_source,
+  .source_max_length = TEST_SOURCE_LENGTH,
+  .target = m_target,
+  .target_min_length = TEST_TARGET_MIN_LENGTH,
+  .target_max_length = TEST_TARGET_MAX_LENGTH,
+  .write = target_write
+};
+
+/****************************************************************************/
+/*                       PRIVATE FUNCTION DEFINITIONS                       */
+/****************************************************************************/
+
+static void build_source_image(void)
+{
+  uint32_t random = 0x12345678;
+  for (uint32_t i = 0; i < sizeof(m_source); i++) {
+    random = random * 1103515245u + 12345u;
+    m_source[i] = (uint8_t)(random >> 16);
+  }
+}
+
+static void build_target_image(uint8_t * target)
+{
+  memcpy(target, m_source, 1000);
+  for (uint32_t i = 100; i < 116; i++) {
+    target[i]++;
+  }
+  for (uint32_t i = 0; i < 32; i++) {
+    target[1000 + i] = (uint8_t)(0xA0 + i);
+  }
+  memcpy(&target[1032], &m_source[1000], TEST_TARGET_LENGTH - 1032);
+}
+
+static void build_encrypted_delta(void)
+{
+  memcpy(m_encrypted_delta, m_delta, sizeof(m_delta));
+  m_encrypted_delta[TEST_FLAGS_OFFSET] = 0x01;
+  for (uint32_t i = 0; i < TEST_IV_SIZE; i++) {
+    m_encrypted_delta[TEST_IV_OFFSET + i] = (uint8_t)(0x30 + (7 * i));
+  }
+  for (uint32_t i = TEST_HEADER_LENGTH; i < sizeof(m_encrypted_delta); i++) {
+    m_encrypted_delta[i] ^= test_key_stream(&m_encrypted_delta[TEST_IV_OFFSET], i - TEST_HEADER_LENGTH);
+  }
+}
+
+static uint16_t fragment_length(uint32_t offset, uint16_t fragment_size)
+{
+  if ((sizeof(m_delta) - offset) < fragment_size) {
+    return (uint16_t)(sizeof(m_delta) - offset);
+  }
+  return fragment_size;
+}
+
+static void write_image(const zpal_bootloader_delta_image_t * image, const uint8_t * delta, uint16_t fragment_size)
+{
+  zpal_bootloader_delta_start(image);
+  for (uint32_t offset = 0; offset < sizeof(m_delta); offset += fragment_size) {
+    zpal_bootloader_delta_write(offset, &delta[offset], fragment_length(offset, fragment_size));
+  }
+}
+
+static void write_delta(uint16_t fragment_size)
+{
+  write_image(&m_image, m_delta, fragment_size);
+}
+
+/****************************************************************************/
+/*                              STUBBED FUNCTIONS                           */
+/****************************************************************************/
+
+// Flash device of fal_cfg.h, needed by the FlashDB sources that provide fdb_calc_crc32()
+const struct fal_flash_dev t32cz20_onchip_flash = {
+  .name = NOR_FLASH_DEV_NAME
+};
+
+/****************************************************************************/
+
+void zpal_feed_watchdog(void)
+{
+  m_watchdog_feeds++;
+}
+
+/****************************************************************************/
+/*                              TEST FIXTURES                               */
+/****************************************************************************/
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  build_source_image();
+  memset(m_target, 0xFF, sizeof(m_target));
+  m_target_writes = 0;
+  m_watchdog_feeds = 0;
+  m_decrypt_starts = 0;
+}
+
+void tearDown(void)
+{
+  zpal_bootloader_delta_stop();
+}
+
+/****************************************************************************/
+/*                                  TESTS                                   */
+/****************************************************************************/
+
+/**
+ * The target image is reconstructed from the source and a delta image received in
+ * fragments, and its CRC matches the one of the delta header.
+ */
+void test_zpal_bootloader_delta_reconstructs_target(void)
+{
+  uint8_t expected[TEST_TARGET_LENGTH];
+  build_target_image(expected);
+
+  write_delta(TEST_FRAGMENT_SIZE);
+
+  // The CRC of the reconstructed image is only checked by the verification
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_RECEIVING, zpal_bootloader_delta_get_status());
+  TEST_ASSERT_EQUAL_UINT32(0, m_watchdog_feeds);
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_DONE, zpal_bootloader_delta_verify());
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_DONE, zpal_bootloader_delta_get_status());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, m_target, TEST_TARGET_LENGTH);
+  TEST_ASSERT_EQUAL_UINT32(TEST_TARGET_CRC32, zpal_bootloader_crc32(m_target, TEST_TARGET_LENGTH));
+  // Full pages and the remainder
+  TEST_ASSERT_EQUAL_UINT32((TEST_TARGET_LENGTH + ZPAL_BOOTLOADER_DELTA_PAGE_SIZE - 1) / ZPAL_BOOTLOADER_DELTA_PAGE_SIZE,
+                           m_target_writes);
+}
+
+/**
+ * A delta image received one byte at a time gives the same image.
+ */
+void test_zpal_bootloader_delta_single_byte_fragments(void)
+{
+  write_delta(1);
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_DONE, zpal_bootloader_delta_verify());
+  TEST_ASSERT_EQUAL_UINT32(TEST_TARGET_CRC32, zpal_bootloader_crc32(m_target, TEST_TARGET_LENGTH));
+}
+
+/**
+ * The source is checked a block per fragment. A delta image generated against another
+ * application is rejected by the fragment that completes the check.
+ */
+void test_zpal_bootloader_delta_wrong_source(void)
+{
+  m_source[TEST_SOURCE_LENGTH - 1] ^= 0x01;
+
+  zpal_bootloader_delta_start(&m_image);
+  uint32_t fragments = 0;
+  for (uint32_t offset = 0;
+       (offset < sizeof(m_delta)) && (ZPAL_BOOTLOADER_DELTA_RECEIVING == zpal_bootloader_delta_get_status());
+       offset += TEST_FRAGMENT_SIZE) {
+    zpal_bootloader_delta_write(offset, &m_delta[offset], fragment_length(offset, TEST_FRAGMENT_SIZE));
+    fragments++;
+  }
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_ERROR, zpal_bootloader_delta_get_status());
+  // The fragment completing the header checks the first block
+  TEST_ASSERT_EQUAL_UINT32(TEST_HEADER_FRAGMENTS + TEST_SOURCE_CHECK_FRAGMENTS - 1, fragments);
+  TEST_ASSERT_TRUE(fragments < ((sizeof(m_delta) + TEST_FRAGMENT_SIZE - 1) / TEST_FRAGMENT_SIZE));
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_ERROR, zpal_bootloader_delta_verify());
+}
+
+/**
+ * The part of the source not checked while a short delta image was received is checked
+ * by the verification.
+ */
+void test_zpal_bootloader_delta_verify_checks_rest_of_source(void)
+{
+  const uint16_t fragment_size = 64;
+  TEST_ASSERT_TRUE(((sizeof(m_delta) + fragment_size - 1) / fragment_size) < TEST_SOURCE_CHECK_FRAGMENTS);
+  m_source[TEST_SOURCE_LENGTH - 1] ^= 0x01;
+
+  write_delta(fragment_size);
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_RECEIVING, zpal_bootloader_delta_get_status());
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_ERROR, zpal_bootloader_delta_verify());
+}
+
+/**
+ * A corrupted reconstructed image is rejected by the verification.
+ */
+void test_zpal_bootloader_delta_verify_checks_target(void)
+{
+  write_delta(TEST_FRAGMENT_SIZE);
+  m_target[TEST_TARGET_LENGTH - 1] ^= 0x01;
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_ERROR, zpal_bootloader_delta_verify());
+}
+
+/**
+ * The LZMA stream of an encrypted delta image is decrypted with the IV of its header
+ * before it is decoded.
+ */
+void test_zpal_bootloader_delta_encrypted(void)
+{
+  uint8_t expected[TEST_TARGET_LENGTH];
+  build_target_image(expected);
+  build_encrypted_delta();
+
+  write_image(&m_image, m_encrypted_delta, TEST_FRAGMENT_SIZE);
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_DONE, zpal_bootloader_delta_verify());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, m_target, TEST_TARGET_LENGTH);
+  TEST_ASSERT_EQUAL_UINT32(1, m_decrypt_starts);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(&m_encrypted_delta[TEST_IV_OFFSET], m_decrypt_iv, TEST_IV_SIZE);
+}
+
+/**
+ * An encrypted delta image is rejected by a platform that cannot decrypt it, and is
+ * not decoded as plaintext.
+ */
+void test_zpal_bootloader_delta_encrypted_not_supported(void)
+{
+  build_encrypted_delta();
+
+  write_image(&m_image_without_decryption, m_encrypted_delta, TEST_FRAGMENT_SIZE);
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_ERROR, zpal_bootloader_delta_verify());
+  TEST_ASSERT_EQUAL_UINT32(0, m_target_writes);
+}
+
+/**
+ * A fragment received out of order ends the session with an error.
+ */
+void test_zpal_bootloader_delta_fragment_out_of_order(void)
+{
+  zpal_bootloader_delta_start(&m_image);
+  zpal_bootloader_delta_write(0, m_delta, TEST_FRAGMENT_SIZE);
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_RECEIVING, zpal_bootloader_delta_get_status());
+
+  zpal_bootloader_delta_write(2 * TEST_FRAGMENT_SIZE, &m_delta[2 * TEST_FRAGMENT_SIZE], TEST_FRAGMENT_SIZE);
+
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_ERROR, zpal_bootloader_delta_get_status());
+}
+
+/**
+ * The CRC is calculated in blocks, each followed by a watchdog feed, and gives the
+ * same result as the standard CRC32.
+ */
+void test_zpal_bootloader_crc32_feeds_watchdog(void)
+{
+  static uint8_t image[10000];
+  memset(image, 0x5A, sizeof(image));
+
+  // CRC32 of "123456789"
+  TEST_ASSERT_EQUAL_UINT32(0xCBF43926, zpal_bootloader_crc32((const uint8_t *)"123456789", 9));
+  m_watchdog_feeds = 0;
+
+  uint32_t first = zpal_bootloader_crc32(image, sizeof(image));
+
+  TEST_ASSERT_EQUAL_UINT32(3, m_watchdog_feeds);
+  image[9999] ^= 0x01;
+  TEST_ASSERT_NOT_EQUAL(first, zpal_bootloader_crc32(image, sizeof(image)));
+}
+
+/**
+ * An image that does not start with the delta magic is not a delta image.
+ */
+void test_zpal_bootloader_delta_detect(void)
+{
+  const uint8_t ota_image[8] = { 0x58, 0xBF, 0x4E, 0x53, 0x00, 0x00, 0x00, 0x00 };
+
+  TEST_ASSERT_FALSE(zpal_bootloader_delta_detect(ota_image, sizeof(ota_image)));
+  TEST_ASSERT_FALSE(zpal_bootloader_delta_detect(m_delta, 3));
+  TEST_ASSERT_TRUE(zpal_bootloader_delta_detect(m_delta, 4));
+  TEST_ASSERT_EQUAL(ZPAL_BOOTLOADER_DELTA_NONE, zpal_bootloader_delta_get_status());
+}
@@ -1,6 +1,7 @@
 # SPDX-FileCopyrightText: 2023 Trident IoT, LLC <https://www.tridentiot.com>
 # SPDX-License-Identifier: LicenseRef-TridentMSLA
 
+import io
 import lzma
 import sys
 import getopt
@@ -10,6 +11,19 @@ import pathlib
 import subprocess
 import secrets
 import string
+import struct
+
+# Delta image format, must match the delta image handling in zpal_bootloader.c
+DELTA_MAGIC = 0x544C445A
+DELTA_VERSION = 1
+DELTA_OP_ADD = 0x01
+DELTA_OP_INSERT = 0x02
+DELTA_FLAG_ENCRYPTED = 0x01
+DELTA_IV_SIZE = 16
+DELTA_DICT_SIZE = 4096      # The node decodes with a dictionary of at most 4 kB
+DELTA_KEY_LENGTH = 8        # Length of the byte sequences used to find matches in the running image
+DELTA_MIN_MATCH = 16        # Shorter matches are sent as inserted bytes
+DELTA_MAX_MISMATCHES = 8    # A match ends after this many consecutive differing bytes
 
 
 def generate_random_string(length):
@@ -57,6 +71,95 @@ def extract_key(key_data):
 
 
 
+def delta_extend(source, target, src_pos, tgt_pos):
+    """
+    Returns the length of the region starting at the given positions where the target is
+    close to the source. Differing bytes are allowed, e.g. changed addresses in moved code.
+    """
+    length = 0
+    good = 0
+    mismatches = 0
+    while (tgt_pos + length < len(target)) and (src_pos + length < len(source)):
+        if target[tgt_pos + length] == source[src_pos + length]:
+            mismatches = 0
+            good = length + 1
+        else:
+            mismatches += 1
+            if mismatches >= DELTA_MAX_MISMATCHES:
+                break
+        length += 1
+    return good
+
+def aes_ctr_encrypt(data, key, iv):
+    """
+    Encrypts data with AES-128-CTR, like the full firmware update image.
+    """
+    result = subprocess.run(
+      ["openssl", "enc", "-aes-128-ctr", "-K", key, "-iv", iv.hex()],
+      input=data,
+      stdout=subprocess.PIPE,
+      check=True,
+    )
+    return result.stdout
+
+def generate_delta(source, target, encryption_key=None):
+    """
+    Generates a delta image that reconstructs target from source, the signed application binary
+    running on the node.
+
+    The patch consists of ADD records, which add bytes to a region of the source, and INSERT
+    records, which carry new bytes. Regions of the source that moved in the target result in ADD
+    records of mostly zeros, which LZMA compresses well.
+
+    With an encryption key, the compressed patch is encrypted with AES-128-CTR. The patch carries
+    the plaintext of the new firmware, so it must be as confidential as the full image. Each delta
+    gets a random initial vector, as reusing the one of the full image would reuse its key stream.
+    """
+    index = {}
+    for pos in range(len(source) - DELTA_KEY_LENGTH, -1, -1):
+        index[source[pos:pos + DELTA_KEY_LENGTH]] = pos
+
+    patch = bytearray()
+    literal_start = 0
+    shift = 0
+    pos = 0
+    while pos < len(target):
+        key = target[pos:pos + DELTA_KEY_LENGTH]
+        # Prefer continuing at the previous displacement, as code tends to move in blocks
+        src_pos = pos + shift
+        if (src_pos < 0) or (source[src_pos:src_pos + DELTA_KEY_LENGTH] != key):
+            src_pos = index.get(key)
+        length = 0 if src_pos is None else delta_extend(source, target, src_pos, pos)
+        if length < DELTA_MIN_MATCH:
+            pos += 1
+            continue
+        if literal_start < pos:
+            patch += struct.pack('<BI', DELTA_OP_INSERT, pos - literal_start) + target[literal_start:pos]
+        diff = bytes((target[pos + i] - source[src_pos + i]) & 0xFF for i in range(length))
+        patch += struct.pack('<BII', DELTA_OP_ADD, length, src_pos) + diff
+        shift = src_pos - pos
+        pos += length
+        literal_start = pos
+    if literal_start < len(target):
+        patch += struct.pack('<BI', DELTA_OP_INSERT, len(target) - literal_start) + target[literal_start:]
+
+    lc, lp, pb = 0, 0, 0
+    filters = [
+      {"id": lzma.FILTER_LZMA1, "preset": 9 | lzma.PRESET_EXTREME, "dict_size": DELTA_DICT_SIZE, "lc": lc, "lp": lp, "pb": pb},
+    ]
+    compressed = lzma.compress(bytes(patch), format=lzma.FORMAT_RAW, filters=filters)
+    props = bytes([(pb * 5 + lp) * 9 + lc]) + DELTA_DICT_SIZE.to_bytes(4, 'little')
+    flags = 0
+    iv = bytes(DELTA_IV_SIZE)
+    if encryption_key != None:
+        iv = secrets.token_bytes(DELTA_IV_SIZE)
+        compressed = aes_ctr_encrypt(compressed, encryption_key, iv)
+        flags |= DELTA_FLAG_ENCRYPTED
+    header = struct.pack('<IB5sBxIIIII16s', DELTA_MAGIC, DELTA_VERSION, props, flags,
+                         len(source), zlib.crc32(source) & 0xFFFFFFFF,
+                         len(target), zlib.crc32(target) & 0xFFFFFFFF, 0, iv)
+    return header + compressed
+
 def main(argv):
     sig_id = int(hex(0x534EBF58),16)
     input_file = None
@@ -74,12 +177,13 @@ def main(argv):
     fw_option = 0
     binary_size = None
     systeminfo = None
+    delta_base_file = None
     # ota_header_size MUST be equal to sizeof(ota_header_t)
     ota_header_size = 48
     try:
-        opts, args = getopt.getopt(argv,"hbcs:e:n:i:o:",["help","bin_only","compress","sign=","encrypt=", "nonce=", "input=","output="])
+        opts, args = getopt.getopt(argv,"hbcs:e:n:i:o:d:",["help","bin_only","compress","sign=","encrypt=", "nonce=", "input=","output=","delta="])
     except getopt.GetoptError:
-        print("ota_image_generate.py -i <bin_file> -o <bin_ota_file> [-b] [-c] [-s <private_key>] [-e <encryption_key>] [-n <nonce>]")
+        print("ota_image_generate.py -i <bin_file> -o <bin_ota_file> [-b] [-c] [-s <private_key>] [-e <encryption_key>] [-n <nonce>] [-d <base_file>]")
         print("<bin_file> the input binary file to generate ota image or signed binary file for")
         print("<bin_ota_file> the output binary file")
         print("<private_key> the private key to use to generate the signed binary file")
@@ -87,6 +191,7 @@ def main(argv):
         print("<nonce> the AES-CTR nonce (Initial vector) used when encrypting the image")
         print("-b only generate signed binary files")
         print("-c compress the binary file before generated the ota/signed binary file")
+        print("<base_file> the signed binary file running on the node. Generates a delta image against it, encrypted with -e <encryption_key>")
         sys.exit(2)
 
     for opt, arg in opts:
@@ -107,6 +212,14 @@ def main(argv):
             encryption_key_file = arg
         elif opt in ("-n", "--nonce"):
             iv_file = arg
+        elif opt in ("-d", "--delta"):
+            delta_base_file = arg
+
+    if (delta_base_file != None) and (use_comp or only_signed_bin or iv_file != None):
+        # Compressed or encrypted images do not resemble the running image. The delta is generated
+        # against the plaintext image instead, then compressed and, with --encrypt, encrypted.
+        print("--delta cannot be combined with --compress, --nonce or --bin_only")
+        sys.exit(2)
 
     random_string = generate_random_string(5)
     # Open the binary file for reading in binary mode
@@ -281,7 +394,7 @@ def main(argv):
 
     try:
     # Write compressed/uncompressed data to file.
-       writef = open(output_file,"wb")
+       writef = io.BytesIO()
        if only_signed_bin == False:
          writef.write(systeminfo)
          endianess = "little"
@@ -310,7 +423,18 @@ def main(argv):
          print(f'ota image generated as {output_file}')
        else:
          writef.write(output_data)
-       writef.close()
+
+       file_data = writef.getvalue()
+       if delta_base_file != None:
+         delta_key = None
+         if encryption_key_file != None:
+           with open(encryption_key_file, "rt") as kfile:
+             delta_key = kfile.read().strip()
+         with open(delta_base_file, "rb") as basef:
+           file_data = generate_delta(basef.read(), file_data, delta_key)
+         print(f'delta image is {len(file_data)} bytes, full image is {len(writef.getvalue())} bytes')
+       with open(output_file, "wb") as outf:
+         outf.write(file_data)
     except Exception as e:
        print(f"An error occurred: {str(e)}")
        sys.exit(1)
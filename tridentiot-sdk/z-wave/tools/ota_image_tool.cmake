@@ -92,6 +92,19 @@ function(zwsdk_generate_fw_update_image ELF_FILENAME)
     set (IMAGE_START_ADDRESS  0x10000000)
   endif()
 
+  # A delta image only carries the differences to the application running on the nodes.
+  # ZW_OTA_DELTA_BASE is the signed binary (<name>_signed.bin) of that application.
+  # The delta image is encrypted with the same key as the full image.
+  set(DELTA_IMAGE_COMMAND "")
+  if(DEFINED ZW_OTA_DELTA_BASE)
+    if(NOT ZWSDK_CONFIG_OTA_DELTA)
+      message(FATAL_ERROR "ZW_OTA_DELTA_BASE is set, but ZPAL is built without ZWSDK_CONFIG_OTA_DELTA")
+    endif()
+    set(DELTA_IMAGE_COMMAND
+      COMMAND ${Python3_EXECUTABLE} ${ZW_SDK_ROOT}/tools/ota_image_generate.py --sign ${PRIVATE_KEY_PATH} --encrypt ${AES_SYMETRICAL_KEY} --delta ${ZW_OTA_DELTA_BASE} --input ${ELF_FILENAME}.bin --output ${ELF_FILENAME}_delta.ota
+    )
+  endif()
+
   string(RANDOM RANDOM_STRING)
   add_custom_command(
     TARGET ${ELF_FILENAME}.elf
@@ -117,12 +130,15 @@ function(zwsdk_generate_fw_update_image ELF_FILENAME)
     # Generate firmware upgrade image
     COMMAND ${Python3_EXECUTABLE} ${ZW_SDK_ROOT}/tools/ota_image_generate.py --sign ${PRIVATE_KEY_PATH} --compress --encrypt ${AES_SYMETRICAL_KEY} --nonce ${AES_INITIAL_VECTOR} --input ${ELF_FILENAME}.bin --output ${ELF_FILENAME}.ota
 
+    ${DELTA_IMAGE_COMMAND}
+
     # Clean up each file.
     # Don't use *.bin because several different application targets are generated
     # in parallel in the same folder. Using *.bin might delete files before they
     # have been used.
+    # ${ELF_FILENAME}_signed.bin is kept. It is the image running on the nodes after the update,
+    # so it is the base of the next delta image.
     COMMAND ${CMAKE_COMMAND} -E remove ${ELF_FILENAME}.bin
-    COMMAND ${CMAKE_COMMAND} -E remove ${ELF_FILENAME}_signed.bin
     COMMAND ${CMAKE_COMMAND} -E remove ${ELF_FILENAME}_signed_combined.bin
 
     WORKING_DIRECTORY ${MY_ELF_LOCATION}
@@ -23,19 +23,39 @@ extern const cmd_handler_map_t __start_zw_cmd_handlers;
 extern const cmd_handler_map_t __stop_zw_cmd_handlers;
 #define cmd_handlers_stop __stop_zw_cmd_handlers
 
+/**
+ * Maps a command to the position + 1 of its first handler in the handler section.
+ * 0 means that no handler exists for the command.
+ *
+ * The table is built on first use so that a serial command costs a single lookup
+ * instead of a walk through every registered handler.
+ */
+static uint8_t cmd_handler_index[UINT8_MAX + 1];
+static bool cmd_handler_index_built = false;
 
-bool invoke_cmd_handler(const comm_interface_frame_ptr frame)
+static void build_cmd_handler_index(void)
 {
-  cmd_handler_map_t const * iter = &cmd_handlers_start;
-  for ( ; iter < &cmd_handlers_stop; ++iter)
-  {
-    if (iter->cmd == frame->cmd) {
-      iter->pHandler(frame);
-      return true;
-    }
+  size_t count = (size_t)(&cmd_handlers_stop - &cmd_handlers_start);
+  ASSERT(count < UINT8_MAX);
+
+  // Walk backwards so that the first handler of a command ends up in the table.
+  for (size_t i = count; i > 0; i--) {
+    cmd_handler_index[(&cmd_handlers_start)[i - 1].cmd] = (uint8_t)i;
   }
+  cmd_handler_index_built = true;
+}
 
-  return false;
+bool invoke_cmd_handler(const comm_interface_frame_ptr frame)
+{
+  if (!cmd_handler_index_built) {
+    build_cmd_handler_index();
+  }
+  uint8_t position = cmd_handler_index[frame->cmd];
+  if (0 == position) {
+    return false;
+  }
+  (&cmd_handlers_start)[position - 1].pHandler(frame);
+  return true;
 }
 
 void cmd_foreach(cmd_foreach_callback_t callback, cmd_context_t context)
@@ -361,13 +361,33 @@ static void handle_cmd(uint8_t input)
   }
 }
 
-static void handle_data(uint8_t input)
+/*
+ * Moves as much of the payload as is available from the UART ring buffer to the frame
+ * buffer in one block, instead of running the state machine for every byte.
+ */
+static void handle_data(void)
 {
-  comm_interface.rx_wait_count--;
-  store_byte(input);
+  size_t length = RECEIVE_BUFFER_SIZE - comm_interface.buffer_len;
+  if (length > comm_interface.rx_wait_count)
+  {
+    length = comm_interface.rx_wait_count;
+  }
+
+  length = zpal_uart_receive(comm_interface.transport.handle,
+                             &comm_interface.buffer[comm_interface.buffer_len],
+                             length);
+  if (0 == length)
+  {
+    return;
+  }
+
+  TimerRestart(&comm_interface.byte_timer);
+  comm_interface.byte_timeout = false;
+  comm_interface.buffer_len = (uint8_t)(comm_interface.buffer_len + length);
+  comm_interface.rx_wait_count = (uint8_t)(comm_interface.rx_wait_count - length);
 
   if ((comm_interface.buffer_len >= RECEIVE_BUFFER_SIZE) ||
-      (comm_interface.buffer_len > serial_frame->len))      //buffer_len - sizeof(sof) >= serial_frame->len
+      (0 == comm_interface.rx_wait_count))
   {
     comm_interface.state = COMM_INTERFACE_STATE_CHECKSUM;
   }
@@ -421,6 +441,12 @@ comm_interface_parse_result_t comm_interface_parse_data(bool ack)
 
   while ((result == PARSE_IDLE) && zpal_uart_get_available(comm_interface.transport.handle))
   {
+    if (COMM_INTERFACE_STATE_DATA == comm_interface.state)
+    {
+      handle_data();
+      continue;
+    }
+
     zpal_uart_receive(comm_interface.transport.handle, &rx_byte, sizeof(rx_byte));
 
     switch (comm_interface.state)
@@ -441,10 +467,6 @@ comm_interface_parse_result_t comm_interface_parse_data(bool ack)
         handle_cmd(rx_byte);
         break;
 
-      case COMM_INTERFACE_STATE_DATA:
-        handle_data(rx_byte);
-        break;
-
       case COMM_INTERFACE_STATE_CHECKSUM:
         result = handle_checksum(rx_byte, ack);
         break;
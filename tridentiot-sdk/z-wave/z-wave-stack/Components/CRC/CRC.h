@@ -33,6 +33,10 @@
 /**
  * Returns a CRC calculation using the CCITT polynomial (0x1021).
  *
+ * The calculation is table driven, using 512 bytes of constant data. Defining
+ * CRC_SLICING_BY_4 when building CRC.c processes four bytes per step instead,
+ * at the cost of 2 KB of constant data.
+ *
  * @param crc Initial value set to CRC_INITAL_VALUE unless calculating multiple parts of a frame. In that case
  *            the value should be set to the result of the previous calculation.
  * @param pDataAddr Pointer to the array of data.
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_CRC.c
+ * @brief Unit tests of the table driven CRC-16-CCITT calculation, checked against a
+ *        bitwise reference implementation.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <unity.h>
+#include <CRC.h>
+
+void setUpSuite(void) {
+}
+
+void tearDownSuite(void) {
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/**
+ * Bitwise reference implementation of the crc-ccitt calculation.
+ */
+static uint16_t crc16_reference(uint16_t crc, const uint8_t *pData, uint16_t len)
+{
+  while (len--) {
+    uint8_t data = *pData++;
+    for (uint8_t bitMask = 0x80; bitMask != 0; bitMask >>= 1) {
+      uint8_t newBit = ((data & bitMask) != 0) ^ ((crc & 0x8000) != 0);
+      crc <<= 1;
+      if (newBit) {
+        crc ^= 0x1021;
+      }
+    }
+  }
+  return crc;
+}
+
+void test_CRC_known_value(void)
+{
+  const uint8_t data[] = "123456789";
+
+  // CRC-16/AUG-CCITT check value
+  TEST_ASSERT_EQUAL_HEX16(0xE5CC, CRC_CheckCrc16(CRC_INITAL_VALUE, data, 9));
+  // CRC-16/XMODEM check value
+  TEST_ASSERT_EQUAL_HEX16(0x31C3, CRC_CheckCrc16(0, data, 9));
+}
+
+void test_CRC_empty_data(void)
+{
+  uint8_t data = 0;
+  TEST_ASSERT_EQUAL_HEX16(CRC_INITAL_VALUE, CRC_CheckCrc16(CRC_INITAL_VALUE, &data, 0));
+}
+
+/**
+ * Every byte value, from a sample of 256 initial CRC values whose high and low
+ * bytes are equal.
+ */
+void test_CRC_every_byte_sampled_crc(void)
+{
+  for (uint16_t crc = 0; crc < 0x100; crc++) {
+    for (uint16_t value = 0; value < 0x100; value++) {
+      uint8_t data = (uint8_t)value;
+      uint16_t initial = (uint16_t)(crc * 0x0101);
+      TEST_ASSERT_EQUAL_HEX16(crc16_reference(initial, &data, 1),
+                              CRC_CheckCrc16(initial, &data, 1));
+    }
+  }
+}
+
+void test_CRC_matches_reference(void)
+{
+  uint8_t data[600];
+  uint32_t seed = 0x12345678;
+
+  for (uint16_t i = 0; i < sizeof(data); i++) {
+    seed = seed * 1103515245 + 12345;
+    data[i] = (uint8_t)(seed >> 16);
+  }
+
+  // Cover lengths in steps of seven, at every alignment modulo four
+  for (uint16_t offset = 0; offset < 4; offset++) {
+    for (uint16_t len = 0; len <= sizeof(data) - 4; len += 7) {
+      TEST_ASSERT_EQUAL_HEX16(crc16_reference(CRC_INITAL_VALUE, &data[offset], len),
+                              CRC_CheckCrc16(CRC_INITAL_VALUE, &data[offset], len));
+    }
+  }
+}
+
+void test_CRC_split_calculation(void)
+{
+  uint8_t data[64];
+  memset(data, 0xA5, sizeof(data));
+  data[10] = 0x00;
+  data[33] = 0xFF;
+
+  uint16_t whole = CRC_CheckCrc16(CRC_INITAL_VALUE, data, sizeof(data));
+  for (uint16_t split = 0; split <= sizeof(data); split++) {
+    uint16_t crc = CRC_CheckCrc16(CRC_INITAL_VALUE, data, split);
+    crc = CRC_CheckCrc16(crc, &data[split], (uint16_t)(sizeof(data) - split));
+    TEST_ASSERT_EQUAL_HEX16(whole, crc);
+  }
+}
@@ -114,6 +114,21 @@ zpal_status_t zpal_nvm_read_object_part(zpal_nvm_handle_t handle, zpal_nvm_objec
  */
 zpal_status_t zpal_nvm_write(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, const void *object, size_t object_size);
 
+/**
+ * @brief Writes part of an object to a given area handle and given object key.
+ *
+ * Only the part has to be passed, the rest of the stored object is kept. The object must
+ * exist and the part must lie within it, so the size of the object does not change.
+ *
+ * @param[in]  handle       NVM area handle.
+ * @param[in]  key          Object key.
+ * @param[in]  object       Address of array of the part that must be written.
+ * @param[in]  offset       The offset in the object where the part shall be written to.
+ * @param[in]  object_size  Size of the part.
+ * @return @ref ZPAL_STATUS_OK if the part was successfully written and @ref ZPAL_STATUS_FAIL otherwise.
+ */
+zpal_status_t zpal_nvm_write_object_part(zpal_nvm_handle_t handle, zpal_nvm_object_key_t key, const void *object, size_t offset, size_t object_size);
+
 /**
  * @brief Erases everything in a given area.
  *
@@ -70,11 +70,11 @@ static void leftshift_onebit(const uint8_t * input, uint8_t * output)
 
 /**
  * @brief Generates two sub keys based on a given key.
- * @param key 128-bit key.
+ * @param key Expanded 128-bit key.
  * @param K1 128-bit first sub key.
  * @param K2 128-bit second sub key.
  */
-static void generate_subkey(const uint8_t * key, uint8_t * K1, uint8_t * K2)
+static void generate_subkey(const aes128_ctx * key, uint8_t * K1, uint8_t * K2)
 {
   uint8_t L[16];
   uint8_t tmp[16];
@@ -92,7 +92,7 @@ static void generate_subkey(const uint8_t * key, uint8_t * K1, uint8_t * K2)
   /*
    * L := AES-128(Key, const_Zero);
    */
-  AES128_ECB_encrypt((uint8_t *)const_Zero, key, L);
+  AES128_ECB_encrypt_ctx(key, const_Zero, L);
 
   if (0 == (L[0] & 0x80)) // if MSB(L) is equal to 0 then K1 := L << 1;
   {
@@ -138,12 +138,24 @@ static void padding(const uint8_t * lastb, uint8_t * pad, const uint8_t length)
   }
 }
 
-//void AES_CMAC ( unsigned char *key, unsigned char *input, int length, unsigned char *mac )
 void aes_cmac_calculate(
         const uint8_t * key,
         const uint8_t * message,
         const uint16_t message_length,
         uint8_t * mac)
+{
+  aes128_ctx key_ctx;
+
+  AES128_init_ctx(&key_ctx, key);
+  aes_cmac_calculate_ctx(&key_ctx, message, message_length, mac);
+}
+
+//void AES_CMAC ( unsigned char *key, unsigned char *input, int length, unsigned char *mac )
+void aes_cmac_calculate_ctx(
+        const aes128_ctx * key,
+        const uint8_t * message,
+        const uint16_t message_length,
+        uint8_t * mac)
 {
   uint8_t X[16];
   uint8_t Y[16];
@@ -194,11 +206,11 @@ void aes_cmac_calculate(
   for (i = 0; i < (n-1); i++)
   {
     xor_128(X, &message[16 * i], Y); /* Y := Mi (+) X  */
-    AES128_ECB_encrypt(Y, key, X); // X := AES-128(key, Y);
+    AES128_ECB_encrypt_ctx(key, Y, X); // X := AES-128(key, Y);
   }
 
   xor_128(X, M_last, Y);
-  AES128_ECB_encrypt(Y, key, X); // X := AES-128(key, Y);
+  AES128_ECB_encrypt_ctx(key, Y, X); // X := AES-128(key, Y);
 
   for (i = 0; i < 16; i++)
   {
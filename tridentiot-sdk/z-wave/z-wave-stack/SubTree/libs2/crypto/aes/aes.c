@@ -66,15 +66,10 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
 /*****************************************************************************/
 // state - array holding the intermediate results during decryption.
 typedef uint8_t state_t[4][4];
-static state_t* state;
-
-// The array that stores the round keys.
-static uint8_t RoundKey[176];
-
-// The Key input to the AES Program
-static const uint8_t* Key;
 
 #if defined(CBC) && CBC
+  // Round keys of the last key passed to the CBC functions, which may be continued with key 0
+  static aes128_ctx CbcCtx;
   // Initial Vector used only for CBC mode
   static uint8_t* Iv;
 #endif
@@ -142,6 +137,55 @@ static const uint8_t Rcon[255] = {
   0x61, 0xc2, 0x9f, 0x25, 0x4a, 0x94, 0x33, 0x66, 0xcc, 0x83, 0x1d, 0x3a, 0x74, 0xe8, 0xcb  };
 
 
+// Encryption table combining SubBytes and MixColumns for one byte of a column:
+// Te0[x] = { 02*S[x], S[x], S[x], 03*S[x] }, most significant byte first.
+// The tables for the other three rows are byte rotations of this one.
+static const uint32_t Te0[256] = {
+  0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU, 0xfff2f20dU, 0xd66b6bbdU, 0xde6f6fb1U, 0x91c5c554U,
+  0x60303050U, 0x02010103U, 0xce6767a9U, 0x562b2b7dU, 0xe7fefe19U, 0xb5d7d762U, 0x4dababe6U, 0xec76769aU,
+  0x8fcaca45U, 0x1f82829dU, 0x89c9c940U, 0xfa7d7d87U, 0xeffafa15U, 0xb25959ebU, 0x8e4747c9U, 0xfbf0f00bU,
+  0x41adadecU, 0xb3d4d467U, 0x5fa2a2fdU, 0x45afafeaU, 0x239c9cbfU, 0x53a4a4f7U, 0xe4727296U, 0x9bc0c05bU,
+  0x75b7b7c2U, 0xe1fdfd1cU, 0x3d9393aeU, 0x4c26266aU, 0x6c36365aU, 0x7e3f3f41U, 0xf5f7f702U, 0x83cccc4fU,
+  0x6834345cU, 0x51a5a5f4U, 0xd1e5e534U, 0xf9f1f108U, 0xe2717193U, 0xabd8d873U, 0x62313153U, 0x2a15153fU,
+  0x0804040cU, 0x95c7c752U, 0x46232365U, 0x9dc3c35eU, 0x30181828U, 0x379696a1U, 0x0a05050fU, 0x2f9a9ab5U,
+  0x0e070709U, 0x24121236U, 0x1b80809bU, 0xdfe2e23dU, 0xcdebeb26U, 0x4e272769U, 0x7fb2b2cdU, 0xea75759fU,
+  0x1209091bU, 0x1d83839eU, 0x582c2c74U, 0x341a1a2eU, 0x361b1b2dU, 0xdc6e6eb2U, 0xb45a5aeeU, 0x5ba0a0fbU,
+  0xa45252f6U, 0x763b3b4dU, 0xb7d6d661U, 0x7db3b3ceU, 0x5229297bU, 0xdde3e33eU, 0x5e2f2f71U, 0x13848497U,
+  0xa65353f5U, 0xb9d1d168U, 0x00000000U, 0xc1eded2cU, 0x40202060U, 0xe3fcfc1fU, 0x79b1b1c8U, 0xb65b5bedU,
+  0xd46a6abeU, 0x8dcbcb46U, 0x67bebed9U, 0x7239394bU, 0x944a4adeU, 0x984c4cd4U, 0xb05858e8U, 0x85cfcf4aU,
+  0xbbd0d06bU, 0xc5efef2aU, 0x4faaaae5U, 0xedfbfb16U, 0x864343c5U, 0x9a4d4dd7U, 0x66333355U, 0x11858594U,
+  0x8a4545cfU, 0xe9f9f910U, 0x04020206U, 0xfe7f7f81U, 0xa05050f0U, 0x783c3c44U, 0x259f9fbaU, 0x4ba8a8e3U,
+  0xa25151f3U, 0x5da3a3feU, 0x804040c0U, 0x058f8f8aU, 0x3f9292adU, 0x219d9dbcU, 0x70383848U, 0xf1f5f504U,
+  0x63bcbcdfU, 0x77b6b6c1U, 0xafdada75U, 0x42212163U, 0x20101030U, 0xe5ffff1aU, 0xfdf3f30eU, 0xbfd2d26dU,
+  0x81cdcd4cU, 0x180c0c14U, 0x26131335U, 0xc3ecec2fU, 0xbe5f5fe1U, 0x359797a2U, 0x884444ccU, 0x2e171739U,
+  0x93c4c457U, 0x55a7a7f2U, 0xfc7e7e82U, 0x7a3d3d47U, 0xc86464acU, 0xba5d5de7U, 0x3219192bU, 0xe6737395U,
+  0xc06060a0U, 0x19818198U, 0x9e4f4fd1U, 0xa3dcdc7fU, 0x44222266U, 0x542a2a7eU, 0x3b9090abU, 0x0b888883U,
+  0x8c4646caU, 0xc7eeee29U, 0x6bb8b8d3U, 0x2814143cU, 0xa7dede79U, 0xbc5e5ee2U, 0x160b0b1dU, 0xaddbdb76U,
+  0xdbe0e03bU, 0x64323256U, 0x743a3a4eU, 0x140a0a1eU, 0x924949dbU, 0x0c06060aU, 0x4824246cU, 0xb85c5ce4U,
+  0x9fc2c25dU, 0xbdd3d36eU, 0x43acacefU, 0xc46262a6U, 0x399191a8U, 0x319595a4U, 0xd3e4e437U, 0xf279798bU,
+  0xd5e7e732U, 0x8bc8c843U, 0x6e373759U, 0xda6d6db7U, 0x018d8d8cU, 0xb1d5d564U, 0x9c4e4ed2U, 0x49a9a9e0U,
+  0xd86c6cb4U, 0xac5656faU, 0xf3f4f407U, 0xcfeaea25U, 0xca6565afU, 0xf47a7a8eU, 0x47aeaee9U, 0x10080818U,
+  0x6fbabad5U, 0xf0787888U, 0x4a25256fU, 0x5c2e2e72U, 0x381c1c24U, 0x57a6a6f1U, 0x73b4b4c7U, 0x97c6c651U,
+  0xcbe8e823U, 0xa1dddd7cU, 0xe874749cU, 0x3e1f1f21U, 0x964b4bddU, 0x61bdbddcU, 0x0d8b8b86U, 0x0f8a8a85U,
+  0xe0707090U, 0x7c3e3e42U, 0x71b5b5c4U, 0xcc6666aaU, 0x904848d8U, 0x06030305U, 0xf7f6f601U, 0x1c0e0e12U,
+  0xc26161a3U, 0x6a35355fU, 0xae5757f9U, 0x69b9b9d0U, 0x17868691U, 0x99c1c158U, 0x3a1d1d27U, 0x279e9eb9U,
+  0xd9e1e138U, 0xebf8f813U, 0x2b9898b3U, 0x22111133U, 0xd26969bbU, 0xa9d9d970U, 0x078e8e89U, 0x339494a7U,
+  0x2d9b9bb6U, 0x3c1e1e22U, 0x15878792U, 0xc9e9e920U, 0x87cece49U, 0xaa5555ffU, 0x50282878U, 0xa5dfdf7aU,
+  0x038c8c8fU, 0x59a1a1f8U, 0x09898980U, 0x1a0d0d17U, 0x65bfbfdaU, 0xd7e6e631U, 0x844242c6U, 0xd06868b8U,
+  0x824141c3U, 0x299999b0U, 0x5a2d2d77U, 0x1e0f0f11U, 0x7bb0b0cbU, 0xa85454fcU, 0x6dbbbbd6U, 0x2c16163aU
+};
+
+#define ROTR8(x)  (((x) >> 8) | ((x) << 24))
+#define Te1(x)    ROTR8(Te0[x])
+#define Te2(x)    ROTR8(ROTR8(Te0[x]))
+#define Te3(x)    ROTR8(ROTR8(ROTR8(Te0[x])))
+
+// Big endian load and store of a 32 bit column
+#define GETU32(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+#define PUTU32(p, v) do { (p)[0] = (uint8_t)((v) >> 24); (p)[1] = (uint8_t)((v) >> 16); \
+                          (p)[2] = (uint8_t)((v) >> 8);  (p)[3] = (uint8_t)(v); } while (0)
+
+
 /*****************************************************************************/
 /* Private functions:                                                        */
 /*****************************************************************************/
@@ -156,153 +200,55 @@ static uint8_t getSBoxInvert(uint8_t num)
 }
 
 // This function produces Nb(Nr+1) round keys. The round keys are used in each round to decrypt the states. 
-static void KeyExpansion(void)
+// Each round key word holds one column of the key, most significant byte first.
+static void KeyExpansion(uint32_t* RoundKey, const uint8_t* Key)
 {
-  uint32_t i, j, k;
-  uint8_t tempa[4]; // Used for the column/row operations
-  
+  uint32_t i;
+  uint32_t tempa;
+
   // The first round key is the key itself.
   for(i = 0; i < Nk; ++i)
   {
-    RoundKey[(i * 4) + 0] = Key[(i * 4) + 0];
-    RoundKey[(i * 4) + 1] = Key[(i * 4) + 1];
-    RoundKey[(i * 4) + 2] = Key[(i * 4) + 2];
-    RoundKey[(i * 4) + 3] = Key[(i * 4) + 3];
+    RoundKey[i] = GETU32(Key + (i * 4));
   }
 
   // All other round keys are found from the previous round keys.
   for(; (i < (Nb * (Nr + 1))); ++i)
   {
-    for(j = 0; j < 4; ++j)
-    {
-      tempa[j]=RoundKey[(i-1) * 4 + j];
-    }
+    tempa = RoundKey[i - 1];
     if (i % Nk == 0)
     {
-      // This function rotates the 4 bytes in a word to the left once.
-      // [a0,a1,a2,a3] becomes [a1,a2,a3,a0]
-
-      // Function RotWord()
-      {
-        k = tempa[0];
-        tempa[0] = tempa[1];
-        tempa[1] = tempa[2];
-        tempa[2] = tempa[3];
-        tempa[3] = k;
-      }
-
-      // SubWord() is a function that takes a four-byte input word and 
-      // applies the S-box to each of the four bytes to produce an output word.
-
-      // Function Subword()
-      {
-        tempa[0] = getSBoxValue(tempa[0]);
-        tempa[1] = getSBoxValue(tempa[1]);
-        tempa[2] = getSBoxValue(tempa[2]);
-        tempa[3] = getSBoxValue(tempa[3]);
-      }
-
-      tempa[0] =  tempa[0] ^ Rcon[i/Nk];
-    }
-#if Nk > 6
-    else if (Nk > 6 && i % Nk == 4)
-    {
-      // Function Subword()
-      {
-        tempa[0] = getSBoxValue(tempa[0]);
-        tempa[1] = getSBoxValue(tempa[1]);
-        tempa[2] = getSBoxValue(tempa[2]);
-        tempa[3] = getSBoxValue(tempa[3]);
-      }
+      // RotWord() rotates the 4 bytes in a word to the left once, SubWord() applies
+      // the S-box to each of them and the result is combined with the round constant.
+      tempa = ((uint32_t)getSBoxValue((tempa >> 16) & 0xff) << 24) ^
+              ((uint32_t)getSBoxValue((tempa >> 8) & 0xff) << 16) ^
+              ((uint32_t)getSBoxValue(tempa & 0xff) << 8) ^
+              ((uint32_t)getSBoxValue(tempa >> 24)) ^
+              ((uint32_t)Rcon[i/Nk] << 24);
     }
-#endif
-    RoundKey[i * 4 + 0] = RoundKey[(i - Nk) * 4 + 0] ^ tempa[0];
-    RoundKey[i * 4 + 1] = RoundKey[(i - Nk) * 4 + 1] ^ tempa[1];
-    RoundKey[i * 4 + 2] = RoundKey[(i - Nk) * 4 + 2] ^ tempa[2];
-    RoundKey[i * 4 + 3] = RoundKey[(i - Nk) * 4 + 3] ^ tempa[3];
+    RoundKey[i] = RoundKey[i - Nk] ^ tempa;
   }
 }
 
 // This function adds the round key to state.
 // The round key is added to the state by an XOR function.
-static void AddRoundKey(uint8_t round)
+static void AddRoundKey(state_t* state, const uint32_t* RoundKey, uint8_t round)
 {
   uint8_t i,j;
   for(i=0;i<4;++i)
   {
     for(j = 0; j < 4; ++j)
     {
-      (*state)[i][j] ^= RoundKey[round * Nb * 4 + i * Nb + j];
-    }
-  }
-}
-
-// The SubBytes Function Substitutes the values in the
-// state matrix with values in an S-box.
-static void SubBytes(void)
-{
-  uint8_t i, j;
-  for(i = 0; i < 4; ++i)
-  {
-    for(j = 0; j < 4; ++j)
-    {
-      (*state)[j][i] = getSBoxValue((*state)[j][i]);
+      (*state)[i][j] ^= (uint8_t)(RoundKey[round * Nb + i] >> (24 - (8 * j)));
     }
   }
 }
 
-// The ShiftRows() function shifts the rows in the state to the left.
-// Each row is shifted with different offset.
-// Offset = Row number. So the first row is not shifted.
-static void ShiftRows(void)
-{
-  uint8_t temp;
-
-  // Rotate first row 1 columns to left  
-  temp           = (*state)[0][1];
-  (*state)[0][1] = (*state)[1][1];
-  (*state)[1][1] = (*state)[2][1];
-  (*state)[2][1] = (*state)[3][1];
-  (*state)[3][1] = temp;
-
-  // Rotate second row 2 columns to left  
-  temp           = (*state)[0][2];
-  (*state)[0][2] = (*state)[2][2];
-  (*state)[2][2] = temp;
-
-  temp       = (*state)[1][2];
-  (*state)[1][2] = (*state)[3][2];
-  (*state)[3][2] = temp;
-
-  // Rotate third row 3 columns to left
-  temp       = (*state)[0][3];
-  (*state)[0][3] = (*state)[3][3];
-  (*state)[3][3] = (*state)[2][3];
-  (*state)[2][3] = (*state)[1][3];
-  (*state)[1][3] = temp;
-}
-
 static uint8_t xtime(uint8_t x)
 {
   return ((x<<1) ^ (((x>>7) & 1) * 0x1b));
 }
 
-// MixColumns function mixes the columns of the state matrix
-static void MixColumns(void)
-{
-  uint8_t i;
-  uint8_t Tmp,Tm,t;
-  for(i = 0; i < 4; ++i)
-  {  
-    t   = (*state)[i][0];
-    Tmp = (*state)[i][0] ^ (*state)[i][1] ^ (*state)[i][2] ^ (*state)[i][3] ;
-    Tm  = (*state)[i][0] ^ (*state)[i][1] ; Tm = xtime(Tm);  (*state)[i][0] ^= Tm ^ Tmp ;
-    Tm  = (*state)[i][1] ^ (*state)[i][2] ; Tm = xtime(Tm);  (*state)[i][1] ^= Tm ^ Tmp ;
-    Tm  = (*state)[i][2] ^ (*state)[i][3] ; Tm = xtime(Tm);  (*state)[i][2] ^= Tm ^ Tmp ;
-    Tm  = (*state)[i][3] ^ t ;        Tm = xtime(Tm);  (*state)[i][3] ^= Tm ^ Tmp ;
-  }
-}
-
 // Multiply is used to multiply numbers in the field GF(2^8)
 #if MULTIPLY_AS_A_FUNCTION
 static uint8_t Multiply(uint8_t x, uint8_t y)
@@ -326,7 +272,7 @@ static uint8_t Multiply(uint8_t x, uint8_t y)
 // MixColumns function mixes the columns of the state matrix.
 // The method used to multiply may be difficult to understand for the inexperienced.
 // Please use the references to gain more information.
-static void InvMixColumns(void)
+static void InvMixColumns(state_t* state)
 {
   int i;
   uint8_t a,b,c,d;
@@ -347,7 +293,7 @@ static void InvMixColumns(void)
 
 // The SubBytes Function Substitutes the values in the
 // state matrix with values in an S-box.
-static void InvSubBytes(void)
+static void InvSubBytes(state_t* state)
 {
   uint8_t i,j;
   for(i=0;i<4;++i)
@@ -359,7 +305,7 @@ static void InvSubBytes(void)
   }
 }
 
-static void InvShiftRows(void)
+static void InvShiftRows(state_t* state)
 {
   uint8_t temp;
 
@@ -389,56 +335,77 @@ static void InvShiftRows(void)
 
 
 // Cipher is the main function that encrypts the PlainText.
-static void Cipher(void)
+// Each of the first Nr-1 rounds performs SubBytes, ShiftRows, MixColumns and
+// AddRoundKey on whole columns through the Te tables. input and output may overlap.
+static void Cipher(const uint32_t* RoundKey, const uint8_t* input, uint8_t* output)
 {
-  uint8_t round = 0;
+  uint8_t round;
+  uint32_t s0, s1, s2, s3;
+  uint32_t t0, t1, t2, t3;
 
   // Add the First round key to the state before starting the rounds.
-  AddRoundKey(0); 
-  
-  // There will be Nr rounds.
-  // The first Nr-1 rounds are identical.
-  // These Nr-1 rounds are executed in the loop below.
+  s0 = GETU32(input     ) ^ RoundKey[0];
+  s1 = GETU32(input +  4) ^ RoundKey[1];
+  s2 = GETU32(input +  8) ^ RoundKey[2];
+  s3 = GETU32(input + 12) ^ RoundKey[3];
+
   for(round = 1; round < Nr; ++round)
   {
-    SubBytes();
-    ShiftRows();
-    MixColumns();
-    AddRoundKey(round);
+    RoundKey += Nb;
+    t0 = Te0[s0 >> 24] ^ Te1((s1 >> 16) & 0xff) ^ Te2((s2 >> 8) & 0xff) ^ Te3(s3 & 0xff) ^ RoundKey[0];
+    t1 = Te0[s1 >> 24] ^ Te1((s2 >> 16) & 0xff) ^ Te2((s3 >> 8) & 0xff) ^ Te3(s0 & 0xff) ^ RoundKey[1];
+    t2 = Te0[s2 >> 24] ^ Te1((s3 >> 16) & 0xff) ^ Te2((s0 >> 8) & 0xff) ^ Te3(s1 & 0xff) ^ RoundKey[2];
+    t3 = Te0[s3 >> 24] ^ Te1((s0 >> 16) & 0xff) ^ Te2((s1 >> 8) & 0xff) ^ Te3(s2 & 0xff) ^ RoundKey[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
   }
-  
+
   // The last round is given below.
   // The MixColumns function is not here in the last round.
-  SubBytes();
-  ShiftRows();
-  AddRoundKey(Nr);
+  RoundKey += Nb;
+  t0 = ((uint32_t)getSBoxValue(s0 >> 24) << 24) ^ ((uint32_t)getSBoxValue((s1 >> 16) & 0xff) << 16) ^
+       ((uint32_t)getSBoxValue((s2 >> 8) & 0xff) << 8) ^ (uint32_t)getSBoxValue(s3 & 0xff) ^ RoundKey[0];
+  t1 = ((uint32_t)getSBoxValue(s1 >> 24) << 24) ^ ((uint32_t)getSBoxValue((s2 >> 16) & 0xff) << 16) ^
+       ((uint32_t)getSBoxValue((s3 >> 8) & 0xff) << 8) ^ (uint32_t)getSBoxValue(s0 & 0xff) ^ RoundKey[1];
+  t2 = ((uint32_t)getSBoxValue(s2 >> 24) << 24) ^ ((uint32_t)getSBoxValue((s3 >> 16) & 0xff) << 16) ^
+       ((uint32_t)getSBoxValue((s0 >> 8) & 0xff) << 8) ^ (uint32_t)getSBoxValue(s1 & 0xff) ^ RoundKey[2];
+  t3 = ((uint32_t)getSBoxValue(s3 >> 24) << 24) ^ ((uint32_t)getSBoxValue((s0 >> 16) & 0xff) << 16) ^
+       ((uint32_t)getSBoxValue((s1 >> 8) & 0xff) << 8) ^ (uint32_t)getSBoxValue(s2 & 0xff) ^ RoundKey[3];
+
+  PUTU32(output,      t0);
+  PUTU32(output +  4, t1);
+  PUTU32(output +  8, t2);
+  PUTU32(output + 12, t3);
 }
 
-static void InvCipher(void)
+static void InvCipher(state_t* state, const uint32_t* RoundKey)
 {
   uint8_t round=0;
 
   // Add the First round key to the state before starting the rounds.
-  AddRoundKey(Nr); 
+  AddRoundKey(state, RoundKey, Nr); 
 
   // There will be Nr rounds.
   // The first Nr-1 rounds are identical.
   // These Nr-1 rounds are executed in the loop below.
   for(round=Nr-1;round>0;round--)
   {
-    InvShiftRows();
-    InvSubBytes();
-    AddRoundKey(round);
-    InvMixColumns();
+    InvShiftRows(state);
+    InvSubBytes(state);
+    AddRoundKey(state, RoundKey, round);
+    InvMixColumns(state);
   }
   
   // The last round is given below.
   // The MixColumns function is not here in the last round.
-  InvShiftRows();
-  InvSubBytes();
-  AddRoundKey(0);
+  InvShiftRows(state);
+  InvSubBytes(state);
+  AddRoundKey(state, RoundKey, 0);
 }
 
+#if defined(CBC) && CBC
 static void BlockCopy(uint8_t* output, uint8_t* input)
 {
   uint8_t i;
@@ -447,6 +414,7 @@ static void BlockCopy(uint8_t* output, uint8_t* input)
     output[i] = input[i];
   }
 }
+#endif
 
 
 
@@ -456,30 +424,37 @@ static void BlockCopy(uint8_t* output, uint8_t* input)
 #if defined(ECB) && ECB
 
 
-void AES128_ECB_encrypt(uint8_t* input, const uint8_t* key, uint8_t* output)
+void AES128_init_ctx(aes128_ctx* ctx, const uint8_t* key)
+{
+  KeyExpansion(ctx->round_key, key);
+}
+
+void AES128_ECB_encrypt_ctx(const aes128_ctx* ctx, const uint8_t* input, uint8_t* output)
+{
+  Cipher(ctx->round_key, input, output);
+}
+
+void AES128_ECB_decrypt_ctx(const aes128_ctx* ctx, const uint8_t* input, uint8_t* output)
 {
   // Copy input to output, and work in-memory on output
-  BlockCopy(output, input);
-  state = (state_t*)output;
+  memmove(output, input, KEYLEN);
+  InvCipher((state_t*)output, ctx->round_key);
+}
 
-  Key = key;
-  KeyExpansion();
+void AES128_ECB_encrypt(uint8_t* input, const uint8_t* key, uint8_t* output)
+{
+  aes128_ctx ctx;
 
-  // The next function call encrypts the PlainText with the Key using AES algorithm.
-  Cipher();
+  AES128_init_ctx(&ctx, key);
+  AES128_ECB_encrypt_ctx(&ctx, input, output);
 }
 
 void AES128_ECB_decrypt(uint8_t* input, const uint8_t* key, uint8_t *output)
 {
-  // Copy input to output, and work in-memory on output
-  BlockCopy(output, input);
-  state = (state_t*)output;
-
-  // The KeyExpansion routine must be called before encryption.
-  Key = key;
-  KeyExpansion();
+  aes128_ctx ctx;
 
-  InvCipher();
+  AES128_init_ctx(&ctx, key);
+  AES128_ECB_decrypt_ctx(&ctx, input, output);
 }
 
 
@@ -506,14 +481,10 @@ void AES128_CBC_encrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length,
   uintptr_t i;
   uint8_t remainders = length % KEYLEN; /* Remaining bytes in the last non-full block */
 
-  BlockCopy(output, input);
-  state = (state_t*)output;
-
   // Skip the key expansion if key is passed as 0
   if(0 != key)
   {
-    Key = key;
-    KeyExpansion();
+    KeyExpansion(CbcCtx.round_key, key);
   }
 
   if(iv != 0)
@@ -524,9 +495,7 @@ void AES128_CBC_encrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length,
   for(i = 0; i < length; i += KEYLEN)
   {
     XorWithIv(input);
-    BlockCopy(output, input);
-    state = (state_t*)output;
-    Cipher();
+    Cipher(CbcCtx.round_key, input, output);
     Iv = output;
     input += KEYLEN;
     output += KEYLEN;
@@ -536,8 +505,7 @@ void AES128_CBC_encrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length,
   {
     BlockCopy(output, input);
     memset(output + remainders, 0, KEYLEN - remainders); /* add 0-padding */
-    state = (state_t*)output;
-    Cipher();
+    Cipher(CbcCtx.round_key, output, output);
   }
 }
 
@@ -546,14 +514,10 @@ void AES128_CBC_decrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length,
   uintptr_t i;
   uint8_t remainders = length % KEYLEN; /* Remaining bytes in the last non-full block */
   
-  BlockCopy(output, input);
-  state = (state_t*)output;
-
   // Skip the key expansion if key is passed as 0
   if(0 != key)
   {
-    Key = key;
-    KeyExpansion();
+    KeyExpansion(CbcCtx.round_key, key);
   }
 
   // If iv is passed as 0, we continue to encrypt without re-setting the Iv
@@ -565,8 +529,7 @@ void AES128_CBC_decrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length,
   for(i = 0; i < length; i += KEYLEN)
   {
     BlockCopy(output, input);
-    state = (state_t*)output;
-    InvCipher();
+    InvCipher((state_t*)output, CbcCtx.round_key);
     XorWithIv(output);
     Iv = input;
     input += KEYLEN;
@@ -577,8 +540,7 @@ void AES128_CBC_decrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length,
   {
     BlockCopy(output, input);
     memset(output+remainders, 0, KEYLEN - remainders); /* add 0-padding */
-    state = (state_t*)output;
-    InvCipher();
+    InvCipher((state_t*)output, CbcCtx.round_key);
   }
 }
 
@@ -10,6 +10,7 @@
 #include <stdlib.h>
 #include <aes.h>
 #include "ccm.h"
+#include "ccm_backend.h"
 
 #ifdef VERBOSE_DEBUG
 #define print_block(block, size)  debug_print_block(block, size)
@@ -47,6 +48,9 @@ static const uint8_t n = N_DEF;
 static const uint8_t t = T_DEF; /* Length of auth_tag in bytes*/
 #endif
 
+/* Accelerator used for complete messages, if any. See ccm_backend.h */
+static const ccm_backend_t *m_backend = NULL;
+
 /* Converts @number to octet string @oct_str of octet length oct_len
  * e.g. if text_to_encrypt_len is 512 and q is 3 then Q is 00000000 00000010 00000000
  * P.S. octet strings are stored in array of unsinged 8 bit integer
@@ -119,9 +123,9 @@ static int format_b0(const uint8_t t, const uint16_t text_to_encrypt_len,
 
 }
 
-static void ciph_block(uint8_t *blocks, const uint8_t *key)
+static void ciph_block(uint8_t *blocks, const aes128_ctx *key)
 {
-    AES128_ECB_encrypt(blocks, key, blocks);
+    AES128_ECB_encrypt_ctx(key, blocks, blocks);
 }
 
 #ifdef VERBOSE_DEBUG
@@ -151,7 +155,7 @@ static void bit_xor(const uint8_t *block, uint8_t *next_block, int size)
 #endif
 
 /*See section A.2.2 in NIST pdf */
-static int format_aad(uint8_t blocks[2][BLOCK_SIZE], const uint8_t *aad, const uint32_t aad_len, const uint8_t *key)
+static int format_aad(uint8_t blocks[2][BLOCK_SIZE], const uint8_t *aad, const uint32_t aad_len, const aes128_ctx *key)
 {
     int i;
     int offset;
@@ -225,7 +229,7 @@ static int format_aad(uint8_t blocks[2][BLOCK_SIZE], const uint8_t *aad, const u
 
 static void format_payload_block(uint8_t blocks[2][BLOCK_SIZE], const uint8_t *P,
                                  const uint16_t text_to_encrypt_len,
-                                 const uint8_t *key)
+                                 const aes128_ctx *key)
 {
     int i;
     int no_blocks_payload = (text_to_encrypt_len / BLOCK_SIZE);
@@ -263,7 +267,7 @@ static void encrypt_or_decrypt(
         uint8_t *block,
         const uint8_t *nonce,
         int mac_len,
-        const uint8_t* key,
+        const aes128_ctx* key,
         uint8_t *mac,
         int mode)
 
@@ -316,6 +320,7 @@ uint32_t CCM_encrypt_and_auth(
         const uint16_t text_to_encrypt_len)
 {
     uint8_t blocks[2][BLOCK_SIZE];
+    aes128_ctx key_ctx;
     int mac_len = t;
     //uint8_t mac[BLOCK_SIZE]; /* see mac_len */
     //int i;
@@ -326,19 +331,33 @@ uint32_t CCM_encrypt_and_auth(
     if (text_to_encrypt_len % BLOCK_SIZE)
         counter_blocks++;
 
+    if ((NULL != m_backend) && (NULL != m_backend->encrypt)) {
+        const ccm_backend_msg_t msg = {
+            key, nonce, n, aad, aad_len,
+            plain_ciphertext, text_to_encrypt_len,
+            plain_ciphertext + text_to_encrypt_len, t
+        };
+        if (CCM_BACKEND_SUCCESS == m_backend->encrypt(&msg)) {
+            return (uint32_t)(text_to_encrypt_len + mac_len);
+        }
+    }
+
+    /* The same key is used for every block, so expand it only once */
+    AES128_init_ctx(&key_ctx, key);
+
     format_b0(mac_len, text_to_encrypt_len, blocks[0], nonce);
     ccm_print_str("block[0]: ");
     print_block(blocks[0], BLOCK_SIZE);
-    ciph_block(blocks[0], key);
-    if(!format_aad(blocks, aad, aad_len, key)) {
+    ciph_block(blocks[0], &key_ctx);
+    if(!format_aad(blocks, aad, aad_len, &key_ctx)) {
         return 0;
     }
 
-    format_payload_block(blocks, plain_ciphertext, text_to_encrypt_len, key);
+    format_payload_block(blocks, plain_ciphertext, text_to_encrypt_len, &key_ctx);
 
     ccm_print_str("MAC/T/auth tag: ");
     print_block(blocks[0], mac_len);
-    encrypt_or_decrypt(plain_ciphertext, text_to_encrypt_len, counter_blocks, blocks[0], nonce, mac_len, key, blocks[0], ENCRYPT);
+    encrypt_or_decrypt(plain_ciphertext, text_to_encrypt_len, counter_blocks, blocks[0], nonce, mac_len, &key_ctx, blocks[0], ENCRYPT);
     ccm_print_str("Encrypted text: ");
     print_block(plain_ciphertext, text_to_encrypt_len);
     memcpy(plain_ciphertext + text_to_encrypt_len, blocks[0], mac_len);
@@ -360,6 +379,7 @@ uint16_t CCM_decrypt_and_auth(
     uint8_t blocks[2][BLOCK_SIZE];
     unsigned int num_counter_blocks = (ciphertext_len - t) / BLOCK_SIZE + 1;
     uint8_t mac[BLOCK_SIZE]; /* see mac_len */
+    aes128_ctx key_ctx;
     int mac_len = t;
     //int i, j;
     //uint8_t *first_block;
@@ -373,8 +393,28 @@ uint16_t CCM_decrypt_and_auth(
       ccm_print_str("INVALID");
       return 0;
     }
+
+    if ((NULL != m_backend) && (NULL != m_backend->decrypt)) {
+        const ccm_backend_msg_t msg = {
+            key, nonce, n, aad, aad_len,
+            cipher_plaintext, (uint16_t)(ciphertext_len - t),
+            cipher_plaintext + ciphertext_len - t, t
+        };
+        switch (m_backend->decrypt(&msg)) {
+            case CCM_BACKEND_SUCCESS:
+                return ciphertext_len - t;
+            case CCM_BACKEND_AUTH_FAILED:
+                ccm_print_str("INVALID MAC reported by backend\n");
+                return 0;
+            default:
+                break;
+        }
+    }
+
+    AES128_init_ctx(&key_ctx, key);
+
     ccm_print_str("decryption ");
-    encrypt_or_decrypt(cipher_plaintext, ciphertext_len - t, num_counter_blocks, blocks[0], nonce, mac_len, key, mac, DECRYPT);
+    encrypt_or_decrypt(cipher_plaintext, ciphertext_len - t, num_counter_blocks, blocks[0], nonce, mac_len, &key_ctx, mac, DECRYPT);
     ccm_print_str("decrypted text: ");
     print_block(cipher_plaintext, ciphertext_len - t);
 
@@ -386,12 +426,12 @@ uint16_t CCM_decrypt_and_auth(
 
     format_b0(mac_len, ciphertext_len - t, blocks[0], nonce);
     print_block(blocks[0], BLOCK_SIZE);
-    ciph_block(blocks[0], key);
-    if(!format_aad(blocks, aad, aad_len, key)) {
+    ciph_block(blocks[0], &key_ctx);
+    if(!format_aad(blocks, aad, aad_len, &key_ctx)) {
         return 0;
     }
 
-    format_payload_block(blocks, cipher_plaintext, ciphertext_len - t, key);
+    format_payload_block(blocks, cipher_plaintext, ciphertext_len - t, &key_ctx);
 
     ccm_print_str("mac: ");
     print_block(blocks[0], mac_len);
@@ -403,6 +443,11 @@ uint16_t CCM_decrypt_and_auth(
     return ciphertext_len - t;
 }
 
+void CCM_set_backend(const ccm_backend_t *backend)
+{
+  m_backend = backend;
+}
+
 #ifndef CCM_USE_PREDEFINED_VALUES
 void set_q_n_t(uint8_t q_in, uint8_t n_in, uint8_t t_in)
 {
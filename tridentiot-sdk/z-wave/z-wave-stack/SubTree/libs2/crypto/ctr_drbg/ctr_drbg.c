@@ -58,6 +58,20 @@ void AJ_AES_ECB_128_ENCRYPT(uint8_t* key, uint8_t* in, uint8_t* out)
 #endif
 }
 
+/*
+ * Block cipher keyed with the current DRBG Key. Without a secure vault the key is
+ * expanded once for all the blocks generated with it.
+ */
+#ifdef ZWAVE_PSA_AES
+typedef const uint8_t * drbg_cipher_t;
+#define DRBG_CIPHER_INIT(cipher, key)     ((cipher) = (key))
+#define DRBG_CIPHER_BLOCK(cipher, in, out) AJ_AES_ECB_128_ENCRYPT((uint8_t *)(cipher), (in), (out))
+#else
+typedef aes128_ctx drbg_cipher_t;
+#define DRBG_CIPHER_INIT(cipher, key)     AES128_init_ctx(&(cipher), (key))
+#define DRBG_CIPHER_BLOCK(cipher, in, out) AES128_ECB_encrypt_ctx(&(cipher), (in), (out))
+#endif
+
 static void AES_CTR_DRBG_Increment(uint8_t* __data, size_t size)
 {
     while (size--) {
@@ -85,14 +99,16 @@ static void AES_CTR_DRBG_Update(CTR_DRBG_CTX* ctx, uint8_t __data[SEEDLEN])
     size_t i = 0;
     uint8_t tmp[SEEDLEN] = { 0 };
     uint8_t* t = tmp;
+    drbg_cipher_t cipher;
 #ifdef VERBOSE
     int j = 0;
 #endif
 
     //AJ_AES_Enable(ctx->k);
+    DRBG_CIPHER_INIT(cipher, ctx->k);
     for (i = 0; i < SEEDLEN; i += OUTLEN) {
         AES_CTR_DRBG_Increment(ctx->v, OUTLEN); /*V= (V+ 1) mod 2 pow(outlen) */
-        AJ_AES_ECB_128_ENCRYPT(ctx->k, ctx->v, t); /* output_block =  Block_Encrypt(Key, V). */
+        DRBG_CIPHER_BLOCK(cipher, ctx->v, t); /* output_block =  Block_Encrypt(Key, V). */
         t += OUTLEN; /*temp = temp || ouput_block */
     }
 
@@ -159,6 +175,7 @@ void AES_CTR_DRBG_Generate(CTR_DRBG_CTX* ctx, uint8_t* rand)
     uint8_t __data[SEEDLEN] = { 0 };
     size_t copy;
     size_t size = RANDLEN;
+    drbg_cipher_t cipher;
 
 //    /* Needed?? Is uint8_t enough ??? */
 //    uint16_t count = 0;
@@ -169,9 +186,10 @@ void AES_CTR_DRBG_Generate(CTR_DRBG_CTX* ctx, uint8_t* rand)
     // Reseed interval 2^32 (counter wraps to zero)
     // See section 10.2.1.5.1. Step 1 in "CTR_DRBG Generate Proces"
     //AJ_AES_Enable(ctx->k);
+    DRBG_CIPHER_INIT(cipher, ctx->k);
     while (size) {
         AES_CTR_DRBG_Increment(ctx->v, OUTLEN);
-        AJ_AES_ECB_128_ENCRYPT(ctx->k, ctx->v, __data);
+        DRBG_CIPHER_BLOCK(cipher, ctx->v, __data);
         copy = (size < OUTLEN) ? size : OUTLEN;
         memcpy(rand, __data, copy);
         rand += copy;
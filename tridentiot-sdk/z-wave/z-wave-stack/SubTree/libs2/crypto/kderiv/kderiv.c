@@ -13,7 +13,8 @@
 #endif
 #define CONSTANT_NK_LEN 15
 
-static void zw_expand_aes_cmac(uint32_t key_id, const uint8_t *network_key, const uint8_t *input, uint16_t length, uint8_t *output)
+static void zw_expand_aes_cmac(uint32_t key_id, const uint8_t *network_key, const aes128_ctx *network_key_ctx,
+                               const uint8_t *input, uint16_t length, uint8_t *output)
 {
 #if defined(ZWAVE_PSA_SECURE_VAULT) && defined(ZWAVE_PSA_AES)
     if (key_id)
@@ -37,7 +38,7 @@ static void zw_expand_aes_cmac(uint32_t key_id, const uint8_t *network_key, cons
     }
 #else
     ASSERT(key_id == ZWAVE_KEY_ID_NONE);
-    aes_cmac_calculate(network_key, input, length, output);
+    aes_cmac_calculate_ctx(network_key_ctx, input, length, output);
 #endif
 }
 
@@ -50,29 +51,38 @@ void generic_expand(
     uint8_t *mpan_key)
 {
     uint8_t temp[32];
+#if defined(ZWAVE_PSA_SECURE_VAULT) && defined(ZWAVE_PSA_AES)
+    /* The CMACs run in the secure vault, which takes the key and not its schedule */
+    const aes128_ctx *p_network_key_ctx = NULL;
+#else
+    /* All four CMACs below use the network key, so it is only expanded once */
+    aes128_ctx network_key_ctx;
+    AES128_init_ctx(&network_key_ctx, network_key);
+    const aes128_ctx *p_network_key_ctx = &network_key_ctx;
+#endif
 
     /* ccm_key = CMAC(NetworkKey, temp) */
     memcpy(temp, constant_nk, 15);
     temp[15] = 0x01;
-    zw_expand_aes_cmac(key_id, network_key, temp, 16, ccm_key);
+    zw_expand_aes_cmac(key_id, network_key, p_network_key_ctx, temp, 16, ccm_key);
 
     /* nonce_pstring first half */
     memcpy(temp, ccm_key, 16);
     memcpy(temp+16, constant_nk, 15);
     temp[31] = 0x02;
-    zw_expand_aes_cmac(key_id, network_key, temp, 32, nonce_pstring);
+    zw_expand_aes_cmac(key_id, network_key, p_network_key_ctx, temp, 32, nonce_pstring);
 
     /* nonce_pstring is 32 bytes, fill out second half */
     memcpy(temp, nonce_pstring, 16);
     memcpy(temp+16, constant_nk, 15);
     temp[31] = 0x03;
-    zw_expand_aes_cmac(key_id, network_key, temp, 32, nonce_pstring+16);
+    zw_expand_aes_cmac(key_id, network_key, p_network_key_ctx, temp, 32, nonce_pstring+16);
 
     /* MPAN key */
     memcpy(temp, nonce_pstring+16, 16);
     memcpy(temp+16, constant_nk, 15);
     temp[31] = 0x04;
-    zw_expand_aes_cmac(key_id, network_key, temp, 32, mpan_key);
+    zw_expand_aes_cmac(key_id, network_key, p_network_key_ctx, temp, 32, mpan_key);
 
     return;
 }
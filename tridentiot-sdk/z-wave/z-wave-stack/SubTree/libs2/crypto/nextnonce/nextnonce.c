@@ -34,7 +34,9 @@ static void ckdf_nonce0_expand(uint8_t *prk, uint8_t *mei)
     zw_wrap_aes_key_secure_vault(&key_id, prk, ZW_PSA_ALG_CMAC);
     zw_psa_aes_cmac(key_id, t0, 32, t1);
 #else
-    aes_cmac_calculate(prk, t0, 32, t1); /* TODO t1 will be 16 byte after this? */
+    aes128_ctx prk_ctx;
+    AES128_init_ctx(&prk_ctx, prk);
+    aes_cmac_calculate_ctx(&prk_ctx, t0, 32, t1); /* TODO t1 will be 16 byte after this? */
 #endif
 
     /*T2 = CMAC(K NONCE , T1 | Constant NK | 0x02)*/
@@ -45,7 +47,7 @@ static void ckdf_nonce0_expand(uint8_t *prk, uint8_t *mei)
     zw_psa_aes_cmac(key_id, t0, 32, t2);
     zw_psa_destroy_key(key_id);
 #else
-    aes_cmac_calculate(prk, t0, 32, t2);
+    aes_cmac_calculate_ctx(&prk_ctx, t0, 32, t2);
 #endif
 
     /* MEI = T1 | T2 */
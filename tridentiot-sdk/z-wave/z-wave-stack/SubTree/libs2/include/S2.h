@@ -192,6 +192,19 @@ typedef enum {
 
 } s2_tx_status_t;
 
+/**
+ * Counters of the SPAN and MPAN tables, see \ref S2_get_pan_stats.
+ */
+typedef struct {
+  uint32_t span_evictions;        ///< SPANs replaced because the table was full
+  /**
+   * Evicted SPANs that were synchronized. The peer of each of these has to resynchronize
+   * with a Nonce Get/Report exchange the next time it communicates with us.
+   */
+  uint32_t span_resync_evictions;
+  uint32_t mpan_evictions;        ///< MPANs replaced because the table was full
+} s2_pan_stats_t;
+
 
 /**
  * Anonymous declaration of the S2 context, the data inside S2 context must not be
@@ -377,6 +390,14 @@ uint8_t S2_is_busy(struct S2* ctxt);
 */
 void S2_free_mpan(struct S2* p_context, node_t owner_id, uint8_t group_id);
 
+/**
+* Get the counters of the SPAN and MPAN tables.
+*
+* \param ctxt         the S2 context
+* \param[out] stats   Counters since the context was initialized
+*/
+void S2_get_pan_stats(struct S2* p_context, s2_pan_stats_t *stats);
+
 #include "S2_external.h"
 #include "s2_inclusion.h"
 
@@ -29,11 +29,39 @@
 
 
 
+/**
+ * AES-128 key with its round keys expanded.
+ *
+ * Expanding the key is as costly as encrypting a block, so modes encrypting
+ * several blocks under the same key should expand it once into a context and
+ * use the _ctx functions. A context is not modified by encryption, so it may be
+ * shared by several users.
+ */
+typedef struct
+{
+  uint32_t round_key[44]; /**< Nb * (Nr + 1) round key words */
+} aes128_ctx;
+
 #if defined(ECB) && ECB
 
 DllExport void AES128_ECB_encrypt(uint8_t* input, const uint8_t* key, uint8_t *output);
 DllExport void AES128_ECB_decrypt(uint8_t* input, const uint8_t* key, uint8_t *output);
 
+/**
+ * Expands a 16 byte key into a context.
+ */
+void AES128_init_ctx(aes128_ctx* ctx, const uint8_t* key);
+
+/**
+ * Encrypts a single 16 byte block. input and output may point to the same buffer.
+ */
+void AES128_ECB_encrypt_ctx(const aes128_ctx* ctx, const uint8_t* input, uint8_t* output);
+
+/**
+ * Decrypts a single 16 byte block. input and output may point to the same buffer.
+ */
+void AES128_ECB_decrypt_ctx(const aes128_ctx* ctx, const uint8_t* input, uint8_t* output);
+
 #endif // #if defined(ECB) && ECB
 
 
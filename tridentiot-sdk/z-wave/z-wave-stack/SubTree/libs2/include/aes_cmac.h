@@ -45,6 +45,7 @@
 
 
 #include <stdint.h>
+#include "aes.h"
 
 /**
  * \ingroup crypto
@@ -75,6 +76,22 @@ void aes_cmac_calculate(
         const uint16_t message_length,
         uint8_t * mac);
 
+/**
+ * @brief Calculates an AES-CMAC from an expanded key, message and message length.
+ *
+ * Use this instead of aes_cmac_calculate() when several MACs are calculated with
+ * the same key, so the key is only expanded once.
+ * @param key Pointer to a key expanded with AES128_init_ctx().
+ * @param message Pointer to the message to be authenticated.
+ * @param message_length Length of the message in octets.
+ * @param mac Pointer to an array where the calculated AES-CMAC can be stored.
+ */
+void aes_cmac_calculate_ctx(
+        const aes128_ctx * key,
+        const uint8_t * message,
+        const uint16_t message_length,
+        uint8_t * mac);
+
 /**
  * @brief Verifies a given AES-CMAC from a given key, message and message length.
  * @param key Pointer to a 128-bit key.
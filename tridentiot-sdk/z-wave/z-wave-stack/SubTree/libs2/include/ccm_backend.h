@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file ccm_backend.h
+ *
+ * Hook for handing complete CCM messages to a crypto accelerator.
+ *
+ * When no backend is registered, or the registered backend declines a message,
+ * CCM_encrypt_and_auth() and CCM_decrypt_and_auth() use the software AES of libs2.
+ */
+#ifndef CCM_BACKEND_H_
+#define CCM_BACKEND_H_
+
+#include <stdint.h>
+
+/**
+ * \ingroup crypto
+ * @{
+ */
+
+/**
+ * Result of a CCM backend operation.
+ */
+typedef enum
+{
+  CCM_BACKEND_SUCCESS,      ///< Message processed and, when decrypting, authenticated
+  CCM_BACKEND_AUTH_FAILED,  ///< Message decrypted, but the MAC did not match
+  CCM_BACKEND_UNSUPPORTED,  ///< Message not processed. The software implementation is used instead.
+} ccm_backend_status_t;
+
+/**
+ * A complete CCM message as passed to a backend.
+ *
+ * The text is processed in place. When encrypting, the MAC is written to @p mac.
+ * When decrypting, @p mac holds the received MAC.
+ */
+typedef struct
+{
+  const uint8_t *key;     ///< 16 byte AES key
+  const uint8_t *nonce;
+  uint8_t nonce_len;
+  const uint8_t *aad;     ///< Additional Authenticated Data (AAD)
+  uint32_t aad_len;
+  uint8_t *text;          ///< Plaintext or ciphertext, excluding the MAC
+  uint16_t text_len;
+  uint8_t *mac;
+  uint8_t mac_len;
+} ccm_backend_msg_t;
+
+/**
+ * Operations of a CCM backend.
+ *
+ * A backend returning CCM_BACKEND_UNSUPPORTED must leave the text and MAC untouched.
+ * Either function pointer may be NULL if the backend only handles one direction.
+ */
+typedef struct
+{
+  ccm_backend_status_t (*encrypt)(const ccm_backend_msg_t *msg);
+  ccm_backend_status_t (*decrypt)(const ccm_backend_msg_t *msg);
+} ccm_backend_t;
+
+/**
+ * Registers the backend used for all following CCM operations.
+ *
+ * @param backend Backend operations, or NULL to use the software implementation only.
+ *                The structure must stay valid while it is registered.
+ */
+void CCM_set_backend(const ccm_backend_t *backend);
+
+/**
+ * @}
+ */
+
+#endif /* CCM_BACKEND_H_ */
@@ -32,6 +32,15 @@
 #define SPAN_TABLE_SIZE 10
 #define MPAN_TABLE_SIZE 10
 #endif
+/*
+ * Number of slots in the hash indexes used to find the SPAN or MPAN of a peer.
+ * Must be a power of two.
+ */
+#if SPAN_TABLE_SIZE > 16
+#define PAN_INDEX_SIZE 256
+#else
+#define PAN_INDEX_SIZE 16
+#endif
 #define MOS_LIST_LENGTH 3
 #if defined(EFR32ZG) || defined(ZW050x)
 #define WORKBUF_SIZE 200
@@ -214,6 +223,20 @@ struct S2
   struct MPAN mpan_table[MPAN_TABLE_SIZE];
   struct MOS_LIST mos_list[MOS_LIST_LENGTH];
 #endif
+
+  /* The tables above are restored from NVM as they are, so the lookup state is kept
+   * separately. An index slot holds the table entry last found for that hash and is
+   * only a hint, which is verified before use. */
+  uint8_t span_index[PAN_INDEX_SIZE];
+  uint16_t span_last_used[SPAN_TABLE_SIZE]; //Use clock value of the last lookup of each SPAN
+  uint16_t span_use_clock;
+#ifdef S2_MULTICAST
+  uint8_t mpan_index[PAN_INDEX_SIZE];
+  uint16_t mpan_last_used[MPAN_TABLE_SIZE]; //Use clock value of the last lookup of each MPAN
+  uint16_t mpan_use_clock;
+#endif
+  s2_pan_stats_t pan_stats;
+
   states_t fsm;
   uint8_t retry;
   s2_inclusion_state_t inclusion_state;
@@ -150,6 +150,61 @@ static uint32_t convert_key_slot_to_keyid(uint8_t slot_id)
 }
 #endif
 
+/**
+ * Record a lookup of entry \a i in the LRU state of a SPAN or MPAN table.
+ */
+static void
+pan_touch(uint16_t* use_clock, uint16_t* last_used, uint8_t table_size, uint8_t i)
+{
+  if (++(*use_clock) == 0)
+  {
+    /* The clock wrapped. Start all entries over as equally old, which only loses
+     * the order of the entries once every 65535 lookups. */
+    memset(last_used, 0, table_size * sizeof(uint16_t));
+    *use_clock = 1;
+  }
+  last_used[i] = *use_clock;
+}
+
+/**
+ * Find the least recently used entry of a SPAN or MPAN table.
+ */
+static uint8_t
+pan_least_recently_used(const uint16_t* last_used, uint8_t table_size)
+{
+  uint8_t lru = 0;
+  uint8_t i;
+
+  for (i = 1; i < table_size; i++)
+  {
+    if (last_used[i] < last_used[lru])
+    {
+      lru = i;
+    }
+  }
+  return lru;
+}
+
+static uint8_t
+span_hash(node_t lnode, node_t rnode)
+{
+  return (uint8_t)((rnode ^ (rnode >> 8) ^ (lnode * 31)) & (PAN_INDEX_SIZE - 1));
+}
+
+static uint8_t
+mpan_hash(node_t owner_id, uint8_t group_id)
+{
+  return (uint8_t)((group_id ^ owner_id ^ (owner_id >> 8) ^ (owner_id << 5)) & (PAN_INDEX_SIZE - 1));
+}
+
+static int
+mpan_matches(struct S2* p_context, const struct MPAN* mpan, node_t owner_id, uint8_t group_id)
+{
+  CTX_DEF
+  return (mpan->state != MPAN_NOT_USED) && (mpan->group_id == group_id)
+      && (mpan->owner_id == owner_id) && ((1 << mpan->class_id) & ctxt->loaded_keys);
+}
+
 /**
  * Find or allocate an mpan by group_id id no match can be found
  * we use a new entry.
@@ -158,23 +213,34 @@ static struct MPAN*
 find_mpan_by_group_id(struct S2* p_context, node_t owner_id, uint8_t group_id, uint8_t create_new)
 {
   CTX_DEF
-  uint8_t rnd[RANDLEN];
+  uint8_t* hint = &ctxt->mpan_index[mpan_hash(owner_id, group_id)];
   int i;
 
-  for (i = 0; i < MPAN_TABLE_SIZE; i++)
+  /* Try the entry last found for this hash before searching the whole table */
+  if ((*hint < MPAN_TABLE_SIZE) && mpan_matches(ctxt, &ctxt->mpan_table[*hint], owner_id, group_id))
+  {
+    i = *hint;
+  }
+  else
   {
-    if ((ctxt->mpan_table[i].state != MPAN_NOT_USED) && (ctxt->mpan_table[i].group_id == group_id)
-        && (ctxt->mpan_table[i].owner_id == owner_id) && ((1 << ctxt->mpan_table[i].class_id) &  ctxt->loaded_keys))
+    for (i = 0; i < MPAN_TABLE_SIZE; i++)
     {
-      return &ctxt->mpan_table[i];
+      if (mpan_matches(ctxt, &ctxt->mpan_table[i], owner_id, group_id))
+      {
+        break;
+      }
     }
   }
+  if (i < MPAN_TABLE_SIZE)
+  {
+    pan_touch(&ctxt->mpan_use_clock, ctxt->mpan_last_used, MPAN_TABLE_SIZE, i);
+    *hint = i;
+    return &ctxt->mpan_table[i];
+  }
   if (!create_new)
   {
     return 0;
   }
-  /*We need to be find an unused group handle */
-  AES_CTR_DRBG_Generate(&s2_ctr_drbg, rnd);
 
   /*Allocate new entry if possible */
   for (i = 0; i < MPAN_TABLE_SIZE; i++)
@@ -185,13 +251,12 @@ find_mpan_by_group_id(struct S2* p_context, node_t owner_id, uint8_t group_id, u
     }
   }
 
-  /*Just select a random entry Note this will overwrite existing entries
-   * TODO we should really select the oldest entry
-   * */
+  /*Replace the least recently used entry */
   if (i == MPAN_TABLE_SIZE)
   {
-    i = rnd[0] % MPAN_TABLE_SIZE;
-    DPRINT("dropping random span entry\n");
+    i = pan_least_recently_used(ctxt->mpan_last_used, MPAN_TABLE_SIZE);
+    ctxt->pan_stats.mpan_evictions++;
+    DPRINT("dropping least recently used mpan entry\n");
   }
 
   ctxt->mpan_table[i].state = owner_id ? MPAN_MOS : MPAN_SET;
@@ -200,26 +265,48 @@ find_mpan_by_group_id(struct S2* p_context, node_t owner_id, uint8_t group_id, u
   ctxt->mpan_table[i].class_id = ctxt->peer.class_id; //Here we assume that peer is set...
 
   AES_CTR_DRBG_Generate(&s2_ctr_drbg, ctxt->mpan_table[i].inner_state);
-  ;
 
+  pan_touch(&ctxt->mpan_use_clock, ctxt->mpan_last_used, MPAN_TABLE_SIZE, i);
+  *hint = i;
   return &ctxt->mpan_table[i];
 }
 
+static int
+span_matches(const struct SPAN* span, const s2_connection_t* con)
+{
+  return (span->state != SPAN_NOT_USED) && (span->lnode == con->l_node) && (span->rnode == con->r_node);
+}
+
 static struct SPAN  *
 find_span_by_node(struct S2* p_context, const s2_connection_t* con)
 {
   CTX_DEF
   uint8_t rnd[RANDLEN];
+  uint8_t* hint = &ctxt->span_index[span_hash(con->l_node, con->r_node)];
   int i;
-  /* Locate existing entry */
-  for (i = 0; i < SPAN_TABLE_SIZE; i++)
+
+  /* Try the entry last found for this hash before searching the whole table */
+  if ((*hint < SPAN_TABLE_SIZE) && span_matches(&ctxt->span_table[*hint], con))
+  {
+    i = *hint;
+  }
+  else
   {
-    if (ctxt->span_table[i].state != SPAN_NOT_USED && (ctxt->span_table[i].lnode == con->l_node)
-        && (ctxt->span_table[i].rnode == con->r_node))
+    /* Locate existing entry */
+    for (i = 0; i < SPAN_TABLE_SIZE; i++)
     {
-      return &ctxt->span_table[i];
+      if (span_matches(&ctxt->span_table[i], con))
+      {
+        break;
+      }
     }
   }
+  if (i < SPAN_TABLE_SIZE)
+  {
+    pan_touch(&ctxt->span_use_clock, ctxt->span_last_used, SPAN_TABLE_SIZE, i);
+    *hint = i;
+    return &ctxt->span_table[i];
+  }
 
   AES_CTR_DRBG_Generate(&s2_ctr_drbg, rnd);
 
@@ -232,17 +319,25 @@ find_span_by_node(struct S2* p_context, const s2_connection_t* con)
     }
   }
 
-  /*Just select a random entry Note this will overwrite existing entries*/
+  /*Replace the least recently used entry. Its peer must resynchronize the next time it
+   * communicates with us, so the entry of an active peer is the last one to go. */
   if (i == SPAN_TABLE_SIZE)
   {
-    i = rnd[0] % SPAN_TABLE_SIZE;
-    DPRINT("dropping random span entry\n");
+    i = pan_least_recently_used(ctxt->span_last_used, SPAN_TABLE_SIZE);
+    ctxt->pan_stats.span_evictions++;
+    if (ctxt->span_table[i].state == SPAN_NEGOTIATED)
+    {
+      ctxt->pan_stats.span_resync_evictions++;
+    }
+    DPRINT("dropping least recently used span entry\n");
   }
 
   ctxt->span_table[i].state = SPAN_NO_SEQ;
   ctxt->span_table[i].lnode = con->l_node;
   ctxt->span_table[i].rnode = con->r_node;
   ctxt->span_table[i].tx_seq = rnd[1];
+  pan_touch(&ctxt->span_use_clock, ctxt->span_last_used, SPAN_TABLE_SIZE, i);
+  *hint = i;
   return &ctxt->span_table[i];
 }
 
@@ -693,6 +788,11 @@ uint8_t S2_is_busy(struct S2* p_context)
   return 0;
 }
 
+void S2_get_pan_stats(struct S2* p_context, s2_pan_stats_t *stats) {
+  CTX_DEF
+  *stats = ctxt->pan_stats;
+}
+
 void S2_free_mpan(struct S2* p_context, node_t owner_id, uint8_t group_id) {
   CTX_DEF
   // Search for a MPAN with the Group ID / owner ID, and if found, set it back to NOT USED.
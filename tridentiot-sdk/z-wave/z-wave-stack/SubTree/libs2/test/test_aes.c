@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_aes.c
+ * @brief Unit tests of the keyed AES-128 context of aes.c.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+#include <stdint.h>
+#include <string.h>
+#include "unity.h"
+#include "aes.h"
+
+// NIST SP 800-38A, F.1.1 ECB-AES128.Encrypt
+static const uint8_t key[] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static const uint8_t plain_text[] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                                      0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                                      0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                                      0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+static const uint8_t cipher_text[] = { 0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+                                       0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+                                       0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+                                       0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4 };
+
+void test_encrypt_decrypt_ecb_ctx(void)
+{
+  uint8_t buffer[64];
+  aes128_ctx ctx;
+  uint8_t i;
+
+  // One key expansion for all four blocks, encrypting and decrypting in place
+  AES128_init_ctx(&ctx, key);
+  memcpy(buffer, plain_text, sizeof(buffer));
+  for(i = 0; i < 4; ++i)
+  {
+    AES128_ECB_encrypt_ctx(&ctx, buffer + (i * 16), buffer + (i * 16));
+  }
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(cipher_text, buffer, sizeof(buffer));
+
+  for(i = 0; i < 4; ++i)
+  {
+    AES128_ECB_decrypt_ctx(&ctx, buffer + (i * 16), buffer + (i * 16));
+  }
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(plain_text, buffer, sizeof(buffer));
+}
+
+void test_encrypt_decrypt_ecb_key(void)
+{
+  uint8_t input[16];
+  uint8_t buffer[16];
+  uint8_t i;
+
+  // The key pointer functions give the same result as a context
+  for(i = 0; i < 4; ++i)
+  {
+    memcpy(input, plain_text + (i * 16), sizeof(input));
+    AES128_ECB_encrypt(input, key, buffer);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(cipher_text + (i * 16), buffer, sizeof(buffer));
+
+    AES128_ECB_decrypt(buffer, key, input);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plain_text + (i * 16), input, sizeof(input));
+  }
+}
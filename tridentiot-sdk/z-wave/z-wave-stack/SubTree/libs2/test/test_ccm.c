@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <unity.h>
 #include "ccm.h"
+#include "ccm_backend.h"
 
 void test_verify_handful_payload_lengths(void)
 {
@@ -438,6 +439,92 @@ free_aad:
     return;
 }
 
+/* Backend stub used to check how the CCM functions dispatch to a registered backend */
+static ccm_backend_status_t m_backend_status;
+static ccm_backend_msg_t m_backend_msg;
+static int m_backend_calls;
+
+static ccm_backend_status_t backend_stub(const ccm_backend_msg_t *msg)
+{
+    m_backend_msg = *msg;
+    m_backend_calls++;
+    if (CCM_BACKEND_UNSUPPORTED != m_backend_status) {
+        memset(msg->text, 0xAA, msg->text_len);
+        memset(msg->mac, 0x55, msg->mac_len);
+    }
+    return m_backend_status;
+}
+
+static const ccm_backend_t m_backend_stub = {
+    .encrypt = backend_stub,
+    .decrypt = backend_stub
+};
+
+void test_backend_unsupported_falls_back_to_software(void)
+{
+    uint8_t key[16]= {0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f};
+    uint8_t nonce[8] = {0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17};
+    uint8_t aad[16] = {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f};
+    const uint8_t plaintext[16] = {0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f};
+    const uint8_t nist_cipher_and_auth_tag[16 + 6] = {0xd2, 0xa1, 0xf0, 0xe0, 0x51, 0xea, 0x5f, 0x62, 0x08, 0x1a, 0x77, 0x92, 0x07, 0x3d, 0x59, 0x3d, 0x1f, 0xc6, 0x4f, 0xbf, 0xac, 0xcd};
+    uint8_t buffer[16 + 6];
+
+    set_q_n_t(7, 8, 6);
+    CCM_set_backend(&m_backend_stub);
+    m_backend_status = CCM_BACKEND_UNSUPPORTED;
+    m_backend_calls = 0;
+
+    memcpy(buffer, plaintext, sizeof(plaintext));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(buffer), CCM_encrypt_and_auth(key, nonce, aad, sizeof(aad), buffer, sizeof(plaintext)));
+    TEST_ASSERT_EQUAL_INT(1, m_backend_calls);
+    TEST_ASSERT_EQUAL_PTR(key, m_backend_msg.key);
+    TEST_ASSERT_EQUAL_UINT8(8, m_backend_msg.nonce_len);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(aad), m_backend_msg.aad_len);
+    TEST_ASSERT_EQUAL_PTR(buffer, m_backend_msg.text);
+    TEST_ASSERT_EQUAL_UINT16(sizeof(plaintext), m_backend_msg.text_len);
+    TEST_ASSERT_EQUAL_PTR(buffer + sizeof(plaintext), m_backend_msg.mac);
+    TEST_ASSERT_EQUAL_UINT8(6, m_backend_msg.mac_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(nist_cipher_and_auth_tag, buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL_UINT16(sizeof(plaintext), CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_INT(2, m_backend_calls);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, sizeof(plaintext));
+
+    CCM_set_backend(NULL);
+}
+
+void test_backend_result_is_used(void)
+{
+    uint8_t key[16] = {0};
+    uint8_t nonce[13] = {0};
+    uint8_t aad[4] = {0};
+    uint8_t buffer[10 + 8];
+    uint8_t expected[10 + 8];
+
+    set_q_n_t(2, 13, 8);
+    CCM_set_backend(&m_backend_stub);
+    m_backend_calls = 0;
+
+    m_backend_status = CCM_BACKEND_SUCCESS;
+    memset(buffer, 0, sizeof(buffer));
+    memset(expected, 0xAA, 10);
+    memset(expected + 10, 0x55, 8);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(buffer), CCM_encrypt_and_auth(key, nonce, aad, sizeof(aad), buffer, 10));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL_UINT16(10, CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), buffer, sizeof(buffer)));
+
+    m_backend_status = CCM_BACKEND_AUTH_FAILED;
+    TEST_ASSERT_EQUAL_UINT16(0, CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_INT(3, m_backend_calls);
+
+    /* Without a backend the bogus MAC is rejected by the software implementation */
+    CCM_set_backend(NULL);
+    TEST_ASSERT_EQUAL_UINT16(0, CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_INT(3, m_backend_calls);
+}
+
+
 #ifdef NOT_USED
 static int test_all_aad_lengths()
 {
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_s2_pan.c
+ * @brief Unit tests of the hint index and the least recently used eviction of the SPAN and
+ *        MPAN tables of S2.c.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+#include <stdint.h>
+#include <string.h>
+#include "unity.h"
+#include "../protocol/S2.c"
+
+static struct S2 s2_ctx;
+
+/*
+ * The functions S2.c expects from the application and the inclusion module. None of
+ * them are used by the table lookups.
+ */
+void S2_send_done_event(struct S2* ctxt, s2_tx_status_t status) { (void)ctxt; (void)status; }
+void S2_msg_received_event(struct S2* ctxt, s2_connection_t* peer, uint8_t* buf, uint16_t len) { (void)ctxt; (void)peer; (void)buf; (void)len; }
+uint8_t S2_send_frame(struct S2* ctxt, const s2_connection_t* peer, uint8_t* buf, uint16_t len) { (void)ctxt; (void)peer; (void)buf; (void)len; return 0; }
+uint8_t S2_send_frame_no_cb(struct S2* ctxt, const s2_connection_t* peer, uint8_t* buf, uint16_t len) { (void)ctxt; (void)peer; (void)buf; (void)len; return 0; }
+uint8_t S2_send_frame_multi(struct S2* ctxt, s2_connection_t* peer, uint8_t* buf, uint16_t len) { (void)ctxt; (void)peer; (void)buf; (void)len; return 0; }
+void S2_set_timeout(struct S2* ctxt, uint32_t interval) { (void)ctxt; (void)interval; }
+void S2_stop_timeout(struct S2* ctxt) { (void)ctxt; }
+void S2_get_hw_random(uint8_t *buf, uint8_t len) { memset(buf, 0, len); }
+void S2_get_commands_supported(node_t lnode, uint8_t class_id, const uint8_t ** cmdClasses, uint8_t* length) { (void)lnode; (void)class_id; *cmdClasses = NULL; *length = 0; }
+void S2_resynchronization_event(node_t remote_node, sos_event_reason_t reason, uint8_t seqno, node_t local_node) { (void)remote_node; (void)reason; (void)seqno; (void)local_node; }
+void s2_inclusion_send_done(struct S2 *p_context, uint8_t status) { (void)p_context; (void)status; }
+void s2_inclusion_decryption_failure(struct S2 *p_context, s2_connection_t* src) { (void)p_context; (void)src; }
+void s2_inclusion_post_event(struct S2 *p_context, s2_connection_t* src) { (void)p_context; (void)src; }
+void s2_restore_keys(struct S2 *p_context, bool make_keys_persist_se) { (void)p_context; (void)make_keys_persist_se; }
+
+static s2_connection_t span_connection(node_t rnode)
+{
+  s2_connection_t con = { 0 };
+  con.l_node = 1;
+  con.r_node = rnode;
+  return con;
+}
+
+void setUp(void)
+{
+  memset(&s2_ctx, 0, sizeof(s2_ctx));
+  s2_ctx.loaded_keys = 0x01;
+  s2_ctx.peer.class_id = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * A lookup of an existing MPAN is served by its hint and does not allocate anything.
+ */
+void test_mpan_hit(void)
+{
+  s2_pan_stats_t stats;
+  struct MPAN* mpan = find_mpan_by_group_id(&s2_ctx, 0, 7, 1);
+
+  TEST_ASSERT_NOT_NULL(mpan);
+  uint8_t slot = (uint8_t)(mpan - s2_ctx.mpan_table);
+  TEST_ASSERT_EQUAL_UINT8(slot, s2_ctx.mpan_index[mpan_hash(0, 7)]);
+
+  TEST_ASSERT_EQUAL_PTR(mpan, find_mpan_by_group_id(&s2_ctx, 0, 7, 0));
+  TEST_ASSERT_EQUAL_PTR(mpan, find_mpan_by_group_id(&s2_ctx, 0, 7, 1));
+  for (int i = 0; i < MPAN_TABLE_SIZE; i++)
+  {
+    if (i != slot)
+    {
+      TEST_ASSERT_EQUAL(MPAN_NOT_USED, s2_ctx.mpan_table[i].state);
+    }
+  }
+  S2_get_pan_stats(&s2_ctx, &stats);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.mpan_evictions);
+}
+
+/**
+ * A miss returns nothing unless asked to create the MPAN, which fills a free entry.
+ * A hint that no longer matches its entry, e.g. after the table was restored from
+ * NVM, falls back to the search of the table.
+ */
+void test_mpan_miss_then_fill(void)
+{
+  TEST_ASSERT_NULL(find_mpan_by_group_id(&s2_ctx, 0, 3, 0));
+
+  struct MPAN* mpan = find_mpan_by_group_id(&s2_ctx, 0, 3, 1);
+  TEST_ASSERT_NOT_NULL(mpan);
+  TEST_ASSERT_EQUAL(MPAN_SET, mpan->state);
+  TEST_ASSERT_EQUAL_UINT8(3, mpan->group_id);
+
+  // Move the entry to another slot behind the back of the index
+  struct MPAN* moved = &s2_ctx.mpan_table[MPAN_TABLE_SIZE - 1];
+  TEST_ASSERT_TRUE(moved != mpan);
+  *moved = *mpan;
+  mpan->state = MPAN_NOT_USED;
+
+  TEST_ASSERT_EQUAL_PTR(moved, find_mpan_by_group_id(&s2_ctx, 0, 3, 0));
+  TEST_ASSERT_EQUAL_UINT8(MPAN_TABLE_SIZE - 1, s2_ctx.mpan_index[mpan_hash(0, 3)]);
+}
+
+/**
+ * A full table replaces the entry that was looked up the longest time ago.
+ */
+void test_mpan_evicts_least_recently_used(void)
+{
+  s2_pan_stats_t stats;
+  struct MPAN* oldest = NULL;
+  uint8_t group;
+
+  for (group = 1; group <= MPAN_TABLE_SIZE; group++)
+  {
+    struct MPAN* mpan = find_mpan_by_group_id(&s2_ctx, 0, group, 1);
+    TEST_ASSERT_NOT_NULL(mpan);
+    if (group == 4)
+    {
+      oldest = mpan;
+    }
+  }
+  // Use all groups but group 4, which becomes the oldest
+  for (group = 1; group <= MPAN_TABLE_SIZE; group++)
+  {
+    if (group != 4)
+    {
+      TEST_ASSERT_NOT_NULL(find_mpan_by_group_id(&s2_ctx, 0, group, 0));
+    }
+  }
+
+  // A group of another owner, so it cannot match any of the groups above
+  struct MPAN* mpan = find_mpan_by_group_id(&s2_ctx, 5, 4, 1);
+
+  TEST_ASSERT_EQUAL_PTR(oldest, mpan);
+  TEST_ASSERT_EQUAL(MPAN_MOS, mpan->state);
+  TEST_ASSERT_EQUAL_UINT16(5, mpan->owner_id);
+  TEST_ASSERT_NULL(find_mpan_by_group_id(&s2_ctx, 0, 4, 0));
+  for (group = 1; group <= MPAN_TABLE_SIZE; group++)
+  {
+    if (group != 4)
+    {
+      TEST_ASSERT_NOT_NULL(find_mpan_by_group_id(&s2_ctx, 0, group, 0));
+    }
+  }
+  S2_get_pan_stats(&s2_ctx, &stats);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.mpan_evictions);
+}
+
+/**
+ * A full SPAN table replaces the least recently used peer and counts the eviction of a
+ * synchronized SPAN as one that forces a resynchronization.
+ */
+void test_span_evicts_least_recently_used(void)
+{
+  s2_pan_stats_t stats;
+  s2_connection_t con;
+  node_t rnode;
+
+  for (rnode = 2; rnode < 2 + SPAN_TABLE_SIZE; rnode++)
+  {
+    con = span_connection(rnode);
+    find_span_by_node(&s2_ctx, &con)->state = SPAN_NEGOTIATED;
+  }
+  for (rnode = 3; rnode < 2 + SPAN_TABLE_SIZE; rnode++)
+  {
+    con = span_connection(rnode);
+    TEST_ASSERT_EQUAL(SPAN_NEGOTIATED, find_span_by_node(&s2_ctx, &con)->state);
+  }
+
+  con = span_connection(1000);
+  struct SPAN* span = find_span_by_node(&s2_ctx, &con);
+
+  TEST_ASSERT_EQUAL(SPAN_NO_SEQ, span->state);
+  TEST_ASSERT_EQUAL_UINT16(1000, span->rnode);
+  S2_get_pan_stats(&s2_ctx, &stats);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.span_evictions);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.span_resync_evictions);
+  // Node 2 was used the longest time ago, so its SPAN was replaced
+  con = span_connection(2);
+  for (int i = 0; i < SPAN_TABLE_SIZE; i++)
+  {
+    TEST_ASSERT_FALSE(span_matches(&s2_ctx.span_table[i], &con));
+  }
+}
@@ -26,19 +26,39 @@
 /**
  * Application event queue size <1..255:1>
  *
+ * Size of the bulk lane of the application event queue
  */
 #if !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_QUEUE_SIZE)
-#define ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_QUEUE_SIZE  5
+#define ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_QUEUE_SIZE  8
 #endif /* !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_QUEUE_SIZE) */
 
+/**
+ * Application urgent event queue size <1..255:1>
+ *
+ * Size of the urgent lane of the application event queue
+ */
+#if !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_URGENT_QUEUE_SIZE)
+#define ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_URGENT_QUEUE_SIZE  4
+#endif /* !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_URGENT_QUEUE_SIZE) */
+
 /**
  * Command Class event queue size <1..255:1>
  *
+ * Size of the bulk lane of the command class event queue
  */
 #if !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_QUEUE_SIZE)
-#define ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_QUEUE_SIZE  2
+#define ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_QUEUE_SIZE  8
 #endif /* !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_QUEUE_SIZE) */
 
+/**
+ * Command Class urgent event queue size <1..255:1>
+ *
+ * Size of the urgent lane of the command class event queue
+ */
+#if !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_URGENT_QUEUE_SIZE)
+#define ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_URGENT_QUEUE_SIZE  4
+#endif /* !defined(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_URGENT_QUEUE_SIZE) */
+
 /**@}*/ /* \addtogroup zaf_event_distributor_soc_configuration */
 
 /**@}*/ /* \addtogroup configuration */
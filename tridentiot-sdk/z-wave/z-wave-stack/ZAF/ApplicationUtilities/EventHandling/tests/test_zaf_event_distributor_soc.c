@@ -6,6 +6,7 @@
  */
 #include <zaf_event_distributor.h>
 #include <zaf_event_distributor_soc.h>
+#include <zaf_event_distributor_soc_config.h>
 #include <ZAF_ApplicationEvents.h>      // for EApplicationEvent
 #include <ev_man.h>                     // for EVENT_SYSTEM
 #include <queue_mock.h>
@@ -1531,3 +1532,207 @@ void test_zaf_event_distributor_enqueue_cc_event_from_isr_fail(void)
   ret = zaf_event_distributor_enqueue_cc_event_from_isr(event_cc.command_class, event_cc.event, event_cc.data);
   TEST_ASSERT_FALSE(ret);
 }
+
+#define CC_URGENT         0x02
+#define CC_COALESCED      0x03
+#define EVENT_COALESCED   0xF0
+
+zaf_event_distributor_event_policy_t
+zaf_event_distributor_app_event_policy(const uint8_t event)
+{
+  zaf_event_distributor_event_policy_t policy = { .lane = ZAF_EVENT_DISTRIBUTOR_LANE_BULK, .coalesce = false };
+  policy.coalesce = (EVENT_COALESCED == event);
+  return policy;
+}
+
+zaf_event_distributor_event_policy_t
+zaf_event_distributor_cc_event_policy(const uint16_t command_class, const uint8_t event)
+{
+  zaf_event_distributor_event_policy_t policy = { .lane = ZAF_EVENT_DISTRIBUTOR_LANE_BULK, .coalesce = false };
+  if (CC_URGENT == command_class) {
+    policy.lane = ZAF_EVENT_DISTRIBUTOR_LANE_URGENT;
+  }
+  policy.coalesce = (CC_COALESCED == command_class);
+  return policy;
+}
+
+static bool urgent_handler_called;
+
+static void
+handler_urgent(const uint8_t event, __attribute__((unused)) const void *data)
+{
+  TEST_ASSERT_EQUAL_INT8(0x07, event);
+  urgent_handler_called = true;
+}
+
+ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER(CC_URGENT, handler_urgent);
+
+/*
+ * Queues are created in this order by zaf_event_distributor_init().
+ */
+enum {
+  QUEUE_APP_URGENT,
+  QUEUE_APP_BULK,
+  QUEUE_CC_URGENT,
+  QUEUE_CC_BULK,
+  QUEUE_COUNT
+};
+
+static QueueHandle_t created_queues[QUEUE_COUNT];
+
+static QueueHandle_t
+xQueueGenericCreateStatic_callback(const UBaseType_t uxQueueLength,
+                                   const UBaseType_t uxItemSize,
+                                   uint8_t * pucQueueStorage,
+                                   StaticQueue_t * pxStaticQueue,
+                                   const uint8_t ucQueueType,
+                                   int cmock_num_calls)
+{
+  TEST_ASSERT_LESS_THAN(QUEUE_COUNT, cmock_num_calls);
+  created_queues[cmock_num_calls] = (QueueHandle_t)pxStaticQueue;
+  return created_queues[cmock_num_calls];
+}
+
+/**
+ * Test that a duplicate of a waiting event is coalesced and counted
+ */
+void test_zaf_event_distributor_enqueue_cc_event_coalesce(void)
+{
+  static uint8_t data_1 = 0x05;
+  static uint8_t data_2 = 0x06;
+  zaf_event_distributor_lane_stats_t stats;
+
+  QueueNotifyingSendToBack_ExpectAndReturn(NULL, NULL, 0, EQUEUENOTIFYING_STATUS_SUCCESS);
+  QueueNotifyingSendToBack_IgnoreArg_pThis();
+  QueueNotifyingSendToBack_IgnoreArg_pItem();
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_cc_event(CC_COALESCED, 0x01, &data_1));
+
+  // Identical to the waiting event
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_cc_event(CC_COALESCED, 0x01, &data_1));
+
+  // Different data is a different event
+  QueueNotifyingSendToBack_ExpectAndReturn(NULL, NULL, 0, EQUEUENOTIFYING_STATUS_SUCCESS);
+  QueueNotifyingSendToBack_IgnoreArg_pThis();
+  QueueNotifyingSendToBack_IgnoreArg_pItem();
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_cc_event(CC_COALESCED, 0x01, &data_2));
+
+  TEST_ASSERT_TRUE(zaf_event_distributor_get_lane_stats(ZAF_EVENT_DISTRIBUTOR_QUEUE_CC,
+                                                        ZAF_EVENT_DISTRIBUTOR_LANE_BULK,
+                                                        &stats));
+  TEST_ASSERT_EQUAL(2, stats.depth);
+  TEST_ASSERT_EQUAL(2, stats.high_water_mark);
+  TEST_ASSERT_EQUAL(1, stats.coalesced);
+  TEST_ASSERT_EQUAL(0, stats.dropped);
+}
+
+/**
+ * Test that an event is enqueued again once the waiting event was distributed
+ */
+void test_zaf_event_distributor_enqueue_app_event_from_isr_coalesce(void)
+{
+  uint8_t event = EVENT_COALESCED;
+  zaf_event_distributor_lane_stats_t stats;
+
+  QueueNotifyingSendToBackFromISR_ExpectAndReturn(NULL, &event, EQUEUENOTIFYING_STATUS_SUCCESS);
+  QueueNotifyingSendToBackFromISR_IgnoreArg_pThis();
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_app_event_from_isr(EVENT_COALESCED));
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_app_event_from_isr(EVENT_COALESCED));
+
+  notification_pending = EAPPLICATIONEVENT_APP;
+  EventDistributorDistribute_StubWithCallback(EventDistributorDistribute_callback);
+
+  xQueueReceive_ExpectAndReturn(queue_handle, &event, 0, pdTRUE);
+  xQueueReceive_IgnoreArg_pvBuffer(); // Used as output
+  xQueueReceive_ReturnMemThruPtr_pvBuffer(&event, sizeof(uint8_t));
+
+  xQueueReceive_ExpectAndReturn(queue_handle, &event, 0, pdFALSE);
+  xQueueReceive_IgnoreArg_pvBuffer(); // Used as output
+
+  zaf_event_distributor_distribute();
+
+  QueueNotifyingSendToBackFromISR_ExpectAndReturn(NULL, &event, EQUEUENOTIFYING_STATUS_SUCCESS);
+  QueueNotifyingSendToBackFromISR_IgnoreArg_pThis();
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_app_event_from_isr(EVENT_COALESCED));
+
+  TEST_ASSERT_TRUE(zaf_event_distributor_get_lane_stats(ZAF_EVENT_DISTRIBUTOR_QUEUE_APP,
+                                                        ZAF_EVENT_DISTRIBUTOR_LANE_BULK,
+                                                        &stats));
+  TEST_ASSERT_EQUAL(1, stats.depth);
+  TEST_ASSERT_EQUAL(1, stats.high_water_mark);
+  TEST_ASSERT_EQUAL(1, stats.coalesced);
+}
+
+/**
+ * Test that failed enqueues are counted
+ */
+void test_zaf_event_distributor_lane_stats_dropped(void)
+{
+  zaf_event_distributor_lane_stats_t stats;
+
+  QueueNotifyingSendToBack_ExpectAndReturn(NULL, NULL, 0, EQUEUENOTIFYING_STATUS_TIMEOUT);
+  QueueNotifyingSendToBack_IgnoreArg_pThis();
+  QueueNotifyingSendToBack_IgnoreArg_pItem();
+  TEST_ASSERT_FALSE(zaf_event_distributor_enqueue_cc_event(CC_URGENT, 0x07, NULL));
+
+  TEST_ASSERT_TRUE(zaf_event_distributor_get_lane_stats(ZAF_EVENT_DISTRIBUTOR_QUEUE_CC,
+                                                        ZAF_EVENT_DISTRIBUTOR_LANE_URGENT,
+                                                        &stats));
+  TEST_ASSERT_EQUAL(ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_URGENT_QUEUE_SIZE, stats.size);
+  TEST_ASSERT_EQUAL(0, stats.depth);
+  TEST_ASSERT_EQUAL(1, stats.dropped);
+
+  TEST_ASSERT_FALSE(zaf_event_distributor_get_lane_stats(ZAF_EVENT_DISTRIBUTOR_QUEUE_COUNT,
+                                                         ZAF_EVENT_DISTRIBUTOR_LANE_URGENT,
+                                                         &stats));
+  TEST_ASSERT_FALSE(zaf_event_distributor_get_lane_stats(ZAF_EVENT_DISTRIBUTOR_QUEUE_CC,
+                                                         ZAF_EVENT_DISTRIBUTOR_LANE_COUNT,
+                                                         &stats));
+}
+
+/**
+ * Test that an urgent event overtakes a bulk event enqueued before it
+ */
+void test_urgent_cc_event_distributed_first(void)
+{
+  static uint8_t data = 0x05;
+  event_cc_t bulk_event = {
+    .command_class = 0x01,
+    .event = 0x01,
+    .data = &data
+  };
+  event_cc_t urgent_event = {
+    .command_class = CC_URGENT,
+    .event = 0x07,
+    .data = NULL
+  };
+
+  xQueueGenericCreateStatic_StubWithCallback(xQueueGenericCreateStatic_callback);
+  zaf_event_distributor_init();
+
+  QueueNotifyingSendToBack_ExpectAndReturn(NULL, (uint8_t*) &bulk_event, 0, EQUEUENOTIFYING_STATUS_SUCCESS);
+  QueueNotifyingSendToBack_IgnoreArg_pThis();
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_cc_event(bulk_event.command_class, bulk_event.event, bulk_event.data));
+
+  QueueNotifyingSendToBack_ExpectAndReturn(NULL, (uint8_t*) &urgent_event, 0, EQUEUENOTIFYING_STATUS_SUCCESS);
+  QueueNotifyingSendToBack_IgnoreArg_pThis();
+  TEST_ASSERT_TRUE(zaf_event_distributor_enqueue_cc_event(urgent_event.command_class, urgent_event.event, urgent_event.data));
+
+  notification_pending = EAPPLICATIONEVENT_CC;
+  EventDistributorDistribute_StubWithCallback(EventDistributorDistribute_callback);
+
+  xQueueReceive_ExpectAndReturn(created_queues[QUEUE_CC_URGENT], &urgent_event, 0, pdTRUE);
+  xQueueReceive_IgnoreArg_pvBuffer(); // Used as output
+  xQueueReceive_ReturnMemThruPtr_pvBuffer(&urgent_event, sizeof(event_cc_t));
+
+  // The urgent lane is empty now
+  xQueueReceive_ExpectAndReturn(created_queues[QUEUE_CC_BULK], &bulk_event, 0, pdTRUE);
+  xQueueReceive_IgnoreArg_pvBuffer(); // Used as output
+  xQueueReceive_ReturnMemThruPtr_pvBuffer(&bulk_event, sizeof(event_cc_t));
+
+  xQueueReceive_ExpectAndReturn(created_queues[QUEUE_CC_BULK], &bulk_event, 0, pdFALSE);
+  xQueueReceive_IgnoreArg_pvBuffer(); // Used as output
+
+  urgent_handler_called = false;
+  zaf_event_distributor_distribute();
+  TEST_ASSERT_TRUE(urgent_handler_called);
+}
@@ -3,6 +3,9 @@
  * @brief ZAF Event distributor source file
  * @copyright 2022 Silicon Laboratories Inc.
  */
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
 #include <AppTimer.h>
 #include <EventDistributor.h>
 #include <SizeOf.h>
@@ -54,20 +57,36 @@ typedef void (*cc_event_handler_invoker_callback_t)(zaf_event_distributor_cc_eve
 static SEventDistributor g_EventDistributor = { 0 };
 
 /**
- * The following four variables are used for the application event queue.
+ * A lane of an event queue.
+ *
+ * Both lanes of a queue notify the application task with the same event bit.
+ */
+typedef struct {
+  SQueueNotifying notifying_queue;
+  StaticQueue_t queue_object;
+  QueueHandle_t queue;
+  zaf_event_distributor_lane_stats_t stats; ///< Only modified inside a critical section
+} event_lane_t;
+
+/**
+ * The following variables are used for the application event queue.
  */
-static SQueueNotifying m_AppEventNotifyingQueue = { 0 };
-static StaticQueue_t m_AppEventQueueObject = { 0 };
+static event_lane_t m_AppEventLanes[ZAF_EVENT_DISTRIBUTOR_LANE_COUNT] = { 0 };
+static uint8_t m_AppUrgentEventQueueStorage[ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_URGENT_QUEUE_SIZE];
 static uint8_t m_AppEventQueueStorage[ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_APP_QUEUE_SIZE];
-static QueueHandle_t m_AppEventQueue = { 0 };
+/// Coalescable application events currently waiting in a lane. One bit per event.
+static uint32_t m_AppEventsPending[(UINT8_MAX + 1) / 32];
 
 /**
- * The following four variables are used for the command class event queue.
+ * The following variables are used for the command class event queue.
  */
-static SQueueNotifying m_CCEventNotifyingQueue = { 0 };
-static StaticQueue_t m_CCEventQueueObject = { 0 };
+static event_lane_t m_CCEventLanes[ZAF_EVENT_DISTRIBUTOR_LANE_COUNT] = { 0 };
+static event_cc_t m_CCUrgentEventQueueStorage[ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_URGENT_QUEUE_SIZE] = { { 0 } };
 static event_cc_t m_CCEventQueueStorage[ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_QUEUE_SIZE] = { { 0 } };
-static QueueHandle_t m_CCEventQueue = { 0 };
+/// Coalescable command class events currently waiting in a lane
+static event_cc_t m_CCEventsPending[ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_URGENT_QUEUE_SIZE
+                                    + ZAF_EVENT_DISTRIBUTOR_SOC_CONFIG_CC_QUEUE_SIZE];
+static uint8_t m_CCEventsPendingCount;
 
 static bool learnModeInProgress;
 static bool resetInProgress;
@@ -322,12 +341,264 @@ event_manager(const uint8_t event)
   zaf_event_distributor_app_event_manager(event);
 }
 
+/*
+ * The bookkeeping of the lanes is shared with interrupts, so it is only accessed
+ * inside a critical section. The queues are thread safe on their own and are
+ * never accessed inside it, since sending also notifies the application task.
+ */
+static UBaseType_t
+lanes_lock(bool from_isr)
+{
+  if (from_isr) {
+    return taskENTER_CRITICAL_FROM_ISR();
+  }
+  taskENTER_CRITICAL();
+  return 0;
+}
+
+static void
+lanes_unlock(bool from_isr, UBaseType_t saved_interrupt_status)
+{
+  if (from_isr) {
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+  } else {
+    taskEXIT_CRITICAL();
+  }
+}
+
+static void
+lane_init(event_lane_t * lane, uint8_t size, uint8_t item_size, uint8_t * storage, uint8_t notification_bit)
+{
+  lane->queue = xQueueCreateStatic(size, item_size, storage, &lane->queue_object);
+
+  /*
+   * Registers events with associated data, and notifies
+   * the specific task about a pending job!
+   */
+  QueueNotifyingInit(&lane->notifying_queue, lane->queue, ZAF_getAppTaskHandle(), notification_bit);
+
+  memset(&lane->stats, 0, sizeof(lane->stats));
+  lane->stats.size = size;
+}
+
+static void
+count_saturated(uint16_t * counter)
+{
+  if (*counter < UINT16_MAX) {
+    (*counter)++;
+  }
+}
+
+/*
+ * Must be called outside a critical section, after the event was counted in the
+ * depth of the lane. The depth is counted before sending, so that it never is
+ * lower than the number of events in the queue when the event is received.
+ */
+static bool
+lane_send(event_lane_t * lane, const uint8_t * item, bool from_isr)
+{
+  EQueueNotifyingStatus Status;
+
+  if (from_isr) {
+    Status = QueueNotifyingSendToBackFromISR(&lane->notifying_queue, item);
+  } else {
+    Status = QueueNotifyingSendToBack(&lane->notifying_queue, item, 0);
+  }
+
+  UBaseType_t saved = lanes_lock(from_isr);
+  if (Status != EQUEUENOTIFYING_STATUS_SUCCESS) {
+    lane->stats.depth--;
+    count_saturated(&lane->stats.dropped);
+  } else if (lane->stats.depth > lane->stats.high_water_mark) {
+    lane->stats.high_water_mark = lane->stats.depth;
+  }
+  lanes_unlock(from_isr, saved);
+
+  if (Status != EQUEUENOTIFYING_STATUS_SUCCESS) {
+    DPRINT("Failed to queue event\n");
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Receives the oldest event of the most urgent lane holding events.
+ * Must be called outside a critical section.
+ *
+ * @return The lane the event was received from, or NULL if all lanes are empty.
+ */
+static event_lane_t *
+lanes_receive(event_lane_t * lanes, void * item)
+{
+  for (uint8_t i = 0; i < ZAF_EVENT_DISTRIBUTOR_LANE_COUNT; i++) {
+    event_lane_t * lane = &lanes[i];
+    /*
+     * The urgent lane is only polled when the bookkeeping says it holds events.
+     * An event counted while it is being sent is received on the next poll.
+     */
+    if ((ZAF_EVENT_DISTRIBUTOR_LANE_URGENT == i) && (0 == lane->stats.depth)) {
+      continue;
+    }
+    if (xQueueReceive(lane->queue, item, 0) == pdTRUE) {
+      return lane;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Must be called inside a critical section.
+ */
+static void
+lane_received(event_lane_t * lane)
+{
+  if (lane->stats.depth > 0) {
+    lane->stats.depth--;
+  }
+}
+
+static event_lane_t *
+policy_lane(event_lane_t * lanes, const zaf_event_distributor_event_policy_t * policy)
+{
+  if (policy->lane >= ZAF_EVENT_DISTRIBUTOR_LANE_COUNT) {
+    return &lanes[ZAF_EVENT_DISTRIBUTOR_LANE_BULK];
+  }
+  return &lanes[policy->lane];
+}
+
+static bool
+app_event_is_pending(const uint8_t event)
+{
+  return 0 != (m_AppEventsPending[event / 32] & (1UL << (event % 32)));
+}
+
+static bool
+receive_app_event(uint8_t * event)
+{
+  event_lane_t * lane = lanes_receive(m_AppEventLanes, event);
+  if (NULL == lane) {
+    return false;
+  }
+
+  UBaseType_t saved = lanes_lock(false);
+  lane_received(lane);
+  m_AppEventsPending[*event / 32] &= ~(1UL << (*event % 32));
+  lanes_unlock(false, saved);
+
+  return true;
+}
+
+static bool
+enqueue_app_event(const uint8_t event, bool from_isr)
+{
+  const zaf_event_distributor_event_policy_t policy = zaf_event_distributor_app_event_policy(event);
+  event_lane_t * lane = policy_lane(m_AppEventLanes, &policy);
+
+  UBaseType_t saved = lanes_lock(from_isr);
+  if (policy.coalesce && app_event_is_pending(event)) {
+    count_saturated(&lane->stats.coalesced);
+    lanes_unlock(from_isr, saved);
+    return true;
+  }
+  // Marked pending before sending, so that an identical event sent meanwhile is coalesced
+  lane->stats.depth++;
+  if (policy.coalesce) {
+    m_AppEventsPending[event / 32] |= 1UL << (event % 32);
+  }
+  lanes_unlock(from_isr, saved);
+
+  if (!lane_send(lane, &event, from_isr)) {
+    if (policy.coalesce) {
+      saved = lanes_lock(from_isr);
+      m_AppEventsPending[event / 32] &= ~(1UL << (event % 32));
+      lanes_unlock(from_isr, saved);
+    }
+    return false;
+  }
+  return true;
+}
+
+static int
+find_pending_cc_event(const event_cc_t * event_cc)
+{
+  for (uint8_t i = 0; i < m_CCEventsPendingCount; i++) {
+    if ((m_CCEventsPending[i].command_class == event_cc->command_class)
+        && (m_CCEventsPending[i].event == event_cc->event)
+        && (m_CCEventsPending[i].data == event_cc->data)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*
+ * Must be called inside a critical section.
+ */
+static void
+remove_pending_cc_event(const event_cc_t * event_cc)
+{
+  int index = find_pending_cc_event(event_cc);
+  if (index >= 0) {
+    m_CCEventsPending[index] = m_CCEventsPending[--m_CCEventsPendingCount];
+  }
+}
+
+static bool
+receive_cc_event(event_cc_t * event_cc)
+{
+  event_lane_t * lane = lanes_receive(m_CCEventLanes, event_cc);
+  if (NULL == lane) {
+    return false;
+  }
+
+  UBaseType_t saved = lanes_lock(false);
+  lane_received(lane);
+  remove_pending_cc_event(event_cc);
+  lanes_unlock(false, saved);
+
+  return true;
+}
+
+static bool
+enqueue_cc_event(const event_cc_t * event_cc, bool from_isr)
+{
+  const zaf_event_distributor_event_policy_t policy =
+    zaf_event_distributor_cc_event_policy(event_cc->command_class, event_cc->event);
+  event_lane_t * lane = policy_lane(m_CCEventLanes, &policy);
+  bool pending = false;
+
+  UBaseType_t saved = lanes_lock(from_isr);
+  if (policy.coalesce && (find_pending_cc_event(event_cc) >= 0)) {
+    count_saturated(&lane->stats.coalesced);
+    lanes_unlock(from_isr, saved);
+    return true;
+  }
+  // Marked pending before sending, so that an identical event sent meanwhile is coalesced
+  lane->stats.depth++;
+  if (policy.coalesce
+      && (m_CCEventsPendingCount < (sizeof(m_CCEventsPending) / sizeof(m_CCEventsPending[0])))) {
+    m_CCEventsPending[m_CCEventsPendingCount++] = *event_cc;
+    pending = true;
+  }
+  lanes_unlock(from_isr, saved);
+
+  if (!lane_send(lane, (const uint8_t*) event_cc, from_isr)) {
+    if (pending) {
+      saved = lanes_lock(from_isr);
+      remove_pending_cc_event(event_cc);
+      lanes_unlock(from_isr, saved);
+    }
+    return false;
+  }
+  return true;
+}
+
 static void
 EventHandlerApp(void)
 {
   uint8_t event = EVENT_SYSTEM_EMPTY;
 
-  while (xQueueReceive(m_AppEventQueue, &event, 0) == pdTRUE) {
+  while (receive_app_event(&event)) {
     DPRINTF("Event: %d\r\n", event);
     event_manager(event);
   }
@@ -364,7 +635,7 @@ EventHandlerCC(void)
 {
   event_cc_t event_cc = { 0 };
 
-  while (xQueueReceive(m_CCEventQueue, (uint8_t*)(&event_cc), 0) == pdTRUE) {
+  while (receive_cc_event(&event_cc)) {
     DPRINTF("CC:%d Event: %d\n", event_cc.command_class, event_cc.event);
     cc_handlers_for_each(call_handler, &event_cc);
   }
@@ -381,41 +652,31 @@ EventHandlerHW(void)
 static void
 EventQueueInit(void)
 {
-  // Initialize Queue Notifier for events in the application.
-  m_AppEventQueue = xQueueCreateStatic(
-    sizeof_array(m_AppEventQueueStorage),
-    sizeof(m_AppEventQueueStorage[0]),
-    (uint8_t*)m_AppEventQueueStorage,
-    &m_AppEventQueueObject
-    );
-
-  // Initialize Queue Notifier for events in the application.
-  m_CCEventQueue = xQueueCreateStatic(
-    sizeof_array(m_CCEventQueueStorage),
-    sizeof(m_CCEventQueueStorage[0]),
-    (uint8_t*)m_CCEventQueueStorage,
-    &m_CCEventQueueObject
-    );
-
-  /*
-   * Registers events with associated data, and notifies
-   * the specific task about a pending job!
-   */
-  QueueNotifyingInit(
-    &m_AppEventNotifyingQueue,
-    m_AppEventQueue,
-    ZAF_getAppTaskHandle(),
-    EAPPLICATIONEVENT_APP);
-
-  /*
-   * Registers events with associated data, and notifies
-   * the specific task about a pending job
-   */
-  QueueNotifyingInit(
-    &m_CCEventNotifyingQueue,
-    m_CCEventQueue,
-    ZAF_getAppTaskHandle(),
-    EAPPLICATIONEVENT_CC);
+  // Initialize Queue Notifiers for events in the application.
+  lane_init(&m_AppEventLanes[ZAF_EVENT_DISTRIBUTOR_LANE_URGENT],
+            sizeof_array(m_AppUrgentEventQueueStorage),
+            sizeof(m_AppUrgentEventQueueStorage[0]),
+            (uint8_t*)m_AppUrgentEventQueueStorage,
+            EAPPLICATIONEVENT_APP);
+  lane_init(&m_AppEventLanes[ZAF_EVENT_DISTRIBUTOR_LANE_BULK],
+            sizeof_array(m_AppEventQueueStorage),
+            sizeof(m_AppEventQueueStorage[0]),
+            (uint8_t*)m_AppEventQueueStorage,
+            EAPPLICATIONEVENT_APP);
+  memset(m_AppEventsPending, 0, sizeof(m_AppEventsPending));
+
+  // Initialize Queue Notifiers for command class events.
+  lane_init(&m_CCEventLanes[ZAF_EVENT_DISTRIBUTOR_LANE_URGENT],
+            sizeof_array(m_CCUrgentEventQueueStorage),
+            sizeof(m_CCUrgentEventQueueStorage[0]),
+            (uint8_t*)m_CCUrgentEventQueueStorage,
+            EAPPLICATIONEVENT_CC);
+  lane_init(&m_CCEventLanes[ZAF_EVENT_DISTRIBUTOR_LANE_BULK],
+            sizeof_array(m_CCEventQueueStorage),
+            sizeof(m_CCEventQueueStorage[0]),
+            (uint8_t*)m_CCEventQueueStorage,
+            EAPPLICATIONEVENT_CC);
+  m_CCEventsPendingCount = 0;
 
 #if defined(ZAF_USE_LEGACY_JOB_HELPER)
   /*
@@ -466,67 +727,66 @@ zaf_event_distributor_get(void)
 
 bool zaf_event_distributor_enqueue_app_event(const uint8_t event)
 {
-  EQueueNotifyingStatus Status;
-
-  Status = QueueNotifyingSendToBack(&m_AppEventNotifyingQueue, &event, 0);
-  if (Status != EQUEUENOTIFYING_STATUS_SUCCESS) {
-    DPRINT("Failed to queue event\n");
-    return false;
-  }
-
-  return true;
+  return enqueue_app_event(event, false);
 }
 
 bool zaf_event_distributor_enqueue_app_event_from_isr(const uint8_t event)
 {
-  EQueueNotifyingStatus Status;
-
-  Status = QueueNotifyingSendToBackFromISR(&m_AppEventNotifyingQueue, &event);
-  if (Status != EQUEUENOTIFYING_STATUS_SUCCESS) {
-    DPRINT("Failed to queue event\n");
-    return false;
-  }
-
-  return true;
+  return enqueue_app_event(event, true);
 }
 
 bool zaf_event_distributor_enqueue_cc_event(const uint16_t command_class,
                                             const uint8_t event,
                                             const void* data)
 {
-  EQueueNotifyingStatus Status;
   const event_cc_t event_cc = {
     .command_class = command_class,
     .event = event,
     .data = data
   };
 
-  Status = QueueNotifyingSendToBack(&m_CCEventNotifyingQueue, (const uint8_t*) &event_cc, 0);
-  if (Status != EQUEUENOTIFYING_STATUS_SUCCESS) {
-    DPRINT("Failed to queue event\n");
-    return false;
-  }
-
-  return true;
+  return enqueue_cc_event(&event_cc, false);
 }
 
 bool zaf_event_distributor_enqueue_cc_event_from_isr(const uint16_t command_class,
                                                      const uint8_t event,
                                                      const void* data)
 {
-  EQueueNotifyingStatus Status;
   const event_cc_t event_cc = {
     .command_class = command_class,
     .event = event,
     .data = data
   };
 
-  Status = QueueNotifyingSendToBackFromISR(&m_CCEventNotifyingQueue, (const uint8_t*) &event_cc);
-  if (Status != EQUEUENOTIFYING_STATUS_SUCCESS) {
-    DPRINT("Failed to queue event\n");
+  return enqueue_cc_event(&event_cc, true);
+}
+
+ZW_WEAK zaf_event_distributor_event_policy_t
+zaf_event_distributor_app_event_policy(__attribute__((unused)) const uint8_t event)
+{
+  return (zaf_event_distributor_event_policy_t) { .lane = ZAF_EVENT_DISTRIBUTOR_LANE_BULK, .coalesce = false };
+}
+
+ZW_WEAK zaf_event_distributor_event_policy_t
+zaf_event_distributor_cc_event_policy(__attribute__((unused)) const uint16_t command_class,
+                                      __attribute__((unused)) const uint8_t event)
+{
+  return (zaf_event_distributor_event_policy_t) { .lane = ZAF_EVENT_DISTRIBUTOR_LANE_BULK, .coalesce = false };
+}
+
+bool zaf_event_distributor_get_lane_stats(const zaf_event_distributor_queue_t queue,
+                                          const zaf_event_distributor_lane_t lane,
+                                          zaf_event_distributor_lane_stats_t * stats)
+{
+  if ((queue >= ZAF_EVENT_DISTRIBUTOR_QUEUE_COUNT) || (lane >= ZAF_EVENT_DISTRIBUTOR_LANE_COUNT) || (NULL == stats)) {
     return false;
   }
 
+  const event_lane_t * lanes = (ZAF_EVENT_DISTRIBUTOR_QUEUE_APP == queue) ? m_AppEventLanes : m_CCEventLanes;
+  UBaseType_t saved = lanes_lock(false);
+  *stats = lanes[lane].stats;
+  lanes_unlock(false, saved);
+
   return true;
 }
 
@@ -25,6 +25,49 @@ typedef struct {
   uint8_t event;
 } event_cc_t;
 
+/**
+ * Lanes of the application and command class event queues.
+ *
+ * Events waiting in the urgent lane are distributed before any event waiting in the bulk lane.
+ */
+typedef enum {
+  ZAF_EVENT_DISTRIBUTOR_LANE_URGENT,  ///< Time critical events, e.g. validating a code and unlocking
+  ZAF_EVENT_DISTRIBUTOR_LANE_BULK,    ///< All other events, e.g. reports and background erasing
+  ZAF_EVENT_DISTRIBUTOR_LANE_COUNT
+} zaf_event_distributor_lane_t;
+
+/**
+ * Event queues of the event distributor
+ */
+typedef enum {
+  ZAF_EVENT_DISTRIBUTOR_QUEUE_APP,  ///< Application events
+  ZAF_EVENT_DISTRIBUTOR_QUEUE_CC,   ///< Command class events
+  ZAF_EVENT_DISTRIBUTOR_QUEUE_COUNT
+} zaf_event_distributor_queue_t;
+
+/**
+ * How an event is enqueued
+ */
+typedef struct {
+  zaf_event_distributor_lane_t lane;  ///< Lane the event is enqueued in
+  /**
+   * If true, the event is not enqueued again while an identical event is still waiting.
+   * Command class events are identical if the command class, the event and the data pointer match.
+   */
+  bool coalesce;
+} zaf_event_distributor_event_policy_t;
+
+/**
+ * Statistics of a lane since the event distributor was initialized
+ */
+typedef struct {
+  uint8_t size;             ///< Number of events the lane can hold
+  uint8_t depth;            ///< Number of events currently waiting
+  uint8_t high_water_mark;  ///< Highest number of events waiting at the same time
+  uint16_t dropped;         ///< Events lost because the lane was full. Saturates at UINT16_MAX.
+  uint16_t coalesced;       ///< Events merged into a waiting event. Saturates at UINT16_MAX.
+} zaf_event_distributor_lane_stats_t;
+
 /**
  * ZAF Event Distributor Handler Map
  */
@@ -121,6 +164,42 @@ bool zaf_event_distributor_enqueue_cc_event_from_isr(const uint16_t command_clas
                                                      const uint8_t event,
                                                      const void* data);
 
+/**
+ * @brief Selects the lane of an application event and whether it can be coalesced
+ *
+ * The default implementation puts all events in the bulk lane without coalescing.
+ * Applications can override it to let time critical events overtake other events.
+ *
+ * @param event The event to enqueue
+ * @return Policy used to enqueue the event
+ */
+zaf_event_distributor_event_policy_t zaf_event_distributor_app_event_policy(const uint8_t event);
+
+/**
+ * @brief Selects the lane of a command class event and whether it can be coalesced
+ *
+ * The default implementation puts all events in the bulk lane without coalescing.
+ * Applications can override it to let time critical events overtake other events.
+ *
+ * @param command_class The command class to receive the event
+ * @param event The event to enqueue
+ * @return Policy used to enqueue the event
+ */
+zaf_event_distributor_event_policy_t zaf_event_distributor_cc_event_policy(const uint16_t command_class,
+                                                                           const uint8_t event);
+
+/**
+ * @brief Reads the statistics of a lane
+ *
+ * @param queue The event queue
+ * @param lane The lane of the queue
+ * @param[out] stats Statistics of the lane
+ * @return Returns true if the statistics were read and false if the queue or lane is invalid.
+ */
+bool zaf_event_distributor_get_lane_stats(const zaf_event_distributor_queue_t queue,
+                                          const zaf_event_distributor_lane_t lane,
+                                          zaf_event_distributor_lane_stats_t * stats);
+
 /**
  * @} // addtogroup EventDistributor
  * @} // addtogroup Events
@@ -27,6 +27,49 @@ extern const  zaf_cc_config_entry_latest_t __stop_zw_zaf_cc_config;
 #define cc_config_start __start_zw_zaf_cc_config
 #define cc_config_stop __stop_zw_zaf_cc_config
 
+/**
+ * Maps a command class to the position + 1 of its first entry in the handler section.
+ * 0 means that the command class is not registered.
+ *
+ * The table is built on first use so that dispatching a received frame costs a single
+ * lookup instead of a walk through every registered command class.
+ */
+static uint8_t cc_handler_index[UINT8_MAX + 1];
+static bool cc_handler_index_built = false;
+
+static void build_cc_handler_index(void)
+{
+  size_t count = ZAF_CC_handler_map_size();
+  ASSERT(count < UINT8_MAX);
+
+  /*
+   * Walk backwards so that the first entry of a command class ends up in the table.
+   * Entries with a command class above 0xFF can never match a received frame.
+   */
+  for (size_t i = count; i > 0; i--) {
+    uint16_t cc = (&cc_handlers_start)[i - 1].CC;
+    if (cc <= UINT8_MAX) {
+      cc_handler_index[cc] = (uint8_t)i;
+    }
+  }
+  cc_handler_index_built = true;
+}
+
+/**
+ * Returns the first entry registered for a given command class or NULL if none exists.
+ */
+static CC_handler_map_latest_t const * find_cc_entry(uint8_t cmdClass)
+{
+  if (!cc_handler_index_built) {
+    build_cc_handler_index();
+  }
+  uint8_t position = cc_handler_index[cmdClass];
+  if (0 == position) {
+    return NULL;
+  }
+  return &cc_handlers_start + (position - 1);
+}
+
 received_frame_status_t ZAF_CC_invoke_specific(CC_handler_map_latest_t const * const p_cc_entry,
                                                cc_handler_input_t *input,
                                                cc_handler_output_t *output)
@@ -59,20 +102,20 @@ received_frame_status_t ZAF_CC_invoke_specific(CC_handler_map_latest_t const * c
 received_frame_status_t invoke_cc_handler(cc_handler_input_t * input,
                                           cc_handler_output_t * output)
 {
-  CC_handler_map_latest_t const * iter = &cc_handlers_start;
-  for ( ; iter < &cc_handlers_stop; ++iter)
-  {
-    if (iter->CC == input->frame->ZW_Common.cmdClass) {
-      return ZAF_CC_invoke_specific(iter, input, output);
-    }
+  CC_handler_map_latest_t const * p_cc_entry = find_cc_entry(input->frame->ZW_Common.cmdClass);
+  if (NULL == p_cc_entry) {
+    return RECEIVED_FRAME_STATUS_CC_NOT_FOUND;
   }
-
-  return RECEIVED_FRAME_STATUS_CC_NOT_FOUND;
+  return ZAF_CC_invoke_specific(p_cc_entry, input, output);
 }
 
 void ZAF_CC_init_specific(uint8_t cmdClass)
 {
-  CC_handler_map_latest_t const * iter = &cc_handlers_start;
+  CC_handler_map_latest_t const * iter = find_cc_entry(cmdClass);
+  if (NULL == iter) {
+    return;
+  }
+  // Entries before the first one of the command class cannot match.
   for ( ; iter < &cc_handlers_stop; ++iter) {
     if ((iter->CC == cmdClass) && (NULL != iter->init)) {
       iter->init();
@@ -83,7 +126,10 @@ void ZAF_CC_init_specific(uint8_t cmdClass)
 
 void ZAF_CC_reset_specific(uint8_t cmdClass)
 {
-  CC_handler_map_latest_t const * iter = &cc_handlers_start;
+  CC_handler_map_latest_t const * iter = find_cc_entry(cmdClass);
+  if (NULL == iter) {
+    return;
+  }
   for ( ; iter < &cc_handlers_stop; ++iter) {
     if ((iter->CC == cmdClass) && (NULL != iter->reset)) {
       iter->reset();
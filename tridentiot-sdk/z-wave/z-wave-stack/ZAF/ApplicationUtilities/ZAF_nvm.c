@@ -40,6 +40,11 @@ zpal_status_t ZAF_nvm_write(zpal_nvm_object_key_t key, const void *object, size_
   return zpal_nvm_write(zaf_handle, key, object, object_size);
 }
 
+zpal_status_t ZAF_nvm_write_object_part(zpal_nvm_object_key_t key, const void *object, size_t offset, size_t size)
+{
+  return zpal_nvm_write_object_part(zaf_handle, key, object, offset, size);
+}
+
 zpal_status_t ZAF_nvm_get_object_size(zpal_nvm_object_key_t key, size_t *len)
 {
   return zpal_nvm_get_object_size(zaf_handle, key, len);
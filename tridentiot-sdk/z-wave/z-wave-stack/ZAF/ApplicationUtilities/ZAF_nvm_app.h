@@ -80,6 +80,17 @@ zpal_status_t ZAF_nvm_app_read_object_part(zpal_nvm_object_key_t key, void *obje
  */
 zpal_status_t ZAF_nvm_app_write(zpal_nvm_object_key_t key, const void *object, size_t object_size);
 
+/**
+ * @brief Writes part of an existing object to application nvm.
+ *
+ * @param[in]  key          Object key.
+ * @param[in]  object       Address of array of the part that is written.
+ * @param[in]  offset       The offset in object where part shall be written to.
+ * @param[in]  size         Size of the object part.
+ * @return status of write operation
+ */
+zpal_status_t ZAF_nvm_app_write_object_part(zpal_nvm_object_key_t key, const void *object, size_t offset, size_t size);
+
 /**
  * @brief Get the object size identified with a given key from NVM.
  *
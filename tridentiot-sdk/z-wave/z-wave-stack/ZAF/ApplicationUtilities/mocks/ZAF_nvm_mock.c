@@ -94,6 +94,23 @@ zpal_status_t ZAF_nvm_write(zpal_nvm_object_key_t key, const void *object, size_
   MOCK_CALL_RETURN_VALUE(p_mock, zpal_status_t);
 }
 
+zpal_status_t ZAF_nvm_write_object_part(zpal_nvm_object_key_t key, const void *object, size_t offset, size_t size)
+{
+  mock_t *p_mock;
+
+  MOCK_CALL_RETURN_IF_USED_AS_STUB(ZPAL_STATUS_OK);
+  MOCK_CALL_FIND_RETURN_ON_FAILURE(p_mock, ZPAL_STATUS_FAIL);
+  MOCK_CALL_RETURN_IF_ERROR_SET(p_mock, zpal_status_t);
+
+  MOCK_CALL_ACTUAL(p_mock, key, object, offset, size);
+
+  MOCK_CALL_COMPARE_INPUT_UINT32(p_mock, ARG0, key);
+  MOCK_CALL_COMPARE_INPUT_UINT8_ARRAY(p_mock, ARG1, p_mock->expect_arg[ARG3].v, ((uint8_t *)object), size);
+  MOCK_CALL_COMPARE_INPUT_UINT32(p_mock, ARG2, offset);
+
+  MOCK_CALL_RETURN_VALUE(p_mock, zpal_status_t);
+}
+
 zpal_status_t ZAF_nvm_get_object_size(zpal_nvm_object_key_t key, size_t * object_size)
 {
   mock_t *p_mock;
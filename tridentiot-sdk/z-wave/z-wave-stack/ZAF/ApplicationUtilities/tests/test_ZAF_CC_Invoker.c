@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC <http://www.caengineering.com>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file test_ZAF_CC_Invoker.c
+ * @brief Verifies that the dispatch table of the CC invoker selects the same entry as a
+ *        linear walk through the handler section.
+ *
+ * @copyright 2026 Card Access Engineering, LLC on behalf of the Z-Wave Alliance
+ */
+#include <unity.h>
+#include <string.h>
+#include <ZAF_CC_Invoker.h>
+
+void setUpSuite(void) {
+
+}
+
+void tearDownSuite(void) {
+
+}
+
+#define CC_FIRST      0x20
+#define CC_DUPLICATE  0x25
+#define CC_LATE_INIT  0x30
+#define CC_NO_HANDLER 0x40
+#define CC_OLD_API    0x50
+#define CC_EXTENDED   0x0100 // Command classes above 0xFF cannot be received
+
+static const void * m_called;
+
+static received_frame_status_t handler_a(cc_handler_input_t * input, cc_handler_output_t * output)
+{
+  (void)input; (void)output;
+  m_called = (const void *)handler_a;
+  return RECEIVED_FRAME_STATUS_SUCCESS;
+}
+
+static received_frame_status_t handler_b(cc_handler_input_t * input, cc_handler_output_t * output)
+{
+  (void)input; (void)output;
+  m_called = (const void *)handler_b;
+  return RECEIVED_FRAME_STATUS_SUCCESS;
+}
+
+static received_frame_status_t handler_c(cc_handler_input_t * input, cc_handler_output_t * output)
+{
+  (void)input; (void)output;
+  m_called = (const void *)handler_c;
+  return RECEIVED_FRAME_STATUS_FAIL;
+}
+
+static void init_a(void)  { m_called = (const void *)init_a; }
+static void init_b(void)  { m_called = (const void *)init_b; }
+static void reset_a(void) { m_called = (const void *)reset_a; }
+static void reset_b(void) { m_called = (const void *)reset_b; }
+
+#define TEST_CC_ENTRY(name, api, cc, handler, init, reset) \
+  static const CC_handler_map_latest_t name __attribute__((aligned(4), __used__, __section__( HANDLER_SECTION ))) = \
+    {api, cc, 1, (cc_handler_t)handler, NULL, NULL, NULL, 0, init, reset}
+
+TEST_CC_ENTRY(entry_first,        3, CC_FIRST,      handler_a, init_a, reset_a);
+TEST_CC_ENTRY(entry_duplicate_1,  3, CC_DUPLICATE,  handler_b, NULL,   reset_b);
+TEST_CC_ENTRY(entry_duplicate_2,  3, CC_DUPLICATE,  handler_c, init_b, reset_a);
+TEST_CC_ENTRY(entry_late_init_1,  3, CC_LATE_INIT,  handler_c, NULL,   NULL);
+TEST_CC_ENTRY(entry_late_init_2,  3, CC_LATE_INIT,  handler_a, init_a, reset_b);
+TEST_CC_ENTRY(entry_no_handler,   3, CC_NO_HANDLER, NULL,      NULL,   NULL);
+TEST_CC_ENTRY(entry_old_api,      9, CC_OLD_API,    handler_b, NULL,   NULL);
+TEST_CC_ENTRY(entry_extended,     3, CC_EXTENDED,   handler_b, init_b, reset_b);
+
+/*
+ * Reference implementations: the linear walks the invoker used before the dispatch table.
+ */
+static received_frame_status_t linear_invoke(cc_handler_input_t * input, cc_handler_output_t * output)
+{
+  CC_handler_map_latest_t const * iter = &cc_handlers_start;
+  for ( ; iter < &cc_handlers_stop; ++iter) {
+    if (iter->CC == input->frame->ZW_Common.cmdClass) {
+      return ZAF_CC_invoke_specific(iter, input, output);
+    }
+  }
+  return RECEIVED_FRAME_STATUS_CC_NOT_FOUND;
+}
+
+static void linear_init(uint8_t cmdClass)
+{
+  CC_handler_map_latest_t const * iter = &cc_handlers_start;
+  for ( ; iter < &cc_handlers_stop; ++iter) {
+    if ((iter->CC == cmdClass) && (NULL != iter->init)) {
+      iter->init();
+      break;
+    }
+  }
+}
+
+static void linear_reset(uint8_t cmdClass)
+{
+  CC_handler_map_latest_t const * iter = &cc_handlers_start;
+  for ( ; iter < &cc_handlers_stop; ++iter) {
+    if ((iter->CC == cmdClass) && (NULL != iter->reset)) {
+      iter->reset();
+      break;
+    }
+  }
+}
+
+void test_invoke_cc_handler_matches_linear_walk(void)
+{
+  ZW_APPLICATION_TX_BUFFER frame_in;
+  ZW_APPLICATION_TX_BUFFER frame_out;
+  RECEIVE_OPTIONS_TYPE_EX rx_options;
+  memset(&frame_in, 0, sizeof(frame_in));
+  memset(&rx_options, 0, sizeof(rx_options));
+
+  cc_handler_input_t input = {
+    .rx_options = &rx_options,
+    .frame = &frame_in,
+    .length = 2
+  };
+  cc_handler_output_t output = {
+    .frame = &frame_out
+  };
+
+  for (uint16_t cc = 0; cc <= UINT8_MAX; cc++) {
+    frame_in.ZW_Common.cmdClass = (uint8_t)cc;
+
+    m_called = NULL;
+    received_frame_status_t expected_status = linear_invoke(&input, &output);
+    const void * expected_handler = m_called;
+
+    m_called = NULL;
+    received_frame_status_t status = invoke_cc_handler(&input, &output);
+
+    TEST_ASSERT_EQUAL_MESSAGE(expected_status, status, "Unexpected status");
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(expected_handler, m_called, "Unexpected handler invoked");
+  }
+}
+
+void test_invoke_cc_handler_selects_first_entry(void)
+{
+  ZW_APPLICATION_TX_BUFFER frame_in;
+  ZW_APPLICATION_TX_BUFFER frame_out;
+  memset(&frame_in, 0, sizeof(frame_in));
+  cc_handler_input_t input = { .frame = &frame_in };
+  cc_handler_output_t output = { .frame = &frame_out };
+
+  frame_in.ZW_Common.cmdClass = CC_NO_HANDLER;
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_NO_SUPPORT, invoke_cc_handler(&input, &output));
+
+  frame_in.ZW_Common.cmdClass = CC_OLD_API;
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_CC_NOT_FOUND, invoke_cc_handler(&input, &output));
+
+  frame_in.ZW_Common.cmdClass = (uint8_t)CC_EXTENDED;
+  m_called = NULL;
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_CC_NOT_FOUND, invoke_cc_handler(&input, &output));
+  TEST_ASSERT_NULL(m_called);
+}
+
+void test_ZAF_CC_init_and_reset_specific_match_linear_walk(void)
+{
+  for (uint16_t cc = 0; cc <= UINT8_MAX; cc++) {
+    m_called = NULL;
+    linear_init((uint8_t)cc);
+    const void * expected_init = m_called;
+
+    m_called = NULL;
+    ZAF_CC_init_specific((uint8_t)cc);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(expected_init, m_called, "Unexpected init function invoked");
+
+    m_called = NULL;
+    linear_reset((uint8_t)cc);
+    const void * expected_reset = m_called;
+
+    m_called = NULL;
+    ZAF_CC_reset_specific((uint8_t)cc);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(expected_reset, m_called, "Unexpected reset function invoked");
+  }
+}
+
+void test_ZAF_CC_init_specific_skips_entries_without_init(void)
+{
+  m_called = NULL;
+  ZAF_CC_init_specific(CC_LATE_INIT);
+  TEST_ASSERT_EQUAL_PTR((const void *)init_a, m_called);
+
+  m_called = NULL;
+  ZAF_CC_init_specific(CC_NO_HANDLER);
+  TEST_ASSERT_NULL(m_called);
+}
@@ -33,6 +33,16 @@
 #define CC_ACTIVE_SCHEDULE_MAX_NUM_SUPPORTED_CCS  1
 #endif /* !defined(CC_ACTIVE_SCHEDULE_MAX_NUM_SUPPORTED_CCS) */
 
+/**
+ * Maximum number of Schedule Reports sent in response to a single Schedule Get <1..255:1>
+ * With a value above 1, the reports for the occupied slots following the requested one
+ * are sent right after it, so a controller does not need a Get per slot.
+ *
+ */
+#if !defined(CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE)
+#define CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE  1
+#endif /* !defined(CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE) */
+
 /**@}*/ /* \addtogroup command_class_active_schedule_configuration */
 
 /**@}*/ /* \addtogroup configuration */
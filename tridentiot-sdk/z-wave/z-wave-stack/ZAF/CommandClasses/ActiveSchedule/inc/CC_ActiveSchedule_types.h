@@ -54,8 +54,8 @@ typedef enum _ascc_app_event_ {
   ASCC_APP_EVENT_ON_GET_SCHEDULE_STATE_COMPLETE,
   ASCC_APP_EVENT_ON_SET_SCHEDULE_STATE_COMPLETE,
   ASCC_APP_EVENT_ON_SCHEDULE_STATE_CHANGE,                ///< End node signals to the stack that a
-                                                          ///  schedule has updated to a new state.
-                                                          ///  Currently unused, but desired.
+                                                          ///  target has entered or left its schedules,
+                                                          ///  e.g. because a Year Day window opened.
 } ascc_app_event_t;
 
 /**
@@ -202,6 +202,14 @@ typedef struct _ascc_sched_enable_event_data {
   bool enabled;
 } ascc_sched_enable_event_data_t;
 
+/**
+ * @brief Defines a helper struct to include schedule state change event data.
+ */
+typedef struct _ascc_sched_state_change_event_data {
+  ascc_target_t target;
+  bool in_schedule;     ///< true if the target is now within one of its schedules.
+} ascc_sched_state_change_event_data_t;
+
 /*************************************
  * Stub Function Definitions
  **************************************/
@@ -331,6 +339,20 @@ typedef ascc_op_result_t (*ascc_set_schedule_data_stub_t)(const ascc_op_type_t o
                                                           const ascc_schedule_t * const schedule,
                                                           uint16_t * next_slot);
 
+/**
+ * @brief Notifies the registered CC that a target has entered or left the time
+ *        fences of the schedules attached to it.
+ *
+ * This stub is optional and may be left NULL if the registered CC does not need to
+ * act on schedule transitions.
+ *
+ * @param target      Const pointer to target
+ * @param in_schedule true if the target is now within one of its schedules,
+ *                    false if it has left the last one.
+ */
+typedef void (*ascc_schedule_state_change_stub_t)(const ascc_target_t * const target,
+                                                  const bool in_schedule);
+
 /**
  * @brief By design, this command class has zero visibility into any other command classes that
  * use it. Therefore, it's a lot easier for it to just have an array of stubs that
@@ -348,6 +370,7 @@ typedef struct _ascc_target_stubs {
   ascc_target_validation_stub_t validate_target;
   ascc_schedule_slot_validation_stub_t validate_schedule_slot;
   ascc_schedule_data_validation_stub_t validate_schedule_data;
+  ascc_schedule_state_change_stub_t schedule_state_changed;   ///< Optional
 } ascc_target_stubs_t;
 
 /****************************************************************************
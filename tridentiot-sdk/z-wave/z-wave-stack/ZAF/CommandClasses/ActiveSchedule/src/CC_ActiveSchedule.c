@@ -144,6 +144,11 @@ static received_frame_status_t validate_and_set_schedule(ascc_op_type_t operatio
                                                          uint16_t * next_schedule_slot,
                                                          uint8_t *duration);
 
+#if (CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE > 1)
+static bool send_report_burst(ascc_schedule_t * schedule,
+                              uint16_t next_schedule_slot,
+                              RECEIVE_OPTIONS_TYPE_EX * rx_options);
+#endif
 static void send_report_tse(zaf_tx_options_t * p_tx_options,
                             void * p_data);
 static void send_report(const cc_handler_input_t * const in_report,
@@ -191,6 +196,14 @@ static cc_handler_input_t m_tse_sched_yd_report = { 0 };
 static cc_handler_input_t m_tse_sched_dr_report = { 0 };
 static cc_handler_input_t m_tse_sched_enable_report = { 0 };
 
+#if (CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE > 1)
+/*
+ * Separate output buffer for report bursts, as the lifeline report buffers may still
+ * be referenced by a pending TSE trigger.
+ */
+static ZW_APPLICATION_TX_BUFFER m_burst_report_buf;
+#endif
+
 /****************************************************************************
 *                  EXPORTED HEADER FUNCTION DEFINITIONS                    *
 ****************************************************************************/
@@ -446,13 +459,13 @@ static void pack_daily_repeating_report_frame(
   out_frame->durationMinute = daily_repeating->duration_minute;
 
   /* Metadata information */
-  out_frame->properties1 = (uint8_t)(schedule->data.metadata_length
+  out_frame->properties2 = (uint8_t)(schedule->data.metadata_length
                                      & ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT_PROPERTIES2_METADATA_LENGTH_MASK);
   if (schedule->data.metadata_length > 0) {
     memcpy(&out_frame->metadata1, &schedule->data.metadata[0], schedule->data.metadata_length);
   }
 
-  *out_frame_len = sizeof(ZW_ACTIVE_SCHEDULE_YEAR_DAY_SCHEDULE_REPORT_1BYTE_FRAME)
+  *out_frame_len = sizeof(ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT_1BYTE_FRAME)
                    + schedule->data.metadata_length - 1;
 }
 
@@ -916,6 +929,14 @@ static received_frame_status_t CC_ActiveSchedule_YearDayGet_handler(cc_handler_i
 
   switch (result.result) {
     case ASCC_OPERATION_SUCCESS: {
+      status = RECEIVED_FRAME_STATUS_SUCCESS;
+#if (CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE > 1)
+      // The requested report is the first of the burst, so nothing is left for the output
+      if (send_report_burst(&schedule, next_schedule_slot, input->rx_options)) {
+        output->duration = 0;
+        break;
+      }
+#endif
       ZW_ACTIVE_SCHEDULE_YEAR_DAY_SCHEDULE_REPORT_1BYTE_FRAME * out_frame =
         &output->frame->ZW_ActiveScheduleYearDayScheduleReport1byteFrame;
       pack_year_day_report_frame(ASCC_REP_TYPE_RESPONSE_TO_GET,
@@ -923,7 +944,6 @@ static received_frame_status_t CC_ActiveSchedule_YearDayGet_handler(cc_handler_i
                                  next_schedule_slot,
                                  out_frame,
                                  &output->length);
-      status = RECEIVED_FRAME_STATUS_SUCCESS;
       output->duration = 0;
       break;
     }
@@ -1003,6 +1023,14 @@ static received_frame_status_t CC_ActiveSchedule_DailyRepeatingGet_handler(cc_ha
 
   switch (result.result) {
     case ASCC_OPERATION_SUCCESS: {
+      status = RECEIVED_FRAME_STATUS_SUCCESS;
+#if (CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE > 1)
+      // The requested report is the first of the burst, so nothing is left for the output
+      if (send_report_burst(&schedule, next_schedule_slot, input->rx_options)) {
+        output->duration = 0;
+        break;
+      }
+#endif
       ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT_1BYTE_FRAME * out_frame =
         &output->frame->ZW_ActiveScheduleDailyRepeatingScheduleReport1byteFrame;
       pack_daily_repeating_report_frame(ASCC_REP_TYPE_RESPONSE_TO_GET,
@@ -1010,7 +1038,7 @@ static received_frame_status_t CC_ActiveSchedule_DailyRepeatingGet_handler(cc_ha
                                         next_schedule_slot,
                                         out_frame,
                                         &output->length);
-      status = RECEIVED_FRAME_STATUS_SUCCESS;
+      output->duration = 0;
       break;
     }
     case ASCC_OPERATION_WORKING: {
@@ -1077,6 +1105,72 @@ static received_frame_status_t CC_ActiveSchedule_handler(cc_handler_input_t * in
   return status;
 }
 
+#if (CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE > 1)
+/**
+ * Sends the report for a requested schedule slot followed by the reports for the
+ * next occupied slots of the same target and type.
+ *
+ * The reports are handed to the transport layer back to back, which queues them and
+ * transmits them without waiting on the application. The burst ends after the last
+ * occupied slot, after CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE reports or once the
+ * transport queue is full. The Next Schedule Slot field of the last report sent tells
+ * the controller where to continue.
+ *
+ * @param[in] schedule           Requested schedule, already populated. Used as a
+ *                               scratch buffer for the following slots.
+ * @param[in] next_schedule_slot Next occupied slot after the requested one, or 0
+ * @param[in] rx_options         Receive options of the Get
+ * @return true if at least the requested report was sent, false if the caller must
+ *         send it as a regular response.
+ */
+static bool send_report_burst(ascc_schedule_t * schedule,
+                              uint16_t next_schedule_slot,
+                              RECEIVE_OPTIONS_TYPE_EX * rx_options)
+{
+  // A single report is answered as usual, and multicast Gets never get more than one
+  if (next_schedule_slot == 0 || !rx_options || is_multicast(rx_options)) {
+    return false;
+  }
+
+  zaf_tx_options_t tx_options;
+  zaf_transport_rx_to_tx_options(rx_options, &tx_options);
+
+  uint8_t sent = 0;
+  while (true) {
+    uint8_t length = 0;
+    if (schedule->type == ASCC_TYPE_YEAR_DAY) {
+      pack_year_day_report_frame(ASCC_REP_TYPE_RESPONSE_TO_GET,
+                                 schedule,
+                                 next_schedule_slot,
+                                 &m_burst_report_buf.ZW_ActiveScheduleYearDayScheduleReport1byteFrame,
+                                 &length);
+    } else {
+      pack_daily_repeating_report_frame(ASCC_REP_TYPE_RESPONSE_TO_GET,
+                                        schedule,
+                                        next_schedule_slot,
+                                        &m_burst_report_buf.ZW_ActiveScheduleDailyRepeatingScheduleReport1byteFrame,
+                                        &length);
+    }
+    // The frame is copied into the transport queue, so the buffer can be reused right away
+    if (!zaf_transport_tx((uint8_t *)&m_burst_report_buf, length, NULL, &tx_options)) {
+      break;
+    }
+    sent++;
+    if (next_schedule_slot == 0 || sent >= CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE) {
+      break;
+    }
+
+    memset(&schedule->data, 0, sizeof(schedule->data));
+    schedule->slot_id = next_schedule_slot;
+    next_schedule_slot = 0;
+    if (validate_and_get_schedule(schedule, &next_schedule_slot).result != ASCC_OPERATION_SUCCESS) {
+      break;
+    }
+  }
+  return sent > 0;
+}
+#endif
+
 /**
  * Callback function for ZAF TSE to send Active Schedule Reports to multiple
  * destinations
@@ -1182,10 +1276,22 @@ static void ascc_event_handler(const uint8_t event,
 
       break;
     }
+    case ASCC_APP_EVENT_ON_SCHEDULE_STATE_CHANGE: {
+      const ascc_sched_state_change_event_data_t* data =
+        (ascc_sched_state_change_event_data_t *)p_data;
+      ascc_target_stubs_t * stubs = NULL;
+
+      // The specification has no report for this, so it is handed to the scheduled CC
+      if (data && get_stubs_by_cc(data->target.target_cc, &stubs)
+          && stubs->schedule_state_changed) {
+        stubs->schedule_state_changed(&data->target, data->in_schedule);
+      }
+
+      break;
+    }
     case ASCC_APP_EVENT_ON_GET_SCHEDULE_CAPABILITIES_COMPLETE:
     case ASCC_APP_EVENT_ON_GET_SCHEDULE_COMPLETE:
     case ASCC_APP_EVENT_ON_GET_SCHEDULE_STATE_COMPLETE:
-    case ASCC_APP_EVENT_ON_SCHEDULE_STATE_CHANGE:
     default:
       break;
   }
@@ -0,0 +1,309 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SPDX-FileCopyrightText: 2026 Z-Wave Alliance <https://z-wavealliance.org>
+ * SPDX-FileCopyrightText: 2026 Card Access Engineering, LLC. <https://www.caengineering.com>
+ */
+
+#include <string.h>
+#include <unity.h>
+#include "test_common.h"
+#include "ZW_classcmd.h"
+#include "ZAF_CC_Invoker.h"
+#include "ZAF_types.h"
+#include "SizeOf.h"
+#include "cc_active_schedule_io.h"
+#include "zaf_transport_tx_mock.h"
+#include "ZW_TransportEndpoint_mock.h"
+#include "cc_active_schedule_config_api_mock.h"
+
+/*
+ * The test is built with CC_ACTIVE_SCHEDULE_REPORT_BURST_SIZE set to 3, so a Get
+ * is answered with up to three reports.
+ */
+#define BURST_SIZE       3
+#define TARGET_ID        1
+#define SLOT_COUNT       7
+#define MAX_TX_FRAMES    8
+
+/// Occupied Daily Repeating slots of the target
+static const uint16_t m_occupied_slots[] = { 1, 2, 4, 5, 7 };
+
+static ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT_1BYTE_FRAME m_tx_frames[MAX_TX_FRAMES];
+static uint8_t m_tx_lengths[MAX_TX_FRAMES];
+static uint8_t m_tx_count;
+/// Number of frames the transport layer accepts before its queue is full
+static uint8_t m_tx_queue_free;
+
+static bool is_slot_occupied(const uint16_t slot)
+{
+  for (uint8_t i = 0; i < sizeof_array(m_occupied_slots); i++) {
+    if (m_occupied_slots[i] == slot) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool stub_validate_target(const ascc_target_t * const target)
+{
+  return target->target_id == TARGET_ID;
+}
+
+static bool stub_validate_schedule_slot(__attribute__((unused)) const uint16_t target_ID,
+                                        __attribute__((unused)) const ascc_type_t type,
+                                        const uint16_t slot)
+{
+  return slot >= 1 && slot <= SLOT_COUNT;
+}
+
+/**
+ * Returns the schedule of an occupied slot, with the slot number as start hour
+ * so that the reports can be told apart.
+ */
+static ascc_op_result_t stub_get_schedule_data(__attribute__((unused)) const ascc_type_t schedule_type,
+                                               const uint16_t slot,
+                                               __attribute__((unused)) const ascc_target_t * const target,
+                                               ascc_schedule_data_t * schedule,
+                                               uint16_t * next_slot)
+{
+  ascc_op_result_t result = {
+    .result = ASCC_OPERATION_FAIL
+  };
+  if (!is_slot_occupied(slot)) {
+    return result;
+  }
+  memset(schedule, 0, sizeof(ascc_schedule_data_t));
+  schedule->schedule.daily_repeating.weekday_mask = 0x7F;
+  schedule->schedule.daily_repeating.start_hour = (uint8_t)slot;
+  schedule->schedule.daily_repeating.duration_hour = 1;
+
+  *next_slot = 0;
+  for (uint16_t next = slot + 1; next <= SLOT_COUNT; next++) {
+    if (is_slot_occupied(next)) {
+      *next_slot = next;
+      break;
+    }
+  }
+  result.result = ASCC_OPERATION_SUCCESS;
+  return result;
+}
+
+static const ascc_target_stubs_t m_target_stubs = {
+  .validate_target = stub_validate_target,
+  .validate_schedule_slot = stub_validate_schedule_slot,
+  .get_schedule_data = stub_get_schedule_data,
+};
+
+static bool zaf_transport_tx_stub(const uint8_t *frame,
+                                  uint8_t frame_length,
+                                  __attribute__((unused)) zaf_tx_callback_t callback,
+                                  __attribute__((unused)) zaf_tx_options_t *zaf_tx_options,
+                                  __attribute__((unused)) int cmock_num_calls)
+{
+  if (m_tx_queue_free == 0) {
+    return false;
+  }
+  m_tx_queue_free--;
+  TEST_ASSERT_TRUE(m_tx_count < MAX_TX_FRAMES);
+  TEST_ASSERT_TRUE(frame_length <= sizeof(m_tx_frames[0]));
+  memcpy(&m_tx_frames[m_tx_count], frame, frame_length);
+  m_tx_lengths[m_tx_count] = frame_length;
+  m_tx_count++;
+  return true;
+}
+
+/**
+ * Sends a Daily Repeating Schedule Get for a slot of the target.
+ *
+ * @param slot            Requested slot
+ * @param[out] out_frame  Response frame returned by the handler
+ * @param[out] out_length Length of the response frame, 0 if none
+ */
+static received_frame_status_t daily_repeating_get(const uint16_t slot,
+                                                   ZW_APPLICATION_TX_BUFFER * out_frame,
+                                                   uint8_t * out_length)
+{
+  command_handler_input_t input;
+  test_common_clear_command_handler_input(&input);
+  ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_GET_FRAME * frame =
+    &input.frame.as_zw_application_tx_buffer.ZW_ActiveScheduleDailyRepeatingScheduleGetFrame;
+  frame->cmdClass = COMMAND_CLASS_ACTIVE_SCHEDULE;
+  frame->cmd = ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_GET;
+  frame->targetCc = COMMAND_CLASS_USER_CREDENTIAL;
+  frame->targetId1 = 0;
+  frame->targetId2 = TARGET_ID;
+  frame->scheduleSlotId1 = (uint8_t)(slot >> 8);
+  frame->scheduleSlotId2 = (uint8_t)slot;
+  input.frameLength = sizeof(ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_GET_FRAME);
+
+  return invoke_cc_handler_v2(&input.rxOptions,
+                              &input.frame.as_zw_application_tx_buffer,
+                              input.frameLength,
+                              out_frame,
+                              out_length);
+}
+
+/**
+ * Checks that a Daily Repeating Schedule Report answers a Get for a slot, and
+ * points the controller to the next slot.
+ */
+static void assert_report(const ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT_1BYTE_FRAME * report,
+                          const uint8_t length,
+                          const uint16_t slot,
+                          const uint16_t next_slot)
+{
+  TEST_ASSERT_EQUAL_UINT8(sizeof(ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT_1BYTE_FRAME) - 1, length);
+  TEST_ASSERT_EQUAL_UINT8(COMMAND_CLASS_ACTIVE_SCHEDULE, report->cmdClass);
+  TEST_ASSERT_EQUAL_UINT8(ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT, report->cmd);
+  TEST_ASSERT_EQUAL_UINT8(ASCC_REP_TYPE_RESPONSE_TO_GET,
+                          report->properties1 & ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_REPORT_PROPERTIES1_REPORT_CODE_MASK);
+  TEST_ASSERT_EQUAL_UINT8(TARGET_ID, report->targetId2);
+  TEST_ASSERT_EQUAL_UINT16(slot, (report->scheduleSlotId1 << 8) | report->scheduleSlotId2);
+  TEST_ASSERT_EQUAL_UINT16(next_slot, (report->nextScheduleSlotId1 << 8) | report->nextScheduleSlotId2);
+  TEST_ASSERT_EQUAL_UINT8(slot, report->startHour);
+}
+
+void setUpSuite(void)
+{
+  cc_active_schedule_config_api_mock_Init();
+  cc_active_schedule_get_num_supported_ccs_IgnoreAndReturn(1);
+  CC_ActiveSchedule_RegisterCallbacks(COMMAND_CLASS_USER_CREDENTIAL, &m_target_stubs);
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(m_tx_frames, 0, sizeof(m_tx_frames));
+  m_tx_count = 0;
+  m_tx_queue_free = MAX_TX_FRAMES;
+  is_multicast_IgnoreAndReturn(false);
+  zaf_transport_rx_to_tx_options_Ignore();
+  zaf_transport_tx_StubWithCallback(zaf_transport_tx_stub);
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * A Get is answered with a burst of reports for the requested slot and the next
+ * occupied ones. Each report points to the slot of the following one, and the
+ * last one to where the controller must continue.
+ */
+void test_ACTIVE_SCHEDULE_report_burst(void)
+{
+  ZW_APPLICATION_TX_BUFFER out_frame;
+  uint8_t out_length = 0xFF;
+
+  received_frame_status_t status = daily_repeating_get(1, &out_frame, &out_length);
+
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, status);
+  // The whole burst goes through the transport layer, nothing is left for the response
+  TEST_ASSERT_EQUAL_UINT8(0, out_length);
+  TEST_ASSERT_EQUAL_UINT8(BURST_SIZE, m_tx_count);
+  assert_report(&m_tx_frames[0], m_tx_lengths[0], 1, 2);
+  assert_report(&m_tx_frames[1], m_tx_lengths[1], 2, 4);
+  assert_report(&m_tx_frames[2], m_tx_lengths[2], 4, 5);
+}
+
+/**
+ * The burst ends with the last occupied slot, whose report has no next slot.
+ */
+void test_ACTIVE_SCHEDULE_report_burst_ends_at_last_slot(void)
+{
+  ZW_APPLICATION_TX_BUFFER out_frame;
+  uint8_t out_length = 0xFF;
+
+  received_frame_status_t status = daily_repeating_get(5, &out_frame, &out_length);
+
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT8(0, out_length);
+  TEST_ASSERT_EQUAL_UINT8(2, m_tx_count);
+  assert_report(&m_tx_frames[0], m_tx_lengths[0], 5, 7);
+  assert_report(&m_tx_frames[1], m_tx_lengths[1], 7, 0);
+}
+
+/**
+ * When the transport queue fills up, the last report queued points to the first
+ * slot that was not sent.
+ */
+void test_ACTIVE_SCHEDULE_report_burst_transport_full(void)
+{
+  ZW_APPLICATION_TX_BUFFER out_frame;
+  uint8_t out_length = 0xFF;
+  m_tx_queue_free = 2;
+
+  received_frame_status_t status = daily_repeating_get(2, &out_frame, &out_length);
+
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT8(0, out_length);
+  TEST_ASSERT_EQUAL_UINT8(2, m_tx_count);
+  assert_report(&m_tx_frames[0], m_tx_lengths[0], 2, 4);
+  assert_report(&m_tx_frames[1], m_tx_lengths[1], 4, 5);
+}
+
+/**
+ * A Get for a slot with no occupied slot after it is answered with a single
+ * regular response, as is a multicast Get.
+ */
+void test_ACTIVE_SCHEDULE_report_burst_single_report(void)
+{
+  ZW_APPLICATION_TX_BUFFER out_frame;
+  uint8_t out_length = 0;
+
+  received_frame_status_t status = daily_repeating_get(7, &out_frame, &out_length);
+
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT8(0, m_tx_count);
+  assert_report(&out_frame.ZW_ActiveScheduleDailyRepeatingScheduleReport1byteFrame, out_length, 7, 0);
+
+  is_multicast_StopIgnore();
+  is_multicast_IgnoreAndReturn(true);
+  out_length = 0;
+  status = daily_repeating_get(1, &out_frame, &out_length);
+
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT8(0, m_tx_count);
+  assert_report(&out_frame.ZW_ActiveScheduleDailyRepeatingScheduleReport1byteFrame, out_length, 1, 2);
+}
+
+/**
+ * A Get answered right away reports no duration, whether it is answered with a
+ * burst or with a single response.
+ */
+void test_ACTIVE_SCHEDULE_report_burst_no_duration(void)
+{
+  const uint16_t slots[] = { 1, 7 };
+  for (uint8_t i = 0; i < sizeof_array(slots); i++) {
+    command_handler_input_t input;
+    test_common_clear_command_handler_input(&input);
+    ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_GET_FRAME * frame =
+      &input.frame.as_zw_application_tx_buffer.ZW_ActiveScheduleDailyRepeatingScheduleGetFrame;
+    frame->cmdClass = COMMAND_CLASS_ACTIVE_SCHEDULE;
+    frame->cmd = ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_GET;
+    frame->targetCc = COMMAND_CLASS_USER_CREDENTIAL;
+    frame->targetId2 = TARGET_ID;
+    frame->scheduleSlotId2 = (uint8_t)slots[i];
+
+    ZW_APPLICATION_TX_BUFFER out_frame;
+    cc_handler_input_t in = {
+      .rx_options = &input.rxOptions,
+      .frame = &input.frame.as_zw_application_tx_buffer,
+      .length = sizeof(ZW_ACTIVE_SCHEDULE_DAILY_REPEATING_SCHEDULE_GET_FRAME)
+    };
+    // Any value left by the caller must be overwritten by the handler
+    cc_handler_output_t out = {
+      .frame = &out_frame,
+      .length = 0,
+      .duration = 0xFF
+    };
+
+    received_frame_status_t status = invoke_cc_handler(&in, &out);
+
+    TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, status);
+    TEST_ASSERT_EQUAL_UINT8(0, out.duration);
+  }
+}
@@ -26,10 +26,14 @@
 /**
  * OTA Cache size <1..65535:1>
  *
- * Specifies the cache size when ota multi frames is enabled
+ * Specifies the cache size when ota multi frames is enabled.
+ * The cache is allocated twice, so that the reports of one MD Get are written to flash while
+ * the reports of the next MD Get are received.
+ * At most the cache size divided by the fragment size is requested in one MD Get. The first
+ * MD Get requests half of that, and the number grows on a good link and shrinks on errors.
  */
 #if !defined(CC_FIRMWARE_UPDATE_CONFIG_OTA_CACHE_SIZE)
-#define CC_FIRMWARE_UPDATE_CONFIG_OTA_CACHE_SIZE  200
+#define CC_FIRMWARE_UPDATE_CONFIG_OTA_CACHE_SIZE  400
 #endif /* !defined(CC_FIRMWARE_UPDATE_CONFIG_OTA_CACHE_SIZE) */
 
 /**
@@ -34,6 +34,7 @@
 #include <ZAF_nvm.h>
 #include <zaf_config_api.h>
 #include <SizeOf.h>
+#include <zaf_event_distributor_soc.h>
 #include "cc_firmware_update_config.h"
 
 //#define DEBUGPRINT
@@ -109,6 +110,7 @@ typedef struct _OTA_UTIL_
   uint8_t requestReport;   /// Status to send in FW Update Request Report
   uint8_t statusReport;    /// Status to send in FW Update MD Status Report
   uint8_t reportsReceived; /// counter to keep track of how many reports are received so far during one multiFrame session. (not from start)
+  uint8_t batchErrors;     /// Number of CRC errors, invalid reports and MD Get retries during one multiFrame session.
 } OTA_UTIL;
 
 //If this struct is changed please increase FIRMWARE_UPDATE_FILE_VERSION in ota_util.c
@@ -183,6 +185,9 @@ STATIC_ASSERT(sizeof(SFirmwareUpdateFile) > sizeof(SFirmwareUpdateFile_DEPRECATE
 /* Used for extending FIRMWARE_UPDATE_REQUEST_TIMEOUTS on MdGet retries - in 1ms ticks */
 #define FIRMWARE_UPDATE_REQUEST_TIMEOUT_RETRY_INC 1500
 
+/* Smallest number of reports requested in one MD Get when multi frames are used */
+#define FIRMWARE_UPDATE_MIN_NUMBER_OF_REPORTS        2
+
 #define ACTIVATION_SUPPORT_MASK_APP        0x80U
 #define ACTIVATION_SUPPORT_MASK_INITIATOR  0x01U
 #define ACTIVATION_SUPPORT_ENABLED_MASK    0x81U
@@ -201,19 +206,42 @@ STATIC_ASSERT(sizeof(SFirmwareUpdateFile) > sizeof(SFirmwareUpdateFile_DEPRECATE
 static zpal_pm_handle_t m_radioPowerLock;
 
 /**
- * Internal storage for incoming FW Update MD Reports.
- * Should be big enough to store at least two incoming frames.
- * If not, then frames are written directly to flash and the storage is not used
+ * Internal storage for incoming FW Update MD Reports, made of two buffers.
+ * Each buffer should be big enough to store at least two incoming frames.
+ * If not, then frames are written directly to flash and only the first buffer is used.
+ *
+ * The reports requested in one MD Get are collected in mdReportsStorage[mdReportsBuffer].
+ * When all of them are received, the next MD Get is queued and the buffer is handed over to
+ * writeReportsBehind(). The flash write runs later as a command class event, and the reports
+ * of the next MD Get are collected in the other buffer meanwhile.
  */
-static uint8_t mdReportsStorage[CC_FIRMWARE_UPDATE_CONFIG_OTA_CACHE_SIZE] __attribute__((aligned(4)));
+static uint8_t mdReportsStorage[2][CC_FIRMWARE_UPDATE_CONFIG_OTA_CACHE_SIZE] __attribute__((aligned(4)));
+
+/// Index of the buffer in mdReportsStorage that collects the incoming reports.
+static uint8_t mdReportsBuffer;
+
+/// Reports waiting to be written to flash by writePendingReports().
+static struct
+{
+  uint32_t offset;  ///< Offset of the reports in the firmware image
+  uint16_t length;  ///< Number of bytes to write. 0 if nothing is waiting.
+  uint8_t buffer;   ///< Index of the buffer in mdReportsStorage holding the reports
+} mdReportsPendingWrite;
 
 /**
  * Number of Reports to request in single FW Update MD Get. Minimum is 1.
- * It's value is calculated upon receiving FW Update MD Request Get.
- * mdGetNumberOfReports = sizeof(mdReportsStorage)/(single fragment size)
+ * It starts at half of mdGetMaxNumberOfReports and adapts to the error rate of the link,
+ * see adaptNumberOfReports().
  */
 static uint8_t mdGetNumberOfReports;
 
+/**
+ * Number of Reports fitting in one buffer of mdReportsStorage.
+ * It's value is calculated from the fragment size upon receiving FW Update MD Request Get.
+ * mdGetMaxNumberOfReports = sizeof(mdReportsStorage[0])/(single fragment size)
+ */
+static uint8_t mdGetMaxNumberOfReports;
+
 /// Actual fragment size calculated upon receiving REQUEST GET.
 static uint8_t firmware_update_packetsize;
 
@@ -229,7 +257,8 @@ static OTA_UTIL myOta = {
     .activation_enabled = 0, // activation_enabled
     .requestReport = FIRMWARE_UPDATE_MD_REQUEST_REPORT_VALID_COMBINATION_V5, // requestReport
     .statusReport = FIRMWARE_UPDATE_MD_STATUS_REPORT_SUCCESSFULLY_V5, // statusReport
-    .reportsReceived = 0 // reportsReceived
+    .reportsReceived = 0, // reportsReceived
+    .batchErrors = 0 // batchErrors
 };
 
 /****************************************************************************/
@@ -263,6 +292,9 @@ static char* getEventAsString(FW_EVENT event);
 #endif //DEBUGPRINT
 static void resetReceivedReportsData(void);
 static bool useMultiFrames(void);
+static void adaptNumberOfReports(void);
+static void writeReportsBehind(uint32_t offset, uint16_t length);
+static void writePendingReports(void);
 
 static JOB_STATUS
 CmdClassFirmwareUpdateMdStatusReport(RECEIVE_OPTIONS_TYPE_EX *rxOpt,
@@ -649,6 +681,7 @@ handleCmdClassFirmwareUpdateMdReport( uint16_t crc16Result,
   if (0 != crc16Result)
   {
     DPRINT("CRC invalid\r\n");
+    myOta.batchErrors++;
     if (useMultiFrames()) {
       zaf_transport_resume();
     }
@@ -666,6 +699,7 @@ handleCmdClassFirmwareUpdateMdReport( uint16_t crc16Result,
     // (firmwareUpdateReportNumber == myOta.firmwareUpdateReportNumberPrevious + 1) do not match.
     // Set Status value and let the timer handle retries
     myOta.statusReport = FIRMWARE_UPDATE_MD_STATUS_REPORT_UNABLE_TO_RECEIVE_V5;
+    myOta.batchErrors++;
     if (useMultiFrames()) {
       zaf_transport_resume();
     }
@@ -684,6 +718,7 @@ handleCmdClassFirmwareUpdateMdReport( uint16_t crc16Result,
     // (firmware_update_packetsize != fw_actualFrameSize) and not last packet - do not match.
     // Set Status value and let the timer handle retries
     myOta.statusReport = FIRMWARE_UPDATE_MD_STATUS_REPORT_UNABLE_TO_RECEIVE_V5;
+    myOta.batchErrors++;
     if (useMultiFrames()) {
       zaf_transport_resume();
     }
@@ -717,15 +752,15 @@ handleCmdClassFirmwareUpdateMdReport( uint16_t crc16Result,
     // If so, write all incoming frames into mdReportsStorage,
     // and write entire content of it into NVM when all of them have been received
     startAddress = myOta.reportsReceived * firmware_update_packetsize;
-    memcpy(&mdReportsStorage[startAddress], pData, fw_actualFrameSize);
+    memcpy(&mdReportsStorage[mdReportsBuffer][startAddress], pData, fw_actualFrameSize);
   }
   else
   {
     // Otherwise, write data directly to flash
     // Using mdReportsStorage to ensure 32-bit alignment
     startAddress = ((uint32_t)(firmwareUpdateReportNumber - 1) * firmware_update_packetsize);
-    memcpy(mdReportsStorage, pData, fw_actualFrameSize);
-    zpal_status = zpal_bootloader_write_data(startAddress, mdReportsStorage, fw_actualFrameSize);
+    memcpy(mdReportsStorage[0], pData, fw_actualFrameSize);
+    zpal_status = zpal_bootloader_write_data(startAddress, mdReportsStorage[0], fw_actualFrameSize);
     ASSERT(zpal_status == ZPAL_STATUS_OK);
   }
 
@@ -777,7 +812,9 @@ handleCmdClassFirmwareUpdateMdReport( uint16_t crc16Result,
 
       // Find the starting address for writing to flash
       startAddress = ((uint32_t)(firmwareUpdateReportNumber - myOta.reportsReceived) * firmware_update_packetsize);
-      zpal_status = zpal_bootloader_write_data(startAddress, mdReportsStorage, len);
+      // The image is verified next, so the reports of the previous MD Get cannot wait any longer.
+      writePendingReports();
+      zpal_status = zpal_bootloader_write_data(startAddress, mdReportsStorage[mdReportsBuffer], len);
       ASSERT(zpal_status == ZPAL_STATUS_OK);
     }
     // Delay verification of the firmware image
@@ -806,16 +843,22 @@ handleCmdClassFirmwareUpdateMdReport( uint16_t crc16Result,
 
         // Find the starting address for writing to flash
         startAddress = ((uint32_t)(firmwareUpdateReportNumber - myOta.reportsReceived) * firmware_update_packetsize);
-        zpal_status = zpal_bootloader_write_data(startAddress, mdReportsStorage, len);
-        ASSERT(zpal_status == ZPAL_STATUS_OK);
         zaf_transport_resume();
+
+        adaptNumberOfReports();
+        DPRINT("FW_EVENT_REPORT_RECEIVED_BATCH --> This triggers new Md Get CMD\n");
+        handleEvent(FW_EVENT_REPORT_RECEIVED_BATCH);
+
+        // The MD Get is queued first. The reports are written to flash later, while the
+        // next reports are collected in the other buffer.
+        writeReportsBehind(startAddress, len);
       }
       else
       {
         // MultiFrames were not used, therefore all fragments are already written to flash.
+        DPRINT("FW_EVENT_REPORT_RECEIVED_BATCH --> This triggers new Md Get CMD\n");
+        handleEvent(FW_EVENT_REPORT_RECEIVED_BATCH);
       }
-      DPRINT("FW_EVENT_REPORT_RECEIVED_BATCH --> This triggers new Md Get CMD\n");
-      handleEvent(FW_EVENT_REPORT_RECEIVED_BATCH);
     }
   }
 }
@@ -988,11 +1031,21 @@ void handleCmdClassFirmwareUpdateMdReqGet(
   firmware_update_packetsize = (uint8_t)fragmentSize;
 
   // At this point maxFragmentSize is known => calculate Number of Reports
-  // If storage is not big enough for at least 2 reports, don't enable multi data frames
+  // If a buffer is not big enough for at least 2 reports, don't enable multi data frames
+  mdGetNumberOfReports = 1;
+  mdGetMaxNumberOfReports = 1;
   if (CC_FIRMWARE_UPDATE_CONFIG_OTA_MULTI_FRAME
-      && sizeof(mdReportsStorage) >= (2 * firmware_update_packetsize))
+      && sizeof(mdReportsStorage[0]) >= (2 * firmware_update_packetsize))
   {
-    mdGetNumberOfReports = sizeof(mdReportsStorage) / firmware_update_packetsize;
+    uint32_t numberOfReports = sizeof(mdReportsStorage[0]) / firmware_update_packetsize;
+    // Number of Reports is a single byte in FW Update MD Get
+    mdGetMaxNumberOfReports = (uint8_t)((numberOfReports > UINT8_MAX) ? UINT8_MAX : numberOfReports);
+    // Start with half a buffer, so that the batches can grow as well as shrink
+    mdGetNumberOfReports = mdGetMaxNumberOfReports / 2;
+    if (FIRMWARE_UPDATE_MIN_NUMBER_OF_REPORTS > mdGetNumberOfReports)
+    {
+      mdGetNumberOfReports = FIRMWARE_UPDATE_MIN_NUMBER_OF_REPORTS;
+    }
   }
   DPRINTF("FW Update MD Get - Number Of Reports requested: %d\n", mdGetNumberOfReports);
 
@@ -1051,6 +1104,10 @@ static void initOTAState(void)
   myOta.fw_numOfRetries = 0;
   myOta.firmwareCrc = 0;
   myOta.statusReport = FIRMWARE_UPDATE_MD_STATUS_REPORT_SUCCESSFULLY_V5;
+  myOta.batchErrors = 0;
+  // Reports of an earlier update must not be written into the new image
+  mdReportsPendingWrite.length = 0;
+  mdReportsBuffer = 0;
 }
 
 /**
@@ -1160,6 +1217,7 @@ static void ZCB_TimerOutFwUpdateFrameGet(SSwTimer* pTimer)
 {
   DPRINTF("Timer expired. Send next Md Get CMD. %d retries made already\n", myOta.fw_numOfRetries);
 
+  myOta.batchErrors++;
   if (useMultiFrames()) {
     zaf_transport_resume();
   }
@@ -1474,7 +1532,7 @@ static void resetReceivedReportsData(void)
 {
   DPRINTF(">> %s() - reset data\n", __func__);
   myOta.reportsReceived = 0;
-  memset(mdReportsStorage, 0x00, sizeof(mdReportsStorage));
+  // mdReportsStorage is not cleared. Only received reports are written to flash.
 }
 
 /// Checks whether multi frames should be used. To use it, Multi frames option
@@ -1483,3 +1541,74 @@ static bool useMultiFrames(void)
 {
   return CC_FIRMWARE_UPDATE_CONFIG_OTA_MULTI_FRAME && ( mdGetNumberOfReports > 1 );
 }
+
+/// Called when all reports requested in one GET are received.
+/// Halves the number of reports to request if the reports were received with errors or
+/// had to be requested again, and otherwise increases it by one up to the storage size.
+static void adaptNumberOfReports(void)
+{
+  if (0 < myOta.batchErrors)
+  {
+    mdGetNumberOfReports /= 2;
+    if (FIRMWARE_UPDATE_MIN_NUMBER_OF_REPORTS > mdGetNumberOfReports)
+    {
+      mdGetNumberOfReports = FIRMWARE_UPDATE_MIN_NUMBER_OF_REPORTS;
+    }
+  }
+  else if (mdGetMaxNumberOfReports > mdGetNumberOfReports)
+  {
+    mdGetNumberOfReports++;
+  }
+  DPRINTF(">> %s() - %d errors, next MD Get requests %d reports\n", __func__, myOta.batchErrors, mdGetNumberOfReports);
+  myOta.batchErrors = 0;
+}
+
+/// Hands the reports collected in the current buffer over to writePendingReports(), which runs
+/// as a command class event, and continues collecting reports in the other buffer.
+static void writeReportsBehind(uint32_t offset, uint16_t length)
+{
+  // Only one buffer can wait for its write. If the previous one still waits, write it now.
+  writePendingReports();
+
+  mdReportsPendingWrite.offset = offset;
+  mdReportsPendingWrite.length = length;
+  mdReportsPendingWrite.buffer = mdReportsBuffer;
+  mdReportsBuffer ^= 1;
+
+  if (!zaf_event_distributor_enqueue_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
+                                              CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS,
+                                              NULL))
+  {
+    DPRINT("Failed to queue the flash write. Writing now.\n");
+    writePendingReports();
+  }
+}
+
+/// Writes the reports handed over to writeReportsBehind() to flash, if they have not been
+/// written yet.
+static void writePendingReports(void)
+{
+  if (0 == mdReportsPendingWrite.length)
+  {
+    return;
+  }
+  zpal_status_t zpal_status = zpal_bootloader_write_data(mdReportsPendingWrite.offset,
+                                                         mdReportsStorage[mdReportsPendingWrite.buffer],
+                                                         mdReportsPendingWrite.length);
+  ASSERT(zpal_status == ZPAL_STATUS_OK);
+  mdReportsPendingWrite.length = 0;
+}
+
+static void
+firmware_update_event_handler(const uint8_t event, __attribute__((unused)) const void *data)
+{
+  switch (event) {
+    case CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS:
+      writePendingReports();
+      break;
+    default:
+      break;
+  }
+}
+
+ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, firmware_update_event_handler);
@@ -37,6 +37,12 @@
 #define WAITTIME_FWU_FAIL 2
 #endif
 
+/**
+ * Command class event that writes the reports of the previous FW Update MD Get to flash.
+ * @private
+ */
+#define CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS  1
+
 /**
  * Please see description of CC_FirmwareUpdate_Init().
  * @private
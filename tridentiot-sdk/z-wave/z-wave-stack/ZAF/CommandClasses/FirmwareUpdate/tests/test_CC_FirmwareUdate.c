@@ -17,6 +17,7 @@
 #include <zpal_nvm.h>
 #include <ZAF_Common_helper_mock.h>
 #include "zaf_transport_tx_mock.h"
+#include "zaf_event_distributor_soc_mock.h"
 //#define DEBUGPRINT
 #ifdef DEBUGPRINT
 #include <CRC.h>
@@ -67,7 +68,10 @@ void setUp(void)
 // Number of retries receiving the same fragment before aborting
 #define FIRMWARE_UPDATE_MAX_RETRY 10
 
-#define OTA_CACHE_SIZE 200
+/// Default of CC_FIRMWARE_UPDATE_CONFIG_OTA_CACHE_SIZE, the size of each report buffer
+#define OTA_CACHE_SIZE 400
+/// Number of reports requested in the first FW Update MD Get: half of a report buffer
+#define OTA_FIRST_NUMBER_OF_REPORTS(fragment_size) ((OTA_CACHE_SIZE / (fragment_size)) / 2)
 
 #define ZAF_FILE_SIZE_CC_FIRMWARE_UPDATE 16
 
@@ -891,7 +895,7 @@ void test_successful_firmware_update(void)
   const uint8_t EXPECTED_FRAME[] = {
                                     COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
                                     FIRMWARE_UPDATE_MD_GET_V5,
-                                    OTA_CACHE_SIZE / FRAGMENT_SIZE, // Number of reports
+                                    OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE), // Number of reports
                                     0, // Report number MSB
                                     1  // Report number LSB
   };
@@ -1168,7 +1172,7 @@ void test_successful_firmware_update_with_activation(void)
   const uint8_t EXPECTED_FRAME[] = {
                                     COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
                                     FIRMWARE_UPDATE_MD_GET_V5,
-                                    OTA_CACHE_SIZE / FRAGMENT_SIZE, // Number of reports
+                                    OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE), // Number of reports
                                     0, // Report number MSB
                                     1  // Report number LSB
   };
@@ -1537,7 +1541,7 @@ void test_ota_util_CRC_error_in_one_fragment(void)
   pMock->return_code.v = 0; // Timer handle
 
   // Setup the mock for validating the first Firmware Update Md Get command the node sends for OTA fragment 1
-  uint8_t numberOfReports = OTA_CACHE_SIZE / sizeof(otaFragment);
+  uint8_t numberOfReports = OTA_FIRST_NUMBER_OF_REPORTS(sizeof(otaFragment));
   uint16_t nextReportNumber = 1;
   const uint8_t EXPECTED_FRAME[] = {
                                     COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
@@ -1855,7 +1859,7 @@ void test_ota_util_CRC_error_in_one_fragment_as_in_C67890(void)
    */
 
   // Setup the mock for validating the first Firmware Update Md Get command the node sends for OTA fragment 1
-  uint8_t numberOfReports = OTA_CACHE_SIZE / sizeof(otaFragment);
+  uint8_t numberOfReports = OTA_FIRST_NUMBER_OF_REPORTS(sizeof(otaFragment));
   uint16_t nextReportNumber = 1;
   const uint8_t EXPECTED_MD_GET_FRAME[] = {
                                     COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
@@ -2398,7 +2402,7 @@ void test_ota_util_CRC_error_in_all_fragments(void)
   const uint8_t EXPECTED_FRAME[] = {
                                     COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
                                     FIRMWARE_UPDATE_MD_GET_V5,
-                                    OTA_CACHE_SIZE / sizeof(otaFragment),
+                                    OTA_FIRST_NUMBER_OF_REPORTS(sizeof(otaFragment)),
                                     0, // Report number MSB
                                     1  // Report number LSB - expect to request fragment number 1.
   };
@@ -2429,7 +2433,7 @@ void test_ota_util_CRC_error_in_all_fragments(void)
       const uint8_t EXPECTED_FRAME[] = {
                                         COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
                                         FIRMWARE_UPDATE_MD_GET_V5,
-                                        OTA_CACHE_SIZE / sizeof(otaFragment),
+                                        OTA_FIRST_NUMBER_OF_REPORTS(sizeof(otaFragment)),
                                         0, // Report number MSB
                                         1  // Report number LSB - expect to request fragment number 1.
       };
@@ -2837,8 +2841,8 @@ void test_multidata_frame_storage_NumberOfReports(void)
   mock_t * pMock = NULL;
 
   const uint8_t FRAGMENT_SIZE_1 = 10;
-  uint8_t numberOfReports1 = OTA_CACHE_SIZE / FRAGMENT_SIZE_1;
-  printf ("numberOfReports = %d = %d/%d\n", numberOfReports1, OTA_CACHE_SIZE, FRAGMENT_SIZE_1);
+  uint8_t numberOfReports1 = OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE_1);
+  printf ("numberOfReports = %d = %d/%d/2\n", numberOfReports1, OTA_CACHE_SIZE, FRAGMENT_SIZE_1);
 
   mock_call_use_as_stub(TO_STR(Check_not_legal_response_job));
   mock_call_use_as_stub(TO_STR(ZAF_nvm_write));
@@ -2878,8 +2882,8 @@ void test_multidata_frame_storage_NumberOfReports(void)
 /// PART 2 -  Use different fragment size and compare number of reports.
 
   const uint8_t FRAGMENT_SIZE_2 = 50;
-  uint8_t numberOfReports2 = OTA_CACHE_SIZE / FRAGMENT_SIZE_2;
-  //printf ("numberOfReports = %d = %d/%d\n", numberOfReports2, OTA_CACHE_SIZE, FRAGMENT_SIZE_2);
+  uint8_t numberOfReports2 = OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE_2);
+  //printf ("numberOfReports = %d = %d/%d/2\n", numberOfReports2, OTA_CACHE_SIZE, FRAGMENT_SIZE_2);
 
 /// Second Request Get
   call_FW_update_Request_Get(pMock, FRAGMENT_SIZE_2, false);
@@ -2919,11 +2923,11 @@ void test_multidata_frame_receiving(void)
   // Test:
   // 1. Make sure that numberOfReports Reports are received successfully after single MD GET
   // 2. MD Reports are coming in order.
-  // 3. Next MD Get is sent after last MD Report is received
+  // 3. Next MD Get is sent after last MD Report is received, asking for one more report
 
   const uint8_t FRAGMENT_SIZE = 50;
-  uint8_t numberOfReports = OTA_CACHE_SIZE / FRAGMENT_SIZE;
-  //printf ("numberOfReports = %d = %d/%d\n", numberOfReports, OTA_CACHE_SIZE, FRAGMENT_SIZE);
+  uint8_t numberOfReports = OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE);
+  //printf ("numberOfReports = %d = %d/%d/2\n", numberOfReports, OTA_CACHE_SIZE, FRAGMENT_SIZE);
 
   mock_call_use_as_stub(TO_STR(Check_not_legal_response_job));
   mock_call_use_as_stub(TO_STR(ZAF_nvm_write));
@@ -2935,6 +2939,9 @@ void test_multidata_frame_receiving(void)
   mock_call_use_as_stub(TO_STR(TimerIsActive));
   mock_call_use_as_stub(TO_STR(zpal_bootloader_reset_page_counters));
 
+  // The flash write of the received reports is verified in test_multidata_frame_storage_success()
+  zaf_event_distributor_enqueue_cc_event_IgnoreAndReturn(true);
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Request Get
   call_FW_update_Request_Get(pMock, FRAGMENT_SIZE, false);
@@ -2996,10 +3003,11 @@ void test_multidata_frame_receiving(void)
       FRAGMENT_SIZE);
 
   // Expect next FW Update MD Get here, report Number = numberOfReports + 1
+  // The batch was received without errors, so one more report is requested.
   const uint8_t MD_GET_EXPECTED_FRAME_2[] = {
                                            COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
                                            FIRMWARE_UPDATE_MD_GET_V5,
-                                           numberOfReports,
+                                           numberOfReports + 1,
                                            (next_report_no << 8) & 0xFF, // Report number MSB
                                            next_report_no & 0xFF// Report number LSB
   };
@@ -3052,8 +3060,8 @@ void test_multidata_frame_with_invalid_md_report(void)
 
   /// Part 0 - Setup
   const uint8_t FRAGMENT_SIZE = 30;
-  uint8_t numberOfReports = OTA_CACHE_SIZE / FRAGMENT_SIZE;
-  //printf ("numberOfReports = %d = %d/%d\n", numberOfReports, OTA_CACHE_SIZE, FRAGMENT_SIZE);
+  uint8_t numberOfReports = OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE);
+  //printf ("numberOfReports = %d = %d/%d/2\n", numberOfReports, OTA_CACHE_SIZE, FRAGMENT_SIZE);
 
   mock_call_use_as_stub(TO_STR(Check_not_legal_response_job));
   mock_call_use_as_stub(TO_STR(zpal_bootloader_is_first_boot));
@@ -3200,17 +3208,37 @@ void test_multidata_frame_with_invalid_md_report(void)
   mock_calls_verify();
 }
 
+/// The command class event handlers registered with ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER().
+extern const zaf_event_distributor_cc_event_handler_map_latest_t __start_zw_zaf_event_distributor_cc_event_handler;
+extern const zaf_event_distributor_cc_event_handler_map_latest_t __stop_zw_zaf_event_distributor_cc_event_handler;
+
+/// Hands a command class event to its handler, as the event distributor of the application does.
+static void distribute_cc_event(uint16_t command_class, uint8_t event)
+{
+  const zaf_event_distributor_cc_event_handler_map_latest_t * p_entry;
+  for (p_entry = &__start_zw_zaf_event_distributor_cc_event_handler;
+       p_entry < &__stop_zw_zaf_event_distributor_cc_event_handler;
+       p_entry++)
+  {
+    if ((p_entry->command_class == command_class) && (NULL != p_entry->handler))
+    {
+      p_entry->handler(event, NULL);
+    }
+  }
+}
+
 void test_multidata_frame_storage_success(void)
 {
   mock_t * pMock;
   /*
    * Test storage:
-   * All received reports from one shot are successfully written to flash.
+   * All received reports from one shot are successfully written to flash,
+   * after the next MD Get has been queued.
    */
   /// Part 0 - Setup
   const uint8_t FRAGMENT_SIZE = 30;
-  uint8_t numberOfReports = OTA_CACHE_SIZE / FRAGMENT_SIZE;
-  //printf ("numberOfReports = %d = %d/%d\n", numberOfReports, OTA_CACHE_SIZE, FRAGMENT_SIZE);
+  uint8_t numberOfReports = OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE);
+  //printf ("numberOfReports = %d = %d/%d/2\n", numberOfReports, OTA_CACHE_SIZE, FRAGMENT_SIZE);
 
   mock_call_use_as_stub(TO_STR(Check_not_legal_response_job));
   mock_call_use_as_stub(TO_STR(zpal_bootloader_is_first_boot));
@@ -3329,16 +3357,16 @@ void test_multidata_frame_storage_success(void)
          &(pFirmwareUpdateMDReport->frame.as_byte_array[4]),
          FRAGMENT_SIZE);
 
-  mock_call_expect(TO_STR(zpal_bootloader_write_data), &pMock);
-  pMock->expect_arg[0].v = 0;
-  pMock->expect_arg[1].p = temp_storage;
-  pMock->expect_arg[2].v = FRAGMENT_SIZE * numberOfReports;
-  pMock->return_code.v = ZPAL_STATUS_OK;
-
   // Next FW Update MD Get. Not relevant for this test.
   zaf_transport_rx_to_tx_options_Ignore();
   zaf_transport_tx_IgnoreAndReturn(true);
 
+  // The reports are handed over to the application task instead of being written right away
+  zaf_event_distributor_enqueue_cc_event_ExpectAndReturn(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
+                                                         CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS,
+                                                         NULL,
+                                                         true);
+
   zaf_transport_resume_Expect();
 
   zaf_transport_resume_Expect();
@@ -3347,6 +3375,257 @@ void test_multidata_frame_storage_success(void)
 
   test_common_command_handler_input_free(pFirmwareUpdateMDReport);
 
+  mock_call_expect(TO_STR(zpal_bootloader_write_data), &pMock);
+  pMock->expect_arg[0].v = 0;
+  pMock->expect_arg[1].p = temp_storage;
+  pMock->expect_arg[2].v = FRAGMENT_SIZE * numberOfReports;
+  pMock->return_code.v = ZPAL_STATUS_OK;
+
+  distribute_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS);
+
+  mock_calls_verify();
+}
+
+/// Expected FW Update MD Get frames. They must stay valid until zaf_transport_tx() is called.
+static uint8_t md_get_expected_frames[8][5];
+static uint8_t md_get_expected_count;
+
+/// Expects a FW Update MD Get requesting number_of_reports reports from report_number.
+static void expect_md_get(uint8_t number_of_reports, uint16_t report_number)
+{
+  uint8_t * frame = md_get_expected_frames[md_get_expected_count++ % sizeof_array(md_get_expected_frames)];
+  frame[0] = COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5;
+  frame[1] = FIRMWARE_UPDATE_MD_GET_V5;
+  frame[2] = number_of_reports;
+  frame[3] = (uint8_t)(report_number >> 8); // Report number MSB
+  frame[4] = (uint8_t)report_number;        // Report number LSB
+
+  zaf_transport_tx_ExpectAndReturn(frame, 5, NULL, NULL, true);
+  zaf_transport_tx_IgnoreArg_callback();
+  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+}
+
+/// Receives valid FW Update MD Reports, starting at *p_report_number.
+static void receive_md_reports(uint16_t * p_report_number, uint8_t count, uint8_t fragment_size)
+{
+  for (uint8_t i = 0; i < count; i++)
+  {
+    command_handler_input_t * pFirmwareUpdateMDReport =
+        firmware_update_meta_data_report_frame_create(false, (*p_report_number)++, fragment_size);
+    received_frame_status_t status = INVOKE_CC_HANDLER(handleCommandClassFWUpdate, pFirmwareUpdateMDReport);
+    TEST_ASSERT_MESSAGE(status == RECEIVED_FRAME_STATUS_SUCCESS, "Wrong frame status :(");
+    test_common_command_handler_input_free(pFirmwareUpdateMDReport);
+  }
+}
+
+/// Expects that the reports of a completed FW Update MD Get are handed over to the application task.
+static void expect_md_reports_write_queued(void)
+{
+  zaf_event_distributor_enqueue_cc_event_ExpectAndReturn(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5,
+                                                         CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS,
+                                                         NULL,
+                                                         true);
+}
+
+/// Expected content of flash writes. They must stay valid until zpal_bootloader_write_data() is called.
+static uint8_t md_reports_expected_data[2][OTA_CACHE_SIZE];
+static uint8_t md_reports_expected_count;
+
+/// Expects count reports, starting at report_number, to be written to flash.
+static void expect_md_reports_written(uint16_t report_number, uint8_t count, uint8_t fragment_size)
+{
+  mock_t * pMock;
+  uint8_t * data = md_reports_expected_data[md_reports_expected_count++ % sizeof_array(md_reports_expected_data)];
+  for (uint16_t i = 0; i < count * fragment_size; i++)
+  {
+    data[i] = (uint8_t)(i % fragment_size); // Content of firmware_update_meta_data_report_frame_create()
+  }
+
+  mock_call_expect(TO_STR(zpal_bootloader_write_data), &pMock);
+  pMock->expect_arg[0].v = (uint32_t)(report_number - 1) * fragment_size;
+  pMock->expect_arg[1].p = data;
+  pMock->expect_arg[2].v = count * fragment_size;
+  pMock->return_code.v = ZPAL_STATUS_OK;
+}
+
+/**
+ * Receives a batch of count valid FW Update MD Reports without errors. Verifies that the
+ * next FW Update MD Get is queued before the reports are written to flash.
+ */
+static void receive_md_batch(uint16_t * p_report_number,
+                             uint8_t count,
+                             uint8_t fragment_size,
+                             uint8_t next_number_of_reports)
+{
+  const uint16_t first_report_number = *p_report_number;
+
+  expect_md_get(next_number_of_reports, first_report_number + count);
+  expect_md_reports_write_queued();
+  receive_md_reports(p_report_number, count, fragment_size);
+
+  // The next MD Get is queued, and no write is expected yet
+  zaf_transport_tx_mock_Verify();
+  zaf_event_distributor_soc_mock_Verify();
+
+  expect_md_reports_written(first_report_number, count, fragment_size);
+  distribute_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS);
+}
+
+void test_multidata_frame_number_of_reports_adapts(void)
+{
+  mock_t * pMock;
+  /*
+   * Tests the number of reports requested per FW Update MD Get:
+   * 1. The first MD Get asks for half of the reports fitting in a report buffer.
+   * 2. It grows by one after each clean batch, up to the report buffer size.
+   * 3. It is halved after a batch with an MD Get retry.
+   * 4. It is never halved below 2.
+   * Tests the flash write of the received reports:
+   * 5. The next MD Get is queued before the reports are written to flash.
+   * 6. A batch still waiting for its write is written before the next batch is handed over.
+   */
+
+  /// Part 0 - Setup
+  const uint8_t FRAGMENT_SIZE = 40;
+  const uint8_t FIRST_NUMBER_OF_REPORTS = OTA_FIRST_NUMBER_OF_REPORTS(FRAGMENT_SIZE); // 5
+  const uint8_t MAX_NUMBER_OF_REPORTS = OTA_CACHE_SIZE / FRAGMENT_SIZE;                // 10
+
+  md_get_expected_count = 0;
+
+  mock_call_use_as_stub(TO_STR(Check_not_legal_response_job));
+  mock_call_use_as_stub(TO_STR(zpal_bootloader_is_first_boot));
+  mock_call_use_as_stub(TO_STR(ZAF_nvm_write));
+  mock_call_use_as_stub(TO_STR(zpal_bootloader_init));
+  mock_call_use_as_stub(TO_STR(MSC_Init));
+  mock_call_use_as_stub(TO_STR(zpal_bootloader_reset_page_counters));
+  mock_call_use_as_stub(TO_STR(ZAF_transportSendDataAbort));
+  mock_call_use_as_stub(TO_STR(TimerIsActive));
+  mock_call_use_as_stub(TO_STR(TimerStart));
+  mock_call_use_as_stub(TO_STR(TimerStop));
+  mock_call_use_as_stub(TO_STR(TimerRestart));
+
+  zaf_transport_resume_Ignore();
+  zaf_transport_rx_to_tx_options_Ignore();
+
+  /// Part 0 - Initialize CC Firmware update
+
+  mock_call_expect(TO_STR(zpal_bootloader_get_info), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  zpal_bootloader_info_t info = {
+                                  .type = ZPAL_BOOTLOADER_PRESENT,
+                                  .capabilities = ZPAL_BOOTLOADER_CAPABILITY_STORAGE
+  };
+  pMock->output_arg[0].p = &info;
+
+  mock_call_expect(TO_STR(ZAF_nvm_get_object_size), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_ANY;
+  pMock->compare_rule_arg[1] = COMPARE_NOT_NULL;
+  size_t fileSize = ZAF_FILE_SIZE_CC_FIRMWARE_UPDATE;
+  pMock->output_arg[1].p     = &fileSize;
+  pMock->return_code.v       = ZPAL_STATUS_OK;
+
+  // The first timer registered in CC_FirmwareUpdate_Init is the MD Get timer
+  mock_t * pMock_AppTimerRegister_FrameGet = NULL;
+  mock_call_expect(TO_STR(AppTimerRegister), &pMock_AppTimerRegister_FrameGet);
+  pMock_AppTimerRegister_FrameGet->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock_AppTimerRegister_FrameGet->expect_arg[1].v = false;
+  pMock_AppTimerRegister_FrameGet->compare_rule_arg[2] = COMPARE_NOT_NULL;
+  pMock_AppTimerRegister_FrameGet->return_code.v = true; // Timer handle
+
+  mock_call_expect(TO_STR(AppTimerRegister), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock->expect_arg[1].v = false;
+  pMock->compare_rule_arg[2] = COMPARE_NOT_NULL;
+  pMock->return_code.v = true; // Timer handle
+
+  CC_FirmwareUpdate_Init(NULL, NULL, false);
+
+  void (* md_get_timeout)(void) = pMock_AppTimerRegister_FrameGet->actual_arg[2].p;
+
+  /// Part 0 - Request Get
+  call_FW_update_Request_Get(pMock, FRAGMENT_SIZE, false);
+
+  uint16_t next_report_no = 1;
+  expect_md_get(FIRST_NUMBER_OF_REPORTS, next_report_no);
+
+  // callback of Request Report triggers sending of FW Update MD Get.
+  transmission_result_t pTxResult = {
+    .status = TRANSMIT_COMPLETE_OK
+  };
+  g_request_get_cb(&pTxResult);
+
+  /// Part 1 - Clean batches grow the number of reports by one, up to the report buffer size
+
+  for (uint8_t number_of_reports = FIRST_NUMBER_OF_REPORTS; number_of_reports <= MAX_NUMBER_OF_REPORTS; number_of_reports++)
+  {
+    uint8_t next_number_of_reports = (number_of_reports < MAX_NUMBER_OF_REPORTS) ? number_of_reports + 1 : MAX_NUMBER_OF_REPORTS;
+    receive_md_batch(&next_report_no, number_of_reports, FRAGMENT_SIZE, next_number_of_reports);
+  }
+
+  /// Part 2 - A batch with a retry halves the number of reports
+
+  uint16_t first_report_no = next_report_no;
+  receive_md_reports(&next_report_no, 2, FRAGMENT_SIZE);
+
+  // The retry only asks for the rest of the batch
+  expect_md_get(MAX_NUMBER_OF_REPORTS - 2, next_report_no);
+  md_get_timeout();
+
+  expect_md_get(MAX_NUMBER_OF_REPORTS / 2, next_report_no + MAX_NUMBER_OF_REPORTS - 2);
+  expect_md_reports_write_queued();
+  receive_md_reports(&next_report_no, MAX_NUMBER_OF_REPORTS - 2, FRAGMENT_SIZE);
+
+  // The write covers the reports received before and after the retry
+  expect_md_reports_written(first_report_no, MAX_NUMBER_OF_REPORTS, FRAGMENT_SIZE);
+  distribute_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS);
+
+  /// Part 3 - The number of reports does not go below 2
+
+  // A retry before any report of the batch asks for the whole batch again
+  expect_md_get(MAX_NUMBER_OF_REPORTS / 2, next_report_no);
+  md_get_timeout();
+
+  first_report_no = next_report_no;
+  expect_md_get(2, next_report_no + MAX_NUMBER_OF_REPORTS / 2);
+  expect_md_reports_write_queued();
+  receive_md_reports(&next_report_no, MAX_NUMBER_OF_REPORTS / 2, FRAGMENT_SIZE);
+
+  expect_md_reports_written(first_report_no, MAX_NUMBER_OF_REPORTS / 2, FRAGMENT_SIZE);
+  distribute_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS);
+
+  first_report_no = next_report_no;
+  receive_md_reports(&next_report_no, 1, FRAGMENT_SIZE);
+  expect_md_get(1, next_report_no);
+  md_get_timeout();
+
+  // 2 / 2 is raised to the minimum of 2
+  expect_md_get(2, next_report_no + 1);
+  expect_md_reports_write_queued();
+  receive_md_reports(&next_report_no, 1, FRAGMENT_SIZE);
+
+  expect_md_reports_written(first_report_no, 2, FRAGMENT_SIZE);
+  distribute_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS);
+
+  /// Part 4 - A batch is written before the next one if the application task is behind
+
+  first_report_no = next_report_no;
+  expect_md_get(3, next_report_no + 2);
+  expect_md_reports_write_queued();
+  receive_md_reports(&next_report_no, 2, FRAGMENT_SIZE);
+
+  // The first batch has not been written when the second batch is complete
+  uint16_t second_report_no = next_report_no;
+  expect_md_get(4, next_report_no + 3);
+  expect_md_reports_written(first_report_no, 2, FRAGMENT_SIZE);
+  expect_md_reports_write_queued();
+  receive_md_reports(&next_report_no, 3, FRAGMENT_SIZE);
+
+  expect_md_reports_written(second_report_no, 3, FRAGMENT_SIZE);
+  distribute_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS);
+
+  // The event of the first batch finds nothing left to write
+  distribute_cc_event(COMMAND_CLASS_FIRMWARE_UPDATE_MD_V5, CC_FIRMWARE_UPDATE_EVENT_WRITE_REPORTS);
+
   mock_calls_verify();
 }
-#endif // CC_FIRMWARE_UPDATE_CONFIG_OTA_MULTI_FRAME
\ No newline at end of file
+#endif // CC_FIRMWARE_UPDATE_CONFIG_OTA_MULTI_FRAME
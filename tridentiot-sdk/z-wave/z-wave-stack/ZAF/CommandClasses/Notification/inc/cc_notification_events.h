@@ -142,6 +142,7 @@ typedef enum {
   NOTIFICATION_EVENT_ACCESS_CONTROL_CREDENTIAL_LOCK_CLOSE_OPERATION = 0x23,
   NOTIFICATION_EVENT_ACCESS_CONTROL_CREDENTIAL_UNLOCK_OPEN_OPERATION = 0x24,
   NOTIFICATION_EVENT_ACCESS_CONTROL_ACCESS_DENIED_OCCUPIED_DISABLED = 0x2F,
+  NOTIFICATION_EVENT_ACCESS_CONTROL_ACCESS_DENIED_SCHEDULE_INACTIVE = 0x30,
   NOTIFICATION_EVENT_ACCESS_CONTROL_INVALID_CREDENTIAL_USED_TO_ACCESS_THE_NODE = 0x32,
   NOTIFICATION_EVENT_ACCESS_CONTROL_NON_ACCESS_USER_ENTERED = 0x33,
   NOTIFICATION_EVENT_ACCESS_CONTROL_UNKNOWN_EVENT = 0XFE
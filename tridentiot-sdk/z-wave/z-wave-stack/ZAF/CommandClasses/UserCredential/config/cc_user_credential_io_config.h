@@ -51,6 +51,27 @@
 #define U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS  20
 #endif /* !defined(U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS) */
 
+/**
+ * [SoC NVM driver] Credential Descriptor read window size <1..65535:1>
+ *
+ * Number of Credential Descriptors read from NVM at once when the table is only
+ * searched, so that lookups do not hold the whole table on the stack
+ */
+#if !defined(U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW)
+#define U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW  8
+#endif /* !defined(U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW) */
+
+/**
+ * [SoC NVM driver] Credential content index size <2..65535:1>
+ *
+ * Number of entries in the RAM index used to find duplicate Credentials by their
+ * content. Must be a power of two and at least twice the Credential Descriptor
+ * table buffer size.
+ */
+#if !defined(U3C_BUFFER_SIZE_CREDENTIAL_INDEX)
+#define U3C_BUFFER_SIZE_CREDENTIAL_INDEX  64
+#endif /* !defined(U3C_BUFFER_SIZE_CREDENTIAL_INDEX) */
+
 /**@}*/ /* \addtogroup command_class_user_credential_io_configuration */
 
 /**@}*/ /* \addtogroup configuration */
@@ -309,6 +309,22 @@ bool CC_UserCredential_manufacturer_validate_admin_pin_code(
   u3c_admin_code_metadata_t * const code
   );
 
+/**
+ * Checks whether the schedules attached to a User allow it to be granted access
+ * at this moment.
+ *
+ * Called every time a Credential is validated, so implementations should avoid
+ * slow operations such as reading from NVM. The default implementation allows
+ * access at all times.
+ *
+ * @param uuid User Unique Identifier of the User owning the Credential
+ *
+ * @return True if the User may be granted access now
+ */
+bool CC_UserCredential_manufacturer_validate_user_schedule(
+  const uint16_t uuid
+  );
+
 /**
  * Generates a default User Name value with either ASCII or UTF-16 encoding,
  * according to CC:0083.01.05.12.052
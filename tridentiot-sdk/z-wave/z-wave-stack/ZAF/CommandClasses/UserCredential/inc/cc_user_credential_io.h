@@ -45,6 +45,20 @@ void CC_UserCredential_factory_reset(void);
  */
 void CC_UserCredential_init_database(void);
 
+/**
+ * Gets the revision of the data of a User, or of the whole database.
+ *
+ * The revision changes whenever the User, its name or any of its Credentials
+ * is added, modified, moved or deleted. This lets callers cache values derived
+ * from the data, such as checksums, and know when to recalculate them.
+ *
+ * @param[in] unique_identifier Unique Identifier of the User, or 0 for the
+ *                              revision of the whole database
+ * @return The revision, or 0 if it is not tracked (e.g. the User does not
+ *         exist), in which case derived values must not be cached
+ */
+uint32_t CC_UserCredential_get_revision(uint16_t unique_identifier);
+
 /****************************************************************************/
 /*                         USER RELATED API FUNCTIONS                       */
 /****************************************************************************/
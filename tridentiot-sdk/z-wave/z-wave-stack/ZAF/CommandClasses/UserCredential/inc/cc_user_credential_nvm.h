@@ -150,6 +150,38 @@ bool u3c_nvm(
   const u3c_nvm_operation operation, const u3c_nvm_area area, uint16_t offset, void* pData,
   uint16_t size);
 
+/**
+ * @brief  Read part of an existing object handled by the User Credential
+ *         Command Class, without reading the bytes before or after it.
+ *
+ * @param area          NVM area of the object
+ * @param offset        Offset of the object within the area
+ * @param pData         Buffer to read into
+ * @param object_offset Offset within the object of the first byte to read
+ * @param size          Number of bytes to read
+ *
+ * @return true if the object exists and the part was read successfully
+ */
+bool u3c_nvm_read_part(
+  const u3c_nvm_area area, uint16_t offset, void* pData, uint16_t object_offset,
+  uint16_t size);
+
+/**
+ * @brief  Overwrite part of an existing object handled by the User Credential
+ *         Command Class, without passing the bytes before or after it.
+ *
+ * @param area          NVM area of the object
+ * @param offset        Offset of the object within the area
+ * @param pData         Data to write
+ * @param object_offset Offset within the object of the first byte to write
+ * @param size          Number of bytes to write
+ *
+ * @return true if the object exists and the part was written successfully
+ */
+bool u3c_nvm_write_part(
+  const u3c_nvm_area area, uint16_t offset, const void* pData, uint16_t object_offset,
+  uint16_t size);
+
 /**
  * @brief  Get the file ID offset of a given User Unique ID.
  *
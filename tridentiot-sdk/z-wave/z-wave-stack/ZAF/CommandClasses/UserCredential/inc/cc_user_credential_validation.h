@@ -37,6 +37,25 @@ bool find_existing_credential(
   u3c_credential_metadata_t * p_existing_metadata
   );
 
+/**
+ * Finds the User and slot of the stored Credential that is identical to a
+ * Credential entered at the node.
+ *
+ * @param[in]  p_credential             Pointer to the entered credential
+ * @param[out] p_user_unique_identifier Unique Identifier of the User the stored
+ *                                      credential belongs to
+ *                                      (valid only if true was returned)
+ * @param[out] p_credential_slot        Slot of the stored credential
+ *                                      (valid only if true was returned)
+ *
+ * @return true if an identical credential is stored
+ */
+bool find_credential_owner(
+  const u3c_credential_t * const p_credential,
+  uint16_t * p_user_unique_identifier,
+  uint16_t * p_credential_slot
+  );
+
 /**
  * Function for validating a Credential against the rules mandated by the
  * specification
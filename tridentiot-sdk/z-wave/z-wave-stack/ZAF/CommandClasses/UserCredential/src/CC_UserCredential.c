@@ -523,9 +523,12 @@ user_credential_event_handler(const uint8_t event, const void * p_data)
       const u3c_event_data_validate_t * const p_data_validate = (const u3c_event_data_validate_t * const) p_data;
       uint8_t notification_event = NOTIFICATION_EVENT_ACCESS_CONTROL_NO_EVENT;
       uint8_t event_out = CC_USER_CREDENTIAL_EVENT_VALIDATE_INVALID;
-      u3c_credential_metadata_t stored_credential = { 0 }; // Metadata of the existing credential in the database
+      u3c_credential_metadata_t stored_credential = { // Metadata of the existing credential in the database
+        .type = p_data_validate->credential->metadata.type
+      };
 
-      if (!find_existing_credential(p_data_validate->credential, &stored_credential)) {
+      if (!find_credential_owner(p_data_validate->credential, &stored_credential.uuid,
+                                 &stored_credential.slot)) {
         // The Credential does not exist in the database
         notification_event = NOTIFICATION_EVENT_ACCESS_CONTROL_INVALID_CREDENTIAL_USED_TO_ACCESS_THE_NODE;
         CC_Notification_TriggerAndTransmit(
@@ -542,6 +545,9 @@ user_credential_event_handler(const uint8_t event, const void * p_data)
           if (!current_user.active) {
             // Users with the "Occupied Disabled" state may not be granted access
             notification_event = NOTIFICATION_EVENT_ACCESS_CONTROL_ACCESS_DENIED_OCCUPIED_DISABLED;
+          } else if (!CC_UserCredential_manufacturer_validate_user_schedule(stored_credential.uuid)) {
+            // Users may only be granted access within the windows of their active schedules
+            notification_event = NOTIFICATION_EVENT_ACCESS_CONTROL_ACCESS_DENIED_SCHEDULE_INACTIVE;
           } else {
             // Grant access
             event_out = CC_USER_CREDENTIAL_EVENT_VALIDATE_VALID;
@@ -391,7 +391,8 @@ bool CC_UserCode_Validate(uint8_t identifier, const uint8_t *pCode, uint8_t len)
       .slot = identifier
     }
   };
-  u3c_credential_metadata_t existing_metadata = { 0 };
-  return find_existing_credential(&credential, &existing_metadata)
-         && (existing_metadata.slot == identifier);
+  uint16_t uuid = 0;
+  uint16_t slot = 0;
+  return find_credential_owner(&credential, &uuid, &slot)
+         && (slot == identifier);
 }
@@ -14,12 +14,86 @@
 #include "cc_user_credential_tx.h"
 #include "CRC.h" // CC:0083.01.15.11.000 & CC:0083.01.17.11.000 & CC:0083.01.19.11.001
 
+/****************************************************************************/
+/*                      PRIVATE TYPES AND DEFINITIONS                       */
+/****************************************************************************/
+
+/// Generator polynomial of the CRC-16 used by CRC_CheckCrc16(), without x^16
+#define CRC16_POLY 0x1021
+
+/**
+ * Checksum data of a single User.
+ *
+ * The CRC is calculated from 0 over the User's data (everything but its Unique
+ * Identifier) and its Credentials, so it can be combined into both the User
+ * Checksum and the All Users Checksum without reading the data again.
+ */
+typedef struct user_checksum_entry_ {
+  uint16_t uuid;
+  uint32_t revision; ///< Revision of the User's data, 0 if the entry is unused
+  uint16_t crc;
+  uint32_t length;   ///< Number of bytes covered by the CRC
+} user_checksum_entry_t;
+
+/****************************************************************************/
+/*                              PRIVATE DATA                                */
+/****************************************************************************/
+
+static user_checksum_entry_t user_checksums[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
+
+static uint32_t all_users_checksum_revision = 0;
+static uint16_t all_users_checksum = 0;
+
 /****************************************************************************/
 /*                             PRIVATE FUNCTIONS                            */
 /****************************************************************************/
 
+/**
+ * Multiplies two polynomials over GF(2) modulo the CRC generator polynomial.
+ */
+static uint16_t crc16_mulmod(uint16_t a, uint16_t b)
+{
+  uint16_t product = 0;
+  while (b) {
+    if (b & 1) {
+      product ^= a;
+    }
+    b >>= 1;
+    a = (a & 0x8000) ? (uint16_t)((a << 1) ^ CRC16_POLY) : (uint16_t)(a << 1);
+  }
+  return product;
+}
+
+/**
+ * Calculates x^(8 * length) modulo the CRC generator polynomial.
+ */
+static uint16_t crc16_shift_factor(uint32_t length)
+{
+  uint16_t factor = 1;
+  uint16_t square = 0x0100; // x^8, i.e. one byte
+  while (length) {
+    if (length & 1) {
+      factor = crc16_mulmod(factor, square);
+    }
+    length >>= 1;
+    square = crc16_mulmod(square, square);
+  }
+  return factor;
+}
+
+/**
+ * Appends a block of data to a running CRC, given the CRC of the block
+ * calculated from 0 and its length.
+ *
+ * The CRC is linear, so CRC(crc, block) = crc * x^(8 * length) + CRC(0, block).
+ */
+static uint16_t crc16_append(uint16_t crc, uint16_t block_crc, uint32_t length)
+{
+  return crc16_mulmod(crc, crc16_shift_factor(length)) ^ block_crc;
+}
+
 static void calculate_credentials_checksum_for_uuid(
-  const uint16_t uuid, uint16_t * checksum)
+  const uint16_t uuid, uint16_t * checksum, uint32_t * length)
 {
   u3c_credential_type type = CREDENTIAL_TYPE_NONE;
   uint16_t slot = 0;
@@ -56,9 +130,79 @@ static void calculate_credentials_checksum_for_uuid(
     *checksum = CRC_CheckCrc16(*checksum, &slot_lsb, 1);
     *checksum = CRC_CheckCrc16(*checksum, &existing_metadata.length, 1);
     *checksum = CRC_CheckCrc16(*checksum, e_data, existing_metadata.length);
+    *length += 4 + existing_metadata.length;
   }
 }
 
+/**
+ * Calculates the CRC of a User's data and Credentials from 0, using the cached
+ * value if the User has not changed since it was calculated.
+ *
+ * @param[in]  uuid  Unique Identifier of the User
+ * @param[out] entry Checksum data of the User
+ * @return Result of reading the User from the database
+ */
+static u3c_db_operation_result get_user_checksum_entry(
+  const uint16_t uuid, user_checksum_entry_t * entry)
+{
+  uint32_t revision = CC_UserCredential_get_revision(uuid);
+  user_checksum_entry_t * p_slot = NULL;
+
+  if (revision) {
+    for (uint16_t i = 0; i < U3C_BUFFER_SIZE_USER_DESCRIPTORS; ++i) {
+      if (user_checksums[i].revision && user_checksums[i].uuid == uuid) {
+        if (user_checksums[i].revision == revision) {
+          *entry = user_checksums[i];
+          return U3C_DB_OPERATION_RESULT_SUCCESS;
+        }
+        p_slot = &user_checksums[i];
+        break;
+      }
+    }
+  }
+
+  u3c_user_t user = { 0 };
+  uint8_t name[UINT8_MAX] = { 0 };
+  u3c_db_operation_result result = CC_UserCredential_get_user(uuid, &user, name);
+  if (result != U3C_DB_OPERATION_RESULT_SUCCESS) {
+    return result;
+  }
+
+  /**
+   * User Type (8 bits) | User Active State (8 bits) | Credential Rule (8 bits) | User Name
+   * Encoding (8 bits) | User Name Length (8 bits) | User Name (User Name Length bytes)
+   * CC:0083.01.15.11.002
+   * CC:0083.01.17.11.001
+   * CC:0083.01.17.11.002
+   */
+  entry->uuid = uuid;
+  entry->revision = revision;
+  entry->crc = 0;
+  entry->crc = CRC_CheckCrc16(entry->crc, (uint8_t*)&user.type, 1);
+  entry->crc = CRC_CheckCrc16(entry->crc, (uint8_t*)&user.active, 1);
+  entry->crc = CRC_CheckCrc16(entry->crc, (uint8_t*)&user.credential_rule, 1);
+  entry->crc = CRC_CheckCrc16(entry->crc, (uint8_t*)&user.name_encoding, 1);
+  entry->crc = CRC_CheckCrc16(entry->crc, &user.name_length, 1); // CC:0083.01.17.11.004
+  entry->crc = CRC_CheckCrc16(entry->crc, name, user.name_length);
+  entry->length = 5 + user.name_length;
+
+  calculate_credentials_checksum_for_uuid(uuid, &entry->crc, &entry->length);
+
+  if (revision) {
+    // Reuse the User's stale entry, otherwise an unused or the oldest one
+    if (!p_slot) {
+      p_slot = &user_checksums[0];
+      for (uint16_t i = 0; i < U3C_BUFFER_SIZE_USER_DESCRIPTORS; ++i) {
+        if (user_checksums[i].revision < p_slot->revision) {
+          p_slot = &user_checksums[i];
+        }
+      }
+    }
+    *p_slot = *entry;
+  }
+  return U3C_DB_OPERATION_RESULT_SUCCESS;
+}
+
 /****************************************************************************/
 /*                             PUBLIC FUNCTIONS                             */
 /****************************************************************************/
@@ -74,50 +218,50 @@ ZW_WEAK received_frame_status_t CC_UserCredential_AllUsersChecksumGet_handler(co
     return RECEIVED_FRAME_STATUS_NO_SUPPORT;
   }
 
-  u3c_user_t user = { 0 };
-  uint8_t name[UINT8_MAX] = { 0 };
-  uint8_t uuid_msb = 0;
-  uint8_t uuid_lsb = 0;
-  bool user_is_available = false;
-
-  uint16_t checksum = CRC_INITAL_VALUE; // CC:0083.01.15.11.000
-  uint16_t user_uid = CC_UserCredential_get_next_user(0);
-
-  while (user_uid) {
-    user_is_available = true;
-    if (CC_UserCredential_get_user(user_uid, &user, name) != U3C_DB_OPERATION_RESULT_SUCCESS) {
-      // Driver error or database corruption
-      return RECEIVED_FRAME_STATUS_FAIL;
-    } else {
+  uint32_t revision = CC_UserCredential_get_revision(0);
+  uint16_t checksum = all_users_checksum;
+
+  // Only walk the Users if something changed since the last calculation
+  if (!revision || revision != all_users_checksum_revision) {
+    user_checksum_entry_t entry = { 0 };
+    uint8_t uuid_msb = 0;
+    uint8_t uuid_lsb = 0;
+    bool user_is_available = false;
+
+    checksum = CRC_INITAL_VALUE; // CC:0083.01.15.11.000
+    uint16_t user_uid = CC_UserCredential_get_next_user(0);
+
+    while (user_uid) {
+      user_is_available = true;
+      if (get_user_checksum_entry(user_uid, &entry) != U3C_DB_OPERATION_RESULT_SUCCESS) {
+        // Driver error or database corruption
+        return RECEIVED_FRAME_STATUS_FAIL;
+      }
       /**
        * User Unique Identifier (16 bits) | User Type (8 bits) | User Active State (8 bits) |
        * Credential Rule (8 bits) | User Name Encoding (8 bits) | User Name Length (8 bits) |
        * User Name (User Name Length bytes)
        * CC:0083.01.15.11.001
-       * CC:0083.01.15.11.002
        */
       uuid_msb = (user_uid >> 8);
       uuid_lsb = user_uid & 0xFF;
       checksum = CRC_CheckCrc16(checksum, &uuid_msb, 1);
       checksum = CRC_CheckCrc16(checksum, &uuid_lsb, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.type, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.active, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.credential_rule, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.name_encoding, 1);
-      checksum = CRC_CheckCrc16(checksum, &user.name_length, 1);
-      checksum = CRC_CheckCrc16(checksum, name, user.name_length);
-
-      calculate_credentials_checksum_for_uuid(user_uid, &checksum);
+      checksum = crc16_append(checksum, entry.crc, entry.length);
+
+      user_uid = CC_UserCredential_get_next_user(user_uid);
     }
-    user_uid = CC_UserCredential_get_next_user(user_uid);
-  }
 
-  /**
-   * If there is no Users data (and thus no Credentials data) set at the node at all,
-   * the checksum MUST be set to 0x0000.
-   * CC:0083.01.15.11.006
-   */
-  checksum = user_is_available ? checksum : 0;
+    /**
+     * If there is no Users data (and thus no Credentials data) set at the node at all,
+     * the checksum MUST be set to 0x0000.
+     * CC:0083.01.15.11.006
+     */
+    checksum = user_is_available ? checksum : 0;
+
+    all_users_checksum = checksum;
+    all_users_checksum_revision = revision;
+  }
 
   /**
    * All Users Checksum Report command must be returned if this functionality is supported.
@@ -139,31 +283,17 @@ ZW_WEAK received_frame_status_t CC_UserCredential_UserChecksumGet_handler(const
     return RECEIVED_FRAME_STATUS_NO_SUPPORT;
   }
 
-  u3c_user_t user = { 0 };
-  uint8_t name[UINT8_MAX] = { 0 };
+  user_checksum_entry_t entry = { 0 };
 
   uint16_t uuid = (uint16_t)(input->frame->ZW_UserChecksumGetFrame.userUniqueIdentifier1 << 8
                              | input->frame->ZW_UserChecksumGetFrame.userUniqueIdentifier2);
 
   uint16_t checksum = CRC_INITAL_VALUE; // CC:0083.01.17.11.000
 
-  u3c_db_operation_result result = CC_UserCredential_get_user(uuid, &user, name);
+  u3c_db_operation_result result = get_user_checksum_entry(uuid, &entry);
 
   if (result == U3C_DB_OPERATION_RESULT_SUCCESS) {
-    /**
-     * User Type (8 bits) | User Active State (8 bits) | Credential Rule (8 bits) | User Name
-     * Encoding (8 bits) | User Name Length (8 bits) | User Name (User Name Length bytes)
-     * CC:0083.01.17.11.001
-     * CC:0083.01.17.11.002
-     */
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.type, 1);
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.active, 1);
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.credential_rule, 1);
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.name_encoding, 1);
-    checksum = CRC_CheckCrc16(checksum, &user.name_length, 1); // CC:0083.01.17.11.004
-    checksum = CRC_CheckCrc16(checksum, name, user.name_length);
-
-    calculate_credentials_checksum_for_uuid(uuid, &checksum);
+    checksum = crc16_append(checksum, entry.crc, entry.length);
   } else if (result == U3C_DB_OPERATION_RESULT_FAIL_DNE) {
     /**
      * If there is no User data (and thus no Credentials data) set at the node for a User Unique Identifier,
@@ -30,6 +30,12 @@ ZW_WEAK void CC_UserCredential_init_database(void)
 {
 }
 
+ZW_WEAK uint32_t CC_UserCredential_get_revision(
+  __attribute__((unused)) uint16_t unique_identifier)
+{
+  return 0;
+}
+
 /****************************************************************************/
 /*                        USER RELATED API FUNCTIONS                        */
 /****************************************************************************/
@@ -119,3 +119,10 @@ ZW_WEAK bool CC_UserCredential_manufacturer_validate_admin_pin_code(
                  : ADMIN_CODE_OPERATION_RESULT_FAIL_MANUF_RULE;
   return is_valid;
 }
+
+ZW_WEAK bool CC_UserCredential_manufacturer_validate_user_schedule(
+  __attribute__((unused)) const uint16_t uuid
+  )
+{
+  return true;
+}
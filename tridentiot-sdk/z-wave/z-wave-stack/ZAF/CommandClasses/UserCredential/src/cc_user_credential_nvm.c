@@ -24,12 +24,51 @@
 #include "ZAF_file_ids.h"
 #include "ZAF_nvm.h"
 #include "cc_user_credential_config_api.h"
+#include "cc_user_credential_validation.h"
+#include "zpal_entropy.h"
 #include "assert.h"
+#include "Assert.h"
 #include <string.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
 
+/****************************************************************************/
+/*                          CONSTANTS and TYPEDEFS                          */
+/****************************************************************************/
+
+#define CREDENTIAL_INDEX_MASK  (U3C_BUFFER_SIZE_CREDENTIAL_INDEX - 1)
+
+// The mask only wraps positions around the index if its size is a power of two
+STATIC_ASSERT((U3C_BUFFER_SIZE_CREDENTIAL_INDEX & CREDENTIAL_INDEX_MASK) == 0,
+              Credential_index_size_must_be_a_power_of_two);
+// Keeps the index at most half full, so that probe sequences stay short
+STATIC_ASSERT(U3C_BUFFER_SIZE_CREDENTIAL_INDEX >= (2 * U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS),
+              Credential_index_size_must_be_at_least_twice_the_number_of_Credentials);
+
+/**
+ * Entry of the Credential content index.
+ */
+typedef struct credential_index_entry_t_ {
+  uint32_t hash;                   ///< Keyed hash of the Credential type and data, 0 if the entry is free
+  uint16_t object_offset;          ///< Offset of the Credential metadata and data objects
+  uint16_t user_unique_identifier; ///< User the Credential belongs to
+  uint16_t credential_slot;
+  u3c_credential_type credential_type;
+  uint8_t credential_length;
+} credential_index_entry_t;
+
+/**
+ * Part of the Credential descriptor table read from NVM, used to search the
+ * table a few descriptors at a time.
+ */
+typedef struct credential_descriptor_window_t_ {
+  credential_descriptor_t descriptors[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW];
+  uint16_t first; ///< Index in the table of the first descriptor held
+  uint16_t count; ///< Number of descriptors held, 0 before the first read
+} credential_descriptor_window_t;
+
 /****************************************************************************/
 /*                             STATIC VARIABLES                             */
 /****************************************************************************/
@@ -68,85 +107,212 @@ static uint16_t credentials_buffer_head = 0;
  */
 static admin_pin_code_metadata_nvm_t admin_code = { 0 };
 
+/**
+ * @brief Mirror of the User descriptor table.
+ *
+ * The table is kept sorted by User Unique Identifier and is updated together
+ * with its NVM copy, so that looking up a User takes a binary search in RAM
+ * instead of a read of the whole table from NVM.
+ * It is (re)loaded from NVM whenever @ref user_descriptors_loaded is false.
+ */
+static user_descriptor_t user_descriptors[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
+static bool user_descriptors_loaded = false;
+
+/**
+ * @brief Buffer for the whole Credential descriptor table.
+ *
+ * The table is a single NVM object sized by the number of Credentials, so the
+ * functions which insert, remove or reorder descriptors have to write all of
+ * it at once. They share this buffer instead of each holding the table on the
+ * stack. Functions which only search the table read it through a
+ * @ref credential_descriptor_window_t.
+ */
+static credential_descriptor_t credential_descriptors[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
+
+/**
+ * @brief Index of the stored Credentials by their content.
+ *
+ * Open addressing hash table (with linear probing) keyed by a hash of each
+ * Credential's type and data, so that a duplicate Credential can be found
+ * without reading every stored Credential from NVM. Each entry also holds the
+ * User and slot of the Credential, so that the owner of a Credential entered
+ * at the node is known without reading its metadata.
+ * It is built from NVM on first use and kept up to date by the Credential
+ * add, modify, delete and move functions.
+ */
+static credential_index_entry_t credential_index[U3C_BUFFER_SIZE_CREDENTIAL_INDEX];
+static bool credential_index_built = false;
+
+/**
+ * @brief Key of the Credential index hash.
+ *
+ * Drawn again every time the index is rebuilt, so that the layout of the
+ * index differs from one build to the next and cannot be predicted from the
+ * Credentials alone. The key is held in RAM next to the index, so this is only
+ * obfuscation: anyone able to read the index can read the key as well, and
+ * short Credentials such as PIN codes are quickly recovered from their hash by
+ * trying every value. The index must be protected like the Credentials it
+ * refers to.
+ */
+static uint32_t credential_index_key = 0;
+
+/**
+ * @brief Revisions of the database and of each User's data.
+ *
+ * The database revision is incremented on every change. Each User's revision
+ * is set to the database revision whenever the User or one of its Credentials
+ * changes, and is indexed by the offset of the User object, which does not
+ * change for as long as the User exists.
+ */
+static uint32_t database_revision = 0;
+static uint32_t user_revisions[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
+
 /****************************************************************************/
 /*                            APPLICATION HOOKS                             */
 /****************************************************************************/
 
 static u3c_nvm_cbs_t m_cbs;
+
+/****************************************************************************/
+/*                             STATIC FUNCTIONS                             */
+/****************************************************************************/
+
+/**
+ * Makes sure the RAM mirror of the User descriptor table is in sync with NVM.
+ *
+ * @return true if the mirror can be used
+ */
+static bool load_user_descriptors(void)
+{
+  if (user_descriptors_loaded) {
+    return true;
+  }
+  memset(user_descriptors, 0, sizeof(user_descriptors));
+  if (n_users > 0
+      && !u3c_nvm(U3C_READ, AREA_USER_DESCRIPTORS, 0, user_descriptors, 0)) {
+    return false;
+  }
+  user_descriptors_loaded = true;
+  return true;
+}
+
+/**
+ * Finds a User in the (sorted) User descriptor table.
+ *
+ * @param[in]  uuid  User Unique Identifier
+ * @param[out] index Index of the User if found, otherwise the index at which
+ *                   the User would have to be inserted to keep the table sorted
+ * @return true if the User was found
+ */
+static bool find_user_descriptor(const uint16_t uuid, uint16_t * index)
+{
+  uint16_t low = 0;
+  uint16_t high = n_users;
+  while (low < high) {
+    uint16_t middle = (uint16_t)(low + ((high - low) / 2));
+    if (user_descriptors[middle].unique_identifier < uuid) {
+      low = (uint16_t)(middle + 1);
+    } else {
+      high = middle;
+    }
+  }
+  *index = low;
+  return (low < n_users) && (user_descriptors[low].unique_identifier == uuid);
+}
+
 /****************************************************************************/
 /*                               API FUNCTIONS                              */
 /****************************************************************************/
 
 /**
- * Execute an NVM read or write operation for object types handled by the User
- * Credential Command Class.
+ * Resolves the file ID base of an NVM area.
  *
- * @return true if the operation has been executed succesfully and more than 0
- *         bytes were transferred
+ * @param area           NVM area
+ * @param[in,out] offset Offset within the area, reset for single object areas
+ * @param[in,out] size   Object size, set for objects of known size
+ * @param[out] file_base File ID base of the area
+ *
+ * @return true if the area is known
  */
-bool u3c_nvm(
-  u3c_nvm_operation operation, u3c_nvm_area area, uint16_t offset, void* pData,
-  uint16_t size)
+static bool get_area_file(
+  u3c_nvm_area area, uint16_t * offset, uint16_t * size, zpal_nvm_object_key_t * file_base)
 {
   // Set parameters depending on the NVM area
-  zpal_nvm_object_key_t file_base;
   switch (area) {
     /**********************/
     /* Known size objects */
     /**********************/
     case AREA_NUMBER_OF_USERS:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_NUMBER_OF_USERS;
-      size = sizeof(uint16_t);
-      offset = 0;
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_NUMBER_OF_USERS;
+      *size = sizeof(uint16_t);
+      *offset = 0;
       break;
 
     case AREA_NUMBER_OF_CREDENTIALS:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_NUMBER_OF_CREDENTIALS;
-      size = sizeof(uint16_t);
-      offset = 0;
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_NUMBER_OF_CREDENTIALS;
+      *size = sizeof(uint16_t);
+      *offset = 0;
       break;
 
     case AREA_USER_DESCRIPTORS:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_USER_DESCRIPTOR_TABLE;
-      size = sizeof(user_descriptor_t) * n_users;
-      offset = 0;
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_USER_DESCRIPTOR_TABLE;
+      *size = sizeof(user_descriptor_t) * n_users;
+      *offset = 0;
       break;
 
     case AREA_CREDENTIAL_DESCRIPTORS:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DESCRIPTOR_TABLE;
-      size = sizeof(credential_descriptor_t) * n_credentials;
-      offset = 0;
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DESCRIPTOR_TABLE;
+      *size = sizeof(credential_descriptor_t) * n_credentials;
+      *offset = 0;
       break;
 
     case AREA_USERS:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_USER_BASE;
-      size = sizeof(u3c_user_t);
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_USER_BASE;
+      *size = sizeof(u3c_user_t);
       break;
 
     case AREA_CREDENTIAL_METADATA:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_BASE;
-      size = sizeof(credential_metadata_nvm_t);
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_BASE;
+      *size = sizeof(credential_metadata_nvm_t);
       break;
 
     case AREA_ADMIN_PIN_CODE_DATA:
-      file_base = ZAF_FILE_ID_ADMIN_PIN_CODE;
-      size = sizeof(admin_pin_code_metadata_nvm_t);
+      *file_base = ZAF_FILE_ID_ADMIN_PIN_CODE;
+      *size = sizeof(admin_pin_code_metadata_nvm_t);
       break;
 
     /************************/
     /* Dynamic size objects */
     /************************/
     case AREA_CREDENTIAL_DATA:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DATA_BASE;
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DATA_BASE;
       break;
 
     case AREA_USER_NAMES:
-      file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_USER_NAME_BASE;
+      *file_base = ZAF_FILE_ID_CC_USER_CREDENTIAL_USER_NAME_BASE;
       break;
 
     default:
       return false;
   }
+  return true;
+}
+
+/**
+ * Execute an NVM read or write operation for object types handled by the User
+ * Credential Command Class.
+ *
+ * @return true if the operation has been executed succesfully and more than 0
+ *         bytes were transferred
+ */
+bool u3c_nvm(
+  u3c_nvm_operation operation, u3c_nvm_area area, uint16_t offset, void* pData,
+  uint16_t size)
+{
+  zpal_nvm_object_key_t file_base;
+  if (!get_area_file(area, &offset, &size, &file_base)) {
+    return false;
+  }
 
   if (size == 0) {
     return true;
@@ -166,27 +332,56 @@ bool u3c_nvm(
   return nvm_result == ZPAL_STATUS_OK;
 }
 
-bool u3c_nvm_get_user_offset_from_id(const uint16_t uuid, uint16_t * offset)
+bool u3c_nvm_read_part(
+  const u3c_nvm_area area, uint16_t offset, void* pData, uint16_t object_offset,
+  uint16_t size)
 {
-  // Read the User descriptor table from NVM
-  user_descriptor_t users[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
-  memset(users, 0, sizeof(users));
-  bool result = false;
-  if (!u3c_nvm(U3C_READ, AREA_USER_DESCRIPTORS, 0, &users, 0)) {
+  zpal_nvm_object_key_t file_base;
+  uint16_t object_size = 0;
+  if (!get_area_file(area, &offset, &object_size, &file_base)) {
     return false;
   }
-  uint16_t page = 0;
-  for (uint16_t i = 0; i < n_users; ++i) {
-    if (users[i].unique_identifier == uuid) {
-      // User found
-      page = users[i].object_offset;
-      result = true;
-    }
+  // The part must lie within objects of known size
+  if ((object_size != 0) && ((uint32_t)object_offset + size > object_size)) {
+    return false;
   }
-  if (result && offset) {
-    *offset = page;
+  if (size == 0) {
+    return true;
   }
-  return result;
+  return ZAF_nvm_read_object_part(file_base + offset, pData, (size_t)object_offset, (size_t)size)
+         == ZPAL_STATUS_OK;
+}
+
+bool u3c_nvm_write_part(
+  const u3c_nvm_area area, uint16_t offset, const void* pData, uint16_t object_offset,
+  uint16_t size)
+{
+  zpal_nvm_object_key_t file_base;
+  uint16_t object_size = 0;
+  if (!get_area_file(area, &offset, &object_size, &file_base)) {
+    return false;
+  }
+  // The part must lie within objects of known size
+  if ((object_size != 0) && ((uint32_t)object_offset + size > object_size)) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+  return ZAF_nvm_write_object_part(file_base + offset, pData, (size_t)object_offset, (size_t)size)
+         == ZPAL_STATUS_OK;
+}
+
+bool u3c_nvm_get_user_offset_from_id(const uint16_t uuid, uint16_t * offset)
+{
+  uint16_t index;
+  if (!load_user_descriptors() || !find_user_descriptor(uuid, &index)) {
+    return false;
+  }
+  if (offset) {
+    *offset = user_descriptors[index].object_offset;
+  }
+  return true;
 }
 
 uint16_t u3c_nvm_get_num_users(void)
@@ -260,24 +455,20 @@ bool convert_credential_metadata_from_nvm(
   return true;
 }
 
-static void ordered_insert_user_descriptor(user_descriptor_t * users, u3c_user_t * user, uint16_t offset)
+static void ordered_insert_user_descriptor(u3c_user_t * user, uint16_t offset)
 {
-  uint16_t insert_index = n_users;
+  uint16_t insert_index;
 
   // Find the correct position to insert the new user
-  for (uint16_t i = 0; i < n_users; ++i) {
-    if (users[i].unique_identifier > user->unique_identifier) {
-      insert_index = i;
-      break;
-    }
-  }
+  find_user_descriptor(user->unique_identifier, &insert_index);
 
   // Shift the elements to make room for the new user
-  memmove(&users[insert_index + 1], &users[insert_index], (n_users - insert_index) * sizeof(user_descriptor_t));
+  memmove(&user_descriptors[insert_index + 1], &user_descriptors[insert_index],
+          (n_users - insert_index) * sizeof(user_descriptor_t));
 
   // Insert the new user at the correct position
-  users[insert_index].object_offset = offset;
-  users[insert_index].unique_identifier = user->unique_identifier;
+  user_descriptors[insert_index].object_offset = offset;
+  user_descriptors[insert_index].unique_identifier = user->unique_identifier;
 
   // Increment the number of users
   ++n_users;
@@ -311,6 +502,34 @@ static uint16_t get_credential_descriptor_index(
   return index;
 }
 
+/**
+ * Gets a Credential descriptor through a window of the descriptor table. The
+ * window is moved to start at the requested descriptor if it does not hold it.
+ *
+ * @param[in,out] window Window of the table
+ * @param[in]     index  Index of the descriptor, less than the number of Credentials
+ * @return The descriptor, or NULL if it could not be read from NVM
+ */
+static const credential_descriptor_t * get_credential_descriptor(
+  credential_descriptor_window_t * window, uint16_t index)
+{
+  if ((index < window->first) || (index >= window->first + window->count)) {
+    uint16_t count = (uint16_t)(n_credentials - index);
+    if (count > U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW) {
+      count = U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW;
+    }
+    if (!u3c_nvm_read_part(AREA_CREDENTIAL_DESCRIPTORS, 0, window->descriptors,
+                           (uint16_t)(index * sizeof(credential_descriptor_t)),
+                           (uint16_t)(count * sizeof(credential_descriptor_t)))) {
+      window->count = 0;
+      return NULL;
+    }
+    window->first = index;
+    window->count = count;
+  }
+  return &window->descriptors[index - window->first];
+}
+
 /**
  * Inserts a Credential descriptor into the Credential Descriptor table,
  * preserving:
@@ -338,6 +557,12 @@ void init_database_variables(void)
 {
   users_buffer_head = 0;
   credentials_buffer_head = 0;
+
+  // Anything derived from the previous contents is now out of date
+  ++database_revision;
+  for (uint16_t i = 0; i < U3C_BUFFER_SIZE_USER_DESCRIPTORS; ++i) {
+    user_revisions[i] = database_revision;
+  }
   max_users = cc_user_credential_get_max_user_unique_identifiers();
   max_credentials = MAX_CREDENTIAL_OBJECTS;
 
@@ -426,6 +651,224 @@ bool is_credential_identical(
     );
 }
 
+/**
+ * Records a change to the data of a User.
+ */
+static void touch_user(const uint16_t uuid)
+{
+  uint16_t offset;
+  ++database_revision;
+  if (u3c_nvm_get_user_offset_from_id(uuid, &offset)
+      && offset < U3C_BUFFER_SIZE_USER_DESCRIPTORS) {
+    user_revisions[offset] = database_revision;
+  }
+}
+
+/****************************************************************************/
+/*                         CREDENTIAL CONTENT INDEX                         */
+/****************************************************************************/
+
+/**
+ * Calculates the index hash of a Credential's type and data: a 32-bit FNV-1a
+ * hash of the index key, type and data, with a final avalanche step so that
+ * the low bits used for the table position depend on every input byte.
+ */
+static uint32_t credential_index_hash(
+  u3c_credential_type type, const uint8_t * p_data, uint8_t length)
+{
+  uint32_t hash = 2166136261UL;
+  for (uint8_t i = 0; i < sizeof(credential_index_key); ++i) {
+    hash = (hash ^ (uint8_t)(credential_index_key >> (8 * i))) * 16777619UL;
+  }
+  hash = (hash ^ (uint8_t)type) * 16777619UL;
+  for (uint8_t i = 0; i < length; ++i) {
+    hash = (hash ^ p_data[i]) * 16777619UL;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6BUL;
+  hash ^= hash >> 13;
+  // 0 marks a free entry
+  return hash ? hash : 1;
+}
+
+/**
+ * Empties the Credential index and draws a new key for it.
+ */
+static void reset_credential_index(void)
+{
+  memset(credential_index, 0, sizeof(credential_index));
+  credential_index_key = 0;
+  for (uint8_t i = 0; i < sizeof(credential_index_key); ++i) {
+    credential_index_key = (credential_index_key << 8) | zpal_get_pseudo_random();
+  }
+}
+
+/**
+ * Returns the position of a Credential in the index, or
+ * U3C_BUFFER_SIZE_CREDENTIAL_INDEX if it is not indexed.
+ */
+static uint16_t credential_index_find_object(uint16_t object_offset)
+{
+  for (uint16_t i = 0; i < U3C_BUFFER_SIZE_CREDENTIAL_INDEX; ++i) {
+    if (credential_index[i].hash && credential_index[i].object_offset == object_offset) {
+      return i;
+    }
+  }
+  return U3C_BUFFER_SIZE_CREDENTIAL_INDEX;
+}
+
+/**
+ * Adds a Credential to the index.
+ *
+ * @return false if the index is full
+ */
+static bool credential_index_insert(
+  const u3c_credential_t * const p_credential, uint16_t user_unique_identifier,
+  uint16_t object_offset)
+{
+  uint32_t hash = credential_index_hash(
+    p_credential->metadata.type, p_credential->data, p_credential->metadata.length);
+
+  // The index is twice as large as the database, but never probe past a full table
+  uint16_t i = (uint16_t)(hash & CREDENTIAL_INDEX_MASK);
+  uint16_t probes = 0;
+  while (credential_index[i].hash) {
+    if (++probes == U3C_BUFFER_SIZE_CREDENTIAL_INDEX) {
+      return false;
+    }
+    i = (uint16_t)((i + 1) & CREDENTIAL_INDEX_MASK);
+  }
+  credential_index[i].hash = hash;
+  credential_index[i].object_offset = object_offset;
+  credential_index[i].user_unique_identifier = user_unique_identifier;
+  credential_index[i].credential_slot = p_credential->metadata.slot;
+  credential_index[i].credential_type = p_credential->metadata.type;
+  credential_index[i].credential_length = p_credential->metadata.length;
+  return true;
+}
+
+static void credential_index_remove(uint16_t object_offset)
+{
+  uint16_t free_index = credential_index_find_object(object_offset);
+  if (free_index == U3C_BUFFER_SIZE_CREDENTIAL_INDEX) {
+    return;
+  }
+  credential_index[free_index].hash = 0;
+
+  /**
+   * Shift back the following entries of the probe sequence that would
+   * otherwise become unreachable through the freed entry.
+   */
+  uint16_t i = free_index;
+  for (uint16_t probes = 1; probes < U3C_BUFFER_SIZE_CREDENTIAL_INDEX; ++probes) {
+    i = (uint16_t)((i + 1) & CREDENTIAL_INDEX_MASK);
+    if (!credential_index[i].hash) {
+      return;
+    }
+    uint16_t home = (uint16_t)(credential_index[i].hash & CREDENTIAL_INDEX_MASK);
+    // Distance from each entry's home position, going around the table
+    uint16_t distance_to_free = (uint16_t)((free_index - home) & CREDENTIAL_INDEX_MASK);
+    uint16_t distance_to_entry = (uint16_t)((i - home) & CREDENTIAL_INDEX_MASK);
+    if (distance_to_free < distance_to_entry) {
+      credential_index[free_index] = credential_index[i];
+      credential_index[i].hash = 0;
+      free_index = i;
+    }
+  }
+}
+
+/**
+ * Updates the User and slot of a moved Credential. Its data is unchanged, so
+ * it stays at the same index position.
+ */
+static void credential_index_set_owner(
+  uint16_t object_offset, uint16_t user_unique_identifier, uint16_t credential_slot)
+{
+  uint16_t i = credential_index_find_object(object_offset);
+  if (i < U3C_BUFFER_SIZE_CREDENTIAL_INDEX) {
+    credential_index[i].user_unique_identifier = user_unique_identifier;
+    credential_index[i].credential_slot = credential_slot;
+  }
+}
+
+/**
+ * Makes sure the Credential content index has been built from NVM.
+ *
+ * @return true if the index can be used
+ */
+static bool build_credential_index(void)
+{
+  if (credential_index_built) {
+    return true;
+  }
+  reset_credential_index();
+  credential_descriptor_window_t window = { 0 };
+  for (uint16_t i = 0; i < n_credentials; ++i) {
+    const credential_descriptor_t * p_descriptor = get_credential_descriptor(&window, i);
+    credential_metadata_nvm_t metadata = { 0 };
+    uint8_t data[U3C_BUFFER_SIZE_CREDENTIAL_DATA] = { 0 };
+    if (!p_descriptor
+        || !u3c_nvm(U3C_READ, AREA_CREDENTIAL_METADATA, p_descriptor->object_offset,
+                    &metadata, 0)
+        || !u3c_nvm(U3C_READ, AREA_CREDENTIAL_DATA, p_descriptor->object_offset,
+                    data, metadata.length)
+        ) {
+      return false;
+    }
+    u3c_credential_t credential = {
+      .metadata = {
+        .slot = p_descriptor->credential_slot,
+        .type = p_descriptor->credential_type,
+        .length = metadata.length,
+      },
+      .data = data
+    };
+    if (!credential_index_insert(&credential, p_descriptor->user_unique_identifier,
+                                 p_descriptor->object_offset)) {
+      return false;
+    }
+  }
+  credential_index_built = true;
+  return true;
+}
+
+/**
+ * Finds a Credential in the index by its type and data. Only the data of
+ * Credentials whose hash and length match is read back from NVM to confirm.
+ *
+ * @return Position of the Credential in the index, or
+ *         U3C_BUFFER_SIZE_CREDENTIAL_INDEX if it is not stored.
+ */
+static uint16_t credential_index_lookup(const u3c_credential_t * const p_credential)
+{
+  if (!build_credential_index()) {
+    return U3C_BUFFER_SIZE_CREDENTIAL_INDEX;
+  }
+
+  uint32_t hash = credential_index_hash(
+    p_credential->metadata.type, p_credential->data, p_credential->metadata.length);
+
+  uint16_t i = (uint16_t)(hash & CREDENTIAL_INDEX_MASK);
+  for (uint16_t probes = 0;
+       probes < U3C_BUFFER_SIZE_CREDENTIAL_INDEX && credential_index[i].hash;
+       ++probes, i = (uint16_t)((i + 1) & CREDENTIAL_INDEX_MASK)) {
+    if (credential_index[i].hash != hash
+        || credential_index[i].credential_type != p_credential->metadata.type
+        || credential_index[i].credential_length != p_credential->metadata.length) {
+      continue;
+    }
+
+    uint8_t data[U3C_BUFFER_SIZE_CREDENTIAL_DATA] = { 0 };
+    if (u3c_nvm(U3C_READ, AREA_CREDENTIAL_DATA, credential_index[i].object_offset,
+                data, credential_index[i].credential_length)
+        && memcmp(data, p_credential->data, credential_index[i].credential_length) == 0
+        ) {
+      return i;
+    }
+  }
+  return U3C_BUFFER_SIZE_CREDENTIAL_INDEX;
+}
+
 /****************************************************************************/
 /*                           GENERAL API FUNCTIONS                          */
 /****************************************************************************/
@@ -445,6 +888,11 @@ void CC_UserCredential_factory_reset(void)
   u3c_nvm(U3C_WRITE, AREA_NUMBER_OF_CREDENTIALS, 0, &n_credentials, 0);
   // Initialize admin code area
   u3c_nvm(U3C_WRITE, AREA_ADMIN_PIN_CODE_DATA, 0, &ac, 0);
+  // The User descriptor table and Credential index are now empty
+  memset(user_descriptors, 0, sizeof(user_descriptors));
+  user_descriptors_loaded = true;
+  reset_credential_index();
+  credential_index_built = true;
   init_database_variables();
 }
 
@@ -460,9 +908,26 @@ void CC_UserCredential_init_database(void)
     CC_UserCredential_factory_reset();
   } else {
     init_database_variables();
+    user_descriptors_loaded = false;
+    load_user_descriptors();
+    // The Credential index is only built when it is first needed
+    credential_index_built = false;
   }
 }
 
+uint32_t CC_UserCredential_get_revision(uint16_t unique_identifier)
+{
+  uint16_t offset;
+  if (unique_identifier == 0) {
+    return database_revision;
+  }
+  if (!u3c_nvm_get_user_offset_from_id(unique_identifier, &offset)
+      || offset >= U3C_BUFFER_SIZE_USER_DESCRIPTORS) {
+    return 0;
+  }
+  return user_revisions[offset];
+}
+
 /****************************************************************************/
 /*                        USER RELATED API FUNCTIONS                        */
 /****************************************************************************/
@@ -478,40 +943,33 @@ u3c_db_operation_result CC_UserCredential_get_user(
   // Name can only be requested if user is requested too.
   assert(user || !name);
 
-  // Read the User descriptor table from NVM
-  user_descriptor_t users[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
-  memset(users, 0, sizeof(users));
-
-  if (!u3c_nvm(U3C_READ, AREA_USER_DESCRIPTORS, 0, &users, 0)) {
+  if (!load_user_descriptors()) {
     return U3C_DB_OPERATION_RESULT_ERROR_IO;
   }
 
   // Find User
-  for (uint16_t i = 0; i < n_users; ++i) {
-    if (users[i].unique_identifier == unique_identifier) {
-      // User found
-
-      // Copy User object from NVM if requested
-      if (user) {
-        if (!u3c_nvm(U3C_READ, AREA_USERS, users[i].object_offset, user, 0)) {
-          return U3C_DB_OPERATION_RESULT_ERROR_IO;
-        }
-      }
+  uint16_t i;
+  if (!find_user_descriptor(unique_identifier, &i)) {
+    // User not found
+    return U3C_DB_OPERATION_RESULT_FAIL_DNE;
+  }
 
-      // Copy User name from NVM if requested
-      if (name) {
-        if (!u3c_nvm(U3C_READ, AREA_USER_NAMES, users[i].object_offset, name,
-                 user->name_length)) {
-          return U3C_DB_OPERATION_RESULT_ERROR_IO;
-        }
-      }
+  // Copy User object from NVM if requested
+  if (user) {
+    if (!u3c_nvm(U3C_READ, AREA_USERS, user_descriptors[i].object_offset, user, 0)) {
+      return U3C_DB_OPERATION_RESULT_ERROR_IO;
+    }
+  }
 
-      return U3C_DB_OPERATION_RESULT_SUCCESS;
+  // Copy User name from NVM if requested
+  if (name) {
+    if (!u3c_nvm(U3C_READ, AREA_USER_NAMES, user_descriptors[i].object_offset, name,
+             user->name_length)) {
+      return U3C_DB_OPERATION_RESULT_ERROR_IO;
     }
   }
 
-  // User not found
-  return U3C_DB_OPERATION_RESULT_FAIL_DNE;
+  return U3C_DB_OPERATION_RESULT_SUCCESS;
 }
 
 uint16_t CC_UserCredential_get_next_user(uint16_t unique_identifier)
@@ -521,25 +979,19 @@ uint16_t CC_UserCredential_get_next_user(uint16_t unique_identifier)
     return 0;
   }
 
-  // Read the User descriptor table from NVM
-  user_descriptor_t users[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
-  memset(users, 0, sizeof(users));
-
-  if (!u3c_nvm(U3C_READ, AREA_USER_DESCRIPTORS, 0, &users, 0)) {
+  if (!load_user_descriptors()) {
     return 0;
   }
 
   uint16_t result = 0;
   if (unique_identifier == 0) {
     // Find the first User
-    return users[0].unique_identifier;
+    return user_descriptors[0].unique_identifier;
   } else {
     // Find the next User
-    for (uint16_t i = 0; i < n_users - 1; ++i) {
-      if (users[i].unique_identifier == unique_identifier) {
-        result = users[i + 1].unique_identifier;
-        break;
-      }
+    uint16_t i;
+    if (find_user_descriptor(unique_identifier, &i) && (i + 1 < n_users)) {
+      result = user_descriptors[i + 1].unique_identifier;
     }
   }
 
@@ -554,14 +1006,21 @@ u3c_db_operation_result CC_UserCredential_add_user(
     return U3C_DB_OPERATION_RESULT_FAIL_FULL;
   }
 
-  // Read the User descriptor table from NVM if it is not empty
-  user_descriptor_t users[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
-  memset(users, 0, sizeof(users));
-
-  if (n_users > 0 && !u3c_nvm(U3C_READ, AREA_USER_DESCRIPTORS, 0, &users, 0)) {
+  if (!load_user_descriptors()) {
     return U3C_DB_OPERATION_RESULT_ERROR_IO;
   }
 
+  // Check if the user already exists
+  uint16_t existing_index;
+  if (find_user_descriptor(user->unique_identifier, &existing_index)) {
+    // Check whether the incoming user is identical to the stored one
+    if (is_user_identical(user, name, user_descriptors[existing_index].object_offset)) {
+      return U3C_DB_OPERATION_RESULT_FAIL_IDENTICAL;
+    } else {
+      return U3C_DB_OPERATION_RESULT_FAIL_OCCUPIED;
+    }
+  }
+
   // Find next empty object
   bool available = false;
   uint16_t object_offset = 0;
@@ -573,18 +1032,8 @@ u3c_db_operation_result CC_UserCredential_add_user(
 
     // Loop through the descriptor table
     for (uint16_t i = 0; i < n_users; ++i) {
-      // Check if the user already exists
-      if (users[i].unique_identifier == user->unique_identifier) {
-        // Check whether the incoming user is identical to the stored one
-        if (is_user_identical(user, name, object_offset)) {
-          return U3C_DB_OPERATION_RESULT_FAIL_IDENTICAL;
-        } else {
-          return U3C_DB_OPERATION_RESULT_FAIL_OCCUPIED;
-        }
-      }
-
       // Check if the object is not assigned to any User
-      if (users[i].object_offset == object_offset) {
+      if (user_descriptors[i].object_offset == object_offset) {
         users_buffer_head = (uint16_t)((users_buffer_head + 1) % max_users);
         available = false;
         break; // Try the next object
@@ -605,16 +1054,19 @@ u3c_db_operation_result CC_UserCredential_add_user(
       }
 
       // Update the descriptor table
-      ordered_insert_user_descriptor(users, user, object_offset);
+      ordered_insert_user_descriptor(user, object_offset);
 
       // Update the descriptor table and number of Users in NVM
       if (
-        u3c_nvm(U3C_WRITE, AREA_USER_DESCRIPTORS, 0, users, 0)
+        u3c_nvm(U3C_WRITE, AREA_USER_DESCRIPTORS, 0, user_descriptors, 0)
         && u3c_nvm(U3C_WRITE, AREA_NUMBER_OF_USERS, 0, &n_users, 0)
         ) {
+        touch_user(user->unique_identifier);
         return U3C_DB_OPERATION_RESULT_SUCCESS;
       } else {
         --n_users;
+        // Resynchronize the mirror with whatever made it to NVM
+        user_descriptors_loaded = false;
         return U3C_DB_OPERATION_RESULT_ERROR_IO;
       }
     }
@@ -632,41 +1084,36 @@ u3c_db_operation_result CC_UserCredential_modify_user(
     return U3C_DB_OPERATION_RESULT_FAIL_DNE;
   }
 
-  // Read the User descriptor table from NVM
-  user_descriptor_t users[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
-  memset(users, 0, sizeof(users));
-
-  if (!u3c_nvm(U3C_READ, AREA_USER_DESCRIPTORS, 0, &users, 0)) {
+  if (!load_user_descriptors()) {
     return U3C_DB_OPERATION_RESULT_ERROR_IO;
   }
 
   // Find User
-  for (uint16_t i = 0; i < n_users; ++i) {
-    if (users[i].unique_identifier == user->unique_identifier) {
-      uint16_t object_offset = users[i].object_offset;
-
-      // Check whether the incoming user is identical to the stored one
-      if (is_user_identical(user, name, object_offset)) {
-        return U3C_DB_OPERATION_RESULT_FAIL_IDENTICAL;
-      }
+  uint16_t i;
+  if (!find_user_descriptor(user->unique_identifier, &i)) {
+    // User not found
+    return U3C_DB_OPERATION_RESULT_FAIL_DNE;
+  }
+  uint16_t object_offset = user_descriptors[i].object_offset;
 
-      bool write_successful = true;
-      // Overwrite User object in NVM
-      write_successful &= u3c_nvm(U3C_WRITE, AREA_USERS, object_offset, user, 0);
-      if (write_successful && name) {
-        // Overwrite User name in NVM
-        write_successful &= u3c_nvm(U3C_WRITE, AREA_USER_NAMES, object_offset, name,
-                                user->name_length);
-      }
+  // Check whether the incoming user is identical to the stored one
+  if (is_user_identical(user, name, object_offset)) {
+    return U3C_DB_OPERATION_RESULT_FAIL_IDENTICAL;
+  }
 
-      return write_successful
-             ? U3C_DB_OPERATION_RESULT_SUCCESS
-             : U3C_DB_OPERATION_RESULT_ERROR_IO;
-    }
+  bool write_successful = true;
+  // Overwrite User object in NVM
+  write_successful &= u3c_nvm(U3C_WRITE, AREA_USERS, object_offset, user, 0);
+  if (write_successful && name) {
+    // Overwrite User name in NVM
+    write_successful &= u3c_nvm(U3C_WRITE, AREA_USER_NAMES, object_offset, name,
+                            user->name_length);
   }
+  touch_user(user->unique_identifier);
 
-  // User not found
-  return U3C_DB_OPERATION_RESULT_FAIL_DNE;
+  return write_successful
+         ? U3C_DB_OPERATION_RESULT_SUCCESS
+         : U3C_DB_OPERATION_RESULT_ERROR_IO;
 }
 
 u3c_db_operation_result CC_UserCredential_delete_user(
@@ -677,51 +1124,49 @@ u3c_db_operation_result CC_UserCredential_delete_user(
     return U3C_DB_OPERATION_RESULT_FAIL_DNE;
   }
 
-  // Read the User descriptor table from NVM
-  user_descriptor_t users[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
-  memset(users, 0, sizeof(users));
-
-  if (!u3c_nvm(U3C_READ, AREA_USER_DESCRIPTORS, 0, &users, 0)) {
+  if (!load_user_descriptors()) {
     return U3C_DB_OPERATION_RESULT_ERROR_IO;
   }
 
   // Find User
-  for (uint16_t i = 0; i < n_users; ++i) {
-    if (users[i].unique_identifier == user_unique_identifier) {
-      --n_users;
+  uint16_t i;
+  if (!find_user_descriptor(user_unique_identifier, &i)) {
+    // User not found
+    return U3C_DB_OPERATION_RESULT_FAIL_DNE;
+  }
 
-      // If the deleted User was not the last in the list
-      if (i < n_users) {
-        // Shift the elements to fill the gap
-        memmove(&users[i], &users[i + 1], (n_users - i) * sizeof(user_descriptor_t));
-      }
-      // Otherwise, simply consider its entry 'popped' from the array and kick user 
-      // changed information up to application level if the application has registered a callback for it
-      if (NULL != m_cbs.user_changed) {
-        m_cbs.user_changed(user_unique_identifier, U3C_OPERATION_TYPE_DELETE);
-      }
-      // Update the descriptor table in NVM
-      if (!u3c_nvm(U3C_WRITE, AREA_USER_DESCRIPTORS, 0, &users, 0)) {
-        ++n_users;
-        return U3C_DB_OPERATION_RESULT_ERROR_IO;
-      }
+  touch_user(user_unique_identifier);
+  --n_users;
 
-      // Update the number of Users in NVM
-      if (!u3c_nvm(U3C_WRITE, AREA_NUMBER_OF_USERS, 0, &n_users, 0)) {
-        return U3C_DB_OPERATION_RESULT_ERROR_IO;
-      }
+  // If the deleted User was not the last in the list
+  if (i < n_users) {
+    // Shift the elements to fill the gap
+    memmove(&user_descriptors[i], &user_descriptors[i + 1], (n_users - i) * sizeof(user_descriptor_t));
+  }
+  // Otherwise, simply consider its entry 'popped' from the array and kick user
+  // changed information up to application level if the application has registered a callback for it
+  if (NULL != m_cbs.user_changed) {
+    m_cbs.user_changed(user_unique_identifier, U3C_OPERATION_TYPE_DELETE);
+  }
+  // Update the descriptor table in NVM
+  if (!u3c_nvm(U3C_WRITE, AREA_USER_DESCRIPTORS, 0, user_descriptors, 0)) {
+    ++n_users;
+    // The User is still stored in NVM, reload it into the mirror
+    user_descriptors_loaded = false;
+    return U3C_DB_OPERATION_RESULT_ERROR_IO;
+  }
 
-      // Make sure the buffer's head is pointing at a valid object
-      if (users_buffer_head >= n_users) {
-        users_buffer_head = 0;
-      }
+  // Update the number of Users in NVM
+  if (!u3c_nvm(U3C_WRITE, AREA_NUMBER_OF_USERS, 0, &n_users, 0)) {
+    return U3C_DB_OPERATION_RESULT_ERROR_IO;
+  }
 
-      return U3C_DB_OPERATION_RESULT_SUCCESS;
-    }
+  // Make sure the buffer's head is pointing at a valid object
+  if (users_buffer_head >= n_users) {
+    users_buffer_head = 0;
   }
 
-  // User not found
-  return U3C_DB_OPERATION_RESULT_FAIL_DNE;
+  return U3C_DB_OPERATION_RESULT_SUCCESS;
 }
 
 /****************************************************************************/
@@ -738,24 +1183,23 @@ u3c_db_operation_result CC_UserCredential_get_credential(
     return U3C_DB_OPERATION_RESULT_FAIL_DNE;
   }
 
-  // Read the Credential descriptor table from NVM
-  credential_descriptor_t credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
-  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)) {
-    return U3C_DB_OPERATION_RESULT_ERROR_IO;
-  }
-
   bool match_any_user = (user_unique_identifier == 0);
 
-  // Find Credential
+  // Find Credential, reading the descriptor table from NVM a window at a time
+  credential_descriptor_window_t window = { 0 };
   for (uint16_t i = 0; i < n_credentials; ++i) {
+    const credential_descriptor_t * p_descriptor = get_credential_descriptor(&window, i);
+    if (!p_descriptor) {
+      return U3C_DB_OPERATION_RESULT_ERROR_IO;
+    }
     if ((match_any_user
-         || credentials[i].user_unique_identifier == user_unique_identifier)
-        && credentials[i].credential_type == credential_type
-        && credentials[i].credential_slot == credential_slot
+         || p_descriptor->user_unique_identifier == user_unique_identifier)
+        && p_descriptor->credential_type == credential_type
+        && p_descriptor->credential_slot == credential_slot
         ) {
       credential_metadata_nvm_t metadata = { 0 };
 
-      if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_METADATA, credentials[i].object_offset,
+      if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_METADATA, p_descriptor->object_offset,
                &metadata, 0)) {
         return U3C_DB_OPERATION_RESULT_ERROR_IO;
       }
@@ -772,7 +1216,7 @@ u3c_db_operation_result CC_UserCredential_get_credential(
 
       // Copy Credential data from NVM if requested
       if (p_credential_data) {
-        if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DATA, credentials[i].object_offset,
+        if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DATA, p_descriptor->object_offset,
                  p_credential_data, metadata.length)) {
           return U3C_DB_OPERATION_RESULT_ERROR_IO;
         }
@@ -795,65 +1239,48 @@ bool CC_UserCredential_get_next_credential(
     return false;
   }
 
-  // Read the Credential descriptor table from NVM
-  credential_descriptor_t credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
-  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)) {
-    return false;
-  }
-
   bool match_any_user = (user_unique_identifier == 0);
   bool match_any_type = (credential_type == CREDENTIAL_TYPE_NONE);
 
-  bool was_next_found = false;
-  uint16_t next_index = 0;
+  if ((credential_slot != 0) && match_any_type) {
+    // A credential type must be provided for a non-zero slot number.
+    return false;
+  }
 
-  if (credential_slot == 0) {
-    // Find the first Credential
-    for (uint16_t i = 0; i < n_credentials; ++i) {
-      if (
-        (match_any_user
-         || credentials[i].user_unique_identifier == user_unique_identifier)
-        && (match_any_type || credentials[i].credential_type == credential_type)
-        ) {
-        was_next_found = true;
-        next_index = i;
-        break;
-      }
-    }
-  } else {
-    if (match_any_type) {
-      // A credential type must be provided for a non-zero slot number.
+  // Read the descriptor table from NVM a window at a time
+  credential_descriptor_window_t window = { 0 };
+  for (uint16_t i = 0; i < n_credentials; ++i) {
+    const credential_descriptor_t * p_descriptor = get_credential_descriptor(&window, i);
+    if (!p_descriptor) {
       return false;
     }
-    for (uint16_t i = 0; i < n_credentials; ++i) {
-      // Discard credentials associated to a different user if specified
-      if (
-        !match_any_user
-        && (credentials[i].user_unique_identifier != user_unique_identifier)
-        ) {
-        continue;
-      }
 
+    // Discard credentials associated to a different user if specified
+    if (
+      !match_any_user
+      && (p_descriptor->user_unique_identifier != user_unique_identifier)
+      ) {
+      continue;
+    }
+
+    bool is_next;
+    if (credential_slot == 0) {
+      // Find the first Credential
+      is_next = match_any_type || (p_descriptor->credential_type == credential_type);
+    } else {
       // Check if this credential is past the current one
-      if (
-        (credentials[i].credential_type > credential_type)
-        || (
-          (credentials[i].credential_type == credential_type)
-          && (credentials[i].credential_slot > credential_slot)
-          )
-        ) {
-        was_next_found = true;
-        next_index = i;
-        break;
-      }
+      is_next = (p_descriptor->credential_type > credential_type)
+                || ((p_descriptor->credential_type == credential_type)
+                    && (p_descriptor->credential_slot > credential_slot));
     }
-  }
 
-  if (was_next_found) {
-    *next_credential_type = credentials[next_index].credential_type;
-    *next_credential_slot = credentials[next_index].credential_slot;
+    if (is_next) {
+      *next_credential_type = p_descriptor->credential_type;
+      *next_credential_slot = p_descriptor->credential_slot;
+      return true;
+    }
   }
-  return was_next_found;
+  return false;
 }
 
 u3c_db_operation_result CC_UserCredential_add_credential(
@@ -865,9 +1292,10 @@ u3c_db_operation_result CC_UserCredential_add_credential(
   }
 
   // Read Credential descriptor table if it is not empty
-  credential_descriptor_t credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS] = { 0 };
+  credential_descriptor_t * credentials = credential_descriptors;
+  memset(credential_descriptors, 0, sizeof(credential_descriptors));
   if (n_credentials > 0
-      && !u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)
+      && !u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, credentials, 0)
       ) {
     return U3C_DB_OPERATION_RESULT_ERROR_IO;
   }
@@ -919,11 +1347,17 @@ u3c_db_operation_result CC_UserCredential_add_credential(
 
       // Update the descriptor table and number of Credentials in NVM
       if (
-        u3c_nvm(U3C_WRITE, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)
+        u3c_nvm(U3C_WRITE, AREA_CREDENTIAL_DESCRIPTORS, 0, credentials, 0)
         && u3c_nvm(U3C_WRITE, AREA_NUMBER_OF_CREDENTIALS, 0, &n_credentials, 0)) {
+        if (credential_index_built
+            && !credential_index_insert(p_credential, p_credential->metadata.uuid, object_offset)) {
+          credential_index_built = false;
+        }
+        touch_user(p_credential->metadata.uuid);
         return U3C_DB_OPERATION_RESULT_SUCCESS;
       } else {
         --n_credentials;
+        credential_index_built = false;
         return U3C_DB_OPERATION_RESULT_ERROR_IO;
       }
     }
@@ -941,27 +1375,27 @@ u3c_db_operation_result CC_UserCredential_modify_credential(
     return U3C_DB_OPERATION_RESULT_FAIL_DNE;
   }
 
-  // Read the Credential descriptor table from NVM
-  credential_descriptor_t credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
-  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)) {
-    return U3C_DB_OPERATION_RESULT_ERROR_IO;
-  }
-
   bool match_any_user = (p_credential->metadata.uuid == 0);
 
-  // Find Credential
+  // Find Credential, reading the descriptor table from NVM a window at a time
+  credential_descriptor_window_t window = { 0 };
   for (uint16_t i = 0; i < n_credentials; ++i) {
-    if (credentials[i].credential_type == p_credential->metadata.type
-        && credentials[i].credential_slot == p_credential->metadata.slot
+    const credential_descriptor_t * p_descriptor = get_credential_descriptor(&window, i);
+    if (!p_descriptor) {
+      return U3C_DB_OPERATION_RESULT_ERROR_IO;
+    }
+    if (p_descriptor->credential_type == p_credential->metadata.type
+        && p_descriptor->credential_slot == p_credential->metadata.slot
         ) {
-      uint16_t object_offset = credentials[i].object_offset;
+      uint16_t object_offset = p_descriptor->object_offset;
+      uint16_t user_unique_identifier = p_descriptor->user_unique_identifier;
 
       /**
        * Check if the UUID is being modified. This operation is not allowed.
        * @ref CC_UserCredential_move_credential should be used instead.
        */
       if (!match_any_user
-          && (credentials[i].user_unique_identifier != p_credential->metadata.uuid)) {
+          && (user_unique_identifier != p_credential->metadata.uuid)) {
         return U3C_DB_OPERATION_RESULT_FAIL_REASSIGN;
       }
 
@@ -979,6 +1413,19 @@ u3c_db_operation_result CC_UserCredential_modify_credential(
       // Overwrite Credential data in NVM
       nvm_success &= u3c_nvm(U3C_WRITE, AREA_CREDENTIAL_DATA, object_offset,
                          p_credential->data, p_credential->metadata.length);
+
+      // Re-index the Credential under its new data
+      if (credential_index_built) {
+        credential_index_remove(object_offset);
+        if (!credential_index_insert(p_credential, user_unique_identifier,
+                                     object_offset)) {
+          credential_index_built = false;
+        }
+      }
+      if (!nvm_success) {
+        credential_index_built = false;
+      }
+      touch_user(user_unique_identifier);
       return nvm_success ? U3C_DB_OPERATION_RESULT_SUCCESS : U3C_DB_OPERATION_RESULT_ERROR_IO;
     }
   }
@@ -997,8 +1444,8 @@ u3c_db_operation_result CC_UserCredential_delete_credential(
   }
 
   // Read the Credential descriptor table from NVM
-  credential_descriptor_t credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
-  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)) {
+  credential_descriptor_t * credentials = credential_descriptors;
+  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, credentials, 0)) {
     return U3C_DB_OPERATION_RESULT_ERROR_IO;
   }
 
@@ -1006,6 +1453,8 @@ u3c_db_operation_result CC_UserCredential_delete_credential(
   for (uint16_t i = 0; i < n_credentials; ++i) {
     if (credentials[i].credential_type == credential_type
         && credentials[i].credential_slot == credential_slot) {
+      uint16_t object_offset = credentials[i].object_offset;
+      touch_user(credentials[i].user_unique_identifier);
       --n_credentials;
 
       // If the deleted Credential was not the last in the list
@@ -1020,6 +1469,7 @@ u3c_db_operation_result CC_UserCredential_delete_credential(
         ++n_credentials;
         return U3C_DB_OPERATION_RESULT_ERROR_IO;
       }
+      credential_index_remove(object_offset);
 
       // Update the number of Credentials
       if (!u3c_nvm(U3C_WRITE, AREA_NUMBER_OF_CREDENTIALS, 0, &n_credentials, 0)) {
@@ -1039,6 +1489,54 @@ u3c_db_operation_result CC_UserCredential_delete_credential(
   return U3C_DB_OPERATION_RESULT_FAIL_DNE;
 }
 
+/**
+ * Moves a Credential to another User, keeping its slot. Its descriptor keeps
+ * its position in the table, so the table is searched a window at a time and
+ * only the UUID of the descriptor is overwritten.
+ */
+static u3c_db_operation_result reassign_credential(
+  u3c_credential_type credential_type, uint16_t credential_slot,
+  uint16_t destination_user_uid)
+{
+  credential_descriptor_window_t window = { 0 };
+  for (uint16_t i = 0; i < n_credentials; ++i) {
+    const credential_descriptor_t * p_descriptor = get_credential_descriptor(&window, i);
+    if (!p_descriptor) {
+      return U3C_DB_OPERATION_RESULT_ERROR_IO;
+    }
+    if (p_descriptor->credential_type != credential_type
+        || p_descriptor->credential_slot != credential_slot) {
+      continue;
+    }
+
+    uint16_t object_offset = p_descriptor->object_offset;
+    uint16_t source_user_uid = p_descriptor->user_unique_identifier;
+    touch_user(source_user_uid);
+    touch_user(destination_user_uid);
+
+    if (source_user_uid != destination_user_uid) {
+      // Change the associated UUID in the stored credential metadata
+      if (!u3c_nvm_write_part(AREA_CREDENTIAL_METADATA, object_offset, &destination_user_uid,
+                              offsetof(credential_metadata_nvm_t, uuid), sizeof(uint16_t))) {
+        return U3C_DB_OPERATION_RESULT_ERROR_IO;
+      }
+    }
+
+    if (!u3c_nvm_write_part(AREA_CREDENTIAL_DESCRIPTORS, 0, &destination_user_uid,
+                            (uint16_t)(i * sizeof(credential_descriptor_t)
+                                       + offsetof(credential_descriptor_t, user_unique_identifier)),
+                            sizeof(uint16_t))) {
+      credential_index_built = false;
+      return U3C_DB_OPERATION_RESULT_ERROR_IO;
+    }
+    credential_index_set_owner(object_offset, destination_user_uid, credential_slot);
+    return U3C_DB_OPERATION_RESULT_SUCCESS;
+  }
+
+  // Credential not found
+  return U3C_DB_OPERATION_RESULT_FAIL_DNE;
+}
+
 u3c_db_operation_result CC_UserCredential_move_credential(
   u3c_credential_type credential_type,
   uint16_t source_credential_slot, uint16_t destination_user_uid,
@@ -1049,14 +1547,17 @@ u3c_db_operation_result CC_UserCredential_move_credential(
     return U3C_DB_OPERATION_RESULT_FAIL_DNE;
   }
 
-  // Read the Credential descriptor table from NVM
-  credential_descriptor_t credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
-  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)) {
+  if (source_credential_slot == destination_credential_slot) {
+    return reassign_credential(credential_type, source_credential_slot, destination_user_uid);
+  }
+
+  // Read the Credential descriptor table from NVM, the moved descriptor changes position
+  credential_descriptor_t * credentials = credential_descriptors;
+  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, credentials, 0)) {
     return U3C_DB_OPERATION_RESULT_ERROR_IO;
   }
 
   bool source_exists = false;
-  bool same_slot = (source_credential_slot == destination_credential_slot);
   bool same_uuid = false;
   bool destination_occupied = false;
   uint16_t source_index;
@@ -1071,15 +1572,10 @@ u3c_db_operation_result CC_UserCredential_move_credential(
         if (credentials[i].user_unique_identifier == destination_user_uid) {
           same_uuid = true;
         }
-        if (same_slot) {
-          break;
-        }
       }
 
-      // Destination credential slot must not be occupied if different
-      if (!same_slot
-          && (credentials[i].credential_slot == destination_credential_slot)
-          ) {
+      // Destination credential slot must not be occupied
+      if (credentials[i].credential_slot == destination_credential_slot) {
         destination_occupied = true;
       }
     }
@@ -1092,19 +1588,21 @@ u3c_db_operation_result CC_UserCredential_move_credential(
   }
 
   uint16_t object_offset = credentials[source_index].object_offset;
+  touch_user(credentials[source_index].user_unique_identifier);
+  touch_user(destination_user_uid);
 
   if (!same_uuid) {
     // Change the associated UUID in the stored credential metadata
-    credential_metadata_nvm_t metadata = { 0 };
-    u3c_nvm(U3C_READ, AREA_CREDENTIAL_METADATA, object_offset, &metadata, 0);
-    metadata.uuid = destination_user_uid;
-    u3c_nvm(U3C_WRITE, AREA_CREDENTIAL_METADATA, object_offset, &metadata, 0);
+    if (!u3c_nvm_write_part(AREA_CREDENTIAL_METADATA, object_offset, &destination_user_uid,
+                            offsetof(credential_metadata_nvm_t, uuid), sizeof(uint16_t))) {
+      return U3C_DB_OPERATION_RESULT_ERROR_IO;
+    }
   }
 
   // Remove the old element from the credential descriptor array
+  n_credentials--;
   memmove(&credentials[source_index], &credentials[source_index + 1],
           (n_credentials - source_index) * sizeof(credential_descriptor_t));
-  n_credentials--;
 
   /**
    * Insert the new element into the credential descriptor array with
@@ -1121,11 +1619,56 @@ u3c_db_operation_result CC_UserCredential_move_credential(
   };
   ordered_insert_credential_descriptor(credentials, &credential, object_offset);
 
-  return (
-    // Overwrite Credential descriptor table in NVM
-    u3c_nvm(U3C_WRITE, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0))
-         ? U3C_DB_OPERATION_RESULT_SUCCESS
-         : U3C_DB_OPERATION_RESULT_ERROR_IO;
+  // Overwrite Credential descriptor table in NVM
+  if (!u3c_nvm(U3C_WRITE, AREA_CREDENTIAL_DESCRIPTORS, 0, credentials, 0)) {
+    credential_index_built = false;
+    return U3C_DB_OPERATION_RESULT_ERROR_IO;
+  }
+
+  credential_index_set_owner(object_offset, destination_user_uid, destination_credential_slot);
+  return U3C_DB_OPERATION_RESULT_SUCCESS;
+}
+
+/**
+ * Overrides the weak implementation in cc_user_credential_validation.c, which
+ * reads every stored Credential, with a lookup in the Credential content index.
+ */
+bool find_existing_credential(
+  const u3c_credential_t * const p_credential,
+  u3c_credential_metadata_t * p_existing_metadata)
+{
+  uint16_t i = credential_index_lookup(p_credential);
+  if (i == U3C_BUFFER_SIZE_CREDENTIAL_INDEX) {
+    return false;
+  }
+
+  credential_metadata_nvm_t metadata = { 0 };
+  if (!u3c_nvm(U3C_READ, AREA_CREDENTIAL_METADATA, credential_index[i].object_offset,
+               &metadata, 0)) {
+    return false;
+  }
+  return convert_credential_metadata_from_nvm(
+    p_existing_metadata, &metadata, credential_index[i].credential_type,
+    credential_index[i].credential_slot);
+}
+
+/**
+ * Overrides the weak implementation in cc_user_credential_validation.c. The
+ * owner of the Credential is taken from the index, so only the Credential data
+ * is read to confirm the match.
+ */
+bool find_credential_owner(
+  const u3c_credential_t * const p_credential,
+  uint16_t * p_user_unique_identifier,
+  uint16_t * p_credential_slot)
+{
+  uint16_t i = credential_index_lookup(p_credential);
+  if (i == U3C_BUFFER_SIZE_CREDENTIAL_INDEX) {
+    return false;
+  }
+  *p_user_unique_identifier = credential_index[i].user_unique_identifier;
+  *p_credential_slot = credential_index[i].credential_slot;
+  return true;
 }
 
 u3c_db_operation_result CC_UserCredential_get_admin_code_info(
@@ -158,6 +158,20 @@ ZW_WEAK bool find_existing_credential(
   return false;
 }
 
+ZW_WEAK bool find_credential_owner(
+  const u3c_credential_t * const p_credential,
+  uint16_t * p_user_unique_identifier,
+  uint16_t * p_credential_slot)
+{
+  u3c_credential_metadata_t existing_metadata = { 0 };
+  if (!find_existing_credential(p_credential, &existing_metadata)) {
+    return false;
+  }
+  *p_user_unique_identifier = existing_metadata.uuid;
+  *p_credential_slot = existing_metadata.slot;
+  return true;
+}
+
 ZW_WEAK bool validate_credential_data(u3c_credential_t * p_credential, RECEIVE_OPTIONS_TYPE_EX * p_rx_options)
 {
   if (u3c_credential_validator_functions[p_credential->metadata.type]) {
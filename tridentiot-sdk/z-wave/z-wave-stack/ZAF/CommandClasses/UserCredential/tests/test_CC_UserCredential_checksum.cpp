@@ -96,6 +96,8 @@ void tearDownSuite(void)
 
 void setUp(void)
 {
+  // Revisions are not tracked, so every checksum is calculated from the database
+  CC_UserCredential_get_revision_IgnoreAndReturn(0);
 }
 
 void tearDown(void)
@@ -1051,6 +1053,260 @@ void test_CREDENTIAL_CHECKSUM_validate_example4(void)
   TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS, status, "Failed to process command");
 }
 
+//******************************************************************************
+// Checksum calculation and cache test cases
+//******************************************************************************
+
+/**
+ * Calculates the CRC of the data of a User without Credentials in one pass over
+ * the data, as laid out in the specification.
+ */
+static uint16_t one_shot_user_crc(uint16_t crc, const u3c_user_t * user, const uint8_t * name)
+{
+  vector<uint8_t> data = {
+    (uint8_t)user->type,
+    (uint8_t)user->active,
+    (uint8_t)user->credential_rule,
+    (uint8_t)user->name_encoding,
+    user->name_length
+  };
+  data.insert(data.end(), name, name + user->name_length);
+  return CRC_CheckCrc16(crc, &data[0], (uint16_t)data.size());
+}
+
+static uint16_t one_shot_uuid_crc(uint16_t crc, uint16_t uuid)
+{
+  uint8_t data[] = { (uint8_t)(uuid >> 8), (uint8_t)(uuid & 0xFF) };
+  return CRC_CheckCrc16(crc, data, sizeof(data));
+}
+
+/**
+ * Expects a User without Credentials to be read from the database.
+ */
+static void expect_user_read(u3c_user_t * user, uint8_t * name)
+{
+  CC_UserCredential_get_user_ExpectAnyArgsAndReturn(U3C_DB_OPERATION_RESULT_SUCCESS);
+  if (user->name_length) {
+    CC_UserCredential_get_user_ReturnArrayThruPtr_name(name, user->name_length);
+  }
+  CC_UserCredential_get_user_ReturnThruPtr_user(user);
+
+  CC_UserCredential_get_next_credential_ExpectAndReturn(user->unique_identifier, CREDENTIAL_TYPE_NONE, 0, NULL, NULL, false);
+  CC_UserCredential_get_next_credential_IgnoreArg_next_credential_type();
+  CC_UserCredential_get_next_credential_IgnoreArg_next_credential_slot();
+}
+
+/**
+ * Sends a User Checksum Get and expects a report with the given checksum.
+ */
+static received_frame_status_t user_checksum_get(uint16_t uuid, uint16_t expected_checksum)
+{
+  vector<uint8_t> frame = CCUserCredential::UserChecksumGet().uuid(uuid);
+  RECEIVE_OPTIONS_TYPE_EX rxo = { 0 };
+
+  cc_handler_input_t input = {
+    .rx_options = &rxo,
+    .frame = (ZW_APPLICATION_TX_BUFFER *)&frame[0],
+    .length = (uint8_t)frame.size()
+  };
+
+  CCUserCredential::UserChecksumReport ExpectedReport = CCUserCredential::UserChecksumReport();
+  ExpectedReport.uuid(uuid);
+  ExpectedReport.checksum(expected_checksum);
+  vector<uint8_t> expected_report = ExpectedReport;
+
+  zaf_transport_rx_to_tx_options_Expect(&rxo, NULL);
+  zaf_transport_rx_to_tx_options_IgnoreArg_tx_options();
+  zaf_transport_tx_ExpectWithArrayAndReturn(&expected_report[0], expected_report.size(), expected_report.size(), NULL, NULL, 0, true);
+  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+
+  return invoke_cc_handler(&input, NULL);
+}
+
+/**
+ * Sends an All Users Checksum Get and expects a report with the given checksum.
+ */
+static received_frame_status_t all_users_checksum_get(uint16_t expected_checksum)
+{
+  vector<uint8_t> frame = CCUserCredential::AllUsersChecksumGet();
+  RECEIVE_OPTIONS_TYPE_EX rxo = { 0 };
+
+  cc_handler_input_t input = {
+    .rx_options = &rxo,
+    .frame = (ZW_APPLICATION_TX_BUFFER *)&frame[0],
+    .length = (uint8_t)frame.size()
+  };
+
+  CCUserCredential::AllUsersChecksumReport ExpectedReport = CCUserCredential::AllUsersChecksumReport();
+  ExpectedReport.checksum(expected_checksum);
+  vector<uint8_t> expected_report = ExpectedReport;
+
+  zaf_transport_rx_to_tx_options_Expect(&rxo, NULL);
+  zaf_transport_rx_to_tx_options_IgnoreArg_tx_options();
+  zaf_transport_tx_ExpectWithArrayAndReturn(&expected_report[0], expected_report.size(), expected_report.size(), NULL, NULL, 0, true);
+  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+
+  return invoke_cc_handler(&input, NULL);
+}
+
+/**
+ * @brief This test verifies that the User Checksum, which appends the CRC of the
+ * User's data calculated from 0 to the initial value, matches the CRC calculated
+ * in one pass over the data, for every User Name length.
+ */
+void test_USER_CHECKSUM_GET_matches_one_shot_crc(void)
+{
+  uint8_t name[UINT8_MAX];
+  for (uint16_t i = 0; i < sizeof(name); i++) {
+    name[i] = (uint8_t)(i * 7 + 3);
+  }
+
+  u3c_user_t user = test_user_Lillie;
+  for (uint16_t name_length = 0; name_length <= UINT8_MAX; name_length++) {
+    user.name_length = (uint8_t)name_length;
+
+    cc_user_credential_is_user_checksum_supported_ExpectAndReturn(true);
+    expect_user_read(&user, name);
+
+    uint16_t expected = one_shot_user_crc(CRC_INITAL_VALUE, &user, name);
+    TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS,
+                              user_checksum_get(test_user_Lillie_uuid, expected),
+                              "Failed to process command");
+  }
+}
+
+/**
+ * @brief This test verifies that the All Users Checksum, which appends the CRC
+ * of each User's data to the running checksum, matches the CRC calculated in one
+ * pass over the data of all Users.
+ */
+void test_ALL_USERS_CHECKSUM_GET_matches_one_shot_crc(void)
+{
+  uint8_t name[UINT8_MAX];
+  for (uint16_t i = 0; i < sizeof(name); i++) {
+    name[i] = (uint8_t)(0xFF - i);
+  }
+
+  u3c_user_t user_a = test_user_Lillie;
+  user_a.name_length = 33;
+  u3c_user_t user_b = test_user_7;
+  user_b.name_length = UINT8_MAX;
+
+  cc_user_credential_is_all_users_checksum_supported_ExpectAndReturn(true);
+  CC_UserCredential_get_next_user_ExpectAndReturn(0, test_user_Lillie_uuid);
+  expect_user_read(&user_a, name);
+  CC_UserCredential_get_next_user_ExpectAndReturn(test_user_Lillie_uuid, test_user_7_uuid);
+  expect_user_read(&user_b, name);
+  CC_UserCredential_get_next_user_ExpectAndReturn(test_user_7_uuid, 0);
+
+  uint16_t expected = CRC_INITAL_VALUE;
+  expected = one_shot_uuid_crc(expected, test_user_Lillie_uuid);
+  expected = one_shot_user_crc(expected, &user_a, name);
+  expected = one_shot_uuid_crc(expected, test_user_7_uuid);
+  expected = one_shot_user_crc(expected, &user_b, name);
+
+  TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS, all_users_checksum_get(expected),
+                            "Failed to process command");
+}
+
+/**
+ * @brief This test verifies that the User Checksum is answered from the cache
+ * as long as the revision of the User is unchanged, and calculated again from
+ * the database once a write has changed it.
+ */
+void test_USER_CHECKSUM_GET_cache_invalidated_on_write(void)
+{
+  u3c_user_t user = test_user_Lillie;
+  uint16_t checksum = one_shot_user_crc(CRC_INITAL_VALUE, &user, test_user_Lillie_name);
+
+  CC_UserCredential_get_revision_StopIgnore();
+
+  // The first Get reads the User from the database
+  cc_user_credential_is_user_checksum_supported_ExpectAndReturn(true);
+  CC_UserCredential_get_revision_ExpectAndReturn(test_user_Lillie_uuid, 5);
+  expect_user_read(&user, test_user_Lillie_name);
+  TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS,
+                            user_checksum_get(test_user_Lillie_uuid, checksum),
+                            "Failed to process command");
+
+  // The User has not changed, so the database is not read again
+  cc_user_credential_is_user_checksum_supported_ExpectAndReturn(true);
+  CC_UserCredential_get_revision_ExpectAndReturn(test_user_Lillie_uuid, 5);
+  TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS,
+                            user_checksum_get(test_user_Lillie_uuid, checksum),
+                            "Failed to process command");
+
+  // A write has changed the User
+  user.active = false;
+  uint16_t new_checksum = one_shot_user_crc(CRC_INITAL_VALUE, &user, test_user_Lillie_name);
+  TEST_ASSERT_NOT_EQUAL(checksum, new_checksum);
+
+  cc_user_credential_is_user_checksum_supported_ExpectAndReturn(true);
+  CC_UserCredential_get_revision_ExpectAndReturn(test_user_Lillie_uuid, 6);
+  expect_user_read(&user, test_user_Lillie_name);
+  TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS,
+                            user_checksum_get(test_user_Lillie_uuid, new_checksum),
+                            "Failed to process command");
+}
+
+/**
+ * @brief This test verifies that the All Users Checksum is answered without
+ * reading the database as long as the database revision is unchanged, and that
+ * after a write only the Users that changed are read again.
+ */
+void test_ALL_USERS_CHECKSUM_GET_cache_invalidated_on_write(void)
+{
+  u3c_user_t user_a = test_user_Lillie;
+  u3c_user_t user_b = test_user_7;
+
+  CC_UserCredential_get_revision_StopIgnore();
+
+  uint16_t checksum = CRC_INITAL_VALUE;
+  checksum = one_shot_uuid_crc(checksum, test_user_7_uuid);
+  checksum = one_shot_user_crc(checksum, &user_b, test_user_7_name);
+  checksum = one_shot_uuid_crc(checksum, test_user_Lillie_uuid);
+  checksum = one_shot_user_crc(checksum, &user_a, test_user_Lillie_name);
+
+  // The first Get reads all Users from the database
+  cc_user_credential_is_all_users_checksum_supported_ExpectAndReturn(true);
+  CC_UserCredential_get_revision_ExpectAndReturn(0, 200);
+  CC_UserCredential_get_next_user_ExpectAndReturn(0, test_user_7_uuid);
+  CC_UserCredential_get_revision_ExpectAndReturn(test_user_7_uuid, 201);
+  expect_user_read(&user_b, test_user_7_name);
+  CC_UserCredential_get_next_user_ExpectAndReturn(test_user_7_uuid, test_user_Lillie_uuid);
+  CC_UserCredential_get_revision_ExpectAndReturn(test_user_Lillie_uuid, 202);
+  expect_user_read(&user_a, test_user_Lillie_name);
+  CC_UserCredential_get_next_user_ExpectAndReturn(test_user_Lillie_uuid, 0);
+  TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS, all_users_checksum_get(checksum),
+                            "Failed to process command");
+
+  // Nothing has changed, so not even the list of Users is read
+  cc_user_credential_is_all_users_checksum_supported_ExpectAndReturn(true);
+  CC_UserCredential_get_revision_ExpectAndReturn(0, 200);
+  TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS, all_users_checksum_get(checksum),
+                            "Failed to process command");
+
+  // A write has changed the second User, the first one is taken from the cache
+  user_a.credential_rule = CREDENTIAL_RULE_DUAL;
+  uint16_t new_checksum = CRC_INITAL_VALUE;
+  new_checksum = one_shot_uuid_crc(new_checksum, test_user_7_uuid);
+  new_checksum = one_shot_user_crc(new_checksum, &user_b, test_user_7_name);
+  new_checksum = one_shot_uuid_crc(new_checksum, test_user_Lillie_uuid);
+  new_checksum = one_shot_user_crc(new_checksum, &user_a, test_user_Lillie_name);
+  TEST_ASSERT_NOT_EQUAL(checksum, new_checksum);
+
+  cc_user_credential_is_all_users_checksum_supported_ExpectAndReturn(true);
+  CC_UserCredential_get_revision_ExpectAndReturn(0, 203);
+  CC_UserCredential_get_next_user_ExpectAndReturn(0, test_user_7_uuid);
+  CC_UserCredential_get_revision_ExpectAndReturn(test_user_7_uuid, 201);
+  CC_UserCredential_get_next_user_ExpectAndReturn(test_user_7_uuid, test_user_Lillie_uuid);
+  CC_UserCredential_get_revision_ExpectAndReturn(test_user_Lillie_uuid, 203);
+  expect_user_read(&user_a, test_user_Lillie_name);
+  CC_UserCredential_get_next_user_ExpectAndReturn(test_user_Lillie_uuid, 0);
+  TEST_ASSERT_EQUAL_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS, all_users_checksum_get(new_checksum),
+                            "Failed to process command");
+}
+
 static void init_test_user_a(void)
 {
   test_user_Matt.active = true;
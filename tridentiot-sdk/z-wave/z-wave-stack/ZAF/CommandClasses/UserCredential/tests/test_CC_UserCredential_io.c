@@ -9,14 +9,17 @@
 #include "test_common.h"
 #include "ZW_classcmd.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 #include "cc_user_credential_config_api_mock.h"
 #include "ZAF_nvm_mock.h"
+#include "zpal_entropy_mock.h"
 #include "cc_user_credential_io.h"
 #include "SizeOf.h"
 #include "cc_user_credential_config.h"
 #include "cc_user_credential_io_config.h"
 #include "cc_user_credential_nvm.h"
+#include "cc_user_credential_validation.h"
 #include "ZAF_file_ids.h"
 
 /*
@@ -28,7 +31,6 @@ static void helper_preparing_user_database(void);
    DEFINITIONS
  */
 #define SIZE_READ_USER_NAME_BUFFER        10
-#define SIZE_USER_DESCRIPTORS             2
 
 /*
    COMMON TEST VARIABLES
@@ -42,8 +44,6 @@ static const uint16_t test_user_B_uuid = 2;
 unsigned char test_user_B_name[] = "AdminB";
 static u3c_user_t test_user_B;
 
-static user_descriptor_t user_descriptor[SIZE_USER_DESCRIPTORS];
-
 static u3c_user_t read_user;
 static uint8_t read_user_name[SIZE_READ_USER_NAME_BUFFER];
 
@@ -90,17 +90,13 @@ void setUp(void)
   test_user_B.credential_rule = CREDENTIAL_RULE_SINGLE;
   test_user_B.name_encoding = USER_NAME_ENCODING_STANDARD_ASCII;
 
-  user_descriptor[0].object_offset     = 0;
-  user_descriptor[0].unique_identifier = test_user_A_uuid;
-
-  user_descriptor[1].object_offset     = 1;
-  user_descriptor[1].unique_identifier = test_user_B_uuid;
-
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   cc_user_credential_get_max_user_unique_identifiers_ExpectAndReturn(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS);
+  // Key of the credential index
+  zpal_get_pseudo_random_IgnoreAndReturn(0x5A);
 
   CC_UserCredential_factory_reset();
 
@@ -132,10 +128,6 @@ void test_USER_CREDENTIAL_IO_get_user_normal(void)
 
   helper_preparing_user_database();
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(user_descriptor, 1);
-
   ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_read_IgnoreArg_object();
   ZAF_nvm_read_ReturnArrayThruPtr_object(&test_user_A, 1);
@@ -163,10 +155,6 @@ void test_USER_CREDENTIAL_IO_get_next_user_normal(void)
 
   helper_preparing_user_database();
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(user_descriptor, 2);
-
   return_value = CC_UserCredential_get_next_user(test_user_A_uuid);
   TEST_ASSERT_EQUAL_UINT8_MESSAGE(test_user_B_uuid, return_value,
                                   "[Get Next User] Getting next user from database failed");
@@ -196,11 +184,7 @@ void test_USER_CREDENTIAL_IO_modify_user_normal(void)
 
   helper_preparing_user_database();
 
-  // Read user descriptors
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(user_descriptor, 2);
-
+  // The user descriptors are served from RAM, only the user metadata is read
   // Read user metadata
   ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_read_IgnoreArg_object();
@@ -233,10 +217,6 @@ void test_USER_CREDENTIAL_IO_delete_user_normal(void)
 
   helper_preparing_user_database();
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(user_descriptor, 2);
-
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   return_value = CC_UserCredential_delete_user(test_user_A_uuid);
@@ -249,28 +229,21 @@ void test_USER_CREDENTIAL_IO_delete_user_normal(void)
  * @brief This test verifes that the users are stored in ascending order
  *        based on their unique identifier. At the beginning the database
  *        is storing two users with unique identifiers 1 and 3. Then a third
- *        user is added with unique identifier 3. The expected order is 1, 2, 3.
+ *        user is added with unique identifier 2. The expected order is 1, 2, 3.
  */
 void test_USER_CREDENTIAL_IO_check_users_ascending_order_normal_insert(void)
 {
   uint16_t return_value;
 
-  // Initializing two users
-  // IMPORTANT: with this the inner n_users variable will be set to 2, the users will be what is returned by the nvm read mock
-  helper_preparing_user_database();
-
   // At the beginning the database is storing two users with unique identifiers 1 and 3
-  user_descriptor_t users[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
-  memset(users, 0, sizeof(users));
+  u3c_user_t test_user_C;
+  memcpy(&test_user_C, &test_user_B, sizeof(u3c_user_t));
+  test_user_C.unique_identifier = 3;
 
-  users[0].unique_identifier = 1;
-  users[1].unique_identifier = 3;
-  // The nvm read will return the two users from the nvm
-  ZAF_nvm_read_ExpectAndReturn(0, NULL, 0, ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_key(); // AREA_USER_DESCRIPTORS
-  ZAF_nvm_read_IgnoreArg_object_size();
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(users, U3C_BUFFER_SIZE_USER_DESCRIPTORS);
+  ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
+  CC_UserCredential_add_user(&test_user_A, test_user_A_name);
+  CC_UserCredential_add_user(&test_user_C, test_user_B_name);
+  ZAF_nvm_write_StopIgnore();
 
   // The area users and area_user_name are not part of the test case, so this will be ignored
   ZAF_nvm_write_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
@@ -400,6 +373,133 @@ void test_USER_CREDENTIAL_IO_add_credential_adding_same_credential_multiple_time
                                   "[Add Credential] Adding the same credential multiple times succeeded");
 }
 
+/**
+ * @brief Verifies that duplicate detection only reads the Credential whose content
+ *        hash matches, and that no Credential is read if none matches.
+ */
+void test_USER_CREDENTIAL_IO_find_existing_credential_normal(void)
+{
+  bool return_value;
+
+  helper_preparing_user_database();
+
+  u3c_credential_t credential;
+  uint8_t credential_data[10];
+
+  memset(credential_data, 0xA5, sizeof(credential_data));
+  credential.metadata.length = sizeof(credential_data);
+  credential.metadata.type   = CREDENTIAL_TYPE_PIN_CODE;
+  credential.metadata.uuid   = test_user_A_uuid;
+  credential.metadata.slot   = 1;
+  credential.data            = credential_data;
+
+  ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
+  CC_UserCredential_add_credential(&credential);
+  ZAF_nvm_write_StopIgnore();
+
+  // The same data in another slot is a duplicate of the stored Credential
+  u3c_credential_t incoming_credential;
+  memcpy(&incoming_credential, &credential, sizeof(u3c_credential_t));
+  incoming_credential.metadata.uuid = test_user_B_uuid;
+  incoming_credential.metadata.slot = 2;
+
+  credential_metadata_nvm_t metadata = {
+    .uuid = test_user_A_uuid,
+    .length = sizeof(credential_data)
+  };
+
+  // Read credential data to confirm the match
+  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_IgnoreArg_object();
+  ZAF_nvm_read_ReturnArrayThruPtr_object(credential_data, sizeof(credential_data));
+
+  // Read credential metadata
+  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_IgnoreArg_object();
+  ZAF_nvm_read_ReturnThruPtr_object(&metadata);
+
+  u3c_credential_metadata_t existing_metadata = { 0 };
+  return_value = find_existing_credential(&incoming_credential, &existing_metadata);
+
+  TEST_ASSERT_TRUE_MESSAGE(return_value, "[Find Credential] Duplicate credential not found");
+  TEST_ASSERT_EQUAL_UINT16(test_user_A_uuid, existing_metadata.uuid);
+  TEST_ASSERT_EQUAL_UINT16(1, existing_metadata.slot);
+
+  // Different data does not match any Credential, so nothing is read from NVM
+  uint8_t other_data[10];
+  memset(other_data, 0x5A, sizeof(other_data));
+  incoming_credential.data = other_data;
+
+  return_value = find_existing_credential(&incoming_credential, &existing_metadata);
+
+  TEST_ASSERT_FALSE_MESSAGE(return_value, "[Find Credential] Unexpected duplicate credential found");
+}
+
+/**
+ * @brief Verifies that the owner of an entered Credential is found with a single
+ *        read of the Credential data, and that it follows the Credential when it
+ *        is moved to another User and slot.
+ */
+void test_USER_CREDENTIAL_IO_find_credential_owner_normal(void)
+{
+  bool return_value;
+  uint16_t owner = 0;
+  uint16_t slot = 0;
+
+  helper_preparing_user_database();
+
+  u3c_credential_t credential;
+  uint8_t credential_data[6];
+
+  memset(credential_data, '7', sizeof(credential_data));
+  credential.metadata.length = sizeof(credential_data);
+  credential.metadata.type   = CREDENTIAL_TYPE_PIN_CODE;
+  credential.metadata.uuid   = test_user_A_uuid;
+  credential.metadata.slot   = 1;
+  credential.data            = credential_data;
+
+  ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
+  CC_UserCredential_add_credential(&credential);
+
+  // Only the Credential data is read to confirm the match
+  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_IgnoreArg_object();
+  ZAF_nvm_read_ReturnArrayThruPtr_object(credential_data, sizeof(credential_data));
+
+  return_value = find_credential_owner(&credential, &owner, &slot);
+
+  TEST_ASSERT_TRUE_MESSAGE(return_value, "[Find Owner] Stored credential not found");
+  TEST_ASSERT_EQUAL_UINT16(test_user_A_uuid, owner);
+  TEST_ASSERT_EQUAL_UINT16(1, slot);
+
+  // Move the Credential to another User and slot
+  credential_descriptor_t credentials[1] = {
+    {
+      .user_unique_identifier = test_user_A_uuid,
+      .credential_slot = 1,
+      .object_offset = 0,
+      .credential_type = CREDENTIAL_TYPE_PIN_CODE
+    }
+  };
+  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_IgnoreArg_object();
+  ZAF_nvm_read_ReturnArrayThruPtr_object(credentials, 1);
+  ZAF_nvm_write_object_part_IgnoreAndReturn(ZPAL_STATUS_OK);
+
+  TEST_ASSERT_EQUAL_UINT8(U3C_DB_OPERATION_RESULT_SUCCESS,
+                          CC_UserCredential_move_credential(CREDENTIAL_TYPE_PIN_CODE, 1, test_user_B_uuid, 3));
+
+  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_IgnoreArg_object();
+  ZAF_nvm_read_ReturnArrayThruPtr_object(credential_data, sizeof(credential_data));
+
+  return_value = find_credential_owner(&credential, &owner, &slot);
+
+  TEST_ASSERT_TRUE_MESSAGE(return_value, "[Find Owner] Moved credential not found");
+  TEST_ASSERT_EQUAL_UINT16(test_user_B_uuid, owner);
+  TEST_ASSERT_EQUAL_UINT16(3, slot);
+}
+
 void test_USER_CREDENTIAL_IO_add_credential_modify_credential(void)
 {
   uint16_t return_value;
@@ -430,9 +530,9 @@ void test_USER_CREDENTIAL_IO_add_credential_modify_credential(void)
   credential_metadata_nvm_t metadata = { 0 };
 
   // Read credential descriptors
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(credentials, 1);
+  ZAF_nvm_read_object_part_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_object_part_IgnoreArg_object();
+  ZAF_nvm_read_object_part_ReturnArrayThruPtr_object(credentials, 1);
 
   // Read credential metadata
   ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
@@ -526,22 +626,28 @@ void test_USER_CREDENTIAL_IO_move_credential_normal(void)
   credentials[0].object_offset          = 0;
   credentials[0].credential_type        = credentialA.metadata.type;
 
-  credential_metadata_nvm_t metadata = { 0 };
-
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   CC_UserCredential_add_credential(&credentialA);
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(credentials, 1);
+  // The slot is unchanged, so the descriptors are only searched
+  ZAF_nvm_read_object_part_ExpectAndReturn(
+    ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DESCRIPTOR_TABLE, NULL,
+    0, sizeof(credential_descriptor_t), ZPAL_STATUS_OK);
+  ZAF_nvm_read_object_part_IgnoreArg_object();
+  ZAF_nvm_read_object_part_ReturnArrayThruPtr_object(credentials, 1);
+
+  // Only the UUID of the stored metadata is overwritten
+  ZAF_nvm_write_object_part_ExpectWithArrayAndReturn(
+    ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_BASE + credentials[0].object_offset,
+    &test_user_B_uuid, sizeof(test_user_B_uuid),
+    offsetof(credential_metadata_nvm_t, uuid), sizeof(test_user_B_uuid), ZPAL_STATUS_OK);
+
+  // The slot is unchanged, so only the UUID of the first descriptor is overwritten
+  ZAF_nvm_write_object_part_ExpectWithArrayAndReturn(
+    ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DESCRIPTOR_TABLE,
+    &test_user_B_uuid, sizeof(test_user_B_uuid),
+    offsetof(credential_descriptor_t, user_unique_identifier), sizeof(test_user_B_uuid), ZPAL_STATUS_OK);
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnThruPtr_object(&metadata);
-
-  ZAF_nvm_write_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-
-  ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   return_value = CC_UserCredential_move_credential(credentialA.metadata.type, credentialA.metadata.slot, test_user_B_uuid, 1);
 
   TEST_ASSERT_EQUAL_UINT8_MESSAGE(U3C_DB_OPERATION_RESULT_SUCCESS, return_value,
@@ -582,9 +688,9 @@ void test_USER_CREDENTIAL_IO_get_credential_normal(void)
   u3c_credential_metadata_t retreived_metadata;
   uint8_t retreived_credential_data[sizeof(credential_data)];
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(credentials, 1);
+  ZAF_nvm_read_object_part_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_object_part_IgnoreArg_object();
+  ZAF_nvm_read_object_part_ReturnArrayThruPtr_object(credentials, 1);
 
   ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_read_IgnoreArg_object();
@@ -639,10 +745,6 @@ void test_USER_CREDENTIAL_IO_get_next_credential_normal(void)
   credentials[1].object_offset          = 1;
   credentials[1].credential_type        = credentialB.metadata.type;
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(credentials, 0);
-
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   CC_UserCredential_add_credential(&credentialA);
 
@@ -653,6 +755,10 @@ void test_USER_CREDENTIAL_IO_get_next_credential_normal(void)
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   CC_UserCredential_add_credential(&credentialB);
 
+  ZAF_nvm_read_object_part_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_object_part_IgnoreArg_object();
+  ZAF_nvm_read_object_part_ReturnArrayThruPtr_object(credentials, 2);
+
   uint16_t retreived_next_credential_slot;
   u3c_credential_type retreived_next_credential_type;
 
@@ -711,9 +817,9 @@ void test_USER_CREDENTIAL_IO_get_next_credential_find_first_credential_for_user_
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   CC_UserCredential_add_credential(&credentialB);
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnArrayThruPtr_object(credentials, 2);
+  ZAF_nvm_read_object_part_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_read_object_part_IgnoreArg_object();
+  ZAF_nvm_read_object_part_ReturnArrayThruPtr_object(credentials, 2);
 
   uint16_t retreived_next_credential_slot;
   u3c_credential_type retreived_next_credential_type;
@@ -728,6 +834,89 @@ void test_USER_CREDENTIAL_IO_get_next_credential_find_first_credential_for_user_
                                   "[Get Next Credential] Finding first credential for user failed");
 }
 
+// Credential descriptor table kept by the stubs below
+static credential_descriptor_t stored_credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
+
+static zpal_status_t credential_table_write_stub(zpal_nvm_object_key_t key, const void* object, size_t object_size, int cmock_num_calls)
+{
+  if (key == ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DESCRIPTOR_TABLE) {
+    memcpy(stored_credentials, object, object_size);
+  }
+  return ZPAL_STATUS_OK;
+}
+
+static zpal_status_t credential_table_read_stub(zpal_nvm_object_key_t key, void* object, size_t object_size, int cmock_num_calls)
+{
+  if (key == ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DESCRIPTOR_TABLE) {
+    memcpy(object, stored_credentials, object_size);
+  } else {
+    memset(object, 0, object_size);
+  }
+  return ZPAL_STATUS_OK;
+}
+
+static zpal_status_t credential_table_read_part_stub(zpal_nvm_object_key_t key, void* object, size_t offset, size_t size, int cmock_num_calls)
+{
+  TEST_ASSERT_EQUAL_UINT16(ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_DESCRIPTOR_TABLE, key);
+  // No more than one window of whole descriptors is read at a time
+  TEST_ASSERT_EQUAL_UINT16(0, offset % sizeof(credential_descriptor_t));
+  TEST_ASSERT_TRUE(size <= U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW * sizeof(credential_descriptor_t));
+  memcpy(object, (const uint8_t *)stored_credentials + offset, size);
+  return ZPAL_STATUS_OK;
+}
+
+/**
+ * @brief Verifies that a Credential descriptor table larger than the read window
+ *        is searched one window at a time.
+ */
+void test_USER_CREDENTIAL_IO_get_next_credential_past_read_window(void)
+{
+  const uint16_t n_stored = U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTOR_WINDOW + 2;
+  TEST_ASSERT_TRUE(n_stored <= U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS);
+
+  helper_preparing_user_database();
+
+  memset(stored_credentials, 0, sizeof(stored_credentials));
+  ZAF_nvm_write_Stub(credential_table_write_stub);
+  ZAF_nvm_read_Stub(credential_table_read_stub);
+  ZAF_nvm_read_object_part_Stub(credential_table_read_part_stub);
+
+  for (uint16_t slot = 1; slot <= n_stored; slot++) {
+    uint8_t credential_data[4] = { '1', '2', (uint8_t)('0' + slot / 10), (uint8_t)('0' + slot % 10) };
+    u3c_credential_t credential = {
+      .metadata = {
+        .length = sizeof(credential_data),
+        .type = CREDENTIAL_TYPE_PIN_CODE,
+        .uuid = test_user_A_uuid,
+        .slot = slot,
+      },
+      .data = credential_data
+    };
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(U3C_DB_OPERATION_RESULT_SUCCESS,
+                                    CC_UserCredential_add_credential(&credential),
+                                    "[Add Credential] Adding credential failed");
+  }
+
+  // The next Credential is only in the second window
+  u3c_credential_type next_type = CREDENTIAL_TYPE_NONE;
+  uint16_t next_slot = 0;
+  bool return_value = CC_UserCredential_get_next_credential(test_user_A_uuid,
+                                                            CREDENTIAL_TYPE_PIN_CODE,
+                                                            n_stored - 1,
+                                                            &next_type,
+                                                            &next_slot);
+  TEST_ASSERT_TRUE_MESSAGE(return_value, "[Get Next Credential] Getting next credential failed");
+  TEST_ASSERT_EQUAL_UINT8(CREDENTIAL_TYPE_PIN_CODE, next_type);
+  TEST_ASSERT_EQUAL_UINT16(n_stored, next_slot);
+
+  return_value = CC_UserCredential_get_next_credential(test_user_A_uuid,
+                                                       CREDENTIAL_TYPE_PIN_CODE,
+                                                       n_stored,
+                                                       &next_type,
+                                                       &next_slot);
+  TEST_ASSERT_FALSE_MESSAGE(return_value, "[Get Next Credential] Found a credential past the last one");
+}
+
 zpal_status_t ZAF_nvm_write_Stub_Callback(zpal_nvm_object_key_t key, const void* object, size_t object_size, int cmock_num_calls)
 {
   if (key == ZAF_FILE_ID_CC_USER_CREDENTIAL_USER_DESCRIPTOR_TABLE) {
@@ -853,9 +1042,6 @@ void test_USER_CREDENTIAL_IO_check_users_ascending_order_move_db_ordered(void)
   credential_descriptor_t credentials[3];
   memset(credentials, 0, sizeof(credentials));
 
-  // Metadata for credential B in NVM
-  credential_metadata_nvm_t nvm_metadata_credentialB = { 0 };
-
   ZAF_nvm_write_IgnoreAndReturn(ZPAL_STATUS_OK);
   ZAF_nvm_read_IgnoreAndReturn(ZPAL_STATUS_OK);
   // This part just incrementing n_crednetials internal variable
@@ -894,11 +1080,11 @@ void test_USER_CREDENTIAL_IO_check_users_ascending_order_move_db_ordered(void)
   expected_credentials[1].object_offset          = 2;
   expected_credentials[1].credential_type        = credentialB.metadata.type;
 
-  ZAF_nvm_read_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
-  ZAF_nvm_read_IgnoreArg_object();
-  ZAF_nvm_read_ReturnThruPtr_object(&nvm_metadata_credentialB);
-
-  ZAF_nvm_write_ExpectAnyArgsAndReturn(ZPAL_STATUS_OK);
+  // Only the UUID of the stored metadata of credential B is overwritten
+  ZAF_nvm_write_object_part_ExpectWithArrayAndReturn(
+    ZAF_FILE_ID_CC_USER_CREDENTIAL_CREDENTIAL_BASE + credentials[1].object_offset,
+    &test_user_A_uuid, sizeof(test_user_A_uuid),
+    offsetof(credential_metadata_nvm_t, uuid), sizeof(test_user_A_uuid), ZPAL_STATUS_OK);
 
   ZAF_nvm_write_ExpectWithArrayAndReturn(0, &expected_credentials, 3, 3 * sizeof(credential_descriptor_t), ZPAL_STATUS_OK);
   ZAF_nvm_write_IgnoreArg_key();